@@ -0,0 +1,361 @@
+#include "app_crash_log.h"
+#include <stdio.h>
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "stm32f4xx_hal.h"
+#include "elog.h"
+#include "elog_flash.h"
+
+#define CRASHLOG_MAGIC 0x434C4F47  // "GOLC"
+#define CRASHLOG_HDR_SIZE 4        // 记录头：长度 + CRC16
+#define CRASHLOG_MAX_LEN 256       // 单条记录最大长度 (与日志行缓冲区一致)
+
+#if (CRASHLOG_BUF_SIZE & (CRASHLOG_BUF_SIZE - 1)) != 0
+#error "CRASHLOG_BUF_SIZE must be power of 2"
+#endif
+
+/* ARMCC5 的 UNINIT 只对 ZI 段生效，必须加 zero_init 才会进入 .bss.noinit */
+#if defined(__CC_ARM)
+#define CRASHLOG_NOINIT __attribute__((section(".bss.noinit"), zero_init))
+#else
+#define CRASHLOG_NOINIT __attribute__((section(".bss.noinit")))
+#endif
+
+static CrashLog_t crash_log CRASHLOG_NOINIT; // 复位后保留的日志环
+static bool crash_ready = false;             // 初始化完成前的日志不记录
+static uint32_t last_rd = 0;                 // 上次运行留下的记录范围 [last_rd, last_wr)
+static uint32_t last_wr = 0;
+static uint32_t last_fault = 0;              // 上次运行是否以断言/HardFault 结束
+static uint32_t last_reset = 0;              // 本次启动的复位原因 (RCC->CSR)
+static char crash_line[CRASHLOG_MAX_LEN];    // 读出记录/格式化故障信息用，静态分配避免占用任务栈
+
+/* CRC-16/CCITT-FALSE 查找表 (多项式 0x1021) */
+static const uint16_t crc16_table[256] = {
+    0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+    0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF,
+    0x1231, 0x0210, 0x3273, 0x2252, 0x52B5, 0x4294, 0x72F7, 0x62D6,
+    0x9339, 0x8318, 0xB37B, 0xA35A, 0xD3BD, 0xC39C, 0xF3FF, 0xE3DE,
+    0x2462, 0x3443, 0x0420, 0x1401, 0x64E6, 0x74C7, 0x44A4, 0x5485,
+    0xA56A, 0xB54B, 0x8528, 0x9509, 0xE5EE, 0xF5CF, 0xC5AC, 0xD58D,
+    0x3653, 0x2672, 0x1611, 0x0630, 0x76D7, 0x66F6, 0x5695, 0x46B4,
+    0xB75B, 0xA77A, 0x9719, 0x8738, 0xF7DF, 0xE7FE, 0xD79D, 0xC7BC,
+    0x48C4, 0x58E5, 0x6886, 0x78A7, 0x0840, 0x1861, 0x2802, 0x3823,
+    0xC9CC, 0xD9ED, 0xE98E, 0xF9AF, 0x8948, 0x9969, 0xA90A, 0xB92B,
+    0x5AF5, 0x4AD4, 0x7AB7, 0x6A96, 0x1A71, 0x0A50, 0x3A33, 0x2A12,
+    0xDBFD, 0xCBDC, 0xFBBF, 0xEB9E, 0x9B79, 0x8B58, 0xBB3B, 0xAB1A,
+    0x6CA6, 0x7C87, 0x4CE4, 0x5CC5, 0x2C22, 0x3C03, 0x0C60, 0x1C41,
+    0xEDAE, 0xFD8F, 0xCDEC, 0xDDCD, 0xAD2A, 0xBD0B, 0x8D68, 0x9D49,
+    0x7E97, 0x6EB6, 0x5ED5, 0x4EF4, 0x3E13, 0x2E32, 0x1E51, 0x0E70,
+    0xFF9F, 0xEFBE, 0xDFDD, 0xCFFC, 0xBF1B, 0xAF3A, 0x9F59, 0x8F78,
+    0x9188, 0x81A9, 0xB1CA, 0xA1EB, 0xD10C, 0xC12D, 0xF14E, 0xE16F,
+    0x1080, 0x00A1, 0x30C2, 0x20E3, 0x5004, 0x4025, 0x7046, 0x6067,
+    0x83B9, 0x9398, 0xA3FB, 0xB3DA, 0xC33D, 0xD31C, 0xE37F, 0xF35E,
+    0x02B1, 0x1290, 0x22F3, 0x32D2, 0x4235, 0x5214, 0x6277, 0x7256,
+    0xB5EA, 0xA5CB, 0x95A8, 0x8589, 0xF56E, 0xE54F, 0xD52C, 0xC50D,
+    0x34E2, 0x24C3, 0x14A0, 0x0481, 0x7466, 0x6447, 0x5424, 0x4405,
+    0xA7DB, 0xB7FA, 0x8799, 0x97B8, 0xE75F, 0xF77E, 0xC71D, 0xD73C,
+    0x26D3, 0x36F2, 0x0691, 0x16B0, 0x6657, 0x7676, 0x4615, 0x5634,
+    0xD94C, 0xC96D, 0xF90E, 0xE92F, 0x99C8, 0x89E9, 0xB98A, 0xA9AB,
+    0x5844, 0x4865, 0x7806, 0x6827, 0x18C0, 0x08E1, 0x3882, 0x28A3,
+    0xCB7D, 0xDB5C, 0xEB3F, 0xFB1E, 0x8BF9, 0x9BD8, 0xABBB, 0xBB9A,
+    0x4A75, 0x5A54, 0x6A37, 0x7A16, 0x0AF1, 0x1AD0, 0x2AB3, 0x3A92,
+    0xFD2E, 0xED0F, 0xDD6C, 0xCD4D, 0xBDAA, 0xAD8B, 0x9DE8, 0x8DC9,
+    0x7C26, 0x6C07, 0x5C64, 0x4C45, 0x3CA2, 0x2C83, 0x1CE0, 0x0CC1,
+    0xEF1F, 0xFF3E, 0xCF5D, 0xDF7C, 0xAF9B, 0xBFBA, 0x8FD9, 0x9FF8,
+    0x6E17, 0x7E36, 0x4E55, 0x5E74, 0x2E93, 0x3EB2, 0x0ED1, 0x1EF0
+};
+
+/**
+ * @brief 计算 CRC16
+ * @param[in] data 数据
+ * @param[in] size 数据长度
+ * @return CRC16 (初值 0xFFFF)
+ */
+static uint16_t CrashLog_Crc16(const uint8_t *data, size_t size)
+{
+    uint16_t crc = 0xFFFF;
+
+    while (size--)
+    {
+        crc = (uint16_t)(crc << 8) ^ crc16_table[(uint8_t)(crc >> 8) ^ *data++];
+    }
+    return crc;
+}
+
+/**
+ * @brief 从环中读出数据 (可以跨过回绕点)
+ * @param[in] pos 读取位置 (单调递增的偏移)
+ * @param[out] buf 输出缓冲区
+ * @param[in] size 读取长度
+ */
+static void CrashLog_Read(uint32_t pos, void *buf, size_t size)
+{
+    uint32_t off = pos & (CRASHLOG_BUF_SIZE - 1);
+    size_t n = (size < CRASHLOG_BUF_SIZE - off) ? size : (CRASHLOG_BUF_SIZE - off);
+
+    memcpy(buf, &crash_log.buf[off], n);
+    memcpy((uint8_t *)buf + n, crash_log.buf, size - n);
+}
+
+/**
+ * @brief 向环中写入数据 (可以跨过回绕点)
+ * @param[in] pos 写入位置 (单调递增的偏移)
+ * @param[in] data 数据
+ * @param[in] size 数据长度
+ */
+static void CrashLog_Copy(uint32_t pos, const void *data, size_t size)
+{
+    uint32_t off = pos & (CRASHLOG_BUF_SIZE - 1);
+    size_t n = (size < CRASHLOG_BUF_SIZE - off) ? size : (CRASHLOG_BUF_SIZE - off);
+
+    memcpy(&crash_log.buf[off], data, n);
+    memcpy(crash_log.buf, (const uint8_t *)data + n, size - n);
+}
+
+/**
+ * @brief 读取并校验一条记录
+ * @param[in] pos 记录位置
+ * @param[in] end 有效数据的结束位置
+ * @param[out] len 日志长度
+ * @param[out] data 日志内容 (至少 CRASHLOG_MAX_LEN 字节)
+ * @return true - 记录完整
+ */
+static bool CrashLog_Check(uint32_t pos, uint32_t end, uint16_t *len, char *data)
+{
+    uint16_t hdr[2];
+
+    if (end - pos < CRASHLOG_HDR_SIZE)
+    {
+        return false;
+    }
+    CrashLog_Read(pos, hdr, sizeof(hdr));
+    if (hdr[0] > CRASHLOG_MAX_LEN || hdr[0] > end - pos - CRASHLOG_HDR_SIZE)
+    {
+        return false;
+    }
+    CrashLog_Read(pos + CRASHLOG_HDR_SIZE, data, hdr[0]);
+    *len = hdr[0];
+    return CrashLog_Crc16((const uint8_t *)data, hdr[0]) == hdr[1];
+}
+
+/**
+ * @brief 复位原因
+ * @param[in] csr RCC->CSR
+ * @return 复位原因字符串
+ */
+static const char *CrashLog_ResetCause(uint32_t csr)
+{
+    if (csr & RCC_CSR_IWDGRSTF)
+    {
+        return "IWDG";
+    }
+    if (csr & RCC_CSR_WWDGRSTF)
+    {
+        return "WWDG";
+    }
+    if (csr & RCC_CSR_LPWRRSTF)
+    {
+        return "low power";
+    }
+    if (csr & RCC_CSR_SFTRSTF)
+    {
+        return "software";
+    }
+    if (csr & RCC_CSR_PORRSTF)
+    {
+        return "power on";
+    }
+    if (csr & RCC_CSR_BORRSTF)
+    {
+        return "brown out";
+    }
+    if (csr & RCC_CSR_PINRSTF)
+    {
+        return "reset pin";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief 复位保留日志初始化
+ * @note 必须在 elog_init() 之前调用。上电时 RAM 内容随机，魔数对不上就清空；
+ *       热复位后逐条校验 CRC，截掉最后一条写了一半的记录，剩下的作为上次运行的日志保留，
+ *       本次运行的日志接在后面继续写，写满后才覆盖上次的内容
+ */
+void CrashLog_Init(void)
+{
+    uint32_t pos;
+    uint16_t len;
+
+    last_reset = RCC->CSR;
+    __HAL_RCC_CLEAR_RESET_FLAGS();
+
+    if (CRASHLOG_MAGIC != crash_log.magic || crash_log.wr - crash_log.rd > CRASHLOG_BUF_SIZE)
+    {
+        crash_log.magic = CRASHLOG_MAGIC;
+        crash_log.rd = 0;
+        crash_log.wr = 0;
+        crash_log.fault = 0;
+    }
+    for (pos = crash_log.rd; pos != crash_log.wr; pos += CRASHLOG_HDR_SIZE + len)
+    {
+        if (!CrashLog_Check(pos, crash_log.wr, &len, crash_line))
+        {
+            break;
+        }
+    }
+    crash_log.wr = pos;
+    last_rd = crash_log.rd;
+    last_wr = crash_log.wr;
+    last_fault = crash_log.fault;
+    crash_log.fault = 0;
+    crash_ready = true;
+}
+
+/**
+ * @brief 记录一行日志 (elog 打包完成后调用，任务和中断中都可以调用)
+ * @param[in] log 日志
+ * @param[in] size 日志长度
+ * @note 只是一次内存拷贝，CRC 在临界区外计算；空间不够时丢掉最旧的记录
+ */
+void CrashLog_Write(const char *log, size_t size)
+{
+    uint16_t hdr[2], old[2];
+    UBaseType_t saved;
+
+    if (!crash_ready || 0 == size)
+    {
+        return;
+    }
+    if (size > CRASHLOG_MAX_LEN)
+    {
+        size = CRASHLOG_MAX_LEN;
+    }
+    hdr[0] = (uint16_t)size;
+    hdr[1] = CrashLog_Crc16((const uint8_t *)log, size);
+
+    saved = taskENTER_CRITICAL_FROM_ISR();
+    while (crash_log.wr + CRASHLOG_HDR_SIZE + size - crash_log.rd > CRASHLOG_BUF_SIZE)
+    {
+        CrashLog_Read(crash_log.rd, old, sizeof(old));
+        crash_log.rd += CRASHLOG_HDR_SIZE + old[0];
+    }
+    CrashLog_Copy(crash_log.wr + CRASHLOG_HDR_SIZE, log, size);
+    CrashLog_Copy(crash_log.wr, hdr, sizeof(hdr));
+    crash_log.wr += CRASHLOG_HDR_SIZE + size;
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+}
+
+/**
+ * @brief 记录故障信息并打上故障标记
+ * @param[in] size crash_line 中的内容长度
+ */
+static void CrashLog_Fault(int size)
+{
+    if (size > 0)
+    {
+        CrashLog_Write(crash_line, ((size_t)size < sizeof(crash_line)) ? (size_t)size : (sizeof(crash_line) - 1));
+    }
+    crash_log.fault = 1;
+}
+
+/**
+ * @brief configASSERT 失败时调用 (中断已关闭，之后进入死循环)
+ * @param[in] file 文件名
+ * @param[in] line 行号
+ */
+void CrashLog_Assert(const char *file, int line)
+{
+    const char *name = strrchr(file, '\\');
+
+    if (NULL == name)
+    {
+        name = strrchr(file, '/');
+    }
+    name = (NULL != name) ? (name + 1) : file;
+    CrashLog_Fault(snprintf(crash_line, sizeof(crash_line), "[CRASH] configASSERT %s:%d\r\n", name, line));
+}
+
+/**
+ * @brief HardFault 中调用，记录故障状态寄存器
+ * @note CFSR 指出故障类型，BFAR/MMFAR 在对应的 VALID 位置位时是出错的地址
+ */
+void CrashLog_HardFault(void)
+{
+    CrashLog_Fault(snprintf(crash_line, sizeof(crash_line),
+                            "[CRASH] HardFault HFSR=%08lX CFSR=%08lX BFAR=%08lX MMFAR=%08lX\r\n",
+                            (unsigned long)SCB->HFSR, (unsigned long)SCB->CFSR,
+                            (unsigned long)SCB->BFAR, (unsigned long)SCB->MMFAR));
+}
+
+/**
+ * @brief 依次读出上次运行留下的记录
+ * @param[in] output 每条记录的输出函数
+ * @return 读出的字节数
+ * @note 本次运行的日志也在往环里写，每条记录在临界区内拷出来再输出；
+ *       已经被本次日志覆盖的部分直接跳过
+ */
+static size_t CrashLog_Walk(void (*output)(const char *log, size_t size))
+{
+    uint32_t pos = last_rd;
+    uint16_t len;
+    size_t total = 0;
+    bool ok;
+    UBaseType_t saved;
+
+    while ((int32_t)(last_wr - pos) > 0)
+    {
+        saved = taskENTER_CRITICAL_FROM_ISR();
+        if ((int32_t)(crash_log.rd - pos) > 0)
+        {
+            pos = crash_log.rd;
+        }
+        ok = ((int32_t)(last_wr - pos) > 0) && CrashLog_Check(pos, last_wr, &len, crash_line);
+        taskEXIT_CRITICAL_FROM_ISR(saved);
+        if (!ok)
+        {
+            break;
+        }
+        output(crash_line, len);
+        total += len;
+        pos += CRASHLOG_HDR_SIZE + len;
+    }
+    return total;
+}
+
+/**
+ * @brief 输出上次运行的日志 (LASTLOG 命令使用)
+ * @param[in] tag 日志标签
+ * @note 记录直接同步输出，统计行走异步队列，放在最后
+ */
+void CrashLog_Print(const char *tag)
+{
+    extern void elog_port_output(const char *log, size_t size);
+    size_t total = CrashLog_Walk(elog_port_output);
+
+    elog_i(tag, "Last run: %lu bytes kept, %s, reset by %s\r\n", (unsigned long)total,
+           last_fault ? "crashed" : "no crash record", CrashLog_ResetCause(last_reset));
+}
+
+/**
+ * @brief 上次运行异常结束时，把保留的日志转存到 Flash 日志
+ * @note 在 elog_start() 之后、调度器启动之前调用；正常复位不转存，
+ *       避免每次启动都把已经存过的 WARN/ERROR 日志重复写一遍
+ */
+void CrashLog_SaveToFlash(void)
+{
+#if CRASHLOG_SAVE_TO_FLASH
+    int size;
+
+    if (!last_fault && !(last_reset & (RCC_CSR_IWDGRSTF | RCC_CSR_WWDGRSTF)))
+    {
+        return;
+    }
+    size = snprintf(crash_line, sizeof(crash_line), "---- last run ended by %s ----\r\n",
+                    last_fault ? "crash" : CrashLog_ResetCause(last_reset));
+    elog_flash_write(crash_line, (size_t)size);
+    CrashLog_Walk(elog_flash_write);
+    elog_flash_flush();
+#endif
+}
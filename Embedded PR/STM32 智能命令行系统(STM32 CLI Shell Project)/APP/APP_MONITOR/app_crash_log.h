@@ -0,0 +1,32 @@
+#ifndef __APP_CRASH_LOG_H__
+#define __APP_CRASH_LOG_H__
+
+/* 本文件会被 FreeRTOSConfig.h 包含 (configASSERT)，不能再包含 FreeRTOS 的头文件 */
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#define CRASHLOG_BUF_SIZE 4096      // 掉电丢失、复位保留的日志环形缓冲区大小 (字节，必须是 2 的幂)
+#define CRASHLOG_SAVE_TO_FLASH 1    // 1: 上次运行以断言/HardFault/看门狗复位结束时，启动后转存到 Flash 日志
+
+/**
+ * @brief 复位保留区的日志环形缓冲区 (放在分散加载文件的 UNINIT 区域，启动代码不会清零)
+ * @note 记录格式：[长度 16位] [数据的 CRC16] [日志文本]，按字节环形存放，可以跨过回绕点
+ */
+typedef struct
+{
+    uint32_t magic;                 // 有效标志，上电后 RAM 内容随机，对不上就整个丢弃
+    uint32_t rd;                    // 最旧一条记录的位置 (单调递增，对缓冲区大小取模)
+    uint32_t wr;                    // 下一条记录的写入位置
+    uint32_t fault;                 // 非0: 本次运行以断言或 HardFault 结束
+    uint8_t buf[CRASHLOG_BUF_SIZE]; // 记录数据
+} CrashLog_t;
+
+void CrashLog_Init(void);
+void CrashLog_Write(const char *log, size_t size);
+void CrashLog_Assert(const char *file, int line);
+void CrashLog_HardFault(void);
+void CrashLog_Print(const char *tag);
+void CrashLog_SaveToFlash(void);
+
+#endif //end __APP_CRASH_LOG_H__
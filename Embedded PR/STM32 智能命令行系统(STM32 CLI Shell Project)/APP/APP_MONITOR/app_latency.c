@@ -0,0 +1,128 @@
+#include "app_latency.h"
+#include <string.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "elog.h"
+#include "bsp_dwt.h"
+
+static Lat_Hist_t lat_hist[LAT_STAGE_NUM]; // 各测量区间的直方图
+static const char *const lat_stage_name[LAT_STAGE_NUM] = {"ISR->Give", "Give->Wake", "ISR->Wake"};
+
+/**
+ * @brief 计算样本所属的桶 (即 log2 向下取整)
+ * @param[in] cycles 样本值
+ * @return 桶下标，0 和 1 都落在第 0 个桶
+ */
+static uint8_t Lat_Bucket(uint32_t cycles)
+{
+    uint8_t k = 0;
+
+    while (cycles > 1U && k < LAT_BUCKETS - 1)
+    {
+        cycles >>= 1;
+        k++;
+    }
+    return k;
+}
+
+/**
+ * @brief 周期数换算成纳秒
+ * @param[in] cycles 周期数
+ * @return 纳秒
+ */
+static uint32_t Lat_CycleToNs(uint64_t cycles)
+{
+    uint32_t freq = BSP_DWT_GetFreq();
+
+    if (0 == freq)
+    {
+        return 0;
+    }
+    return (uint32_t)((cycles * 1000000000ULL) / freq);
+}
+
+/**
+ * @brief 记录一个延迟样本
+ * @param[in] stage 测量区间
+ * @param[in] cycles 延迟 (DWT 周期数，32位差值，单次延迟不会超过卷绕时间)
+ * @note 只在 UART 解析任务中调用，打印时才需要与之互斥
+ */
+void Latency_Record(Lat_Stage_t stage, uint32_t cycles)
+{
+    Lat_Hist_t *hist;
+
+    if (stage >= LAT_STAGE_NUM)
+    {
+        return;
+    }
+    hist = &lat_hist[stage];
+
+    taskENTER_CRITICAL();
+    hist->bucket[Lat_Bucket(cycles)]++;
+    if (0 == hist->count || cycles < hist->min)
+    {
+        hist->min = cycles;
+    }
+    if (cycles > hist->max)
+    {
+        hist->max = cycles;
+    }
+    hist->count++;
+    hist->sum += cycles;
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief 清空所有直方图
+ */
+void Latency_Reset(void)
+{
+    taskENTER_CRITICAL();
+    memset(lat_hist, 0, sizeof(lat_hist));
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief 打印各区间的延迟统计和直方图 (LAT 命令使用)
+ * @param[in] tag 日志标签
+ * @note 桶的边界按周期数取 2 的幂，显示时换算成纳秒；只打印非空的桶
+ */
+void Latency_Print(const char *tag)
+{
+    static Lat_Hist_t snapshot; // 静态分配，避免占用 CLI 任务栈
+    uint8_t s, k;
+
+    for (s = 0; s < LAT_STAGE_NUM; s++)
+    {
+        taskENTER_CRITICAL();
+        snapshot = lat_hist[s];
+        taskEXIT_CRITICAL();
+
+        elog_i(tag, "[%s] n=%lu min=%luns avg=%luns max=%luns\r\n",
+               lat_stage_name[s],
+               (unsigned long)snapshot.count,
+               (unsigned long)Lat_CycleToNs(snapshot.min),
+               (unsigned long)(snapshot.count ? Lat_CycleToNs(snapshot.sum / snapshot.count) : 0),
+               (unsigned long)Lat_CycleToNs(snapshot.max));
+
+        for (k = 0; k < LAT_BUCKETS; k++)
+        {
+            if (0 == snapshot.bucket[k])
+            {
+                continue;
+            }
+            if (k == LAT_BUCKETS - 1)
+            {
+                elog_i(tag, "  >= %8luns : %lu\r\n",
+                       (unsigned long)Lat_CycleToNs(1ULL << k),
+                       (unsigned long)snapshot.bucket[k]);
+            }
+            else
+            {
+                elog_i(tag, "  < %9luns : %lu\r\n",
+                       (unsigned long)Lat_CycleToNs(2ULL << k),
+                       (unsigned long)snapshot.bucket[k]);
+            }
+        }
+    }
+}
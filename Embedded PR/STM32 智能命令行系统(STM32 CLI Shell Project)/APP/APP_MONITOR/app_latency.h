@@ -0,0 +1,35 @@
+#ifndef __APP_LATENCY_H__
+#define __APP_LATENCY_H__
+
+#include <stdint.h>
+
+#define LAT_BUCKETS 24 // 直方图桶数，第 k 个桶统计 [2^k, 2^(k+1)) 个周期，最后一个桶收纳所有更大的值
+
+/**
+ * @brief UART 接收链路上的测量区间
+ */
+typedef enum
+{
+    LAT_ISR_TO_GIVE = 0, // 进入中断 -> 释放信号量 (HAL 中断处理 + 数据搬运)
+    LAT_GIVE_TO_WAKE,    // 释放信号量 -> 任务开始运行 (调度延迟，调优任务优先级看这一项)
+    LAT_ISR_TO_WAKE,     // 进入中断 -> 任务开始运行 (端到端)
+    LAT_STAGE_NUM
+} Lat_Stage_t;
+
+/**
+ * @brief 单个测量区间的对数直方图 (单位：统计时钟周期)
+ */
+typedef struct
+{
+    uint32_t bucket[LAT_BUCKETS]; // 各桶计数
+    uint32_t count;               // 样本总数
+    uint32_t min;                 // 最小值
+    uint32_t max;                 // 最大值
+    uint64_t sum;                 // 累加和 (求平均用)
+} Lat_Hist_t;
+
+void Latency_Record(Lat_Stage_t stage, uint32_t cycles);
+void Latency_Reset(void);
+void Latency_Print(const char *tag);
+
+#endif //end __APP_LATENCY_H__
@@ -0,0 +1,170 @@
+#include "app_power.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "elog.h"
+#include "main.h"
+#include "bsp_dwt.h"
+
+extern TIM_HandleTypeDef htim1; // HAL 时间基准 (stm32f4xx_hal_timebase_tim.c)
+
+static LowPower_Stats_t lp_stats;       // 睡眠统计
+static uint32_t lp_start_tick;          // 开始统计的时刻
+static uint32_t lp_sleep_begin;         // 本次睡眠开始的时刻
+static uint32_t lp_sleep_expected;      // 本次睡眠预定的时长
+static bool lp_sleeping;                // 已执行到 WFI (内核放弃进入睡眠时不调用 PreSleep)
+static uint32_t lp_hal_offset;          // HAL 节拍与系统节拍之差，第一次睡眠时记录
+static bool lp_hal_synced;
+static uint32_t lp_st_val;              // 进入 WFI 前的 SysTick 当前值
+static uint32_t lp_st_pend;             // 进入 WFI 前 SysTick 中断是否已经挂起
+static uint32_t lp_dwt;                 // 进入 WFI 前的 DWT 周期数
+
+/**
+ * @brief 进入睡眠前的处理 (configPRE_SLEEP_PROCESSING，中断已关闭)
+ * @param[in] expected 预定睡眠的节拍数
+ * @note HAL 的时间基准 TIM1 每 1ms 中断一次，不停掉的话 CPU 每毫秒都会被叫醒，
+ *       无节拍模式就没有意义了；停掉期间少计的毫秒数在 LowPower_IdleEnd 中补上。
+ *       使用 Sleep 模式 (WFI，不进 Stop)：外设和 DMA 时钟都不停，
+ *       串口 DMA 照常接收，空闲线中断一来 CPU 立即醒来，唤醒延迟只是普通的中断延迟
+ * @note 内核时钟在 Sleep 模式下停止，DWT CYCCNT 不计数；SysTick 已按睡眠时长重装并照常计数，
+ *       这里记下两者的值，醒来后由 LowPower_PostSleep 补上 CYCCNT 少计的周期
+ */
+void LowPower_PreSleep(uint32_t expected)
+{
+    lp_sleeping = true;
+    HAL_SuspendTick();
+    lp_st_pend = SCB->ICSR & SCB_ICSR_PENDSTSET_Msk;
+    lp_st_val = SysTick->VAL;
+    lp_dwt = BSP_DWT_GetCycle();
+}
+
+/**
+ * @brief 醒来后的处理 (configPOST_SLEEP_PROCESSING，中断仍关闭)
+ * @param[in] expected 预定睡眠的节拍数
+ * @note 睡眠期间 TIM1 的更新标志早已置位，直接恢复中断会多计 1ms，先清掉
+ * @note SysTick 和 CYCCNT 都按内核时钟计数，SysTick 在睡眠中不停，两者从 PreSleep 到这里的差值
+ *       就是 WFI 期间 CYCCNT 停掉的周期数。SysTick 到 0 会叫醒 CPU，所以最多重装一次：
+ *       当前值变大，或 SysTick 中断在睡眠中变为挂起 (不读 CTRL，port.c 接下来还要用 COUNTFLAG)
+ */
+void LowPower_PostSleep(uint32_t expected)
+{
+    uint32_t pend = SCB->ICSR & SCB_ICSR_PENDSTSET_Msk;
+    uint32_t val = SysTick->VAL;
+    uint32_t awake = BSP_DWT_GetCycle() - lp_dwt;
+    uint32_t elapsed;
+
+    if (val > lp_st_val || (pend != 0 && 0 == lp_st_pend))
+    {
+        elapsed = lp_st_val + SysTick->LOAD + 1U - val; // 计到 0 后从 LOAD 重装
+    }
+    else
+    {
+        elapsed = lp_st_val - val;
+    }
+    if ((int32_t)(elapsed - awake) > 0)
+    {
+        BSP_DWT_AddSleep(elapsed - awake);
+    }
+
+    __HAL_TIM_CLEAR_FLAG(&htim1, TIM_FLAG_UPDATE);
+    HAL_ResumeTick();
+}
+
+/**
+ * @brief 开始一次无节拍睡眠 (traceLOW_POWER_IDLE_BEGIN，空闲任务中、调度器已挂起)
+ * @param[in] now 当前节拍数 (含挂起期间积压的节拍)
+ * @param[in] expected 预定睡眠的节拍数 (到下一个任务超时或定时器到期)
+ */
+void LowPower_IdleBegin(uint32_t now, uint32_t expected)
+{
+    lp_sleep_begin = now;
+    lp_sleep_expected = expected;
+    if (!lp_hal_synced)
+    {
+        lp_hal_offset = uwTick - now;
+        lp_hal_synced = true;
+    }
+}
+
+/**
+ * @brief 结束一次无节拍睡眠 (traceLOW_POWER_IDLE_END，内核已经补上睡眠期间的节拍)
+ * @param[in] now 当前节拍数 (含挂起期间积压的节拍)
+ * @note 睡眠时长按整节拍计，被中断提前唤醒时不足 1 个节拍的部分不计入，统计值略低于实际睡眠时间。
+ * @note HAL 节拍不能简单地加上睡眠的节拍数：TIM1 和 SysTick 相位不同，睡眠多在系统节拍刚过时开始，
+ *       每次平均少算半个节拍，串口频繁唤醒时偏差会越积越大 (tickless_sim 仿真 5ms 一批数据，1 分钟差约 5s)。
+ *       改为把 HAL 节拍对齐到 "系统节拍 + 固定差值"，两次睡眠之间 TIM1 照常计数，最多超前 1ms；
+ *       只向前调、不回退，HAL_GetTick() 保持单调，驱动里的超时判断不会出错
+ */
+void LowPower_IdleEnd(uint32_t now)
+{
+    uint32_t slept = now - lp_sleep_begin;
+
+    if (!lp_sleeping)
+    {
+        return; // 准备睡眠时已有任务就绪，内核放弃了这次睡眠
+    }
+    lp_sleeping = false;
+
+    if ((int32_t)(now + lp_hal_offset - uwTick) > 0) // HAL 节拍频率与系统节拍相同 (都是 1kHz)
+    {
+        uwTick = now + lp_hal_offset;
+    }
+
+    lp_stats.sleep_cnt++;
+    lp_stats.sleep_ticks += slept;
+    if (slept + 1U < lp_sleep_expected)
+    {
+        lp_stats.early_wake_cnt++;
+    }
+    if (slept > lp_stats.max_sleep)
+    {
+        lp_stats.max_sleep = slept;
+    }
+}
+
+/**
+ * @brief 获取睡眠统计
+ * @param[out] stats 统计结果，total_ticks 为从开始统计到现在的节拍数
+ */
+void LowPower_GetStats(LowPower_Stats_t *stats)
+{
+    taskENTER_CRITICAL();
+    *stats = lp_stats;
+    stats->total_ticks = xTaskGetTickCount() - lp_start_tick;
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief 清空睡眠统计，从现在开始重新计算
+ */
+void LowPower_Reset(void)
+{
+    taskENTER_CRITICAL();
+    lp_stats.sleep_cnt = 0;
+    lp_stats.early_wake_cnt = 0;
+    lp_stats.max_sleep = 0;
+    lp_stats.sleep_ticks = 0;
+    lp_start_tick = xTaskGetTickCount();
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief 打印睡眠驻留率
+ * @param[in] tag 日志标签
+ * @note 驻留率 = 睡眠时间 / 统计时长。即使完全空闲也到不了 100%：
+ *       SysTick 是 24 位计数器，100MHz 下一次最多睡约 167ms，
+ *       系统监控定时器每 PROF_SAMPLE_MS 也会唤醒一次
+ */
+void LowPower_Print(const char *tag)
+{
+    LowPower_Stats_t stats;
+    uint32_t permille;
+
+    LowPower_GetStats(&stats);
+    permille = (0 == stats.total_ticks) ? 0 : (uint32_t)((uint64_t)stats.sleep_ticks * 1000U / stats.total_ticks);
+    elog_i(tag, "Tickless idle: %s\r\n", (LOWPOWER_TICKLESS_ENABLE != 0) ? "ON" : "OFF");
+    elog_i(tag, "Sleep residency: %lu.%lu%% (%lu of %lu ms)\r\n", (unsigned long)(permille / 10),
+           (unsigned long)(permille % 10), (unsigned long)stats.sleep_ticks, (unsigned long)stats.total_ticks);
+    elog_i(tag, "Sleeps: %lu, Early wakes: %lu, Longest: %lu ms, Average: %lu ms\r\n",
+           (unsigned long)stats.sleep_cnt, (unsigned long)stats.early_wake_cnt, (unsigned long)stats.max_sleep,
+           (unsigned long)((0 == stats.sleep_cnt) ? 0 : stats.sleep_ticks / stats.sleep_cnt));
+}
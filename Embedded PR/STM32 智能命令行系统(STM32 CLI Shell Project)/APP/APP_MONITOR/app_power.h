@@ -0,0 +1,30 @@
+#ifndef __APP_POWER_H__
+#define __APP_POWER_H__
+
+/* 本文件会被 FreeRTOSConfig.h 包含 (低功耗钩子)，不能再包含 FreeRTOS 的头文件 */
+#include <stdint.h>
+#include <stdbool.h>
+
+#define LOWPOWER_TICKLESS_ENABLE 1 // 1: 空闲时停掉系统节拍并进入 Sleep 模式 (configUSE_TICKLESS_IDLE), 0: 节拍一直运行
+
+/**
+ * @brief 睡眠统计 (单位：系统节拍，1 tick = 1ms)
+ */
+typedef struct
+{
+    uint32_t sleep_cnt;      // 进入睡眠的次数
+    uint32_t early_wake_cnt; // 预定时间未到就被中断 (串口接收等) 唤醒的次数
+    uint32_t max_sleep;      // 最长的一次睡眠
+    uint32_t sleep_ticks;    // 累计睡眠时间
+    uint32_t total_ticks;    // 统计时长
+} LowPower_Stats_t;
+
+void LowPower_PreSleep(uint32_t expected);
+void LowPower_PostSleep(uint32_t expected);
+void LowPower_IdleBegin(uint32_t now, uint32_t expected);
+void LowPower_IdleEnd(uint32_t now);
+void LowPower_GetStats(LowPower_Stats_t *stats);
+void LowPower_Reset(void);
+void LowPower_Print(const char *tag);
+
+#endif //end __APP_POWER_H__
@@ -0,0 +1,194 @@
+#include "app_profiler.h"
+#include <string.h>
+#include "elog.h"
+
+/**
+ * @brief 单个任务的负载历史
+ * @note 与 app_runtime_stats 的累计表按下标一一对应，
+ *       表项被别的任务复用时 (task_num 变化) 历史清零重新统计
+ */
+typedef struct
+{
+    char name[configMAX_TASK_NAME_LEN]; // 任务名
+    UBaseType_t task_num;               // 任务编号
+    uint16_t hist[PROF_HISTORY_LEN];    // 负载历史环形缓冲区 (千分比)
+    uint16_t count;                     // 有效样本数 (最大 PROF_HISTORY_LEN)
+    uint32_t sum_1s;                    // 最近 PROF_WIN_1S 个样本之和
+    uint32_t sum_10s;                   // 最近 PROF_WIN_10S 个样本之和
+    uint32_t sum_60s;                   // 最近 PROF_WIN_60S 个样本之和
+    uint16_t peak;                      // 峰值
+    bool used;                          // 表项是否在用
+} Prof_Task_t;
+
+static Prof_Task_t prof_table[RTS_MAX_TASKS]; // 各任务的负载历史
+static uint16_t prof_head;                    // 下一个样本写入位置 (所有任务共用)
+
+/**
+ * @brief 计算窗口平均值
+ * @param[in] sum 窗口内样本之和
+ * @param[in] win 窗口长度 (样本数)
+ * @param[in] count 有效样本数，不足一个窗口时按实际样本数平均
+ * @return 平均负载 (千分比)
+ */
+static uint16_t Prof_Avg(uint32_t sum, uint16_t win, uint16_t count)
+{
+    uint16_t n = (count < win) ? count : win;
+    if (0 == n)
+    {
+        return 0;
+    }
+    return (uint16_t)(sum / n);
+}
+
+/**
+ * @brief 取出 win 个样本之前写入的历史值
+ * @param[in] task 任务历史
+ * @param[in] win 窗口长度 (样本数)
+ * @return 即将移出窗口的样本值，不足一个窗口时为 0
+ */
+static uint16_t Prof_Oldest(const Prof_Task_t *task, uint16_t win)
+{
+    return task->hist[(prof_head + PROF_HISTORY_LEN - win) % PROF_HISTORY_LEN];
+}
+
+/**
+ * @brief 负载分析器初始化
+ */
+void Profiler_Init(void)
+{
+    memset(prof_table, 0, sizeof(prof_table));
+    prof_head = 0;
+}
+
+/**
+ * @brief 追加一个采样周期的负载样本 (每 PROF_SAMPLE_MS 调用一次)
+ * @note 必须在 RuntimeStats_Sample 之后、同一个上下文中调用
+ * @note 工作流程：
+ *       1. 读取运行时间统计的窗口增量，换算成千分比
+ *       2. 用 "加新样本、减掉移出窗口的旧样本" 的方式维护三个窗口的累加和，
+ *          每次更新 O(1)，不需要遍历历史
+ *       3. 新样本写入环形缓冲区，更新峰值
+ */
+void Profiler_Update(void)
+{
+    const RTS_TaskEntry_t *rts;
+    uint32_t window;
+    uint16_t load;
+    uint8_t i;
+
+    rts = RuntimeStats_GetTable(&window);
+
+    vTaskSuspendAll();
+    for (i = 0; i < RTS_MAX_TASKS; i++)
+    {
+        Prof_Task_t *task = &prof_table[i];
+
+        if (!rts[i].used)
+        {
+            task->used = false;
+            continue;
+        }
+        if (!task->used || task->task_num != rts[i].task_num)
+        {
+            // 新任务 (或表项被复用)：清空历史，旧样本全部视为 0
+            memset(task, 0, sizeof(*task));
+            task->used = true;
+            task->task_num = rts[i].task_num;
+            memcpy(task->name, rts[i].name, sizeof(task->name));
+        }
+
+        load = (0 == window) ? 0 : (uint16_t)(((uint64_t)rts[i].delta * 1000U) / window);
+        if (load > 1000)
+        {
+            load = 1000;
+        }
+
+        // 60s 窗口等于整个环形缓冲区，最旧的样本就是 prof_head 处即将被覆盖的值
+        task->sum_1s += load - Prof_Oldest(task, PROF_WIN_1S);
+        task->sum_10s += load - Prof_Oldest(task, PROF_WIN_10S);
+        task->sum_60s += load - Prof_Oldest(task, PROF_WIN_60S);
+        task->hist[prof_head] = load;
+
+        if (task->count < PROF_HISTORY_LEN)
+        {
+            task->count++;
+        }
+        if (load > task->peak)
+        {
+            task->peak = load;
+        }
+    }
+    prof_head = (prof_head + 1) % PROF_HISTORY_LEN;
+    (void)xTaskResumeAll();
+}
+
+/**
+ * @brief 清零所有任务的峰值
+ */
+void Profiler_ResetPeak(void)
+{
+    uint8_t i;
+
+    vTaskSuspendAll();
+    for (i = 0; i < RTS_MAX_TASKS; i++)
+    {
+        prof_table[i].peak = 0;
+    }
+    (void)xTaskResumeAll();
+}
+
+/**
+ * @brief 获取各任务的负载摘要
+ * @param[out] out 摘要输出数组
+ * @param[in] max 数组容量
+ * @return 实际写入的任务数
+ */
+uint8_t Profiler_GetSummary(Prof_Summary_t *out, uint8_t max)
+{
+    uint8_t i, n = 0;
+
+    vTaskSuspendAll();
+    for (i = 0; i < RTS_MAX_TASKS && n < max; i++)
+    {
+        const Prof_Task_t *task = &prof_table[i];
+        if (!task->used || 0 == task->count)
+        {
+            continue;
+        }
+        memcpy(out[n].name, task->name, sizeof(out[n].name));
+        out[n].task_num = (uint8_t)task->task_num;
+        out[n].cur = task->hist[(prof_head + PROF_HISTORY_LEN - 1) % PROF_HISTORY_LEN];
+        out[n].avg_1s = Prof_Avg(task->sum_1s, PROF_WIN_1S, task->count);
+        out[n].avg_10s = Prof_Avg(task->sum_10s, PROF_WIN_10S, task->count);
+        out[n].avg_60s = Prof_Avg(task->sum_60s, PROF_WIN_60S, task->count);
+        out[n].peak = task->peak;
+        n++;
+    }
+    (void)xTaskResumeAll();
+    return n;
+}
+
+/**
+ * @brief 打印各任务的负载滑动平均和峰值 (PROF 命令使用)
+ * @param[in] tag 日志标签
+ */
+void Profiler_Print(const char *tag)
+{
+    static Prof_Summary_t summary[RTS_MAX_TASKS]; // 静态分配，避免占用 CLI 任务栈
+    uint8_t i, n;
+
+    n = Profiler_GetSummary(summary, RTS_MAX_TASKS);
+
+    elog_i(tag, "Task Name\tCur\t1s\t10s\t60s\tPeak\r\n");
+    elog_i(tag, "-------------------------------------------------------\r\n");
+    for (i = 0; i < n; i++)
+    {
+        elog_i(tag, "%-16s%u.%u%%\t%u.%u%%\t%u.%u%%\t%u.%u%%\t%u.%u%%\r\n",
+               summary[i].name,
+               summary[i].cur / 10, summary[i].cur % 10,
+               summary[i].avg_1s / 10, summary[i].avg_1s % 10,
+               summary[i].avg_10s / 10, summary[i].avg_10s % 10,
+               summary[i].avg_60s / 10, summary[i].avg_60s % 10,
+               summary[i].peak / 10, summary[i].peak % 10);
+    }
+}
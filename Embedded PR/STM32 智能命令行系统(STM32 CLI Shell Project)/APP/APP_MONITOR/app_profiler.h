@@ -0,0 +1,35 @@
+#ifndef __APP_PROFILER_H__
+#define __APP_PROFILER_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "app_runtime_stats.h"
+
+#define PROF_SAMPLE_MS 250                                // 采样周期 (ms)，由系统监控定时器驱动
+#define PROF_HISTORY_LEN (60000 / PROF_SAMPLE_MS)         // 历史环形缓冲区长度，保存最近 60s 的样本
+#define PROF_WIN_1S (1000 / PROF_SAMPLE_MS)               // 1s 窗口包含的样本数
+#define PROF_WIN_10S (10000 / PROF_SAMPLE_MS)             // 10s 窗口包含的样本数
+#define PROF_WIN_60S PROF_HISTORY_LEN                     // 60s 窗口包含的样本数
+
+/**
+ * @brief 单个任务的负载摘要 (单位：千分比 0-1000)
+ * @note CLI 打印和二进制遥测共用这个结构
+ */
+typedef struct
+{
+    char name[configMAX_TASK_NAME_LEN]; // 任务名
+    uint8_t task_num;                   // 任务编号
+    uint16_t cur;                       // 最近一个采样周期的负载
+    uint16_t avg_1s;                    // 1s 滑动平均
+    uint16_t avg_10s;                   // 10s 滑动平均
+    uint16_t avg_60s;                   // 60s 滑动平均
+    uint16_t peak;                      // 峰值 (上次清零以来)
+} Prof_Summary_t;
+
+void Profiler_Init(void);
+void Profiler_Update(void);
+void Profiler_ResetPeak(void);
+uint8_t Profiler_GetSummary(Prof_Summary_t *out, uint8_t max);
+void Profiler_Print(const char *tag);
+
+#endif //end __APP_PROFILER_H__
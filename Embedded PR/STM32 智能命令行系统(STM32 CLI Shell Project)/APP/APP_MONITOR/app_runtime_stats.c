@@ -0,0 +1,184 @@
+#include "app_runtime_stats.h"
+#include <string.h>
+#include "elog.h"
+#include "bsp_dwt.h"
+
+static TaskStatus_t rts_status[RTS_MAX_TASKS];   // uxTaskGetSystemState 的输出缓冲区
+static RTS_TaskEntry_t rts_table[RTS_MAX_TASKS]; // 64位累计表
+static RTS_TaskEntry_t rts_snapshot[RTS_MAX_TASKS]; // 打印用的快照，避免打印时表被采样修改
+static uint64_t rts_start_time;  // 开始统计的时刻 (统计时钟计数)
+static uint64_t rts_last_time;   // 上一次采样的时刻
+static uint32_t rts_window;      // 最近一个采样窗口的长度
+
+/**
+ * @brief 统计时钟当前值 (64位)
+ * @note 与 getRunTimeCounterValue() 使用同一个时钟和分频，保证单位一致
+ */
+static uint64_t RTS_Now(void)
+{
+    return BSP_DWT_GetCycle64() >> DWT_RUNTIME_SHIFT;
+}
+
+/**
+ * @brief 按任务编号查找表项，找不到则分配一个空闲表项
+ * @param[in] task_num 任务编号
+ * @return 表项指针，表满时返回 NULL
+ */
+static RTS_TaskEntry_t *RTS_FindEntry(UBaseType_t task_num)
+{
+    RTS_TaskEntry_t *free_entry = NULL;
+    uint8_t i;
+
+    for (i = 0; i < RTS_MAX_TASKS; i++)
+    {
+        if (rts_table[i].used && rts_table[i].task_num == task_num)
+        {
+            return &rts_table[i];
+        }
+        if (!rts_table[i].used && NULL == free_entry)
+        {
+            free_entry = &rts_table[i];
+        }
+    }
+    return free_entry;
+}
+
+/**
+ * @brief 运行时间统计初始化
+ * @note 记录起始时刻并清空累计表，需在调度器启动前调用
+ */
+void RuntimeStats_Init(void)
+{
+    memset(rts_table, 0, sizeof(rts_table));
+    rts_start_time = RTS_Now();
+    rts_last_time = rts_start_time;
+    rts_window = 0;
+}
+
+/**
+ * @brief 周期采样，把各任务的32位计数增量累加到64位
+ * @note 工作流程：
+ *       1. 通过 uxTaskGetSystemState 读取所有任务的 ulRunTimeCounter
+ *       2. 与上次的值做无符号相减得到窗口增量 (32位卷绕自动处理)
+ *       3. 增量累加到64位 total，同时保存为 delta 供窗口百分比使用
+ *       4. 本次没出现的任务说明已被删除，释放其表项
+ * @note 采样周期必须小于32位统计计数的卷绕时间 (6.25MHz 下约 11 分钟)
+ */
+void RuntimeStats_Sample(void)
+{
+    UBaseType_t count, i;
+    uint8_t j;
+    bool seen[RTS_MAX_TASKS] = {false};
+    uint64_t now;
+
+    count = uxTaskGetSystemState(rts_status, RTS_MAX_TASKS, NULL);
+    now = RTS_Now();
+
+    for (i = 0; i < count; i++)
+    {
+        RTS_TaskEntry_t *entry = RTS_FindEntry(rts_status[i].xTaskNumber);
+        if (NULL == entry)
+        {
+            continue; // 表已满，忽略多出来的任务
+        }
+        if (!entry->used)
+        {
+            // 新任务：从当前计数开始统计，之前的时间全部算作第一个窗口
+            memset(entry, 0, sizeof(*entry));
+            entry->used = true;
+            entry->task_num = rts_status[i].xTaskNumber;
+            strncpy(entry->name, rts_status[i].pcTaskName, configMAX_TASK_NAME_LEN - 1);
+        }
+        entry->delta = rts_status[i].ulRunTimeCounter - entry->last_counter;
+        entry->last_counter = rts_status[i].ulRunTimeCounter;
+        entry->total += entry->delta;
+        seen[entry - rts_table] = true;
+    }
+
+    // 清除已删除任务的表项
+    for (j = 0; j < RTS_MAX_TASKS; j++)
+    {
+        if (rts_table[j].used && !seen[j])
+        {
+            rts_table[j].used = false;
+        }
+    }
+
+    rts_window = (uint32_t)(now - rts_last_time);
+    rts_last_time = now;
+}
+
+/**
+ * @brief 获取64位累计表 (共 RTS_MAX_TASKS 项，used 为 false 的表项无效)
+ * @param[out] window 最近一个采样窗口的长度 (统计时钟计数)，可为 NULL
+ * @return 累计表首地址
+ * @note 没有拷贝，只能在采样所在的上下文 (定时器服务任务) 中紧接着 RuntimeStats_Sample 使用
+ */
+const RTS_TaskEntry_t *RuntimeStats_GetTable(uint32_t *window)
+{
+    if (NULL != window)
+    {
+        *window = rts_window;
+    }
+    return rts_table;
+}
+
+/**
+ * @brief 计算千分比
+ * @param[in] part 部分
+ * @param[in] whole 总量
+ * @return part / whole 的千分比 (0-1000)
+ */
+static uint32_t RTS_Permille(uint64_t part, uint64_t whole)
+{
+    if (0 == whole)
+    {
+        return 0;
+    }
+    return (uint32_t)((part * 1000U) / whole);
+}
+
+/**
+ * @brief 打印各任务的 CPU 占用 (TOP 命令使用)
+ * @param[in] tag 日志标签
+ * @note 输出两列百分比：
+ *       - Total：自统计开始以来的平均占用 (64位累计，不受卷绕影响)
+ *       - Last ：最近一个采样窗口内的占用
+ */
+void RuntimeStats_Print(const char *tag)
+{
+    uint64_t elapsed;
+    uint32_t window, ticks_per_ms, total_pm, last_pm;
+    uint8_t i;
+
+    // 挂起调度器拷贝快照，打印过程中采样任务可以继续更新原表
+    vTaskSuspendAll();
+    memcpy(rts_snapshot, rts_table, sizeof(rts_snapshot));
+    elapsed = rts_last_time - rts_start_time;
+    window = rts_window;
+    (void)xTaskResumeAll();
+
+    ticks_per_ms = (BSP_DWT_GetFreq() >> DWT_RUNTIME_SHIFT) / 1000U;
+    if (0 == ticks_per_ms)
+    {
+        ticks_per_ms = 1;
+    }
+
+    elog_i(tag, "Task Name\tAbs Time(ms)\tTotal\tLast\r\n");
+    elog_i(tag, "-------------------------------------------------------\r\n");
+    for (i = 0; i < RTS_MAX_TASKS; i++)
+    {
+        if (!rts_snapshot[i].used)
+        {
+            continue;
+        }
+        total_pm = RTS_Permille(rts_snapshot[i].total, elapsed);
+        last_pm = RTS_Permille(rts_snapshot[i].delta, window);
+        elog_i(tag, "%-16s%lu\t\t%lu.%lu%%\t%lu.%lu%%\r\n",
+               rts_snapshot[i].name,
+               (unsigned long)(rts_snapshot[i].total / ticks_per_ms),
+               (unsigned long)(total_pm / 10), (unsigned long)(total_pm % 10),
+               (unsigned long)(last_pm / 10), (unsigned long)(last_pm % 10));
+    }
+    elog_i(tag, "Uptime: %lu s\r\n", (unsigned long)(elapsed / (ticks_per_ms * 1000U)));
+}
@@ -0,0 +1,31 @@
+#ifndef __APP_RUNTIME_STATS_H__
+#define __APP_RUNTIME_STATS_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define RTS_MAX_TASKS 12 // 最多统计的任务数量 (需 >= 系统中的任务总数)
+
+/**
+ * @brief 单个任务的64位运行时间统计
+ * @note FreeRTOS 内核里的 ulRunTimeCounter 只有32位，会卷绕
+ *       这里按窗口求增量再累加到64位，长时间运行百分比依然准确
+ */
+typedef struct
+{
+    char name[configMAX_TASK_NAME_LEN]; // 任务名
+    UBaseType_t task_num;               // 任务编号 (xTaskNumber)
+    uint32_t last_counter;              // 上次采样时内核的32位计数
+    uint64_t total;                     // 64位累计运行时间 (统计时钟计数)
+    uint32_t delta;                     // 最近一个采样窗口内的运行时间
+    bool used;                          // 表项是否在用
+} RTS_TaskEntry_t;
+
+void RuntimeStats_Init(void);
+void RuntimeStats_Sample(void);
+void RuntimeStats_Print(const char *tag);
+const RTS_TaskEntry_t *RuntimeStats_GetTable(uint32_t *window);
+
+#endif //end __APP_RUNTIME_STATS_H__
@@ -0,0 +1,167 @@
+#include "app_stack_monitor.h"
+#include <string.h>
+#include "timers.h"
+#include "elog.h"
+
+#define LOG_TAG_STK "Stack_mon"
+
+static StackMon_Entry_t stk_table[STACK_MON_MAX_TASKS]; // 被监控的任务
+static bool stk_sys_registered = false;                 // 空闲任务和定时器任务是否已登记
+
+/**
+ * @brief 登记一个需要监控栈用量的任务
+ * @param[in] task 任务句柄
+ * @param[in] size 创建任务时分配的栈大小 (字节)
+ * @note 内核只能告诉我们剩余多少栈，总大小需要创建者在这里告诉监控器
+ */
+void StackMon_Register(TaskHandle_t task, uint32_t size)
+{
+    uint8_t i;
+
+    if (NULL == task)
+    {
+        return;
+    }
+    taskENTER_CRITICAL();
+    for (i = 0; i < STACK_MON_MAX_TASKS; i++)
+    {
+        if (NULL == stk_table[i].task || task == stk_table[i].task)
+        {
+            stk_table[i].task = task;
+            stk_table[i].size = size;
+            stk_table[i].min_free = size;
+            break;
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief 取消监控 (删除任务之前必须调用，否则会访问已释放的任务控制块)
+ * @param[in] task 任务句柄
+ */
+void StackMon_Unregister(TaskHandle_t task)
+{
+    uint8_t i;
+
+    taskENTER_CRITICAL();
+    for (i = 0; i < STACK_MON_MAX_TASKS; i++)
+    {
+        if (task == stk_table[i].task)
+        {
+            memset(&stk_table[i], 0, sizeof(stk_table[i]));
+        }
+    }
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief 计算推荐的栈大小
+ * @param[in] entry 任务的栈使用记录
+ * @return 峰值用量 + 余量，向上对齐到 8 字节 (AAPCS 要求栈 8 字节对齐)
+ */
+static uint32_t StackMon_Recommend(const StackMon_Entry_t *entry)
+{
+    uint32_t used = entry->size - entry->min_free;
+    uint32_t margin = used * STACK_MON_MARGIN_PCT / 100U;
+
+    if (margin < STACK_MON_MARGIN_MIN)
+    {
+        margin = STACK_MON_MARGIN_MIN;
+    }
+    return (used + margin + 7U) & ~7U;
+}
+
+/**
+ * @brief 周期采样所有任务的栈高水位
+ * @note 运行在定时器服务任务中。工作流程：
+ *       1. 第一次运行时登记空闲任务和定时器任务 (句柄在调度器启动后才有效)
+ *       2. 通过 uxTaskGetStackHighWaterMark 读取剩余栈 (单位是字，需换算成字节)
+ *       3. 出现新的最低值且低于 STACK_MON_WARN_PCT 时提前告警，
+ *          不必等到真正溢出触发 vApplicationStackOverflowHook
+ */
+void StackMon_Sample(void)
+{
+    uint32_t free_bytes;
+    uint8_t i;
+
+    if (!stk_sys_registered)
+    {
+        StackMon_Register(xTaskGetIdleTaskHandle(), configMINIMAL_STACK_SIZE * sizeof(StackType_t));
+        StackMon_Register(xTimerGetTimerDaemonTaskHandle(), configTIMER_TASK_STACK_DEPTH * sizeof(StackType_t));
+        stk_sys_registered = true;
+    }
+
+    for (i = 0; i < STACK_MON_MAX_TASKS; i++)
+    {
+        if (NULL == stk_table[i].task)
+        {
+            continue;
+        }
+        free_bytes = uxTaskGetStackHighWaterMark(stk_table[i].task) * sizeof(StackType_t);
+        if (free_bytes >= stk_table[i].min_free)
+        {
+            continue;
+        }
+        stk_table[i].min_free = free_bytes;
+
+        if (free_bytes * 100U < stk_table[i].size * STACK_MON_WARN_PCT)
+        {
+            elog_w(LOG_TAG_STK, "%s stack low: %lu/%lu bytes free",
+                   pcTaskGetName(stk_table[i].task),
+                   (unsigned long)free_bytes, (unsigned long)stk_table[i].size);
+        }
+    }
+}
+
+/**
+ * @brief 打印各任务的栈使用情况和推荐大小 (STACK 命令使用)
+ * @param[in] tag 日志标签
+ * @note Save 列为按推荐值调整后可节省的字节数，为负表示当前栈偏小需要加大
+ */
+void StackMon_Print(const char *tag)
+{
+    StackMon_Entry_t entry;
+    uint32_t recommend;
+    int32_t save, total_save = 0;
+    uint8_t i;
+
+    elog_i(tag, "Task Name\tSize\tUsed\tFree\tRecmd\tSave\r\n");
+    elog_i(tag, "-------------------------------------------------------\r\n");
+    for (i = 0; i < STACK_MON_MAX_TASKS; i++)
+    {
+        taskENTER_CRITICAL();
+        entry = stk_table[i];
+        taskEXIT_CRITICAL();
+
+        if (NULL == entry.task)
+        {
+            continue;
+        }
+        recommend = StackMon_Recommend(&entry);
+        save = (int32_t)entry.size - (int32_t)recommend;
+        total_save += save;
+        elog_i(tag, "%-16s%lu\t%lu\t%lu\t%lu\t%ld\r\n",
+               pcTaskGetName(entry.task),
+               (unsigned long)entry.size,
+               (unsigned long)(entry.size - entry.min_free),
+               (unsigned long)entry.min_free,
+               (unsigned long)recommend,
+               (long)save);
+    }
+    elog_i(tag, "Total save: %ld bytes (margin %d%%, min %d bytes)\r\n",
+           (long)total_save, STACK_MON_MARGIN_PCT, STACK_MON_MARGIN_MIN);
+}
+
+/**
+ * @brief 栈溢出钩子 (configCHECK_FOR_STACK_OVERFLOW 开启后由内核在任务切换时调用)
+ * @param[in] xTask 溢出的任务
+ * @param[in] pcTaskName 任务名
+ * @note 覆盖 cmsis_os2.c 中的弱定义。此时栈已损坏，只输出任务名后停机
+ */
+void vApplicationStackOverflowHook(TaskHandle_t xTask, signed char *pcTaskName)
+{
+    (void)xTask;
+    elog_a(LOG_TAG_STK, "Stack overflow: %s", (char *)pcTaskName);
+    configASSERT(0);
+}
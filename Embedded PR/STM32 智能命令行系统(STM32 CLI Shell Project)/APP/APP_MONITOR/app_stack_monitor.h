@@ -0,0 +1,29 @@
+#ifndef __APP_STACK_MONITOR_H__
+#define __APP_STACK_MONITOR_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define STACK_MON_MAX_TASKS 12      // 最多监控的任务数量
+#define STACK_MON_MARGIN_PCT 25     // 推荐栈大小在峰值用量上追加的余量 (%)
+#define STACK_MON_MARGIN_MIN 128    // 余量下限 (字节)，防止小栈任务余量过小
+#define STACK_MON_WARN_PCT 20       // 剩余栈低于总大小的该比例时告警 (%)
+
+/**
+ * @brief 单个任务的栈使用记录
+ */
+typedef struct
+{
+    TaskHandle_t task;      // 任务句柄
+    uint32_t size;          // 分配的栈大小 (字节)
+    uint32_t min_free;      // 历史最小剩余栈 (字节)，即高水位
+} StackMon_Entry_t;
+
+void StackMon_Register(TaskHandle_t task, uint32_t size);
+void StackMon_Unregister(TaskHandle_t task);
+void StackMon_Sample(void);
+void StackMon_Print(const char *tag);
+
+#endif //end __APP_STACK_MONITOR_H__
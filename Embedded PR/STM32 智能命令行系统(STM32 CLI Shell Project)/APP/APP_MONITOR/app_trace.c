@@ -0,0 +1,166 @@
+#include "app_trace.h"
+#include <string.h>
+#include "SEGGER_RTT.h"
+#include "bsp_dwt.h"
+
+static uint8_t trace_rtt_buf[TRACE_RTT_BUF_SIZE]; // RTT 追踪通道缓冲区
+static volatile bool trace_on = false;            // 是否记录事件
+static uint32_t trace_drop = 0;                   // 尚未上报的丢弃条数
+static uint32_t trace_drop_total = 0;             // 累计丢弃条数
+
+/**
+ * @brief 写入一条记录 (调用者必须持有 RTT 锁)
+ * @param[in] rec 记录
+ * @note 通道为 NO_BLOCK_SKIP 模式，空间不足时整条丢弃，不会阻塞也不会写半条
+ *       之前有丢弃时先补一条 TRC_DROP，上位机据此标出时间线上的空洞
+ */
+static void Trace_WriteNoLock(const Trace_Record_t *rec)
+{
+    Trace_Record_t drop;
+
+    if (0 != trace_drop)
+    {
+        drop.ts = rec->ts;
+        drop.event = TRC_DROP;
+        drop.id = 0;
+        drop.arg = (trace_drop > 0xFFFF) ? 0xFFFF : (uint16_t)trace_drop;
+        if (0 == SEGGER_RTT_WriteSkipNoLock(TRACE_RTT_CHANNEL, &drop, sizeof(drop)))
+        {
+            trace_drop++;
+            trace_drop_total++;
+            return;
+        }
+        trace_drop = 0;
+    }
+    if (0 == SEGGER_RTT_WriteSkipNoLock(TRACE_RTT_CHANNEL, rec, sizeof(*rec)))
+    {
+        trace_drop++;
+        trace_drop_total++;
+    }
+}
+
+/**
+ * @brief 事件追踪初始化
+ * @note 配置 RTT 上行通道并写入同步记录，必须在创建任务之前调用，
+ *       否则上位机拿不到任务名
+ */
+void Trace_Init(void)
+{
+    SEGGER_RTT_ConfigUpBuffer(TRACE_RTT_CHANNEL, "Trace", trace_rtt_buf, sizeof(trace_rtt_buf),
+                              SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+    trace_drop = 0;
+    trace_drop_total = 0;
+    trace_on = (TRACE_ENABLE != 0);
+    Trace_Event(TRC_SYNC, 0, (uint16_t)(BSP_DWT_GetFreq() / 1000000U));
+}
+
+/**
+ * @brief 打开/关闭事件记录
+ * @param[in] enable true - 打开, false - 关闭
+ * @note 重新打开时补一条同步记录，方便上位机重新对齐时间
+ */
+void Trace_SetEnable(bool enable)
+{
+    trace_on = enable;
+    if (enable)
+    {
+        Trace_Event(TRC_SYNC, 0, (uint16_t)(BSP_DWT_GetFreq() / 1000000U));
+    }
+}
+
+/**
+ * @brief 查询是否正在记录
+ */
+bool Trace_IsEnabled(void)
+{
+    return trace_on;
+}
+
+/**
+ * @brief 获取因通道满累计丢弃的记录数
+ */
+uint32_t Trace_GetDropCount(void)
+{
+    return trace_drop_total;
+}
+
+/**
+ * @brief 记录一个事件
+ * @param[in] event 事件类型
+ * @param[in] id 任务编号 / IRQ 编号 / 队列类型
+ * @param[in] arg 事件参数
+ * @note 会在任务切换、中断和内核临界区中被调用，只做一次 8 字节拷贝；
+ *       时间戳在 RTT 锁内读取，保证通道里的记录按时间排序
+ */
+void Trace_Event(uint8_t event, uint8_t id, uint16_t arg)
+{
+    Trace_Record_t rec;
+
+    if (!trace_on)
+    {
+        return;
+    }
+    SEGGER_RTT_LOCK();
+    rec.ts = BSP_DWT_GetCycle();
+    rec.event = event;
+    rec.id = id;
+    rec.arg = arg;
+    Trace_WriteNoLock(&rec);
+    SEGGER_RTT_UNLOCK();
+}
+
+/**
+ * @brief 记录任务名 (由 traceTASK_CREATE 调用)
+ * @param[in] id 任务编号
+ * @param[in] name 任务名
+ * @note 每条记录携带 4 个字符，名字以 '\0' 结束，上位机按分片序号拼接
+ */
+void Trace_TaskCreate(uint8_t id, const char *name)
+{
+    Trace_Record_t rec;
+    uint16_t chunk = 0;
+    size_t len, pos;
+
+    if (!trace_on)
+    {
+        return;
+    }
+    len = strlen(name) + 1; // 连同结束符一起发送
+    SEGGER_RTT_LOCK();
+    for (pos = 0; pos < len; pos += sizeof(rec.ts))
+    {
+        rec.ts = 0;
+        memcpy(&rec.ts, &name[pos], (len - pos < sizeof(rec.ts)) ? (len - pos) : sizeof(rec.ts));
+        rec.event = TRC_TASK_NAME;
+        rec.id = id;
+        rec.arg = chunk++;
+        Trace_WriteNoLock(&rec);
+    }
+    SEGGER_RTT_UNLOCK();
+}
+
+/**
+ * @brief 记录堆分配/释放 (由 traceMALLOC/traceFREE 调用)
+ * @param[in] event TRC_MALLOC / TRC_FREE
+ * @param[in] addr 分配到的地址 (分配失败为 NULL)
+ * @param[in] size 申请字节数 / 释放的块大小
+ * @note 堆在 128K RAM 内且 8 字节对齐，地址>>3 的低16位足以区分每个块；
+ *       记录里不带时间戳，上位机用 trace_decode.py --heap 导出分配序列，
+ *       交给 heap_bench 回放
+ */
+void Trace_Heap(uint8_t event, const void *addr, uint32_t size)
+{
+    Trace_Record_t rec;
+
+    if (!trace_on)
+    {
+        return;
+    }
+    SEGGER_RTT_LOCK();
+    rec.ts = size;
+    rec.event = event;
+    rec.id = (NULL == addr) ? 1 : 0;
+    rec.arg = (uint16_t)((uint32_t)addr >> 3);
+    Trace_WriteNoLock(&rec);
+    SEGGER_RTT_UNLOCK();
+}
@@ -0,0 +1,50 @@
+#ifndef __APP_TRACE_H__
+#define __APP_TRACE_H__
+
+/* 本文件会被 FreeRTOSConfig.h 包含，不能再包含 FreeRTOS 的头文件 */
+#include <stdint.h>
+#include <stdbool.h>
+
+#define TRACE_ENABLE 1           // 1: 编译事件追踪, 0: 所有追踪宏展开为空
+#define TRACE_RTT_CHANNEL 1      // 追踪数据使用的 RTT 上行通道 (通道 0 是日志)
+#define TRACE_RTT_BUF_SIZE 2048  // 追踪通道缓冲区大小 (字节)，256 条记录
+
+/**
+ * @brief 追踪事件类型 (上位机 trace_decode.py 按同样的编号解码)
+ */
+typedef enum
+{
+    TRC_SYNC = 0,        // 同步记录: ts=当前时刻, arg=CPU频率(MHz)
+    TRC_TASK_NAME,       // 任务名: id=任务编号, arg=分片序号, ts 字段存放 4 个字符
+    TRC_TASK_SWITCH_IN,  // 任务切入: id=任务编号
+    TRC_ISR_ENTER,       // 进入中断: id=IRQ 编号
+    TRC_ISR_EXIT,        // 退出中断: id=IRQ 编号
+    TRC_QUEUE_SEND,      // 队列/信号量发送: id=队列类型, arg=队列地址>>2 的低16位
+    TRC_QUEUE_SEND_ISR,  // 中断中发送
+    TRC_QUEUE_RECEIVE,   // 队列/信号量接收成功
+    TRC_QUEUE_BLOCK,     // 因接收而阻塞
+    TRC_DROP,            // 通道满丢弃的记录数: arg=丢弃条数
+    TRC_MALLOC,          // 堆分配: ts 字段存放申请字节数, arg=地址>>3 的低16位, id=1 表示分配失败
+    TRC_FREE             // 堆释放: ts 字段存放块大小, arg=地址>>3 的低16位
+} Trace_Event_t;
+
+/**
+ * @brief 追踪记录 (固定 8 字节，小端)
+ */
+typedef struct
+{
+    uint32_t ts;     // DWT 周期数 (32位，上位机负责展开卷绕)
+    uint8_t event;   // 事件类型 Trace_Event_t
+    uint8_t id;      // 任务编号 / IRQ 编号 / 队列类型
+    uint16_t arg;    // 事件参数
+} Trace_Record_t;
+
+void Trace_Init(void);
+void Trace_SetEnable(bool enable);
+bool Trace_IsEnabled(void);
+uint32_t Trace_GetDropCount(void);
+void Trace_Event(uint8_t event, uint8_t id, uint16_t arg);
+void Trace_TaskCreate(uint8_t id, const char *name);
+void Trace_Heap(uint8_t event, const void *addr, uint32_t size);
+
+#endif //end __APP_TRACE_H__
@@ -1,137 +1,233 @@
-#include "app_binary_parse.h"
-
-#define LOG_TAG_BIN "Binary_parse"
-
-/**
- * @brief ֡״̬ö
- * ״̬ת: WAIT_HEADER -> READ_IDS -> READ_LEN -> READ_PAYLOD -> CHECK_SUM -> WAIT_HEADER
- */
-typedef enum
-{
-    STATE_WAIT_HEADER = 0, // ȴ֡ͷ
-    STATE_READ_IDS,        // ȡ豸IDϵͳIDϢIDк (4ֽ)
-    STATE_READ_LEN,        // ȡس (1ֽ)
-    STATE_READ_PAYLOD,     // ȡ (ɱ䳤)
-    STATE_CHECK_SUM        // ȡУ (1ֽ)
-} Parse_state_t;
-
-static Parse_state_t g_state = STATE_WAIT_HEADER; // ǰ״̬
-static binary_parse_t g_parse;                    // ƴװ֡ݽṹ
-static uint16_t g_rx_idx = 0;                     // ֽڼ (ڶȡ״ֽ̬λ)
-static uint8_t g_check_sum = 0;                   // ۻУ (У)
-
-/**
- * @brief Ķ֡
- * @param[in] pasre ָָ֡
- * @note ú֡Уȷ󱻵
- */
-static void Handle_Parse(binary_parse_t *pasre)
-{
-    if (pasre->msg_id == 0x51)
-    {
-        elog_i(LOG_TAG_BIN, "Binary Recv! Seq:%d, Len:%d", pasre->seq, pasre->payload_len);
-    }
-}
-
-/**
- * @brief ֽڽЭ֡ (״̬ʽ)
- *
- * @param[in] byte ĵֽ
- * @return true  - һ֡ݽ (ܳɹʧ)
- * @return false - ֡δɣȴֽ
- *
- * @note Э֡ʽ: [֡ͷ] [豸ID] [ϵͳID] [ϢID] [к] [] [] [У]
- *       úͨ״ֽ̬ڴյݣۻУ֤֡
- */
-bool Binary_parseByte(uint8_t byte)
-{
-    bool is_parse_finished = false;
-    switch (g_state)
-    {
-    case STATE_WAIT_HEADER:
-        // ȴ֡ͷ־⵽֡ͷתID״̬
-        if (BINARY_HEAD == byte)
-        {
-            g_state = STATE_READ_IDS;
-            g_rx_idx = 0;
-            g_check_sum = BINARY_HEAD; // ֡ͷУͼ
-        }
-        break;
-
-    case STATE_READ_IDS:
-        // ζȡ4IDֽ: device_id, system_id, msg_id, seq
-        if (0 == g_rx_idx)
-            g_parse.device_id = byte;
-        else if (1 == g_rx_idx)
-            g_parse.system_id = byte;
-        else if (2 == g_rx_idx)
-            g_parse.msg_id = byte;
-        else if (3 == g_rx_idx)
-            g_parse.seq = byte;
-
-        g_check_sum += byte; // ۼӵУ
-        g_rx_idx++;
-
-        if (4 == g_rx_idx) // 4IDֽڶȡ
-        {
-            g_state = STATE_READ_LEN;
-        }
-        break;
-
-    case STATE_READ_LEN:
-        // ȡسֶ
-        g_parse.payload_len = byte;
-        g_check_sum += byte;
-
-        // У飺ֵ֡
-        if (g_parse.payload_len >= BINAERY_MAX_LEN)
-        {
-            g_state = STATE_WAIT_HEADER;
-            is_parse_finished = true;
-        }
-        else if (0 == g_parse.payload_len) // ޸ݣֱУ
-        {
-            g_state = STATE_CHECK_SUM;
-        }
-        else // иݣת״̬
-        {
-            g_state = STATE_READ_PAYLOD;
-            g_rx_idx = 0; // üʹ
-        }
-        break;
-
-    case STATE_READ_PAYLOD:
-        // ֽڶȡݵ
-        g_parse.payload[g_rx_idx] = byte;
-        g_check_sum += byte;
-        g_rx_idx++;
-
-        if (g_rx_idx >= g_parse.payload_len) // ݶȡ
-        {
-            g_state = STATE_CHECK_SUM;
-        }
-        break;
-
-    case STATE_CHECK_SUM:
-        // ȡյУͣУͱȽ
-        g_parse.checksum = byte;
-        if (g_check_sum == g_parse.checksum) // Уɹ
-        {
-            Handle_Parse(&g_parse); // ô֡
-        }
-        else // УʧܣϢ
-        {
-            elog_i(LOG_TAG_BIN, "Err: Cal=%02X, Recv=%02X\r\n", g_check_sum, byte);
-            elog_e(LOG_TAG_BIN, "Checksum Error!");
-        }
-
-        g_state = STATE_WAIT_HEADER; // صȴ״̬׼һ֡
-        is_parse_finished = true;
-        break;
-
-    default:
-        g_state = STATE_WAIT_HEADER;
-        break;
-    }
-    return is_parse_finished;
-}
+// 热路径模块的编译期日志上限：每帧一条的 DEBUG 日志在编译时去掉，参数也不求值 (调试时改成 ELOG_LVL_DEBUG)
+// 必须在包含任何头文件 (间接包含 elog.h) 之前定义
+#define ELOG_LOCAL_LVL ELOG_LVL_INFO
+#include "app_binary_parse.h"
+#include <string.h>
+#include "bsp_uart_driver.h"
+#include "app_profiler.h"
+
+#define LOG_TAG_BIN "Binary_parse"
+
+/**
+ * @brief 二进制帧解析状态枚举
+ * 状态机流转: WAIT_HEADER -> READ_IDS -> READ_LEN -> READ_PAYLOD -> CHECK_SUM -> WAIT_HEADER
+ */
+typedef enum
+{
+    STATE_WAIT_HEADER = 0, // 等待帧头
+    STATE_READ_IDS,        // 读取设备ID、系统ID、消息ID、序列号 (4字节)
+    STATE_READ_LEN,        // 读取负载长度 (1字节)
+    STATE_READ_PAYLOD,     // 读取负载数据 (可变长度)
+    STATE_CHECK_SUM        // 读取并校验检验和 (1字节)
+} Parse_state_t;
+
+static Parse_state_t g_state = STATE_WAIT_HEADER; // 当前解析状态
+static binary_parse_t g_parse;                    // 正在拼装的帧数据结构
+static uint16_t g_rx_idx = 0;                     // 字节计数器 (用于读取各个状态的字节位置)
+static uint8_t g_check_sum = 0;                   // 累积计算的校验和 (用于校验数据完整性)
+
+static binary_parse_t g_tx;                       // 发送帧缓冲区 (只在解析任务中使用)
+
+/**
+ * @brief 组帧并通过UART发送
+ * @param[in] frame 待发送的帧 (校验和由本函数计算填写，调用者无需关心)
+ * @return true - 发送成功, false - 长度非法或发送失败
+ * @note 帧格式与接收相同: [帧头] [设备ID] [系统ID] [消息ID] [序列号] [长度] [负载] [校验和]
+ */
+bool Binary_SendFrame(const binary_parse_t *frame)
+{
+    static uint8_t buf[BINAERY_MAX_LEN + 7]; // 帧头 + 4个ID + 长度 + 负载 + 校验和
+    uint16_t len = 0, i;
+    uint8_t sum = 0;
+
+    if (frame->payload_len >= BINAERY_MAX_LEN)
+    {
+        return false;
+    }
+
+    buf[len++] = BINARY_HEAD;
+    buf[len++] = frame->device_id;
+    buf[len++] = frame->system_id;
+    buf[len++] = frame->msg_id;
+    buf[len++] = frame->seq;
+    buf[len++] = frame->payload_len;
+    memcpy(&buf[len], frame->payload, frame->payload_len);
+    len += frame->payload_len;
+
+    for (i = 0; i < len; i++)
+    {
+        sum += buf[i];
+    }
+    buf[len++] = sum;
+
+    return BSP_UART_Send(buf, len);
+}
+
+/**
+ * @brief 应答任务负载遥测请求
+ * @param[in] req 请求帧，应答沿用其设备ID、系统ID和序列号
+ * @note 负载格式 (多字节字段均为小端)：
+ *       [任务数 N] + N * { 任务名[8] 编号[1] 当前[2] 1s[2] 10s[2] 60s[2] 峰值[2] }
+ *       负载单位为千分比 (0-1000)
+ */
+static void Binary_SendProf(const binary_parse_t *req)
+{
+    static Prof_Summary_t summary[RTS_MAX_TASKS];
+    uint16_t values[5];
+    uint8_t n, i, j, len = 1;
+
+    n = Profiler_GetSummary(summary, RTS_MAX_TASKS);
+
+    g_tx.device_id = req->device_id;
+    g_tx.system_id = req->system_id;
+    g_tx.msg_id = BINARY_MSG_PROF_RSP;
+    g_tx.seq = req->seq;
+    for (i = 0; i < n; i++)
+    {
+        if (len + BINARY_PROF_NAME_LEN + 1 + sizeof(values) >= BINAERY_MAX_LEN)
+        {
+            break; // 负载放不下，剩余任务不再上报
+        }
+        memset(&g_tx.payload[len], 0, BINARY_PROF_NAME_LEN);
+        strncpy((char *)&g_tx.payload[len], summary[i].name, BINARY_PROF_NAME_LEN);
+        len += BINARY_PROF_NAME_LEN;
+        g_tx.payload[len++] = summary[i].task_num;
+
+        values[0] = summary[i].cur;
+        values[1] = summary[i].avg_1s;
+        values[2] = summary[i].avg_10s;
+        values[3] = summary[i].avg_60s;
+        values[4] = summary[i].peak;
+        for (j = 0; j < 5; j++)
+        {
+            g_tx.payload[len++] = (uint8_t)(values[j] & 0xFF);
+            g_tx.payload[len++] = (uint8_t)(values[j] >> 8);
+        }
+    }
+    g_tx.payload[0] = i;
+    g_tx.payload_len = len;
+
+    if (!Binary_SendFrame(&g_tx))
+    {
+        elog_limited_w(LOG_TAG_BIN, "Prof telemetry send failed"); // 每个周期都可能失败，限流
+    }
+}
+
+/**
+ * @brief 处理完整的二进制帧数据
+ * @param[in] pasre 指向完整解析帧的指针
+ * @note 该函数在帧数据完整且校验和正确后被调用
+ */
+static void Handle_Parse(binary_parse_t *pasre)
+{
+    if (pasre->msg_id == BINARY_MSG_TEST)
+    {
+        elog_defer_d(LOG_TAG_BIN, "Binary Recv! Seq:%d, Len:%d", pasre->seq, pasre->payload_len); // 每帧一条，DEBUG 级
+    }
+    else if (pasre->msg_id == BINARY_MSG_PROF_REQ)
+    {
+        Binary_SendProf(pasre);
+    }
+}
+
+/**
+ * @brief 逐字节解析二进制协议帧 (状态机方式)
+ *
+ * @param[in] byte 待解析的单个字节
+ * @return true  - 一帧数据解析完成 (可能成功或失败)
+ * @return false - 帧数据尚未完成，继续等待后续字节
+ *
+ * @note 协议帧格式: [帧头] [设备ID] [系统ID] [消息ID] [序列号] [长度] [负载] [校验和]
+ *       该函数通过状态机逐个字节处理接收的数据，累积计算校验和用于验证帧的完整性
+ */
+bool Binary_parseByte(uint8_t byte)
+{
+    bool is_parse_finished = false;
+    switch (g_state)
+    {
+    case STATE_WAIT_HEADER:
+        // 等待帧头标志，检测到帧头后转入读ID状态
+        if (BINARY_HEAD == byte)
+        {
+            g_state = STATE_READ_IDS;
+            g_rx_idx = 0;
+            g_check_sum = BINARY_HEAD; // 帧头纳入校验和计算
+        }
+        break;
+
+    case STATE_READ_IDS:
+        // 依次读取4个ID字节: device_id, system_id, msg_id, seq
+        if (0 == g_rx_idx)
+            g_parse.device_id = byte;
+        else if (1 == g_rx_idx)
+            g_parse.system_id = byte;
+        else if (2 == g_rx_idx)
+            g_parse.msg_id = byte;
+        else if (3 == g_rx_idx)
+            g_parse.seq = byte;
+
+        g_check_sum += byte; // 累加到校验和
+        g_rx_idx++;
+
+        if (4 == g_rx_idx) // 4个ID字节读取完成
+        {
+            g_state = STATE_READ_LEN;
+        }
+        break;
+
+    case STATE_READ_LEN:
+        // 读取负载长度字段
+        g_parse.payload_len = byte;
+        g_check_sum += byte;
+
+        // 长度校验：超过最大值则丢弃该帧
+        if (g_parse.payload_len >= BINAERY_MAX_LEN)
+        {
+            g_state = STATE_WAIT_HEADER;
+            is_parse_finished = true;
+        }
+        else if (0 == g_parse.payload_len) // 无负载数据，直接跳到校验和
+        {
+            g_state = STATE_CHECK_SUM;
+        }
+        else // 有负载数据，转入读负载状态
+        {
+            g_state = STATE_READ_PAYLOD;
+            g_rx_idx = 0; // 重置计数器供负载数组索引使用
+        }
+        break;
+
+    case STATE_READ_PAYLOD:
+        // 逐字节读取负载数据到缓冲区
+        g_parse.payload[g_rx_idx] = byte;
+        g_check_sum += byte;
+        g_rx_idx++;
+
+        if (g_rx_idx >= g_parse.payload_len) // 负载数据读取完成
+        {
+            g_state = STATE_CHECK_SUM;
+        }
+        break;
+
+    case STATE_CHECK_SUM:
+        // 读取接收到的校验和，与计算的校验和比较
+        g_parse.checksum = byte;
+        if (g_check_sum == g_parse.checksum) // 校验成功
+        {
+            Handle_Parse(&g_parse); // 调用处理函数处理完整的帧
+        }
+        else // 校验失败，输出错误信息 (合并成一条，噪声突发时按调用点限流)
+        {
+            elog_limited_e(LOG_TAG_BIN, "Checksum Error! Cal=%02X, Recv=%02X", g_check_sum, byte);
+        }
+
+        g_state = STATE_WAIT_HEADER; // 返回等待状态，准备接收下一帧
+        is_parse_finished = true;
+        break;
+
+    default:
+        g_state = STATE_WAIT_HEADER;
+        break;
+    }
+    return is_parse_finished;
+}
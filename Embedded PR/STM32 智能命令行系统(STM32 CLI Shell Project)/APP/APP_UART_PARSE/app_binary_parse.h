@@ -1,25 +1,31 @@
-#ifndef __APP_BINARY_PARSE_H__
-#define __APP_BINARY_PARSE_H__
-
-#include <stdint.h>
-#include <stdbool.h>
-#include "elog.h"
-#define BINARY_HEAD 0xEF
-#define BINAERY_MAX_LEN 255
-typedef struct 
-{
-    uint8_t device_id;
-    uint8_t system_id;
-    uint8_t msg_id;
-    uint8_t seq;//
-    uint8_t payload_len;
-    uint8_t payload[BINAERY_MAX_LEN];
-    uint8_t checksum;
-}binary_parse_t;
-
-bool Binary_parseByte(uint8_t byte);
-
-
-
-
-#endif //end __APP_BINARY_PARSE_H__
+#ifndef __APP_BINARY_PARSE_H__
+#define __APP_BINARY_PARSE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "elog.h"
+#define BINARY_HEAD 0xEF
+#define BINAERY_MAX_LEN 255
+
+#define BINARY_MSG_TEST 0x51     // 测试帧，只打印序列号和长度
+#define BINARY_MSG_PROF_REQ 0x52 // 请求任务负载遥测 (无负载)
+#define BINARY_MSG_PROF_RSP 0x53 // 任务负载遥测应答
+#define BINARY_PROF_NAME_LEN 8   // 遥测中任务名截断长度
+typedef struct 
+{
+    uint8_t device_id;
+    uint8_t system_id;
+    uint8_t msg_id;
+    uint8_t seq;//包序列
+    uint8_t payload_len;
+    uint8_t payload[BINAERY_MAX_LEN];
+    uint8_t checksum;
+}binary_parse_t;
+
+bool Binary_parseByte(uint8_t byte);
+bool Binary_SendFrame(const binary_parse_t *frame);
+
+
+
+
+#endif //end __APP_BINARY_PARSE_H__
@@ -1,250 +1,675 @@
-#include "app_cli_parse.h"
-#include <stdlib.h>
-// ---  FreeRTOS ͷļ () ---
-#include "FreeRTOS.h"
-#include "task.h"
-
-#define LOG_TAG_CLI "Cli_parse"
-static char shell_buff[SHELL_MAX_LEN]; // 뻺洢û
-static uint16_t shell_idx;             // дλ¼ǰֽ
-
-extern volatile uint8_t g_cpu_load_enable;
-
-/**
- * @brief CPUѹ
- * @param[in] args ַ"1"ʾø߸ģʽ"0"ʾر
- * @note ;ģCPU߸Բϵͳѹµܱ
- * @example ʹ÷: LOAD 1 ()  LOAD 0 (ر)
- */
-static void Cmd_SetLoad(char *args)
-{
-    if (args == NULL)
-    {
-        elog_i(LOG_TAG_CLI, "Usage: LOAD 1 or 0\r\n");
-        return;
-    }
-
-    int state = atoi(args);
-    g_cpu_load_enable = state ? 1 : 0;
-
-    elog_i(LOG_TAG_CLI, "CPU Stress Test: %s\r\n", g_cpu_load_enable ? "ON (High Load)" : "OFF (Idle)");
-}
-
-/**
- * @brief FreeRTOSͳϢ
- * @note ʹþ̬ռCLIջռ䣬ֹջ
- *       10ÿԼ40~50ֽڣ1024ֽ㹻Ϣ
- */
-static char pcWriteBuffer[1024];
-
-/**
- * @brief ϵͳ״̬鿴 (TOP)
- * @param[in] args Ҫ
- * @note ܣ
- *       1. гϢ (״̬ȼջʣࡢ)
- *       2. ʾCPUʱͳ (ռõCPUٷֱ)
- * @note ״̬˵: R=, B=, S=, D=ɾ
- */
-static void Cmd_Top(char *args)
-{
-    // 1. ӡб (Name, State, Prio, Stack, Num)
-    // State: R=, B=, S=, D=ɾ
-    elog_i(LOG_TAG_CLI, "\r\n=======================================================\r\n");
-    elog_i(LOG_TAG_CLI, "Task Name\tState\tPrio\tStack\tNum\r\n");
-    elog_i(LOG_TAG_CLI, "-------------------------------------------------------\r\n");
-
-    // бʽ buffer 
-    memset(pcWriteBuffer, 0, 1024);
-    vTaskList(pcWriteBuffer);
-    elog_i(LOG_TAG_CLI, "%s", pcWriteBuffer); // ӡ
-    elog_i(LOG_TAG_CLI, "=======================================================\r\n");
-
-    // 2. ӡ CPU ʹ (Name, AbsTime, %)
-    // ֮ǰ DWT û⣬ʾٷֱ
-    elog_i(LOG_TAG_CLI, "Task Name\tAbs Time\t%% Time\r\n");
-    elog_i(LOG_TAG_CLI, "-------------------------------------------------------\r\n");
-
-    //  CPU ͳƸʽ buffer 
-    memset(pcWriteBuffer, 0, 1024);
-    vTaskGetRunTimeStats(pcWriteBuffer);
-    elog_i(LOG_TAG_CLI, "%s", pcWriteBuffer);
-    elog_i(LOG_TAG_CLI, "=======================================================\r\n");
-}
-
-/**
- * @brief LED
- * @param[in] args ֲַ֧
- *                 - "ON"LED
- *                 - "OFF"ϨLED
- *                 - "TOGGLE"LED״̬ת
- * @note ʽLED ON/OFF/TOGGLE
- */
-static void Cmd_LED(char *args)
-{
-    if (NULL == args)
-    {
-        elog_w(LOG_TAG_CLI, "Error: Missing args (ON/OFF/TOGGLE)\r\n");
-        return;
-    }
-    char *save_ptr = NULL;
-    char *args1 = strtok_r(args, " ", &save_ptr);
-    if (NULL == args1)
-        return;
-    if (0 == strcmp(args1, "ON"))
-    {
-        BSP_LED_Set(1);
-        elog_i(LOG_TAG_CLI, "LED -> ON\r\n");
-    }
-    else if (0 == strcmp(args1, "OFF"))
-    {
-        BSP_LED_Set(0);
-        elog_i(LOG_TAG_CLI, "LED -> OFF\r\n");
-    }
-    else if (0 == strcmp(args1, "TOGGLE"))
-    {
-        BSP_LED_Toggle();
-        elog_i(LOG_TAG_CLI, "LED -> TOGGLE\r\n");
-    }
-}
-
-/**
- * @brief ȡоƬ¶
- * @param[in] args Ҫ
- * @note ܣȡMCUڲ¶ȴݲʾǰоƬ¶
- */
-static void Cmd_get_temp(char *args)
-{
-    float temp = BSP_Get_ChipTemp();
-    elog_i(LOG_TAG_CLI, "Chip Temperature: %.2f C\r\n", temp);
-}
-
-/**
- * @brief ϵͳ
- * @param[in] args Ҫ
- * @note ܣϵͳλϵͳ
- */
-static void Cmd_Reboot(char *args)
-{
-    elog_i(LOG_TAG_CLI, "OK: Rebooting...\r\n");
-}
-
-/**
- * @brief /
- * @param[in] args ַٶֵ (0-100) Ƕֵ
- * @note ܣõתٻǶ
- * @example ʹ÷: MOTOR 50 (ٶΪ50)
- */
-static void Cmd_Motor(char *args)
-{
-    if (args == NULL)
-    {
-        printf("Error: Missing speed\r\n");
-        return;
-    }
-    // ַתΪֱӸֵ
-    int speed = atoi(args);
-    BSP_Servo_SetAngle(speed);
-    elog_i(LOG_TAG_CLI, "Set Speed -> %d\r\n", speed);
-}
-
-/**
- * @brief Ϣʾ
- * @param[in] args Ҫ
- * @note ܣгпõ÷˵
- */
-static void Cmd_Help(char *args)
-{
-    uint8_t i = 0;
-    elog_i(LOG_TAG_CLI, "--- Commands ---\r\n");
-    for (i = 0; i < g_num_cmd; i++)
-    {
-        elog_i(LOG_TAG_CLI, "%-10s : %s\r\n", g_shell_cmds[i].name, g_shell_cmds[i].help);
-    }
-    elog_i(LOG_TAG_CLI, "--------------------------\r\n");
-}
-
-/**
- * @brief 鶨
- * @note ṹơӦĴָ롢ı
- *       ֻڴһм¼ϵͳԶʶ
- */
-static const Shell_command_t g_shell_cmds[] = {
-    {"LED", Cmd_LED, "Control LED (Usage: LED ON/OFF/TOGGLE)"},
-    {"MOTOR", Cmd_Motor, "Set Motor Speed (0-100)"},
-    {"REBOOT", Cmd_Reboot, "Reboot System"},
-    {"TEMP", Cmd_get_temp, "Get chip temperature!"},
-    {"TOP", Cmd_Top, "Get System info"},
-    {"LOAD", Cmd_SetLoad, "Set CPU Load for Stress Test (Usage: LOAD 1/0)"},
-    {"HELP", Cmd_Help, "Show help list"}};
-
-// Զеֹ޸ĵµĴ
-const uint8_t g_num_cmd = sizeof(g_shell_cmds) / sizeof(g_shell_cmds[0]);
-
-extern const Shell_command_t g_shell_cmds[];
-extern const uint8_t g_num_cmd;
-
-/**
- * @brief ִк
- * @note ̣
- *       1. ʹַָȡ
- *       2. ƥ
- *       3. öӦĴݲ
- *       4. ʾ
- */
-static void Shell_Exce(void)
-{
-    shell_buff[shell_idx] = '\0'; // ַ
-    uint8_t i;
-    char *saveptr = NULL;
-    // ַָȡ (һո֮ǰĲ)
-    char *cmd_name = strtok_r(shell_buff, " ", &saveptr);
-    if (NULL == cmd_name)
-        return;
-
-    // Ѱƥ
-    for (i = 0; i < g_num_cmd; i++)
-    {
-        if (strcmp(cmd_name, g_shell_cmds[i].name) == 0)
-        {
-            // ҵƥöӦsaveptrΪʣַ
-            g_shell_cmds[i].func(saveptr);
-            return; // ִϣ˳
-        }
-    }
-    // ʱʾϢ
-    elog_i(LOG_TAG_CLI, "Unknown CMD: '%s'. Try 'HELP'.\r\n", cmd_name);
-}
-
-/**
- * @brief ֽڽ
- * @param[in] byte յֽ
- * @return true  - һ (⵽س/з)
- * @return false - δ
- * @note ̣
- *       1. ⻻з (\n) س (\r) ж
- *       2. յʱִ
- *       3. 쳣ַʱ¿ʼ
- */
-bool Shell_parsebyte(uint8_t byte)
-{
-    bool is_line_finish = false;
-
-    if (byte == '\n' || byte == '\r') // н (س)
-    {
-        if (shell_idx > 0)
-        {
-            Shell_Exce();  // Чʱִ
-            shell_idx = 0; // û׼һ
-        }
-        is_line_finish = true;
-    }
-    else if (shell_idx < SHELL_MAX_LEN - 1) // ַδ
-    {
-        shell_buff[shell_idx++] = (char)byte;
-    }
-    else // ݲ
-    {
-        shell_idx = 0;
-    }
-    return is_line_finish;
-}
+#include "app_cli_parse.h"
+#include <stdlib.h>
+// --- 引入 FreeRTOS 头文件 (必须加) ---
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define LOG_TAG_CLI "Cli_parse"
+static char shell_buff[SHELL_MAX_LEN]; // 命令行输入缓冲区，存储用户输入的完整命令
+static uint16_t shell_idx;             // 缓冲区写入位置索引，记录当前已输入的字节数
+
+extern volatile uint8_t g_cpu_load_enable;
+extern osThreadId_t defaultTaskHandle;
+extern const Shell_command_t g_shell_cmds[]; // 命令表 (定义在文件末尾，HELP 命令需要提前声明)
+extern const uint8_t g_num_cmd;
+
+#if USE_FreeRTOS_HEAP_TLSF
+// heap_tlsf.c 额外提供的统计接口 (portable.h 里没有声明)
+extern BaseType_t xPortGetHeapPoolStats(UBaseType_t uxClass, size_t *pxBlockSize, size_t *pxCachedBlocks,
+                                        size_t *pxHits, size_t *pxMisses);
+extern size_t xPortGetTotalHeapSize(void);
+#endif
+
+// elog_port.c 提供的 Flash 日志接口 (移植文件没有头文件)
+extern void elog_port_save_sync(void);         // 把 RAM 环中待存的日志写入 Flash
+extern uint32_t elog_port_get_save_drop(void); // RAM 环满丢弃的日志条数
+
+/**
+ * @brief CPU负载压力测试命令处理函数
+ * @param[in] args 命令参数字符串，"1"表示启用高负载模式，"0"表示关闭
+ * @note 用途：模拟CPU高负载以测试系统在压力下的性能表现
+ * @example 使用方法: LOAD 1 (启用) 或 LOAD 0 (关闭)
+ */
+static void Cmd_SetLoad(char *args)
+{
+    if (args == NULL)
+    {
+        elog_i(LOG_TAG_CLI, "Usage: LOAD 1 or 0\r\n");
+        return;
+    }
+
+    int state = atoi(args);
+    g_cpu_load_enable = state ? 1 : 0;
+    osThreadFlagsSet(defaultTaskHandle, 0x01U); // 默认任务空闲时一直阻塞，通知它重新检查负载开关
+
+    elog_i(LOG_TAG_CLI, "CPU Stress Test: %s\r\n", g_cpu_load_enable ? "ON (High Load)" : "OFF (Idle)");
+}
+
+/**
+ * @brief FreeRTOS任务状态缓冲区
+ * @note 静态分配，既不占 CLI 任务栈，也不像 vTaskList 那样每次从堆里申请
+ */
+static TaskStatus_t top_status[RTS_MAX_TASKS];
+
+/**
+ * @brief 系统状态查看命令 (TOP命令)
+ * @param[in] args 命令参数（此命令不需要参数）
+ * @note 功能：
+ *       1. 列出所有任务信息 (任务名、状态、优先级、栈剩余、编号)
+ *       2. 显示CPU时间统计 (累计占用百分比 + 最近一个采样窗口的占用百分比)
+ * @note 任务状态说明: X=运行, R=就绪, B=阻塞, S=挂起, D=删除
+ */
+static void Cmd_Top(char *args)
+{
+    static const char state_char[] = {'X', 'R', 'B', 'S', 'D', '?'}; // 按 eTaskState 顺序
+    UBaseType_t i, count;
+
+    // 1. 打印任务列表 (Name, State, Prio, Stack, Num)
+    elog_i(LOG_TAG_CLI, "\r\n=======================================================\r\n");
+    elog_i(LOG_TAG_CLI, "Task Name\tState\tPrio\tStack\tNum\r\n");
+    elog_i(LOG_TAG_CLI, "-------------------------------------------------------\r\n");
+
+    // 与 vTaskList 的输出格式相同，逐行打印：每条日志只占一个 ELOG_LINE_BUF_SIZE 大小的暂存槽
+    count = uxTaskGetSystemState(top_status, RTS_MAX_TASKS, NULL);
+    for (i = 0; i < count; i++)
+    {
+        elog_i(LOG_TAG_CLI, "%-*s\t%c\t%u\t%u\t%u\r\n", configMAX_TASK_NAME_LEN - 1, top_status[i].pcTaskName,
+               state_char[(top_status[i].eCurrentState < eInvalid) ? top_status[i].eCurrentState : eInvalid],
+               (unsigned int)top_status[i].uxCurrentPriority, (unsigned int)top_status[i].usStackHighWaterMark,
+               (unsigned int)top_status[i].xTaskNumber);
+    }
+    elog_i(LOG_TAG_CLI, "=======================================================\r\n");
+
+    // 2. 打印 CPU 使用率 (Name, AbsTime, Total %, Last %)
+    // 不再使用 vTaskGetRunTimeStats：内核的32位累加器约 11 分钟就会卷绕，长时间运行后百分比错乱
+    // 改为打印 app_runtime_stats 按窗口累加的64位统计
+    RuntimeStats_Print(LOG_TAG_CLI);
+    elog_i(LOG_TAG_CLI, "=======================================================\r\n");
+}
+
+/**
+ * @brief 任务负载分析命令 (PROF命令)
+ * @param[in] args 命令参数，"RESET" 表示清零峰值，不带参数则打印
+ * @note 与 TOP 的单次快照不同，PROF 显示后台每 PROF_SAMPLE_MS 采样一次的历史：
+ *       当前周期负载、1s/10s/60s 滑动平均和峰值，便于在 LOAD 1 压测时定位突发负载的任务
+ */
+static void Cmd_Prof(char *args)
+{
+    if (NULL != args && 0 == strcmp(args, "RESET"))
+    {
+        Profiler_ResetPeak();
+        elog_i(LOG_TAG_CLI, "Profiler peak cleared\r\n");
+        return;
+    }
+    elog_i(LOG_TAG_CLI, "\r\n=======================================================\r\n");
+    Profiler_Print(LOG_TAG_CLI);
+    elog_i(LOG_TAG_CLI, "=======================================================\r\n");
+}
+
+/**
+ * @brief 任务栈使用情况命令 (STACK命令)
+ * @param[in] args 命令参数（此命令不需要参数）
+ * @note 显示每个任务分配的栈、历史峰值用量、最小剩余和推荐大小，
+ *       用于按实测数据调整各任务的 stack_size，把省下的 RAM 留给收发和日志缓冲区
+ */
+static void Cmd_Stack(char *args)
+{
+    elog_i(LOG_TAG_CLI, "\r\n=======================================================\r\n");
+    StackMon_Print(LOG_TAG_CLI);
+    elog_i(LOG_TAG_CLI, "=======================================================\r\n");
+}
+
+/**
+ * @brief 堆使用情况命令 (HEAP命令)
+ * @param[in] args 命令参数（此命令不需要参数）
+ * @note 碎片率 = 1 - 最大空闲块/空闲总量，越大说明空闲内存越零碎；
+ *       heap_4 (默认) 的总量按 configTOTAL_HEAP_SIZE 计，含对齐和结尾标记占用的十几个字节；
+ *       使用 heap_tlsf 时小块按大小分级缓存，命中 (Hit) 的申请不经过 TLSF，一级的 Miss 持续增长说明缓存上限偏小
+ */
+static void Cmd_Heap(char *args)
+{
+    HeapStats_t stats;
+    size_t total;
+#if USE_FreeRTOS_HEAP_TLSF
+    size_t block_size, cached, hits, misses;
+    UBaseType_t i;
+#endif
+
+    vPortGetHeapStats(&stats);
+#if USE_FreeRTOS_HEAP_TLSF
+    total = xPortGetTotalHeapSize();
+#else
+    total = configTOTAL_HEAP_SIZE;
+#endif
+    elog_i(LOG_TAG_CLI, "Heap: %lu total, %lu free, %lu peak used\r\n", (unsigned long)total,
+           (unsigned long)stats.xAvailableHeapSpaceInBytes,
+           (unsigned long)(total - stats.xMinimumEverFreeBytesRemaining));
+    elog_i(LOG_TAG_CLI, "Free blocks: %lu, Largest: %lu, Fragmentation: %lu%%\r\n",
+           (unsigned long)stats.xNumberOfFreeBlocks, (unsigned long)stats.xSizeOfLargestFreeBlockInBytes,
+           (0 == stats.xAvailableHeapSpaceInBytes) ? 0UL
+           : (unsigned long)(100 - stats.xSizeOfLargestFreeBlockInBytes * 100 / stats.xAvailableHeapSpaceInBytes));
+    elog_i(LOG_TAG_CLI, "Allocs: %lu, Frees: %lu\r\n", (unsigned long)stats.xNumberOfSuccessfulAllocations,
+           (unsigned long)stats.xNumberOfSuccessfulFrees);
+#if USE_FreeRTOS_HEAP_TLSF
+    elog_i(LOG_TAG_CLI, "%-6s %-6s %-6s %s\r\n", "Pool", "Cached", "Hit", "Miss");
+    for (i = 0; pdTRUE == xPortGetHeapPoolStats(i, &block_size, &cached, &hits, &misses); i++)
+    {
+        elog_i(LOG_TAG_CLI, "%-6lu %-6lu %-6lu %lu\r\n", (unsigned long)block_size, (unsigned long)cached,
+               (unsigned long)hits, (unsigned long)misses);
+    }
+#endif
+}
+
+/**
+ * @brief 低功耗睡眠统计命令 (POWER命令)
+ * @param[in] args 命令参数，"RESET" 表示清空统计，不带参数则打印
+ * @note 显示无节拍空闲模式下的睡眠驻留率；串口唤醒后的响应延迟看 LAT 命令的 ISR->Wake 一项
+ */
+static void Cmd_Power(char *args)
+{
+    if (NULL != args && 0 == strcmp(args, "RESET"))
+    {
+        LowPower_Reset();
+        elog_i(LOG_TAG_CLI, "Sleep statistics cleared\r\n");
+        return;
+    }
+    LowPower_Print(LOG_TAG_CLI);
+}
+
+/**
+ * @brief UART接收延迟直方图命令 (LAT命令)
+ * @param[in] args 命令参数，"RESET" 表示清空统计，不带参数则打印
+ * @note 显示 中断入口 -> 释放信号量 -> 解析任务运行 各段延迟的对数直方图，
+ *       调整任务优先级时主要看 Give->Wake 一项
+ */
+static void Cmd_Latency(char *args)
+{
+    if (NULL != args && 0 == strcmp(args, "RESET"))
+    {
+        Latency_Reset();
+        elog_i(LOG_TAG_CLI, "Latency histogram cleared\r\n");
+        return;
+    }
+    elog_i(LOG_TAG_CLI, "\r\n=======================================================\r\n");
+    Latency_Print(LOG_TAG_CLI);
+    elog_i(LOG_TAG_CLI, "=======================================================\r\n");
+}
+
+/**
+ * @brief 事件追踪开关命令 (TRACE命令)
+ * @param[in] args 命令参数，"ON" 打开，"OFF" 关闭，不带参数显示当前状态
+ * @note 追踪数据从 RTT 通道 1 输出，用 JLinkRTTLogger 抓取后由 trace_decode.py 转成时间线
+ */
+static void Cmd_Trace(char *args)
+{
+    if (NULL != args && 0 == strcmp(args, "ON"))
+    {
+        Trace_SetEnable(true);
+    }
+    else if (NULL != args && 0 == strcmp(args, "OFF"))
+    {
+        Trace_SetEnable(false);
+    }
+    elog_i(LOG_TAG_CLI, "Trace: %s, Dropped: %lu\r\n",
+           Trace_IsEnabled() ? "ON" : "OFF", (unsigned long)Trace_GetDropCount());
+}
+
+/**
+ * @brief 日志输出丢弃统计命令 (LOG命令)
+ * @param[in] args 命令参数（此命令不需要参数）
+ * @note 异步队列满丢弃的是整条日志；UART 发送缓冲区满 (超过背压等待时间) 时丢弃整段数据，
+ *       丢弃数持续增长说明日志量超过了 115200 波特率的带宽；
+ *       Flash 日志先进 RAM 环，由空闲优先级的任务写入，写 Flash/擦扇区期间环满时丢弃整条日志；
+ *       擦扇区前等上位机停止发送，擦除期间 (CPU 停顿 1~2 秒) 仍有输入时记一次 RX 溢出，输入可能已被覆盖；
+ *       限流/折叠只对 elog_limited 调用点 (解析错误等热路径)，命令回复不受影响；丢掉的日志在打包之前丢弃，不占用队列和带宽
+ */
+static void Cmd_Log(char *args)
+{
+    uint32_t tx_drop_cnt, tx_drop_bytes;
+    uint32_t rx_overrun, rx_drop_bytes;
+    uint32_t rate_limited, repeated;
+
+    BSP_UART_GetTxDrop(&tx_drop_cnt, &tx_drop_bytes);
+    BSP_UART_GetRxLoss(&rx_overrun, &rx_drop_bytes);
+    elog_get_suppressed_count(&rate_limited, &repeated);
+    elog_i(LOG_TAG_CLI, "Log queue dropped: %lu\r\n", (unsigned long)elog_async_get_drop_count());
+    elog_i(LOG_TAG_CLI, "Rate limited: %lu, Repeated: %lu\r\n", (unsigned long)rate_limited, (unsigned long)repeated);
+    elog_i(LOG_TAG_CLI, "UART TX dropped: %lu (%lu bytes)\r\n",
+           (unsigned long)tx_drop_cnt, (unsigned long)tx_drop_bytes);
+    elog_i(LOG_TAG_CLI, "Flash save dropped: %lu\r\n", (unsigned long)elog_port_get_save_drop());
+    elog_i(LOG_TAG_CLI, "UART RX overrun: %lu, dropped: %lu bytes\r\n",
+           (unsigned long)rx_overrun, (unsigned long)rx_drop_bytes);
+}
+
+/**
+ * @brief 查看保存在 Flash 中的日志 (FLOG命令)
+ * @param[in] args 命令参数，数字表示输出最近多少字节 (默认 1024)，"CLEAN" 擦除全部日志
+ * @note WARN 及以上等级的日志由日志任务放进 RAM 环，空闲优先级的 Flash 任务攒一批再写入扇区 6/7，复位后仍可查看；
+ *       输出前先把 RAM 中的日志写入 Flash，保证看到的是最新内容 (当前扇区写满时会擦下一个扇区，CPU 停顿约 1~2 秒)
+ */
+static void Cmd_FlashLog(char *args)
+{
+    size_t used, size = 1024;
+
+    if (NULL != args && 0 == strcmp(args, "CLEAN"))
+    {
+        elog_flash_clean();
+        return;
+    }
+    if (NULL != args)
+    {
+        size = (size_t)strtoul(args, NULL, 0);
+    }
+    elog_port_save_sync();
+    used = elog_flash_get_used_size();
+    if (size > used)
+    {
+        size = used;
+    }
+    // Flash 日志直接同步输出，统计行走异步队列，放在后面才不会插到日志中间
+    elog_flash_output_recent(size);
+    elog_i(LOG_TAG_CLI, "Flash log: %lu bytes saved, last %lu bytes shown\r\n", (unsigned long)used, (unsigned long)size);
+}
+
+/**
+ * @brief 查看上次运行的日志 (LASTLOG命令)
+ * @param[in] args 命令参数（此命令不需要参数）
+ * @note 日志在打包时就拷贝进复位保留的 RAM 环，断言/HardFault/看门狗复位前还在队列里的日志也能看到；
+ *       上电复位时 RAM 内容无效，没有记录
+ */
+static void Cmd_LastLog(char *args)
+{
+    CrashLog_Print(LOG_TAG_CLI);
+}
+
+/**
+ * @brief LED控制命令处理函数
+ * @param[in] args 命令参数字符串，支持三种操作：
+ *                 - "ON"：点亮LED
+ *                 - "OFF"：熄灭LED
+ *                 - "TOGGLE"：LED状态翻转
+ * @note 参数格式：LED ON/OFF/TOGGLE
+ */
+static void Cmd_LED(char *args)
+{
+    if (NULL == args)
+    {
+        elog_w(LOG_TAG_CLI, "Error: Missing args (ON/OFF/TOGGLE)\r\n");
+        return;
+    }
+    char *save_ptr = NULL;
+    char *args1 = strtok_r(args, " ", &save_ptr);
+    if (NULL == args1)
+        return;
+    if (0 == strcmp(args1, "ON"))
+    {
+        BSP_LED_Set(1);
+        elog_i(LOG_TAG_CLI, "LED -> ON\r\n");
+    }
+    else if (0 == strcmp(args1, "OFF"))
+    {
+        BSP_LED_Set(0);
+        elog_i(LOG_TAG_CLI, "LED -> OFF\r\n");
+    }
+    else if (0 == strcmp(args1, "TOGGLE"))
+    {
+        BSP_LED_Toggle();
+        elog_i(LOG_TAG_CLI, "LED -> TOGGLE\r\n");
+    }
+}
+
+/**
+ * @brief 获取芯片温度命令处理函数
+ * @param[in] args 命令参数（此命令不需要参数）
+ * @note 功能：显示 ADC 后台采集的最新芯片温度和 VDDA，不再当场启动转换
+ */
+static void Cmd_get_temp(char *args)
+{
+    ADC_Result_t adc;
+
+    if (!BSP_ADC_GetLatest(&adc))
+    {
+        elog_w(LOG_TAG_CLI, "ADC not ready\r\n");
+        return;
+    }
+    elog_i(LOG_TAG_CLI, "Chip Temperature: %.2f C, VDDA: %u mV\r\n", (float)adc.temp_centi / 100.0f,
+           (unsigned int)adc.vdda_mv);
+}
+
+/**
+ * @brief 打印 ADC 滤波器设置和耗时
+ */
+static void Cmd_Filter_Print(void)
+{
+    static const char *const mode_name[] = {"OFF", "F32", "Q15"};
+    BSP_ADC_FiltInfo_t info;
+    uint32_t per_sample;
+    uint8_t s;
+
+    BSP_ADC_GetFilterInfo(&info);
+    elog_i(LOG_TAG_CLI, "ADC filter: %s, %u stage(s), fs %u Hz, %u scans per block\r\n", mode_name[info.mode],
+           (unsigned int)info.coeffs.stages, (unsigned int)ADC_SAMPLE_HZ, (unsigned int)ADC_OVERSAMPLE);
+    for (s = 0; s < info.coeffs.stages; s++)
+    {
+        elog_i(LOG_TAG_CLI, "  [%u] b %.8f %.8f %.8f  a %.8f %.8f\r\n", (unsigned int)s,
+               info.coeffs.coeffs[s][0], info.coeffs.coeffs[s][1], info.coeffs.coeffs[s][2],
+               info.coeffs.coeffs[s][3], info.coeffs.coeffs[s][4]);
+    }
+    // 每块 ADC_OVERSAMPLE 次扫描 x ADC_CH_NUM 个通道，周期数保留两位小数
+    per_sample = info.cycles_last * 100U / (ADC_OVERSAMPLE * ADC_CH_NUM);
+    elog_i(LOG_TAG_CLI, "Filter time: %lu cycles/block (max %lu), %lu.%02lu cycles/sample\r\n",
+           (unsigned long)info.cycles_last, (unsigned long)info.cycles_max,
+           (unsigned long)(per_sample / 100U), (unsigned long)(per_sample % 100U));
+    if (!info.q15_ok)
+    {
+        elog_i(LOG_TAG_CLI, "Coefficients do not fit Q15, F32 only\r\n");
+    }
+    else if (info.q15_den_min < ADC_FILT_Q15_DEN_WARN)
+    {
+        elog_i(LOG_TAG_CLI, "Q15: 1 + a1 + a2 = %ld/16384, output will stick in dead zones, use F32\r\n",
+               (long)info.q15_den_min);
+    }
+}
+
+/**
+ * @brief 抓取连续的原始采样并打印 (FILT DUMP)
+ * @param[in] blocks 块数，每块 ADC_OVERSAMPLE 次扫描 (256ms)
+ * @note 每行 8 次扫描，格式 "ADC: 参考电压 温度 ..."，用 STM32_PC_Tool/dsp_bench 读入；
+ *       每块 8 行，日志队列 16 个槽位放得下，队列来不及输出 (丢块) 时打印警告，dsp_bench 在此处分段
+ */
+static void Cmd_Filter_Dump(uint32_t blocks)
+{
+    static uint16_t raw[ADC_OVERSAMPLE * ADC_CH_NUM]; // 静态分配，避免占用 CLI 任务栈
+    char line[8 * 12 + 1];
+    uint32_t last, seq, i, j, wait;
+    int len;
+
+    BSP_ADC_CaptureEnable(true);
+    last = BSP_ADC_CaptureGet(raw);
+    seq = last;
+    while (blocks > 0)
+    {
+        // 每块 256ms，最多等 1s
+        for (wait = 0; wait < 50; wait++)
+        {
+            osDelay(20);
+            seq = BSP_ADC_CaptureGet(raw);
+            if (seq != last)
+            {
+                break;
+            }
+        }
+        if (seq == last)
+        {
+            elog_w(LOG_TAG_CLI, "ADC not running\r\n");
+            break;
+        }
+        if (seq - last > 1U && last != 0U)
+        {
+            elog_w(LOG_TAG_CLI, "ADC dump: %lu block(s) lost\r\n", (unsigned long)(seq - last - 1U));
+        }
+        last = seq;
+        for (i = 0; i < ADC_OVERSAMPLE; i += 8)
+        {
+            len = 0;
+            for (j = i; j < i + 8; j++)
+            {
+                len += snprintf(&line[len], sizeof(line) - len, " %u %u",
+                                (unsigned int)raw[j * ADC_CH_NUM + ADC_CH_VREFINT],
+                                (unsigned int)raw[j * ADC_CH_NUM + ADC_CH_TEMP]);
+            }
+            elog_i(LOG_TAG_CLI, "ADC:%s\r\n", line);
+        }
+        blocks--;
+    }
+    BSP_ADC_CaptureEnable(false);
+}
+
+/**
+ * @brief ADC 滤波器命令 (FILT命令)
+ * @param[in] args 命令参数：
+ *        - 不带参数：显示滤波方式、系数和每个采样的耗时 (DWT 周期)
+ *        - MODE F32/Q15/OFF：浮点 / 定点 / 不滤波 (直接平均)
+ *        - LP <fc> [stages]：巴特沃斯低通，截止频率 fc (Hz)，stages 个二阶节 (默认 1)
+ *        - SET <n> <b0> <b1> <b2> <a1> <a2>：直接设置第 n 节系数，n 等于当前节数时追加一节；
+ *          分母按 1 + a1*z^-1 + a2*z^-2 书写 (与 MATLAB/scipy 一致)
+ *        - DUMP [blocks]：打印连续的原始采样，默认 1 块，最多 240 块 (约 1 分钟)
+ * @note Q15 的 DF1 结构状态只有 16 位，截止频率低于约 2Hz 时输出会卡在死区里，用 F32；
+ *       两种方式的噪声与耗时对比见 STM32_PC_Tool/dsp_bench
+ */
+static void Cmd_Filter(char *args)
+{
+    BSP_ADC_FiltInfo_t info;
+    char *save_ptr = NULL;
+    char *sub, *tok;
+    float fc;
+    uint32_t n;
+    uint8_t i;
+
+    sub = (NULL != args) ? strtok_r(args, " ", &save_ptr) : NULL;
+    if (NULL == sub)
+    {
+        Cmd_Filter_Print();
+        return;
+    }
+    if (0 == strcmp(sub, "MODE"))
+    {
+        tok = strtok_r(NULL, " ", &save_ptr);
+        if (NULL != tok && 0 == strcmp(tok, "OFF"))
+        {
+            BSP_ADC_SetFilterMode(ADC_FILT_OFF);
+        }
+        else if (NULL != tok && 0 == strcmp(tok, "F32"))
+        {
+            BSP_ADC_SetFilterMode(ADC_FILT_F32);
+        }
+        else if (NULL != tok && 0 == strcmp(tok, "Q15"))
+        {
+            if (!BSP_ADC_SetFilterMode(ADC_FILT_Q15))
+            {
+                elog_w(LOG_TAG_CLI, "Coefficients do not fit Q15\r\n");
+                return;
+            }
+        }
+        else
+        {
+            elog_w(LOG_TAG_CLI, "Usage: FILT MODE F32/Q15/OFF\r\n");
+            return;
+        }
+    }
+    else if (0 == strcmp(sub, "LP"))
+    {
+        tok = strtok_r(NULL, " ", &save_ptr);
+        fc = (NULL != tok) ? strtof(tok, NULL) : 0.0f;
+        tok = strtok_r(NULL, " ", &save_ptr);
+        n = (NULL != tok) ? (uint32_t)atoi(tok) : 1U;
+        if (n > ADC_FILT_MAX_STAGES || !BSP_ADC_SetFilterLowpass(fc, (uint8_t)n))
+        {
+            elog_w(LOG_TAG_CLI, "Usage: FILT LP <0 < fc < %u Hz> [stages 1~%u]\r\n", (unsigned int)(ADC_SAMPLE_HZ / 2),
+                   (unsigned int)ADC_FILT_MAX_STAGES);
+            return;
+        }
+    }
+    else if (0 == strcmp(sub, "SET"))
+    {
+        BSP_ADC_GetFilterInfo(&info);
+        tok = strtok_r(NULL, " ", &save_ptr);
+        n = (NULL != tok) ? (uint32_t)atoi(tok) : ADC_FILT_MAX_STAGES;
+        for (i = 0; i < 5 && n <= info.coeffs.stages && n < ADC_FILT_MAX_STAGES; i++)
+        {
+            tok = strtok_r(NULL, " ", &save_ptr);
+            if (NULL == tok)
+            {
+                break;
+            }
+            info.coeffs.coeffs[n][i] = strtof(tok, NULL);
+        }
+        if (i < 5)
+        {
+            elog_w(LOG_TAG_CLI, "Usage: FILT SET <stage 0~%u> <b0> <b1> <b2> <a1> <a2>\r\n",
+                   (unsigned int)((info.coeffs.stages < ADC_FILT_MAX_STAGES) ? info.coeffs.stages
+                                                                             : ADC_FILT_MAX_STAGES - 1));
+            return;
+        }
+        if (n == info.coeffs.stages)
+        {
+            info.coeffs.stages++;
+        }
+        if (!BSP_ADC_SetFilterCoeffs(&info.coeffs))
+        {
+            elog_w(LOG_TAG_CLI, "Rejected: unstable (need |a2| < 1, |a1| < 1 + a2) or not Q15 compatible\r\n");
+            return;
+        }
+    }
+    else if (0 == strcmp(sub, "DUMP"))
+    {
+        tok = strtok_r(NULL, " ", &save_ptr);
+        n = (NULL != tok) ? (uint32_t)atoi(tok) : 1U;
+        Cmd_Filter_Dump((n > 240U) ? 240U : n);
+        return;
+    }
+    else
+    {
+        elog_w(LOG_TAG_CLI, "Usage: FILT [MODE F32/Q15/OFF | LP <fc> [stages] | SET <n> b0 b1 b2 a1 a2 | DUMP [blocks]]\r\n");
+        return;
+    }
+    Cmd_Filter_Print();
+}
+
+/**
+ * @brief 系统重启命令处理函数
+ * @param[in] args 命令参数（此命令不需要参数）
+ * @note 功能：触发系统软复位，重新启动整个系统
+ */
+static void Cmd_Reboot(char *args)
+{
+    elog_i(LOG_TAG_CLI, "OK: Rebooting...\r\n");
+}
+
+/**
+ * @brief 电机/舵机控制命令处理函数
+ * @param[in] args 命令参数字符串，包含速度值 (0-100) 或角度值
+ * @note 功能：设置电机转速或舵机角度
+ * @example 使用方法: MOTOR 50 (设置速度为50)
+ */
+static void Cmd_Motor(char *args)
+{
+    if (args == NULL)
+    {
+        printf("Error: Missing speed\r\n");
+        return;
+    }
+    // 将参数字符串转换为整数，直接赋值给舵机
+    int speed = atoi(args);
+    BSP_Servo_SetAngle(speed);
+    elog_i(LOG_TAG_CLI, "Set Speed -> %d\r\n", speed);
+}
+
+/**
+ * @brief 帮助信息显示命令处理函数
+ * @param[in] args 命令参数（此命令不需要参数）
+ * @note 功能：列出所有可用的命令及其用法说明
+ */
+static void Cmd_Help(char *args)
+{
+    uint8_t i = 0;
+    elog_i(LOG_TAG_CLI, "--- Commands ---\r\n");
+    for (i = 0; i < g_num_cmd; i++)
+    {
+        elog_i(LOG_TAG_CLI, "%-10s : %s\r\n", g_shell_cmds[i].name, g_shell_cmds[i].help);
+    }
+    elog_i(LOG_TAG_CLI, "--------------------------\r\n");
+}
+
+/**
+ * @brief 命令表数组定义
+ * @note 结构：命令名称、对应的处理函数指针、帮助文本描述
+ *       新增命令只需在此数组中添加一行记录，系统会自动识别
+ */
+const Shell_command_t g_shell_cmds[] = {
+    {"LED", Cmd_LED, "Control LED (Usage: LED ON/OFF/TOGGLE)"},
+    {"MOTOR", Cmd_Motor, "Set Motor Speed (0-100)"},
+    {"REBOOT", Cmd_Reboot, "Reboot System"},
+    {"TEMP", Cmd_get_temp, "Get chip temperature!"},
+    {"FILT", Cmd_Filter, "ADC filter (Usage: FILT / FILT MODE F32/Q15/OFF / FILT LP <fc> [stages] / FILT SET <n> b0 b1 b2 a1 a2 / FILT DUMP [blocks])"},
+    {"TOP", Cmd_Top, "Get System info"},
+    {"PROF", Cmd_Prof, "Task load history (Usage: PROF / PROF RESET)"},
+    {"STACK", Cmd_Stack, "Task stack usage & recommended size"},
+    {"HEAP", Cmd_Heap, "Heap usage, fragmentation & pool hits (TLSF only)"},
+    {"LAT", Cmd_Latency, "UART RX latency histogram (Usage: LAT / LAT RESET)"},
+    {"POWER", Cmd_Power, "Tickless idle sleep residency (Usage: POWER / POWER RESET)"},
+    {"TRACE", Cmd_Trace, "RTT event trace (Usage: TRACE ON/OFF)"},
+    {"LOG", Cmd_Log, "Log output drop/suppress counters"},
+    {"LASTLOG", Cmd_LastLog, "Logs of the last run kept in RAM across reset"},
+    {"FLOG", Cmd_FlashLog, "Saved logs in flash (Usage: FLOG [bytes] / FLOG CLEAN)"},
+    {"LOAD", Cmd_SetLoad, "Set CPU Load for Stress Test (Usage: LOAD 1/0)"},
+    {"HELP", Cmd_Help, "Show help list"}};
+
+// 自动计算命令表中的命令数量，避免手工修改导致的错误
+const uint8_t g_num_cmd = sizeof(g_shell_cmds) / sizeof(g_shell_cmds[0]);
+
+/**
+ * @brief 命令执行函数
+ * @note 工作流程：
+ *       1. 使用字符串分割函数提取命令名称
+ *       2. 遍历命令表查找匹配的命令
+ *       3. 调用对应的处理函数并传递参数
+ *       4. 若命令不存在则输出错误提示
+ */
+static void Shell_Exce(void)
+{
+    shell_buff[shell_idx] = '\0'; // 字符串结束符
+    uint8_t i;
+    char *saveptr = NULL;
+    // 分割字符串，获取命令名 (第一个空格之前的部分)
+    char *cmd_name = strtok_r(shell_buff, " ", &saveptr);
+    if (NULL == cmd_name)
+        return;
+
+    // 遍历命令表，寻找匹配的命令
+    for (i = 0; i < g_num_cmd; i++)
+    {
+        if (strcmp(cmd_name, g_shell_cmds[i].name) == 0)
+        {
+            // 找到匹配命令，调用对应函数，saveptr为剩余参数字符串
+            g_shell_cmds[i].func(saveptr);
+            return; // 执行完毕，退出
+        }
+    }
+    // 命令不存在时输出提示信息
+    elog_i(LOG_TAG_CLI, "Unknown CMD: '%s'. Try 'HELP'.\r\n", cmd_name);
+}
+
+/**
+ * @brief 逐字节解析命令行输入
+ * @param[in] byte 单个接收的字节
+ * @return true  - 一行命令完整接收 (检测到回车/换行符)
+ * @return false - 命令行数据尚未接收完成
+ * @note 工作流程：
+ *       1. 检测换行符 (\n) 或回车符 (\r) 判断命令完整性
+ *       2. 接收到完整命令行时触发执行
+ *       3. 缓冲区满或异常字符时清空重新开始
+ */
+bool Shell_parsebyte(uint8_t byte)
+{
+    bool is_line_finish = false;
+
+    if (byte == '\n' || byte == '\r') // 检测命令行结束符 (回车或换行)
+    {
+        if (shell_idx > 0)
+        {
+            Shell_Exce();  // 有有效数据时执行命令
+            shell_idx = 0; // 重置缓冲区索引，准备接收下一条命令
+        }
+        is_line_finish = true;
+    }
+    else if (shell_idx < SHELL_MAX_LEN - 1) // 正常字符，缓冲区未满
+    {
+        shell_buff[shell_idx++] = (char)byte;
+    }
+    else // 缓冲区满，丢弃数据并重置
+    {
+        shell_idx = 0;
+    }
+    return is_line_finish;
+}
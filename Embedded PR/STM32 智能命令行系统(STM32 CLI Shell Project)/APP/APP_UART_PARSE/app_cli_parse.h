@@ -1,27 +1,36 @@
-#ifndef __APP_CLI_PARSE_H__
-#define __APP_CLI_PARSE_H__
-
-#include <stdint.h>
-#include <stdbool.h>
-#include "elog.h"
-#include <string.h>
-#include <stdio.h>
-#include <stdlib.h>
-#include "bsp_servo.h"
-#include "bsp_led_driver.h"
-#include "bsp_mcu_inter_temperature.h"
-
-#define SHELL_MAX_LEN 64
-
-bool Shell_parsebyte(uint8_t byte);
-//عshell
-typedef void(*shell_func)(char *arg);
-typedef struct 
-{
-    char *name;
-    shell_func func;
-    char *help;
-}Shell_command_t;
-
-
-#endif //end __APP_CLI_PARSE_H__
+#ifndef __APP_CLI_PARSE_H__
+#define __APP_CLI_PARSE_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "elog.h"
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "bsp_servo.h"
+#include "bsp_led_driver.h"
+#include "bsp_mcu_inter_temperature.h"
+#include "app_runtime_stats.h"
+#include "app_profiler.h"
+#include "app_stack_monitor.h"
+#include "app_latency.h"
+#include "app_trace.h"
+#include "bsp_uart_driver.h"
+#include "elog_flash.h"
+#include "app_crash_log.h"
+#include "app_power.h"
+
+#define SHELL_MAX_LEN 64
+
+bool Shell_parsebyte(uint8_t byte);
+//重构shell函数
+typedef void(*shell_func)(char *arg);
+typedef struct 
+{
+    char *name;
+    shell_func func;
+    char *help;
+}Shell_command_t;
+
+
+#endif //end __APP_CLI_PARSE_H__
@@ -1,12 +1,12 @@
-#ifndef __APP_DISPATCHER_H__
-#define __APP_DISPATCHER_H__
-
-#include <stdint.h>
-#include <string.h>
-#include <stdbool.h>
-#include "app_binary_parse.h"
-#include "app_cli_parse.h"
-void Dispatcher_Input(uint8_t byte);
-
-
-#endif //end __APP_DISPATCHER_H__
+#ifndef __APP_DISPATCHER_H__
+#define __APP_DISPATCHER_H__
+
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include "app_binary_parse.h"
+#include "app_cli_parse.h"
+void Dispatcher_Input(uint8_t byte);
+
+
+#endif //end __APP_DISPATCHER_H__
@@ -1,12 +1,13 @@
-#ifndef __APP_USART_REC_PARSE_H__
-#define __APP_USART_REC_PARSE_H__
-
-#include "stdint.h"
-#include "bsp_uart_driver.h"
-#include "ring_buffer.h"
-#include "app_dispatcher.h"
-#include "bsp_servo.h"
-void UartParseTask(void *argument);
-
-
-#endif //end __APP_USART_REC_PARSE_H__
+#ifndef __APP_USART_REC_PARSE_H__
+#define __APP_USART_REC_PARSE_H__
+
+#include "stdint.h"
+#include "bsp_uart_driver.h"
+#include "ring_buffer.h"
+#include "app_dispatcher.h"
+#include "bsp_servo.h"
+#include "app_latency.h"
+void UartParseTask(void *argument);
+
+
+#endif //end __APP_USART_REC_PARSE_H__
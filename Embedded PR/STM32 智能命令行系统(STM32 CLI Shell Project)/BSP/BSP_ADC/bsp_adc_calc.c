@@ -0,0 +1,135 @@
+#include "bsp_adc_calc.h"
+
+/**
+ * @brief 数据手册典型值，出厂校准值无效时使用
+ * @note 系统存储区未写校准值时读出 0xFFFF，按 12 位范围判断是否有效
+ */
+#define TYP_VREFINT_MV 1210     // 内部参考电压典型值 (mV)
+#define TYP_V25_UV 760000       // 25℃ 时温度传感器输出 (uV)
+#define TYP_AVG_SLOPE_UV 2500   // 温度斜率 (uV/℃)
+
+#define ADC_FULL_Q (4095UL << ADC_Q_SHIFT) // 满量程读数 (1/16 LSB)
+
+/**
+ * @brief 带符号整数除法，四舍五入
+ */
+static int32_t ADC_Calc_DivRound(int64_t num, int64_t den)
+{
+    return (int32_t)((num >= 0) ? (num + den / 2) / den : (num - den / 2) / den);
+}
+
+static int ADC_Calc_VrefValid(const ADC_Calib_t *cal)
+{
+    return (cal->vrefint_cal > 0) && (cal->vrefint_cal <= 4095);
+}
+
+static int ADC_Calc_TsValid(const ADC_Calib_t *cal)
+{
+    return ADC_Calc_VrefValid(cal) && (cal->ts_cal2 <= 4095) && (cal->ts_cal1 < cal->ts_cal2);
+}
+
+/**
+ * @brief 对 DMA 缓冲区中交错存放的扫描结果求平均
+ * @param[in] buf 扫描结果，每次扫描 ADC_CH_NUM 个值 (按 Rank 顺序)
+ * @param[in] scans 扫描次数 (1~1024，累加不会溢出)
+ * @param[out] vref_q 内部参考电压平均读数 (1/16 LSB)
+ * @param[out] temp_q 温度传感器平均读数 (1/16 LSB)
+ * @note 噪声接近白噪声时，64 次平均使噪声降为 1/8，多出约 3 位有效分辨率，
+ *       结果保留 4 位小数，不再在换算前截断
+ */
+void ADC_Calc_Oversample(const uint16_t *buf, uint32_t scans, uint16_t *vref_q, uint16_t *temp_q)
+{
+    uint32_t vref_sum = 0, temp_sum = 0, i;
+
+    for (i = 0; i < scans; i++)
+    {
+        vref_sum += buf[i * ADC_CH_NUM + ADC_CH_VREFINT];
+        temp_sum += buf[i * ADC_CH_NUM + ADC_CH_TEMP];
+    }
+    *vref_q = (uint16_t)(((vref_sum << ADC_Q_SHIFT) + scans / 2) / scans);
+    *temp_q = (uint16_t)(((temp_sum << ADC_Q_SHIFT) + scans / 2) / scans);
+}
+
+/**
+ * @brief 由内部参考电压读数计算 VDDA
+ * @param[in] cal 出厂校准值
+ * @param[in] vref_q 内部参考电压平均读数 (1/16 LSB)
+ * @return VDDA (mV)，读数为 0 时返回 0
+ * @note 内部参考电压不随 VDDA 变化，读数与 VDDA 成反比：
+ *       VDDA = 3300mV * VREFINT_CAL / 读数
+ */
+uint16_t ADC_Calc_VddaMv(const ADC_Calib_t *cal, uint32_t vref_q)
+{
+    uint32_t num;
+
+    if (0 == vref_q)
+    {
+        return 0;
+    }
+    if (ADC_Calc_VrefValid(cal))
+    {
+        num = (uint32_t)ADC_CAL_VREF_MV * cal->vrefint_cal << ADC_Q_SHIFT;
+    }
+    else
+    {
+        num = (uint32_t)TYP_VREFINT_MV * ADC_FULL_Q;
+    }
+    return (uint16_t)((num + vref_q / 2) / vref_q);
+}
+
+/**
+ * @brief 计算芯片温度
+ * @param[in] cal 出厂校准值
+ * @param[in] temp_q 温度传感器平均读数 (1/16 LSB)
+ * @param[in] vref_q 同一批的内部参考电压平均读数 (1/16 LSB)
+ * @return 温度 (0.01℃)
+ * @note 先把读数折算到校准时的 VDDA = 3.3V：读数 * VREFINT_CAL / 参考电压读数，
+ *       VDDA 的波动在这一步抵消，再在 TS_CAL1 (30℃) 和 TS_CAL2 (110℃) 之间线性插值；
+ *       两点校准消除了各芯片 V25 的离散 (典型值公式的主要误差来源，可达数℃)
+ */
+int16_t ADC_Calc_TempCenti(const ADC_Calib_t *cal, uint32_t temp_q, uint32_t vref_q)
+{
+    int64_t norm_q, vsense_uv;
+    int32_t centi;
+
+    if (0 == vref_q)
+    {
+        return 0;
+    }
+    if (ADC_Calc_TsValid(cal))
+    {
+        norm_q = ADC_Calc_DivRound((int64_t)temp_q * cal->vrefint_cal << ADC_Q_SHIFT, vref_q);
+        centi = ADC_TS_CAL1_TEMP * 100 +
+                ADC_Calc_DivRound((norm_q - ((int64_t)cal->ts_cal1 << ADC_Q_SHIFT)) * (ADC_TS_CAL2_TEMP - ADC_TS_CAL1_TEMP) * 100,
+                                  (int64_t)(cal->ts_cal2 - cal->ts_cal1) << ADC_Q_SHIFT);
+    }
+    else
+    {
+        // 典型值公式：Temp = (Vsense - V25) / Avg_Slope + 25
+        vsense_uv = (int64_t)temp_q * ADC_Calc_VddaMv(cal, vref_q) * 1000 / ADC_FULL_Q;
+        centi = 2500 + ADC_Calc_DivRound((vsense_uv - TYP_V25_UV) * 100, TYP_AVG_SLOPE_UV);
+    }
+    if (centi > INT16_MAX)
+    {
+        centi = INT16_MAX;
+    }
+    else if (centi < INT16_MIN)
+    {
+        centi = INT16_MIN;
+    }
+    return (int16_t)centi;
+}
+
+/**
+ * @brief 对一段扫描结果求平均并换算
+ * @param[in] cal 出厂校准值
+ * @param[in] buf 扫描结果 (按 Rank 顺序交错存放)
+ * @param[in] scans 扫描次数
+ * @param[out] result 换算结果
+ */
+void ADC_Calc_Convert(const ADC_Calib_t *cal, const uint16_t *buf, uint32_t scans, ADC_Result_t *result)
+{
+    ADC_Calc_Oversample(buf, scans, &result->vref_q, &result->temp_q);
+    result->vdda_mv = ADC_Calc_VddaMv(cal, result->vref_q);
+    result->temp_centi = ADC_Calc_TempCenti(cal, result->temp_q, result->vref_q);
+}
@@ -0,0 +1,43 @@
+#ifndef BSP_ADC_CALC_H
+#define BSP_ADC_CALC_H
+#include <stdint.h>
+
+/* 本文件只做换算，不依赖 HAL，可以直接在 PC 上编译测试 (STM32_PC_Tool/adc_sim) */
+
+#define ADC_CH_VREFINT 0        // 扫描序列 Rank1：内部参考电压
+#define ADC_CH_TEMP 1           // 扫描序列 Rank2：温度传感器
+#define ADC_CH_NUM 2            // 每次扫描的通道数
+#define ADC_OVERSAMPLE 64       // 每半个 DMA 缓冲区的扫描次数，取平均后更新一次结果
+#define ADC_Q_SHIFT 4           // 过采样结果保留的小数位数 (1/16 LSB)
+
+#define ADC_CAL_VREF_MV 3300    // 出厂校准时的 VDDA (mV)
+#define ADC_TS_CAL1_TEMP 30     // TS_CAL1 对应的温度 (℃)
+#define ADC_TS_CAL2_TEMP 110    // TS_CAL2 对应的温度 (℃)
+
+/**
+ * @brief 出厂校准值 (系统存储区，VDDA = 3.3V 时的 12 位原始值)
+ */
+typedef struct
+{
+    uint16_t vrefint_cal;   // VREFINT_CAL：30℃ 时内部参考电压的读数
+    uint16_t ts_cal1;       // TS_CAL1：30℃ 时温度传感器的读数
+    uint16_t ts_cal2;       // TS_CAL2：110℃ 时温度传感器的读数
+} ADC_Calib_t;
+
+/**
+ * @brief 一次过采样的换算结果
+ */
+typedef struct
+{
+    uint16_t vref_q;        // 内部参考电压平均读数 (1/16 LSB)
+    uint16_t temp_q;        // 温度传感器平均读数 (1/16 LSB)
+    uint16_t vdda_mv;       // 由内部参考电压反推的 VDDA (mV)
+    int16_t temp_centi;     // 芯片温度 (0.01℃)
+} ADC_Result_t;
+
+void ADC_Calc_Oversample(const uint16_t *buf, uint32_t scans, uint16_t *vref_q, uint16_t *temp_q);
+uint16_t ADC_Calc_VddaMv(const ADC_Calib_t *cal, uint32_t vref_q);
+int16_t ADC_Calc_TempCenti(const ADC_Calib_t *cal, uint32_t temp_q, uint32_t vref_q);
+void ADC_Calc_Convert(const ADC_Calib_t *cal, const uint16_t *buf, uint32_t scans, ADC_Result_t *result);
+
+#endif //end BSP_ADC_CALC_H
@@ -0,0 +1,316 @@
+#include "bsp_adc_filter.h"
+#include <math.h>
+#include <string.h>
+
+#define Q14_ONE (1L << (15 - ADC_FILT_Q15_POST_SHIFT)) // Q15 模式下系数 1.0 对应的整数值
+
+/**
+ * @brief 把 1/16 LSB 的结果限制在 uint16_t 范围内
+ */
+static uint16_t ADC_Filter_ClampQ(int32_t q)
+{
+    if (q < 0)
+    {
+        return 0;
+    }
+    if (q > UINT16_MAX)
+    {
+        return UINT16_MAX;
+    }
+    return (uint16_t)q;
+}
+
+/**
+ * @brief 取基准值，该通道状态清零
+ * @param[in] ch 通道
+ * @param[in] sample 该通道的一个读数，作为基准值
+ * @note 滤波器只处理读数与基准的差，状态清零就是直流稳态，不用等低通滤波器从 0 爬到实际读数；
+ *       差值很小，浮点的有效位和 Q15 的动态范围都用在噪声上：读数 1500 左右时 float 的分辨率约 1e-4 LSB，
+ *       经反馈放大 1 / (1 + a1 + a2) 倍 (截止频率 0.5Hz 时约 7000 倍) 后会超过滤波器本身的输出噪声
+ */
+static void ADC_Filter_Prime(ADC_Filter_t *f, uint8_t ch, uint16_t sample)
+{
+    f->offset[ch] = sample;
+    f->base_q[ch] = (int32_t)lroundf((float32_t)sample * f->dc_gain * (1 << ADC_Q_SHIFT));
+    memset(f->state_f32[ch], 0, sizeof(f->state_f32[ch]));
+    memset(f->state_q15[ch], 0, sizeof(f->state_q15[ch]));
+}
+
+/**
+ * @brief 初始化滤波器：不滤波，系数为直通 (1 节，b0 = 1)
+ */
+void ADC_Filter_Init(ADC_Filter_t *f)
+{
+    ADC_Filt_Coeffs_t pass = {1, {{1.0f, 0.0f, 0.0f, 0.0f, 0.0f}}};
+
+    memset(f, 0, sizeof(*f));
+    ADC_Filter_SetCoeffs(f, &pass);
+    f->mode = ADC_FILT_OFF;
+}
+
+/**
+ * @brief 设计巴特沃斯低通滤波器
+ * @param[out] coeffs 设计结果
+ * @param[in] fc 截止频率 (Hz)
+ * @param[in] fs 采样频率 (Hz)
+ * @param[in] stages 二阶节数，阶数为 2 * stages
+ * @return true: 成功, false: 参数超出范围
+ * @note 双线性变换 (在 fc 处预畸变)，第 k 节的品质因数 Q = 1 / (2cos((2k+1)π / 4N))，N 为节数；
+ *       各节直流增益都是 1
+ */
+bool ADC_Filter_DesignLowpass(ADC_Filt_Coeffs_t *coeffs, float fc, float fs, uint8_t stages)
+{
+    float w0, cos_w0, alpha, q, a0;
+    uint8_t k;
+
+    if (stages < 1 || stages > ADC_FILT_MAX_STAGES || !(fc > 0.0f) || !(fc < fs / 2.0f))
+    {
+        return false;
+    }
+    w0 = 2.0f * PI * fc / fs;
+    cos_w0 = cosf(w0);
+    coeffs->stages = stages;
+    for (k = 0; k < stages; k++)
+    {
+        q = 1.0f / (2.0f * cosf(PI * (2 * k + 1) / (4.0f * stages)));
+        alpha = sinf(w0) / (2.0f * q);
+        a0 = 1.0f + alpha;
+        coeffs->coeffs[k][0] = (1.0f - cos_w0) / 2.0f / a0;
+        coeffs->coeffs[k][1] = (1.0f - cos_w0) / a0;
+        coeffs->coeffs[k][2] = coeffs->coeffs[k][0];
+        coeffs->coeffs[k][3] = -2.0f * cos_w0 / a0;
+        coeffs->coeffs[k][4] = (1.0f - alpha) / a0;
+    }
+    return true;
+}
+
+/**
+ * @brief 把系数量化成 CMSIS Q15 格式
+ * @param[in] coeffs 系数 (已检查过稳定性)
+ * @param[out] coeff_q15 {b0, 0, b1, b2, -a1, -a2}，Q14
+ * @param[out] bias 截断误差的补偿量 (1 LSB(q15))
+ * @param[out] den_min 各节 (1 + a1 + a2) 量化值的最小值
+ * @return false: 系数超出 [-2, 2) 或量化后极点落到 z = 1 上
+ * @note 低截止频率时 b0 只有个位数，量化后直流增益会明显偏离，
+ *       这里调整 b1 使量化后的 b0 + b1 + b2 与 1 + a1 + a2 之比保持设计值，直流增益不变；
+ *       DF1 Q15 的输出右移是截断 (向负无穷)，每节平均偏低 0.5 LSB(q15)，经反馈放大 1 / (1 + a1 + a2) 倍，
+ *       arm_mean_q15 的整数除法再偏低 0.5 LSB(q15)，合计算成固定补偿量，在输出时加回
+ */
+static bool ADC_Filter_QuantizeQ15(const ADC_Filt_Coeffs_t *coeffs, q15_t *coeff_q15, int32_t *bias, int32_t *den_min)
+{
+    int32_t q[5], target, den_q;
+    float32_t dc_gain, sum = 0.0f;
+    const float *c;
+    uint8_t s, i;
+
+    *den_min = Q14_ONE;
+    for (s = 0; s < coeffs->stages; s++)
+    {
+        c = coeffs->coeffs[s];
+        for (i = 0; i < 5; i++)
+        {
+            if (!(fabsf(c[i]) < 2.0f))
+            {
+                return false;
+            }
+            q[i] = (int32_t)lroundf(c[i] * Q14_ONE);
+        }
+        den_q = Q14_ONE + q[3] + q[4];
+        if (den_q <= 0)
+        {
+            return false;
+        }
+        dc_gain = (c[0] + c[1] + c[2]) / (1.0f + c[3] + c[4]);
+        target = (int32_t)lroundf(dc_gain * den_q);
+        q[1] += target - (q[0] + q[1] + q[2]);
+        if (q[1] < INT16_MIN || q[1] > INT16_MAX || q[3] <= INT16_MIN || q[4] <= INT16_MIN)
+        {
+            return false;
+        }
+        coeff_q15[s * 6 + 0] = (q15_t)q[0];
+        coeff_q15[s * 6 + 1] = 0;
+        coeff_q15[s * 6 + 2] = (q15_t)q[1];
+        coeff_q15[s * 6 + 3] = (q15_t)q[2];
+        coeff_q15[s * 6 + 4] = (q15_t)-q[3];
+        coeff_q15[s * 6 + 5] = (q15_t)-q[4];
+        // 前面各节的偏差经过本节的直流增益，本节再加上自己的截断偏差
+        sum = sum * dc_gain + 0.5f * Q14_ONE / den_q;
+        if (den_q < *den_min)
+        {
+            *den_min = den_q;
+        }
+    }
+    *bias = (int32_t)lroundf(sum + 0.5f); // arm_mean_q15 的截断在最后一节之后，不经过滤波器
+    return true;
+}
+
+/**
+ * @brief 设置滤波器系数并清空状态
+ * @param[in] coeffs 系数 (a1 a2 按设计工具的写法，不取反)
+ * @return true: 成功, false: 节数不对、不稳定，或当前是 Q15 模式而系数无法量化，原系数不变
+ * @note 系数无法量化时仍可用于 F32 模式，q15_ok 置 false，之后不能切到 Q15
+ */
+bool ADC_Filter_SetCoeffs(ADC_Filter_t *f, const ADC_Filt_Coeffs_t *coeffs)
+{
+    q15_t coeff_q15[ADC_FILT_MAX_STAGES * 6];
+    float32_t gain = 1.0f;
+    int32_t bias, den_min;
+    const float *c;
+    bool q15_ok;
+    uint8_t s, ch;
+
+    if (coeffs->stages < 1 || coeffs->stages > ADC_FILT_MAX_STAGES)
+    {
+        return false;
+    }
+    for (s = 0; s < coeffs->stages; s++)
+    {
+        c = coeffs->coeffs[s];
+        // 稳定三角形：|a2| < 1 且 |a1| < 1 + a2，同时保证 1 + a1 + a2 > 0
+        if (!(fabsf(c[4]) < 1.0f) || !(fabsf(c[3]) < 1.0f + c[4]))
+        {
+            return false;
+        }
+        gain *= (c[0] + c[1] + c[2]) / (1.0f + c[3] + c[4]);
+    }
+    q15_ok = ADC_Filter_QuantizeQ15(coeffs, coeff_q15, &bias, &den_min);
+    if (!q15_ok && ADC_FILT_Q15 == f->mode)
+    {
+        return false;
+    }
+
+    f->design = *coeffs;
+    f->dc_gain = gain;
+    f->q15_ok = q15_ok;
+    if (q15_ok)
+    {
+        memcpy(f->coeff_q15, coeff_q15, sizeof(coeff_q15));
+        f->q15_bias = bias;
+        f->q15_den_min = den_min;
+    }
+    for (s = 0; s < coeffs->stages; s++)
+    {
+        f->coeff_f32[s * 5 + 0] = coeffs->coeffs[s][0];
+        f->coeff_f32[s * 5 + 1] = coeffs->coeffs[s][1];
+        f->coeff_f32[s * 5 + 2] = coeffs->coeffs[s][2];
+        f->coeff_f32[s * 5 + 3] = -coeffs->coeffs[s][3];
+        f->coeff_f32[s * 5 + 4] = -coeffs->coeffs[s][4];
+    }
+    for (ch = 0; ch < ADC_CH_NUM; ch++)
+    {
+        arm_biquad_cascade_df1_init_f32(&f->inst_f32[ch], coeffs->stages, f->coeff_f32, f->state_f32[ch]);
+        arm_biquad_cascade_df1_init_q15(&f->inst_q15[ch], coeffs->stages, f->coeff_q15, f->state_q15[ch],
+                                        ADC_FILT_Q15_POST_SHIFT);
+    }
+    f->primed = false;
+    return true;
+}
+
+/**
+ * @brief 切换滤波方式，下一块数据重新取基准
+ * @return false: 当前系数无法量化成 Q15，模式不变
+ */
+bool ADC_Filter_SetMode(ADC_Filter_t *f, ADC_Filt_Mode_t mode)
+{
+    if (ADC_FILT_Q15 == mode && !f->q15_ok)
+    {
+        return false;
+    }
+    f->mode = mode;
+    f->primed = false;
+    return true;
+}
+
+/**
+ * @brief 丢弃滤波器历史，下一块数据重新取基准
+ */
+void ADC_Filter_Reset(ADC_Filter_t *f)
+{
+    f->primed = false;
+}
+
+/**
+ * @brief 取出一个通道的数据，减去基准值后转成 Q15
+ * @return false: 有读数超出 Q15 范围 (±255 LSB)
+ */
+static bool ADC_Filter_LoadQ15(ADC_Filter_t *f, const uint16_t *buf, uint32_t scans, uint8_t ch)
+{
+    int32_t d;
+    bool in_range = true;
+    uint32_t i;
+
+    for (i = 0; i < scans; i++)
+    {
+        d = ((int32_t)buf[i * ADC_CH_NUM + ch] - f->offset[ch]) << ADC_FILT_Q15_SHIFT;
+        if (d < INT16_MIN || d > INT16_MAX)
+        {
+            in_range = false;
+            d = (d < 0) ? INT16_MIN : INT16_MAX;
+        }
+        f->work_q15[i] = (q15_t)d;
+    }
+    return in_range;
+}
+
+/**
+ * @brief 对一块扫描结果滤波后求平均
+ * @param[in] buf 扫描结果 (按 Rank 顺序交错存放)
+ * @param[in] scans 扫描次数 (1 ~ ADC_OVERSAMPLE)
+ * @param[out] vref_q 内部参考电压读数 (1/16 LSB)
+ * @param[out] temp_q 温度传感器读数 (1/16 LSB)
+ * @note 滤波器状态跨块保留，相当于以 ADC_SAMPLE_HZ 连续滤波，每块输出一次均值 (抽取)；
+ *       F32：差值直接转浮点，1.0 = 1 LSB；
+ *       Q15：差值左移 ADC_FILT_Q15_SHIFT 位，输出四舍五入回 1/16 LSB。
+ *       读数离基准超过 ±255 LSB (VDDA 或温度大幅变化) 时重新取基准，丢掉之前的历史
+ */
+void ADC_Filter_Process(ADC_Filter_t *f, const uint16_t *buf, uint32_t scans, uint16_t *vref_q, uint16_t *temp_q)
+{
+    uint16_t *out[ADC_CH_NUM];
+    float32_t mean_f32;
+    q15_t mean_q15;
+    uint32_t i;
+    uint8_t ch;
+
+    if (ADC_FILT_OFF == f->mode || 0 == scans || scans > ADC_OVERSAMPLE)
+    {
+        ADC_Calc_Oversample(buf, scans, vref_q, temp_q);
+        return;
+    }
+    if (!f->primed)
+    {
+        for (ch = 0; ch < ADC_CH_NUM; ch++)
+        {
+            ADC_Filter_Prime(f, ch, buf[ch]);
+        }
+        f->primed = true;
+    }
+
+    out[ADC_CH_VREFINT] = vref_q;
+    out[ADC_CH_TEMP] = temp_q;
+    for (ch = 0; ch < ADC_CH_NUM; ch++)
+    {
+        if (ADC_FILT_F32 == f->mode)
+        {
+            for (i = 0; i < scans; i++)
+            {
+                f->work_f32[i] = (float32_t)((int32_t)buf[i * ADC_CH_NUM + ch] - f->offset[ch]);
+            }
+            arm_biquad_cascade_df1_f32(&f->inst_f32[ch], f->work_f32, f->work_f32, scans);
+            arm_mean_f32(f->work_f32, scans, &mean_f32);
+            *out[ch] = ADC_Filter_ClampQ(f->base_q[ch] + (int32_t)lroundf(mean_f32 * (1 << ADC_Q_SHIFT)));
+        }
+        else
+        {
+            if (!ADC_Filter_LoadQ15(f, buf, scans, ch))
+            {
+                ADC_Filter_Prime(f, ch, buf[ch]);
+                ADC_Filter_LoadQ15(f, buf, scans, ch);
+            }
+            arm_biquad_cascade_df1_q15(&f->inst_q15[ch], f->work_q15, f->work_q15, scans);
+            arm_mean_q15(f->work_q15, scans, &mean_q15);
+            *out[ch] = ADC_Filter_ClampQ(f->base_q[ch] +
+                                         ((mean_q15 + f->q15_bias + (1 << (ADC_FILT_Q15_SHIFT - ADC_Q_SHIFT - 1))) >>
+                                          (ADC_FILT_Q15_SHIFT - ADC_Q_SHIFT)));
+        }
+    }
+}
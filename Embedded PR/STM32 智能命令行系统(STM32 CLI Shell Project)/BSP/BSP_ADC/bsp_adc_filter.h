@@ -0,0 +1,68 @@
+#ifndef BSP_ADC_FILTER_H
+#define BSP_ADC_FILTER_H
+#include <stdint.h>
+#include <stdbool.h>
+#include "arm_math.h"
+#include "bsp_adc_calc.h"
+
+/* 本文件不依赖 HAL，与 CMSIS-DSP 源码一起可以直接在 PC 上编译测试 (STM32_PC_Tool/dsp_bench) */
+
+#define ADC_FILT_MAX_STAGES 2       // 最多级联的二阶节数 (即最高 4 阶)
+#define ADC_FILT_Q15_SHIFT 7        // Q15 模式输入 (减去基准后) 左移位数：1 LSB(q15) = 1/128 LSB，范围 ±255 LSB
+#define ADC_FILT_Q15_POST_SHIFT 1   // Q15 系数按 Q14 存放，系数范围 [-2, 2)
+#define ADC_FILT_Q15_DEN_WARN 32    // q15_den_min 低于此值时 Q15 输出会卡在死区里 (截止频率低于采样率的 1% 左右)
+
+/**
+ * @brief 滤波方式
+ */
+typedef enum
+{
+    ADC_FILT_OFF = 0,   // 不滤波，直接取平均 (ADC_Calc_Oversample)
+    ADC_FILT_F32,       // 浮点 DF1 二阶节级联 (arm_biquad_cascade_df1_f32)
+    ADC_FILT_Q15,       // 定点 DF1 二阶节级联 (arm_biquad_cascade_df1_q15)
+} ADC_Filt_Mode_t;
+
+/**
+ * @brief 滤波器系数
+ * @note 每节 b0 b1 b2 a1 a2，按设计工具的习惯写法：
+ *       H(z) = (b0 + b1*z^-1 + b2*z^-2) / (1 + a1*z^-1 + a2*z^-2)
+ *       CMSIS 要求 a1 a2 取反，在 ADC_Filter_SetCoeffs 里转换
+ */
+typedef struct
+{
+    uint8_t stages;                             // 节数 (1 ~ ADC_FILT_MAX_STAGES)
+    float coeffs[ADC_FILT_MAX_STAGES][5];       // b0 b1 b2 a1 a2
+} ADC_Filt_Coeffs_t;
+
+/**
+ * @brief 滤波器实例：两个通道各有一份状态，系数共用
+ */
+typedef struct
+{
+    ADC_Filt_Mode_t mode;
+    ADC_Filt_Coeffs_t design;                               // 设置的系数 (原样保存，供显示)
+    bool primed;                                            // 已取基准值，状态有效
+    int32_t offset[ADC_CH_NUM];                             // 基准值 (LSB)，滤波器只处理读数与基准的差
+    int32_t base_q[ADC_CH_NUM];                             // 基准值经过滤波器后的输出 (1/16 LSB)，输出时加回
+    float32_t coeff_f32[ADC_FILT_MAX_STAGES * 5];           // CMSIS 格式 {b0, b1, b2, -a1, -a2}
+    q15_t coeff_q15[ADC_FILT_MAX_STAGES * 6];               // CMSIS 格式 {b0, 0, b1, b2, -a1, -a2}，Q14
+    float32_t dc_gain;                                      // 整个滤波器的直流增益
+    bool q15_ok;                                            // 系数能量化成 Q15
+    int32_t q15_bias;                                       // Q15 截断误差的补偿量 (1 LSB(q15))
+    int32_t q15_den_min;                                    // 各节 (1 + a1 + a2) 的 Q14 值取最小，越小死区越宽
+    float32_t state_f32[ADC_CH_NUM][ADC_FILT_MAX_STAGES * 4];
+    q15_t state_q15[ADC_CH_NUM][ADC_FILT_MAX_STAGES * 4];
+    arm_biquad_casd_df1_inst_f32 inst_f32[ADC_CH_NUM];
+    arm_biquad_casd_df1_inst_q15 inst_q15[ADC_CH_NUM];
+    float32_t work_f32[ADC_OVERSAMPLE];                     // 单通道一块数据的工作区 (原地滤波)
+    q15_t work_q15[ADC_OVERSAMPLE];
+} ADC_Filter_t;
+
+void ADC_Filter_Init(ADC_Filter_t *f);
+bool ADC_Filter_DesignLowpass(ADC_Filt_Coeffs_t *coeffs, float fc, float fs, uint8_t stages);
+bool ADC_Filter_SetCoeffs(ADC_Filter_t *f, const ADC_Filt_Coeffs_t *coeffs);
+bool ADC_Filter_SetMode(ADC_Filter_t *f, ADC_Filt_Mode_t mode);
+void ADC_Filter_Reset(ADC_Filter_t *f);
+void ADC_Filter_Process(ADC_Filter_t *f, const uint16_t *buf, uint32_t scans, uint16_t *vref_q, uint16_t *temp_q);
+
+#endif //end BSP_ADC_FILTER_H
@@ -1,107 +1,255 @@
-#include "bsp_mcu_inter_temperature.h"
-#include "adc.h"
-#include <stdio.h>
-
-/**
- * @brief STM32F4ϵڲ¶ȴУ׼
- * @note ЩSTM32F411ٷֲ
- *       ͬϵеĲвͬҪοӦֲ
- */
-#define V25             0.76f       // 25ʱĲοѹλV
-#define AVG_SLOPE       0.0025f     // ¶-ѹбʣ2.5 mV/ = 0.0025 V/棩
-#define VREF_INT        1.21f       // ڲοѹ׼ֵ1.21V
-
-/**
- * @brief ȡADCԭʼתֵ
- * @return ADC12λԭʼתֵ (0-4095)
- * 
- * @note ̣
- *       1. ADCת
- *       2. ȴתɣѯ
- *       3. ȡת
- *       4. ֹͣADCģʽ¿ʡԣ
- * 
- * @note ˵
- *       - HAL_ADC_Start()ת
- *       - HAL_ADC_PollForConversion()ѯȴתɣʱ10ms
- *       - HAL_ADC_GetValue()ȡת
- *       - HAL_ADC_Stop()ֹͣADC
- */
-static uint32_t BSP_ADC_ReadRaw(void)
-{
-    // ADCת
-    HAL_ADC_Start(&hadc1);
-    
-    // ѯȴתɣʱʱ10ms
-    HAL_ADC_PollForConversion(&hadc1, 10);
-    
-    // ȡתԭʼֵ12λΧ0-4095
-    uint32_t val = HAL_ADC_GetValue(&hadc1);
-    
-    // ֹͣADCתģʽ¿ʡԣΪ˰ȫֹͣ
-    HAL_ADC_Stop(&hadc1);
-    
-    return val;
-}
-
-/**
- * @brief ȡMCUоƬڲ¶
- * @return оƬǰ¶ȣλ棬Լ3棩
- * 
- * @note ԭ˵
- *       STM32¶ȴһPNᣬѹ¶ȱ仯仯
- *       ͨѹԷƵǰ¶
- *       
- *       ؼ
- *       - Vsense¶ȴѹ
- *       - V2525ʱĲοѹ0.76V
- *       - AvgSlope¶бʣ2.5mV/棩
- *       
- *       תʽ
- *       Temp = ((Vsense - V25) / AvgSlope) + 25
- * 
- * @note Ӱأ
- *       1. VDDA粨ӰADCת
- *       2. ¶ȷΧ-40 ~ 125
- *       3. Ծȣ3棨ٷ
- * 
- * @note 裺
- *       1. ȡڲοѹͨVrefint- ڲVDDA
- *       2. ȡ¶ȴͨ
- *       3. ʵVDDAѹ
- *       4. ¶ȴѹVsense
- *       5. 빫ʽ¶
- */
-float BSP_Get_ChipTemp(void)
-{
-    // 1ȡڲοѹͨVrefint
-    // ;VDDAѹADCתӰ
-    // VrefintͨͨADCеRank1
-    uint32_t vref_raw = BSP_ADC_ReadRaw();
-    
-    // 2ȡ¶ȴͨ
-    // ¶ȴͨͨADCеRank2
-    uint32_t temp_raw = BSP_ADC_ReadRaw();
-    
-    // 3ʵʵVDDAѹ
-    // ԭʼvdda = (VREF_INT_CAL / vref_raw) * 3.3V
-    // 򻯴ֱʹñ׼ֵ3.3V粻Ҫ߾ȣ
-    // ȷvdda = (1.21 * 4095.0) / vref_raw ʵVref
-    float vdda = 3.3f;  // 򻯰汾蹩ȶ
-    // ȷ汾float vdda = (VREF_INT * 4095.0f) / vref_raw;
-    
-    // 4ADCԭʼֵתΪѹֵ
-    // ʽV = (ADCֵ / 4095) * VDDA
-    // 409512λADCֵ
-    float v_sense = (float)temp_raw * vdda / 4095.0f;
-    
-    // 5STM32F4¶תʽ
-    // Temp = ((Vsense - V25) / AvgSlope) + 25
-    // 磺
-    // - Vsense = 0.76V Temp = ((0.76 - 0.76) / 0.0025) + 25 = 25
-    // - Vsense = 0.71V Temp = ((0.71 - 0.76) / 0.0025) + 25 = 5
-    float temp = ((v_sense - V25) / AVG_SLOPE) + 25.0f;
-    
-    return temp;
-}
-
+#include "bsp_mcu_inter_temperature.h"
+#include <string.h>
+#include "adc.h"
+#include "tim.h"
+#include "bsp_dwt.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+/**
+ * @brief ADC 后台采集
+ * @note 工作方式：
+ *       - TIM3 更新事件 (TRGO, ADC_SAMPLE_HZ) 触发一次扫描：Rank1 内部参考电压，Rank2 温度传感器，
+ *         各 480 个 ADC 周期 (ADCCLK = 25MHz，约 20us，满足温度传感器最短 10us 的采样时间)
+ *       - DMA2 Stream0 循环模式把结果搬进 adc_dma_buf，CPU 不参与转换
+ *       - 半满/全满中断各处理刚写完的一半：ADC_OVERSAMPLE 次扫描经 CMSIS-DSP 低通滤波 (bsp_adc_filter.c)
+ *         后求平均并换算，即每 ADC_OVERSAMPLE / ADC_SAMPLE_HZ = 256ms 更新一次结果，CPU 每秒只被叫醒约 4 次
+ *       - 结果放在带序号的快照里 (顺序锁)，读取方任意时刻都能在常数时间内拿到完整的一组值
+ */
+#define ADC_DMA_LEN (2 * ADC_OVERSAMPLE * ADC_CH_NUM)
+#define ADC_BLOCK_LEN (ADC_OVERSAMPLE * ADC_CH_NUM)
+
+#define ADC_FILT_DEFAULT_FC 0.5f    // 默认截止频率 (Hz)：噪声约为直接平均的一半，延迟约 1s，看芯片温度足够
+#define ADC_FILT_DEFAULT_STAGES 2   // 默认四阶巴特沃斯
+
+static uint16_t adc_dma_buf[ADC_DMA_LEN];   // DMA 循环缓冲区，前后两半交替处理
+static ADC_Calib_t adc_calib;               // 出厂校准值，启动时从系统存储区读出
+static volatile uint32_t adc_seq;           // 快照序号：奇数表示正在更新，0 表示还没有结果
+static volatile ADC_Result_t adc_snapshot;  // 最近一次的换算结果
+
+static ADC_Filter_t adc_filter;             // 只在 DMA 中断里运行，任务中修改要关中断
+static volatile uint32_t adc_filt_cycles;   // 最近一块的滤波耗时
+static volatile uint32_t adc_filt_cycles_max;
+
+static uint16_t adc_cap_buf[2][ADC_BLOCK_LEN];  // 原始数据抓取 (FILT DUMP)，双缓冲
+static volatile uint32_t adc_cap_seq;           // 已抓取的块数，最新一块在 adc_cap_buf[(seq - 1) & 1]
+static volatile bool adc_cap_enable;
+
+/**
+ * @brief 启动 ADC 后台采集
+ * @note MX_ADC1_Init / MX_TIM3_Init 之后调用；启动后约 256ms 才有第一个结果
+ */
+void BSP_ADC_Start(void)
+{
+    adc_calib.vrefint_cal = *VREFINT_CAL_ADDR;
+    adc_calib.ts_cal1 = *TEMPSENSOR_CAL1_ADDR;
+    adc_calib.ts_cal2 = *TEMPSENSOR_CAL2_ADDR;
+
+    ADC_Filter_Init(&adc_filter);
+    BSP_ADC_SetFilterLowpass(ADC_FILT_DEFAULT_FC, ADC_FILT_DEFAULT_STAGES);
+    BSP_ADC_SetFilterMode(ADC_FILT_F32);
+
+    HAL_ADC_Start_DMA(&hadc1, (uint32_t *)adc_dma_buf, ADC_DMA_LEN);
+    HAL_TIM_Base_Start(&htim3);
+}
+
+/**
+ * @brief 处理半个缓冲区并更新快照 (DMA 中断中调用，只有这一个写入方)
+ * @param[in] buf 刚写完的半个缓冲区
+ */
+static void BSP_ADC_Update(const uint16_t *buf)
+{
+    ADC_Result_t result;
+    uint32_t start, cycles;
+
+    if (adc_cap_enable)
+    {
+        memcpy(adc_cap_buf[adc_cap_seq & 1U], buf, sizeof(adc_cap_buf[0]));
+        __DMB();
+        adc_cap_seq++;
+    }
+
+    // 滤波和换算在快照外完成，序号为奇数的时间只有一次结构体拷贝
+    start = BSP_DWT_GetCycle();
+    ADC_Filter_Process(&adc_filter, buf, ADC_OVERSAMPLE, &result.vref_q, &result.temp_q);
+    cycles = BSP_DWT_GetCycle() - start;
+    adc_filt_cycles = cycles;
+    if (cycles > adc_filt_cycles_max)
+    {
+        adc_filt_cycles_max = cycles;
+    }
+    result.vdda_mv = ADC_Calc_VddaMv(&adc_calib, result.vref_q);
+    result.temp_centi = ADC_Calc_TempCenti(&adc_calib, result.temp_q, result.vref_q);
+
+    adc_seq++;
+    __DMB();
+    adc_snapshot = result;
+    __DMB();
+    adc_seq++;
+}
+
+/**
+ * @brief DMA 半满回调：前一半写完，DMA 正在写后一半
+ */
+void HAL_ADC_ConvHalfCpltCallback(ADC_HandleTypeDef *hadc)
+{
+    if (hadc->Instance == ADC1)
+    {
+        BSP_ADC_Update(&adc_dma_buf[0]);
+    }
+}
+
+/**
+ * @brief DMA 全满回调：后一半写完，DMA 回到开头
+ */
+void HAL_ADC_ConvCpltCallback(ADC_HandleTypeDef *hadc)
+{
+    if (hadc->Instance == ADC1)
+    {
+        BSP_ADC_Update(&adc_dma_buf[ADC_DMA_LEN / 2]);
+    }
+}
+
+/**
+ * @brief 读取最近一次的换算结果
+ * @param[out] result 换算结果
+ * @return true: 成功, false: 采集尚未产生结果
+ * @note 不关中断、不加锁：先后两次读到的序号相同且为偶数，说明拷贝期间快照没有被更新，
+ *       否则重读。写入方是 DMA 中断，任务中调用时最多重读一次；
+ *       不要在优先级高于 DMA2_Stream0 的中断中调用 (会在更新中途等待自己无法让出的写入方)
+ */
+bool BSP_ADC_GetLatest(ADC_Result_t *result)
+{
+    uint32_t seq;
+
+    do
+    {
+        seq = adc_seq;
+        __DMB();
+        *result = adc_snapshot;
+        __DMB();
+    } while ((seq & 1U) || (seq != adc_seq));
+
+    return (0 != seq);
+}
+
+/**
+ * @brief 获取MCU芯片内部温度
+ * @return 芯片当前温度（单位：℃），采集尚未产生结果时返回 0
+ *
+ * @note 原理说明：
+ *       STM32内置温度传感器是一个PN结，其正向压降随温度变化而变化
+ *       通过测量其输出电压，可以反推当前温度
+ *
+ * @note 精度说明：
+ *       - VDDA 由同一批的内部参考电压读数反推，供电波动不再影响结果
+ *       - 使用出厂两点校准值 (30℃/110℃)，不再依赖 V25 典型值 (芯片间离散可达数℃)
+ *       - 64 次过采样平均，读数噪声降为单次的 1/8，默认再经过 0.5Hz 低通滤波，噪声约再减半
+ *       换算公式见 bsp_adc_calc.c
+ */
+float BSP_Get_ChipTemp(void)
+{
+    ADC_Result_t result;
+
+    if (!BSP_ADC_GetLatest(&result))
+    {
+        return 0.0f;
+    }
+    return (float)result.temp_centi / 100.0f;
+}
+
+/**
+ * @brief 切换滤波方式
+ * @param[in] mode ADC_FILT_OFF / ADC_FILT_F32 / ADC_FILT_Q15
+ * @return false: 当前系数无法量化成 Q15
+ * @note 滤波器在 DMA 中断中运行，修改时关中断 (DMA2_Stream0 优先级 5，在 FreeRTOS 管理范围内)
+ */
+bool BSP_ADC_SetFilterMode(ADC_Filt_Mode_t mode)
+{
+    bool ok;
+
+    taskENTER_CRITICAL();
+    ok = ADC_Filter_SetMode(&adc_filter, mode);
+    adc_filt_cycles_max = 0;
+    taskEXIT_CRITICAL();
+    return ok;
+}
+
+/**
+ * @brief 设置滤波器系数，滤波器状态清空
+ * @param[in] coeffs 系数 (a1 a2 按设计工具的写法，不取反)
+ * @return false: 系数无效，见 ADC_Filter_SetCoeffs
+ */
+bool BSP_ADC_SetFilterCoeffs(const ADC_Filt_Coeffs_t *coeffs)
+{
+    bool ok;
+
+    taskENTER_CRITICAL();
+    ok = ADC_Filter_SetCoeffs(&adc_filter, coeffs);
+    adc_filt_cycles_max = 0;
+    taskEXIT_CRITICAL();
+    return ok;
+}
+
+/**
+ * @brief 按截止频率设置巴特沃斯低通滤波器
+ * @param[in] fc 截止频率 (Hz)，0 < fc < ADC_SAMPLE_HZ / 2
+ * @param[in] stages 二阶节数 (1 ~ ADC_FILT_MAX_STAGES)
+ * @return false: 参数超出范围
+ */
+bool BSP_ADC_SetFilterLowpass(float fc, uint8_t stages)
+{
+    ADC_Filt_Coeffs_t coeffs;
+
+    // 三角函数在关中断之外算
+    if (!ADC_Filter_DesignLowpass(&coeffs, fc, (float)ADC_SAMPLE_HZ, stages))
+    {
+        return false;
+    }
+    return BSP_ADC_SetFilterCoeffs(&coeffs);
+}
+
+/**
+ * @brief 读取滤波器设置和耗时
+ */
+void BSP_ADC_GetFilterInfo(BSP_ADC_FiltInfo_t *info)
+{
+    taskENTER_CRITICAL();
+    info->mode = adc_filter.mode;
+    info->coeffs = adc_filter.design;
+    info->q15_ok = adc_filter.q15_ok;
+    info->q15_den_min = adc_filter.q15_den_min;
+    info->cycles_last = adc_filt_cycles;
+    info->cycles_max = adc_filt_cycles_max;
+    taskEXIT_CRITICAL();
+}
+
+/**
+ * @brief 打开/关闭原始数据抓取
+ * @note 打开后 DMA 中断每处理一块就把原始读数拷进双缓冲 (256 字节，约 1us)
+ */
+void BSP_ADC_CaptureEnable(bool enable)
+{
+    adc_cap_enable = enable;
+}
+
+/**
+ * @brief 取最近抓取的一块原始数据
+ * @param[out] dst ADC_OVERSAMPLE 次扫描的读数 (按 Rank 顺序交错存放)
+ * @return 已抓取的块数，与上次返回值相差大于 1 说明中间有块没取到，为 0 时 dst 无效
+ * @note 中断只写另一半缓冲区，拷贝期间序号变了 (中断连写两块) 就重拷
+ */
+uint32_t BSP_ADC_CaptureGet(uint16_t *dst)
+{
+    uint32_t seq;
+
+    do
+    {
+        seq = adc_cap_seq;
+        __DMB();
+        memcpy(dst, adc_cap_buf[(seq - 1U) & 1U], sizeof(adc_cap_buf[0]));
+        __DMB();
+    } while (seq != adc_cap_seq);
+
+    return seq;
+}
@@ -1,7 +1,34 @@
-#ifndef BSP_MCU_INTER_TEMPERATURE_H
-#define BSP_MCU_INTER_TEMPERATURE_H
-#include <stdint.h>
-
-float BSP_Get_ChipTemp(void);
-
-#endif //end BSP_MCU_INTER_TEMPERATURE_H
+#ifndef BSP_MCU_INTER_TEMPERATURE_H
+#define BSP_MCU_INTER_TEMPERATURE_H
+#include <stdint.h>
+#include <stdbool.h>
+#include "bsp_adc_calc.h"
+#include "bsp_adc_filter.h"
+
+#define ADC_SAMPLE_HZ 250   // 扫描频率，由 TIM3 配置决定：100MHz / (9999 + 1) / (39 + 1)
+
+/**
+ * @brief 滤波器状态 (CLI 显示用)
+ */
+typedef struct
+{
+    ADC_Filt_Mode_t mode;
+    ADC_Filt_Coeffs_t coeffs;
+    bool q15_ok;            // 系数能量化成 Q15
+    int32_t q15_den_min;    // 见 ADC_Filter_t
+    uint32_t cycles_last;   // 最近一块的滤波耗时 (CPU 周期)
+    uint32_t cycles_max;    // 设置滤波器以来的最大耗时
+} BSP_ADC_FiltInfo_t;
+
+void BSP_ADC_Start(void);
+bool BSP_ADC_GetLatest(ADC_Result_t *result);
+float BSP_Get_ChipTemp(void);
+
+bool BSP_ADC_SetFilterMode(ADC_Filt_Mode_t mode);
+bool BSP_ADC_SetFilterCoeffs(const ADC_Filt_Coeffs_t *coeffs);
+bool BSP_ADC_SetFilterLowpass(float fc, uint8_t stages);
+void BSP_ADC_GetFilterInfo(BSP_ADC_FiltInfo_t *info);
+void BSP_ADC_CaptureEnable(bool enable);
+uint32_t BSP_ADC_CaptureGet(uint16_t *dst);
+
+#endif //end BSP_MCU_INTER_TEMPERATURE_H
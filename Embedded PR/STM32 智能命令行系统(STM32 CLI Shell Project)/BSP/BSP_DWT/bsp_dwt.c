@@ -0,0 +1,125 @@
+#include "bsp_dwt.h"
+
+#if defined(__linux__) || defined(__APPLE__)
+/* 主机仿真构建：没有 DWT，用单调时钟代替，1个"周期" = 1ns */
+#include <time.h>
+
+void BSP_DWT_Init(void)
+{
+}
+
+uint64_t BSP_DWT_GetCycle64(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+uint32_t BSP_DWT_GetCycle(void)
+{
+    return (uint32_t)BSP_DWT_GetCycle64();
+}
+
+uint32_t BSP_DWT_GetFreq(void)
+{
+    return 1000000000UL;
+}
+
+void BSP_DWT_AddSleep(uint32_t cycles)
+{
+    (void)cycles;
+}
+
+#else
+#include "main.h"
+
+/**
+ * @brief 64位周期计数扩展状态
+ * @note DWT->CYCCNT 只有32位，100MHz 下约 42.9 秒就会卷绕
+ *       每次读取时与上一次的值比较，若变小说明发生了卷绕，高32位加1
+ *       只要保证每 42 秒内至少调用一次 BSP_DWT_GetCycle64()，计数就不会丢
+ *       (上下文切换、HAL 1ms 时基中断都会调用，远远满足要求)
+ */
+static uint32_t dwt_last_low = 0;  // 上一次读到的 CYCCNT
+static uint32_t dwt_high = 0;      // 卷绕次数 (64位计数的高32位)
+static uint64_t dwt_sleep = 0;     // Sleep 模式下 CYCCNT 停止计数而补上的周期数 (BSP_DWT_AddSleep)
+
+/**
+ * @brief DWT 周期计数器初始化
+ * @note 工作流程：
+ *       1. 打开 DEMCR 的 TRCENA 位，使能 DWT 外设
+ *       2. 清零 CYCCNT 以及软件扩展的高32位
+ *       3. 置位 CYCCNTENA 启动计数
+ */
+void BSP_DWT_Init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    dwt_last_low = 0;
+    dwt_high = 0;
+    dwt_sleep = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/**
+ * @brief 读取32位周期数
+ * @return 当前 CYCCNT 值加上睡眠补偿 (64位计数的低32位)
+ * @note 适合测量短时间间隔 (< 42 秒)，两次读数直接相减即可，卷绕自动处理。
+ *       补偿值只在空闲任务关中断时增加，任务被抢占期间空闲任务不会运行，读到的两个值不会错开
+ */
+uint32_t BSP_DWT_GetCycle(void)
+{
+    return DWT->CYCCNT + (uint32_t)dwt_sleep;
+}
+
+/**
+ * @brief 读取卷绕安全的64位周期数
+ * @return 上电以来的总周期数，包括睡眠期间补上的周期 (100MHz 下可计数约 5800 年)
+ * @note 任务、中断、PendSV 都会调用，因此用 PRIMASK 关中断保护读-比较-更新过程
+ *       保存并恢复原来的 PRIMASK，允许在已关中断的上下文中嵌套调用
+ */
+uint64_t BSP_DWT_GetCycle64(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    uint32_t low, high;
+    uint64_t sleep;
+
+    __disable_irq();
+    low = DWT->CYCCNT;
+    if (low < dwt_last_low)
+    {
+        dwt_high++; // 发生卷绕
+    }
+    dwt_last_low = low;
+    high = dwt_high;
+    sleep = dwt_sleep;
+    __set_PRIMASK(primask);
+
+    return (((uint64_t)high << 32) | low) + sleep;
+}
+
+/**
+ * @brief 补上 CPU 睡眠期间少计的周期数
+ * @param[in] cycles WFI 期间 CYCCNT 停止计数的周期数
+ * @note Sleep 模式下内核时钟 (HCLK) 停止，CYCCNT 也跟着停，基于 DWT 的时间戳、TOP 统计、日志限速都会变慢。
+ *       由 LowPower_PostSleep 按 SysTick (同样是内核时钟，睡眠中照常计数) 算出停掉的周期数后调用。
+ *       不用 DBGMCU_CR.DBG_SLEEP 让 HCLK 在睡眠中继续运行：那样睡眠电流明显增加
+ */
+void BSP_DWT_AddSleep(uint32_t cycles)
+{
+    uint32_t primask = __get_PRIMASK();
+
+    __disable_irq();
+    dwt_sleep += cycles;
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief 获取周期计数频率
+ * @return 计数频率 (Hz)，即内核时钟 SystemCoreClock
+ */
+uint32_t BSP_DWT_GetFreq(void)
+{
+    return SystemCoreClock;
+}
+#endif
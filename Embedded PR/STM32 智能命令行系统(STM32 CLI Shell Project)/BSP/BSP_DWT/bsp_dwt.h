@@ -0,0 +1,18 @@
+#ifndef BSP_DWT_H
+#define BSP_DWT_H
+#include <stdint.h>
+
+/**
+ * @brief 运行时间统计时钟分频位数
+ * @note FreeRTOS 的统计计数器只有32位，这里把 64 位周期数右移后再交给内核
+ *       100MHz >> 4 = 6.25MHz (0.16us 精度)
+ */
+#define DWT_RUNTIME_SHIFT 4
+
+void BSP_DWT_Init(void);
+uint32_t BSP_DWT_GetCycle(void);
+uint64_t BSP_DWT_GetCycle64(void);
+uint32_t BSP_DWT_GetFreq(void);
+void BSP_DWT_AddSleep(uint32_t cycles);
+
+#endif //end BSP_DWT_H
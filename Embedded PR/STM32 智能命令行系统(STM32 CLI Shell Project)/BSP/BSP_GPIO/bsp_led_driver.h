@@ -1,7 +1,7 @@
-#ifndef BSP_LED_DRIVER_H
-#define BSP_LED_DRIVER_H
-#include <stdint.h>
-void BSP_LED_Set(uint8_t state);
-void BSP_LED_Toggle(void);
-
-#endif //end BSP_LED_DRIVER_H
+#ifndef BSP_LED_DRIVER_H
+#define BSP_LED_DRIVER_H
+#include <stdint.h>
+void BSP_LED_Set(uint8_t state);
+void BSP_LED_Toggle(void);
+
+#endif //end BSP_LED_DRIVER_H
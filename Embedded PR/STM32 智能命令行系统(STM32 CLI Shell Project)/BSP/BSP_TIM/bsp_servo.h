@@ -1,9 +1,9 @@
-#ifndef BSP_SERVO_H
-#define BSP_SERVO_H
-#include <stdint.h>
-#include "tim.h"
-#include "elog.h"
-void BSP_Servo_Init(void);
-void BSP_Servo_SetAngle(uint8_t angle);
-
-#endif
+#ifndef BSP_SERVO_H
+#define BSP_SERVO_H
+#include <stdint.h>
+#include "tim.h"
+#include "elog.h"
+void BSP_Servo_Init(void);
+void BSP_Servo_SetAngle(uint8_t angle);
+
+#endif
@@ -1,305 +1,674 @@
-#include "bsp_uart_driver.h"
-
-/* USER CODE BEGIN Variables */
-#define LOG_TAG_U "BSP_UART_LOG"
-extern UART_HandleTypeDef huart1;          // UART1STM32CubeMXɣ
-extern DMA_HandleTypeDef hdma_usart1_rx;   // DMAվSTM32CubeMXɣ
-#if 0 //ʹöд
-QueueHandle_t uart_Mailbox = NULL;
-#endif 
-#if 1 //ʹöֵźȥ
-SemaphoreHandle_t uart_Semaphore = NULL;   // ֵźͬDMA¼
-#endif
-
-/**
- * @brief λʵ
- * @note ;ʱ洢DMAյݣAPPȡ
- *       С4096ֽڣԻݰ
- */
-#define RX_POOL_SIZE 4096
-static uint8_t uart_rx_pool[RX_POOL_SIZE];       // λݳ
-static RingBuffer_t g_uart_rx_rb;                // λʵ
-
-/**
- * @brief DMAջ
- * @note DMAֱд˻Ч
- *       С2048ֽڣ֧ѭģʽcircular DMA
- */
-#define DMA_RX_BUF_SIZE 2048
-static uint8_t dma_rx_buf[DMA_RX_BUF_SIZE];    // DMAԭʼջ
-static uint16_t old_pos = 0;                    // һδDMAλãڼ
-volatile uint32_t g_drop_cnt = 0;              // λʱ
-
-/* USER CODE END Variables */
-
-/**
- * @brief UARTDMAʼ
- * @note ̣
- *       1. ʼλ
- *       2. FreeRTOSͬԭźУ
- *       3. DMA+жģʽ
- * @note ͬѡ
- *       - зֽڽգѽ
- *       - źգЧʸߣǰʹ
- */
-void BSP_UART_Init(void)
-{
-    // ʼλΪݻ׼
-    RB_Init(&g_uart_rx_rb, uart_rx_pool, RX_POOL_SIZE);
-    
-#if 0 //д䣨ѽã
-    /* USER CODE BEGIN RTOS_QUEUES */
-    /* add queues, ... */
-    //queue 1
-    uart_Mailbox = NULL;
-    uart_Mailbox = xQueueCreate(1, 4);
-    /* USER CODE END RTOS_QUEUES */
-    if(uart_Mailbox == NULL){
-        elog_i(LOG_TAG_U, "uart_Mailbox create failed");
-    }
-    else{
-        elog_i(LOG_TAG_U, "uart_Mailbox create success");
-    }
-#endif 
-
-#if 1 //ֵźȥ䣨ǰʹã
-    // ֵźͬDMA¼
-    uart_Semaphore = xSemaphoreCreateBinary();
-    if(NULL == uart_Semaphore){
-        elog_i(LOG_TAG_U, "uart_Semaphore create failed");
-    }else{
-        elog_i(LOG_TAG_U, "uart_Semaphore create success");
-    }
-    // ʼDMAλָ룬ƴʹ
-    old_pos = 0;
-#endif 
-
-#if 0 //жϽ(ûʹDMAѽ)
-    // ֽжϽշʽѱDMA
-    if(HAL_OK == HAL_UART_Receive_IT(&huart1, &uart_rx_temp, 1)){
-        elog_i(LOG_TAG_U, "HAL_UART_Receive_IT success");
-    }
-    else{
-        elog_i(LOG_TAG_U, "HAL_UART_Receive_IT failed");
-    }
-#endif    
-
-#if 1 //DMA+жϽգǰʹã
-    // HAL_UARTEx_ReceiveToIdle_DMA
-    // - ReceiveToIdleڽյUARTźʱжϣֹͣʱ
-    // - DMAʹDMAԶգռCPU
-    // Ϸȱ֤ʵʱԣҲCPUЧ
-    if(HAL_OK == HAL_UARTEx_ReceiveToIdle_DMA(&huart1, dma_rx_buf, DMA_RX_BUF_SIZE)){
-        elog_i(LOG_TAG_U, "HAL_UARTEx_ReceiveToIdle_DMA success");
-    }
-    else{
-        elog_i(LOG_TAG_U, "HAL_UARTEx_ReceiveToIdle_DMA failed");
-    }
-#endif 
-}
-
-/**
- * @brief UARTݶȡ
- * @param[out] data 洢ȡݵĻ
- * @param[in] len ȡֽ
- * @return ʵʶȡֽСlenΪλûôݣ
- * @note ̣
- *       1. ӻλֽڶȡ
- *       2. ݲlenֽڣ򷵻ʵʶȡ
- */
-uint32_t BSP_UART_Read(uint8_t *data, uint32_t len)
-{
-    uint32_t read_len = 0;
-    // ֽڴӻλȡֱջﵽ󳤶
-    while(read_len < len){
-        if(true == RB_Read(&g_uart_rx_rb, &data[read_len])){
-            read_len++;
-        }
-        else{
-            // Ѷ꣬Ѷֽ
-            break;
-        }
-    }
-    return read_len;
-}
-
-#if 0 //ʹõֽжϽյĻصѽã
-/**
- * @brief UARTжϻصֽģʽѽã
- * @note ֽжϷ⣺
- *       1. ÿһֽھʹһжϣ
- *       2. ʺϸ١ݽ
- *       ѱDMA+жϷ
- */
-void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
-{
-    /* Prevent unused argument(s) compilation warning */
-    UNUSED(huart);
-    
-    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-    // յĵֽд뻷λ
-    RB_Write(&g_uart_rx_rb, uart_rx_temp);
-    
-#if 0 //ʹöд
-    xQueueSendFromISR(uart_Mailbox, &g_uart_rx_rb, &xHigherPriorityTaskWoken);
-#endif
-    
-#if 1 //ʹöֵźȥ
-    xSemaphoreGiveFromISR(uart_Semaphore, &xHigherPriorityTaskWoken);
-#endif
-    
-    // һֽ
-    HAL_UART_Receive_IT(&huart1, &uart_rx_temp, 1);
-}
-#endif 
-
-#if 1 //ʹDMA+жϽյĻصǰʹã
-/**
- * @brief UART+DMAжϻص
- * @param[in] huart UART
- * @param[in] Size DMAǰдλãֽ±꣬0-DMA_RX_BUF_SIZE֮䣩
- * 
- * @note ѵ㣺ѭDMAľ
- *       - ѭDMAд̶СĻдĩβԶصͷ
- *       - ÿжʱSizeʾDMAǰдλ
- *       - ҪͨSizeold_posĲֵ˶
- *       
- * @note 
- *       1. Size > old_posֱȡֵ
- *       2. ƣSize < old_posoldĩβٴ0Size
- */
-void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
-{
-    /* Prevent unused argument(s) compilation warning */
-    UNUSED(huart);
-    UNUSED(Size);
-    
-    uint16_t length;
-    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
-    
-    /* === ֹ󴥷/ظ === */
-    // ǰDMAλúϴͬ˵ûݣֱ˳
-    // ҪԱ⴦
-    if(Size == old_pos){
-        return;
-    }
-
-#if 1
-    /**
-     * @brief ѭDMAȡ㷨
-     * 
-     * Size: DMAǰдλã0DMA_RX_BUF_SIZE֮䣩
-     * old_pos: ϴǴݵλ
-     * 
-     * ӣ
-     * - С256ֽ
-     * - 1old_pos=10, Size=50
-     *   ݣ50-10=40ֽڣ[10, 50)
-     * - 2ƣold_pos=240, Size=30
-     *   ݣ(256-240) + 30 = 46ֽ
-     *   һΣ[240, 256) = 16ֽ
-     *   ڶΣ[0, 30) = 30ֽ
-     */
-    if(Size > old_pos){
-        // 1ֱӼֵ
-        length = Size - old_pos;
-        // DMA[old_pos, Size)д뻷λ
-        for(int i = 0; i < length; i++){
-            RB_Write(&g_uart_rx_rb, dma_rx_buf[old_pos + i]);
-        }
-    }
-    else{
-        // 2ƣDMAд˻ĩβִͷʼ
-        // 磺old_pos=240, Size=30, С=256
-        
-        // һΣold_posĩβ
-        length = DMA_RX_BUF_SIZE - old_pos;
-        for(int i = 0; i < length; i++){
-            RB_Write(&g_uart_rx_rb, dma_rx_buf[old_pos + i]);
-        }
-        
-        // ڶΣӻͷSize
-        for(int i = 0; i < Size; i++){
-            RB_Write(&g_uart_rx_rb, dma_rx_buf[i]);
-        }
-    }
-#endif 
-
-#if 0
-    /**
-     * @brief һ־ƴʹģ㣩
-     * ŵ㣺
-     * ȱ㣺߼ֱ
-     */
-    // ݳȣԶƣ
-    length = Size - old_pos;
-    if(length < 0){
-        length += DMA_RX_BUF_SIZE;
-    }
-    
-    // ѭд룬ȡԶ
-    for(int i = 0; i < length; i++){
-        uint16_t dma_idx = (old_pos + i) % DMA_RX_BUF_SIZE;
-        
-        // Ϲؼ㡿Ƿдʧ
-        if(RB_Write(&g_uart_rx_rb, dma_rx_buf[dma_idx]) == false){
-            // λˣݶʧ
-            g_drop_cnt++;
-        }
-    }
-#endif
-    
-    // λָ룬һжʹ
-    old_pos = Size;
-    
-    // SizeǡõڻС˵DMAպдƻ0
-    // Ϊ˰ȫֶold_pos=0׼һֽ
-    if(old_pos == DMA_RX_BUF_SIZE){
-        old_pos = 0;
-    }
-    
-    // ͷź֪ͨAPPݿɶ
-    xSemaphoreGiveFromISR(uart_Semaphore, &xHigherPriorityTaskWoken);
-    // лиȼ񱻻ѣ
-    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
-}
-#endif
-
-/**
- * @brief UARTص
- * @param[in] huart UART
- * @note ܵĴͣ
- *       - ORE (Overrun Error)ջݶʧ
- *       - NE (Noise Error)ź
- *       - FE (Framing Error)֡ʽֹͣλ쳣
- *       - PE (Parity Error)żУ
- * @note ָԣ
- *       1. ־λ
- *       2. DMA
- *       3. ָ루old_pos
- */
-void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
-{
-    // 1. жǷUSART1жUARTʵ
-    if(huart->Instance == USART1){
-        // 2. DMAչд
-        
-        // 3. ؼDMAʱӲ
-        // ˱ָͬold_pos´μ
-        // ע⣺old_posstaticֻڱļ
-        
-        // 4. UART־λ
-        __HAL_UART_CLEAR_OREFLAG(huart);    // ش־
-        __HAL_UART_CLEAR_NEFLAG(huart);     // ־
-        __HAL_UART_CLEAR_FEFLAG(huart);     // ֡ʽ־
-        __HAL_UART_CLEAR_PEFLAG(huart);     // żУ־
-        
-        // 5. DMAգCPRȷʽ
-        // ע⣺ὫDMAдָõ0
-        HAL_UARTEx_ReceiveToIdle_DMA(huart, dma_rx_buf, DMA_RX_BUF_SIZE);
-        
-        // 6. ؼָͬ
-        // DMAӲָΪ0ָҲΪ0
-        old_pos = 0;
-    }
-}
+#include "bsp_uart_driver.h"
+#include <string.h>
+
+/* USER CODE BEGIN Variables */
+#define LOG_TAG_U "BSP_UART_LOG"
+extern UART_HandleTypeDef huart1;          // UART1句柄（由STM32CubeMX生成）
+extern DMA_HandleTypeDef hdma_usart1_rx;   // DMA接收句柄（由STM32CubeMX生成）
+#if 0 //使用队列传输
+QueueHandle_t uart_Mailbox = NULL;
+#endif 
+#if 1 //使用二值信号量去传输
+SemaphoreHandle_t uart_Semaphore = NULL;   // 二值信号量，用于同步DMA接收完成事件
+#if APP_STATIC_ALLOCATION
+static StaticSemaphore_t uart_Semaphore_cb; // 信号量控制块 (静态分配模式)
+#endif
+#endif
+
+/**
+ * @brief 环形缓冲区实例定义
+ * @note 用途：临时存储DMA接收的数据，供APP任务读取
+ *       大小：4096字节，足以缓存多个数据包
+ */
+#define RX_POOL_SIZE 4096
+static uint8_t uart_rx_pool[RX_POOL_SIZE];       // 环形缓冲区数据池
+static RingBuffer_t g_uart_rx_rb;                // 环形缓冲区实例
+
+/**
+ * @brief DMA接收缓冲区定义
+ * @note DMA直接写入此缓冲区，不经过软件，效率最高
+ *       大小：2048字节，支持循环模式（circular DMA）
+ */
+#define DMA_RX_BUF_SIZE 2048
+static uint8_t dma_rx_buf[DMA_RX_BUF_SIZE];    // DMA原始接收缓冲区
+static uint16_t old_pos = 0;                    // 上一次处理的DMA位置，用于计算新增数据量
+volatile uint32_t g_drop_cnt = 0;              // 丢包计数器（环形缓冲区满时递增）
+
+/**
+ * @brief 接收丢失统计
+ * @note DMA 在后台一直往 dma_rx_buf 里写，中断停顿 (擦 Flash 扇区时 CPU 取指停住) 超过写满一圈的时间
+ *       (2048 字节，115200 波特率约 178ms) 又有数据进来时，没取走的数据可能被覆盖，记一次溢出；
+ *       UART 硬件溢出 (ORE) 也记一次
+ */
+static volatile uint32_t uart_rx_overrun_cnt = 0; // 接收溢出次数
+static volatile uint32_t uart_rx_event_cnt = 0;   // 接收事件回调次数
+static volatile TickType_t uart_rx_tick = 0;      // 最近一次接收事件的 tick
+static uint32_t uart_rx_byte_cycles = 0;          // 收一个字节的 DWT 周期数 (10 位)
+static uint32_t uart_stall_cycle;                 // 停顿开始的时刻
+static uint16_t uart_stall_pos;                   // 停顿开始时 DMA 写到的位置
+static uint32_t uart_stall_events;                // 停顿开始时的接收事件次数
+
+#define UART_TX_TIMEOUT_MS 50                   // 发送等待缓冲区空间的超时时间
+
+/**
+ * @brief DMA 发送乒乓缓冲区
+ * @note 一个缓冲区由 DMA 发送，另一个收集新数据；发送完成中断里交换，
+ *       CPU 只做内存拷贝，从不在 UART 上忙等
+ *       每个缓冲区 512 字节，115200 波特率下约 44ms 发完
+ */
+#define UART_TX_BUF_SIZE 512
+static uint8_t uart_tx_buf[2][UART_TX_BUF_SIZE]; // 乒乓缓冲区
+static uint16_t uart_tx_len[2];                  // 各缓冲区已收集的字节数
+static uint8_t uart_tx_fill = 0;                 // 正在收集数据的缓冲区下标
+
+/**
+ * @brief 发送状态
+ * @note 缓冲区在临界区里交换，HAL_UART_Transmit_DMA 在退出临界区后才调用 (配置 DMA 要几微秒)，
+ *       中间这段是 STARTING：别人不会再启动发送，错误回调也不会把它当成被中止的发送
+ */
+typedef enum
+{
+    UART_TX_IDLE = 0,                            // DMA 空闲
+    UART_TX_STARTING,                            // 已交换缓冲区，正在启动 DMA
+    UART_TX_BUSY,                                // DMA 正在发送另一个缓冲区
+} UART_TxState_t;
+static volatile UART_TxState_t uart_tx_state = UART_TX_IDLE;
+static volatile uint32_t uart_tx_drop_cnt = 0;   // 因缓冲区满丢弃的次数
+static volatile uint32_t uart_tx_drop_bytes = 0; // 因缓冲区满丢弃的字节数
+static SemaphoreHandle_t uart_tx_sem = NULL;     // 发送完成时释放，用于等待缓冲区空间 (背压)
+static StaticSemaphore_t uart_tx_sem_cb;
+
+/**
+ * @brief 接收链路延迟测量的时间戳 (DWT 周期数)
+ * @note 进入中断时记录 isr，释放信号量时把它和 give 一起锁存，
+ *       解析任务被唤醒后通过 BSP_UART_GetRxStamp 取走，用于统计中断到任务的延迟
+ */
+static volatile uint32_t uart_isr_cycle;        // 最近一次进入 USART1/DMA 中断的时刻
+static volatile uint32_t uart_stamp_isr;        // 释放信号量时锁存的中断进入时刻
+static volatile uint32_t uart_stamp_give;       // 释放信号量的时刻
+static volatile bool uart_stamp_valid = false;  // 时间戳是否尚未被任务取走
+
+/* USER CODE END Variables */
+
+/**
+ * @brief UART和DMA初始化函数
+ * @note 工作流程：
+ *       1. 初始化环形缓冲区
+ *       2. 创建FreeRTOS同步原语（信号量或队列）
+ *       3. 启动DMA接收+空闲中断模式
+ * @note 同步机制选择：
+ *       - 队列方案：单字节接收，开销大，已禁用
+ *       - 信号量方案：批量接收，效率高，当前使用
+ */
+void BSP_UART_Init(void)
+{
+    uart_rx_byte_cycles = SystemCoreClock / (huart1.Init.BaudRate / 10);
+
+    // 发送完成信号量，静态创建，日志输出任务在缓冲区满时等待它
+    uart_tx_sem = xSemaphoreCreateBinaryStatic(&uart_tx_sem_cb);
+
+    // 初始化环形缓冲区，为后续数据缓存做准备
+    RB_Init(&g_uart_rx_rb, uart_rx_pool, RX_POOL_SIZE);
+    
+#if 0 //创建队列传输（已禁用）
+    /* USER CODE BEGIN RTOS_QUEUES */
+    /* add queues, ... */
+    //queue 1
+    uart_Mailbox = NULL;
+    uart_Mailbox = xQueueCreate(1, 4);
+    /* USER CODE END RTOS_QUEUES */
+    if(uart_Mailbox == NULL){
+        elog_i(LOG_TAG_U, "uart_Mailbox create failed");
+    }
+    else{
+        elog_i(LOG_TAG_U, "uart_Mailbox create success");
+    }
+#endif 
+
+#if 1 //创建二值信号量去传输（当前使用）
+    // 创建二值信号量，用于同步DMA接收完成事件
+#if APP_STATIC_ALLOCATION
+    uart_Semaphore = xSemaphoreCreateBinaryStatic(&uart_Semaphore_cb);
+#else
+    uart_Semaphore = xSemaphoreCreateBinary();
+#endif
+    if(NULL == uart_Semaphore){
+        elog_i(LOG_TAG_U, "uart_Semaphore create failed");
+    }else{
+        elog_i(LOG_TAG_U, "uart_Semaphore create success");
+    }
+    // 初始化DMA位置指针，供后续卷绕处理使用
+    old_pos = 0;
+#endif 
+
+#if 0 //启动中断接收(没有使用DMA，已禁用)
+    // 单字节中断接收方式，已被DMA方案替代
+    if(HAL_OK == HAL_UART_Receive_IT(&huart1, &uart_rx_temp, 1)){
+        elog_i(LOG_TAG_U, "HAL_UART_Receive_IT success");
+    }
+    else{
+        elog_i(LOG_TAG_U, "HAL_UART_Receive_IT failed");
+    }
+#endif    
+
+#if 1 //启动DMA+空闲中断接收（当前使用）
+    // HAL_UARTEx_ReceiveToIdle_DMA：
+    // - ReceiveToIdle：在接收到UART空闲信号时触发中断（数据停止传输时）
+    // - DMA：使用DMA自动接收，不占用CPU
+    // 这个组合方案既保证了实时性，也提高了CPU效率
+    if(HAL_OK == HAL_UARTEx_ReceiveToIdle_DMA(&huart1, dma_rx_buf, DMA_RX_BUF_SIZE)){
+        elog_i(LOG_TAG_U, "HAL_UARTEx_ReceiveToIdle_DMA success");
+    }
+    else{
+        elog_i(LOG_TAG_U, "HAL_UARTEx_ReceiveToIdle_DMA failed");
+    }
+#endif 
+}
+
+/**
+ * @brief UART数据读取函数
+ * @param[out] data 存储读取数据的缓冲区
+ * @param[in] len 请求读取的最大字节数
+ * @return 实际读取的字节数（可能小于len，因为环形缓冲区可能没有那么多数据）
+ * @note 工作流程：
+ *       1. 从环形缓冲区逐字节读取
+ *       2. 如果缓冲区中数据不足len字节，则返回实际读取的数量
+ */
+uint32_t BSP_UART_Read(uint8_t *data, uint32_t len)
+{
+    uint32_t read_len = 0;
+    // 逐字节从环形缓冲区读取，直到缓冲区空或达到请求长度
+    while(read_len < len){
+        if(true == RB_Read(&g_uart_rx_rb, &data[read_len])){
+            read_len++;
+        }
+        else{
+            // 缓冲区已读完，返回已读的字节数
+            break;
+        }
+    }
+    return read_len;
+}
+
+/**
+ * @brief 取出要发送的缓冲区 (调用者必须处于临界区)
+ * @param[out] len 要发送的字节数
+ * @return 要发送的缓冲区，NULL - DMA 不空闲或没有数据
+ * @note DMA 空闲且有数据时交换缓冲区并进入 STARTING，退出临界区后交给 UART_TxStart
+ */
+static uint8_t *UART_TxTake(uint16_t *len)
+{
+    uint8_t *buf;
+
+    if(UART_TX_IDLE != uart_tx_state || 0 == uart_tx_len[uart_tx_fill]){
+        return NULL;
+    }
+    buf = uart_tx_buf[uart_tx_fill];
+    *len = uart_tx_len[uart_tx_fill];
+    uart_tx_state = UART_TX_STARTING;
+    uart_tx_fill ^= 1;
+    uart_tx_len[uart_tx_fill] = 0;
+    return buf;
+}
+
+/**
+ * @brief 启动 DMA 发送 UART_TxTake 取出的缓冲区 (不在临界区内调用)
+ * @param[in] buf 要发送的缓冲区，NULL 时什么都不做
+ * @param[in] len 要发送的字节数
+ * @note 启动失败时 (UART 正在错误处理) 这个缓冲区丢弃并计数
+ */
+static void UART_TxStart(uint8_t *buf, uint16_t len)
+{
+    HAL_StatusTypeDef status;
+    UBaseType_t saved;
+
+    if(NULL == buf){
+        return;
+    }
+    status = HAL_UART_Transmit_DMA(&huart1, buf, len);
+
+    saved = taskENTER_CRITICAL_FROM_ISR();
+    if(HAL_OK != status){
+        uart_tx_state = UART_TX_IDLE;
+        uart_tx_drop_cnt++;
+        uart_tx_drop_bytes += len;
+    }else if(UART_TX_STARTING == uart_tx_state){
+        // 短数据可能在这之前就发完了，发送完成回调已经把状态改掉
+        uart_tx_state = UART_TX_BUSY;
+    }
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+}
+
+/**
+ * @brief 判断当前上下文能否阻塞等待
+ * @return true - 调度器运行中、且不在临界区内的任务上下文
+ */
+static bool UART_TxCanWait(void)
+{
+    return (NULL != uart_tx_sem) && !xPortIsInsideInterrupt() && (0 == __get_BASEPRI())
+        && (taskSCHEDULER_RUNNING == xTaskGetSchedulerState());
+}
+
+/**
+ * @brief UART 数据发送函数 (DMA 乒乓缓冲，非阻塞)
+ * @param[in] data 待发送的数据
+ * @param[in] len 数据长度 (不超过 UART_TX_BUF_SIZE)
+ * @param[in] timeout_ms 缓冲区满时最多等待的时间，中断中调用时不等待
+ * @return true - 已放入发送缓冲区, false - 缓冲区满被丢弃
+ * @note 工作流程：
+ *       1. 在临界区中把数据整段拷贝进正在收集的缓冲区，空间不够就整段不放，
+ *          保证一行日志或一个二进制帧不会被截断或与其他数据交织
+ *       2. DMA 空闲时交换缓冲区，退出临界区后启动发送；否则由发送完成中断接着发
+ *       3. 空间不够时任务可以等待发送完成 (背压)，超时或在中断中则丢弃并计数
+ */
+bool BSP_UART_Write(const uint8_t *data, uint16_t len, uint32_t timeout_ms)
+{
+    bool can_wait = UART_TxCanWait();
+    TickType_t start = 0;
+    TickType_t wait = pdMS_TO_TICKS(timeout_ms);
+    TickType_t passed;
+    UBaseType_t saved;
+    uint8_t *tx_buf;
+    uint16_t tx_len = 0;
+
+    if(NULL == data || 0 == len){
+        return false;
+    }
+    if(can_wait){
+        // 中断里不读 tick (xTaskGetTickCount 不能在中断中调用)，也不等待
+        start = xTaskGetTickCount();
+    }
+    if(len <= UART_TX_BUF_SIZE){
+        for(;;){
+            saved = taskENTER_CRITICAL_FROM_ISR();
+            if(UART_TX_BUF_SIZE - uart_tx_len[uart_tx_fill] >= len){
+                memcpy(&uart_tx_buf[uart_tx_fill][uart_tx_len[uart_tx_fill]], data, len);
+                uart_tx_len[uart_tx_fill] += len;
+                tx_buf = UART_TxTake(&tx_len);
+                taskEXIT_CRITICAL_FROM_ISR(saved);
+                UART_TxStart(tx_buf, tx_len);
+                return true;
+            }
+            taskEXIT_CRITICAL_FROM_ISR(saved);
+
+            if(!can_wait){
+                break;
+            }
+            passed = xTaskGetTickCount() - start;
+            if(passed >= wait){
+                break;
+            }
+            // 等待下一次发送完成，腾出一个缓冲区后重试
+            xSemaphoreTake(uart_tx_sem, wait - passed);
+        }
+    }
+
+    saved = taskENTER_CRITICAL_FROM_ISR();
+    uart_tx_drop_cnt++;
+    uart_tx_drop_bytes += len;
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+    return false;
+}
+
+/**
+ * @brief UART数据发送函数（等待缓冲区空间）
+ * @param[in] data 待发送的数据
+ * @param[in] len 数据长度
+ * @return true - 已放入发送缓冲区, false - 超时
+ * @note 与日志共用 DMA 发送缓冲区，整帧放入，不会与日志交织
+ */
+bool BSP_UART_Send(const uint8_t *data, uint16_t len)
+{
+    return BSP_UART_Write(data, len, UART_TX_TIMEOUT_MS);
+}
+
+/**
+ * @brief 获取发送丢弃统计
+ * @param[out] drop_cnt 丢弃次数
+ * @param[out] drop_bytes 丢弃字节数
+ */
+void BSP_UART_GetTxDrop(uint32_t *drop_cnt, uint32_t *drop_bytes)
+{
+    *drop_cnt = uart_tx_drop_cnt;
+    *drop_bytes = uart_tx_drop_bytes;
+}
+
+/**
+ * @brief 记录进入UART接收相关中断的时刻
+ * @note 在 stm32f4xx_it.c 的 USART1/DMA2_Stream2 中断入口调用，要尽量短
+ */
+void BSP_UART_MarkIsrEntry(void)
+{
+    uart_isr_cycle = BSP_DWT_GetCycle();
+}
+
+/**
+ * @brief 取走最近一次释放信号量时锁存的时间戳
+ * @param[out] isr_cycle 进入中断的时刻
+ * @param[out] give_cycle 释放信号量的时刻
+ * @return true - 有新的时间戳, false - 自上次读取后没有新的释放
+ */
+bool BSP_UART_GetRxStamp(uint32_t *isr_cycle, uint32_t *give_cycle)
+{
+    bool valid;
+
+    taskENTER_CRITICAL();
+    valid = uart_stamp_valid;
+    *isr_cycle = uart_stamp_isr;
+    *give_cycle = uart_stamp_give;
+    uart_stamp_valid = false;
+    taskEXIT_CRITICAL();
+
+    return valid;
+}
+
+/**
+ * @brief DMA 当前写到的位置 (0 ~ DMA_RX_BUF_SIZE-1)
+ */
+static uint16_t UART_RxDmaPos(void)
+{
+    uint16_t pos = (uint16_t)(DMA_RX_BUF_SIZE - __HAL_DMA_GET_COUNTER(&hdma_usart1_rx));
+
+    return (pos >= DMA_RX_BUF_SIZE) ? 0 : pos;
+}
+
+/**
+ * @brief 接收线路是否空闲
+ * @param[in] idle_ms 至少空闲多久
+ * @return true - DMA 里没有未处理的数据，且最近 idle_ms 内没有接收事件
+ * @note Flash 日志擦扇区前用它等上位机停止发送，见 elog_flash_port_erase
+ */
+bool BSP_UART_RxIdle(uint32_t idle_ms)
+{
+    bool idle;
+
+    taskENTER_CRITICAL();
+    idle = (UART_RxDmaPos() == old_pos) && ((xTaskGetTickCount() - uart_rx_tick) >= pdMS_TO_TICKS(idle_ms));
+    taskEXIT_CRITICAL();
+
+    return idle;
+}
+
+/**
+ * @brief 标记接收中断将要停顿 (擦 Flash 扇区之前调用)
+ */
+void BSP_UART_RxStallBegin(void)
+{
+    UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+
+    uart_stall_cycle = BSP_DWT_GetCycle();
+    uart_stall_pos = UART_RxDmaPos();
+    uart_stall_events = uart_rx_event_cnt;
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+}
+
+/**
+ * @brief 停顿结束 (擦完 Flash 扇区之后调用)，判断 DMA 缓冲区是否可能被覆盖
+ * @note 调度器启动前 (上电恢复 Flash 日志时) 也会调用，所以临界区用 FROM_ISR 版本，不动嵌套计数
+ * @note 停顿短于写满一圈的时间时一定没有丢失；超过时只要这期间收到过数据就记一次溢出
+ *       (停顿一结束中断就先处理了积压的数据，所以同时看事件次数，正好收满整圈时位置不变)
+ */
+void BSP_UART_RxStallEnd(void)
+{
+    UBaseType_t saved;
+    uint32_t elapsed;
+    bool arrived;
+
+    saved = taskENTER_CRITICAL_FROM_ISR();
+    elapsed = BSP_DWT_GetCycle() - uart_stall_cycle;
+    arrived = (UART_RxDmaPos() != uart_stall_pos) || (uart_rx_event_cnt != uart_stall_events);
+    if(arrived && elapsed >= DMA_RX_BUF_SIZE * uart_rx_byte_cycles){
+        uart_rx_overrun_cnt++;
+    }
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+}
+
+/**
+ * @brief 获取接收丢失统计
+ * @param[out] overrun_cnt 溢出次数 (中断停顿时 DMA 缓冲区可能被覆盖 + UART 硬件溢出)
+ * @param[out] drop_bytes 环形缓冲区满丢弃的字节数
+ */
+void BSP_UART_GetRxLoss(uint32_t *overrun_cnt, uint32_t *drop_bytes)
+{
+    *overrun_cnt = uart_rx_overrun_cnt;
+    *drop_bytes = g_drop_cnt;
+}
+
+#if 0 //使用单字节中断接收的回调函数（已禁用）
+/**
+ * @brief UART接收完成中断回调（单字节模式，已禁用）
+ * @note 单字节中断方案的问题：
+ *       1. 每接收一个字节就触发一次中断，开销大
+ *       2. 不适合高速、批量数据接收
+ *       已被DMA+空闲中断方案替代
+ */
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
+{
+    /* Prevent unused argument(s) compilation warning */
+    UNUSED(huart);
+    
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    // 将接收到的单字节写入环形缓冲区
+    RB_Write(&g_uart_rx_rb, uart_rx_temp);
+    
+#if 0 //使用队列传输
+    xQueueSendFromISR(uart_Mailbox, &g_uart_rx_rb, &xHigherPriorityTaskWoken);
+#endif
+    
+#if 1 //使用二值信号量去传输
+    xSemaphoreGiveFromISR(uart_Semaphore, &xHigherPriorityTaskWoken);
+#endif
+    
+    // 继续接收下一个字节
+    HAL_UART_Receive_IT(&huart1, &uart_rx_temp, 1);
+}
+#endif 
+
+#if 1 //使用DMA+空闲中断接收的回调函数（当前使用）
+/**
+ * @brief UART空闲+DMA接收完成中断回调
+ * @param[in] huart UART句柄
+ * @param[in] Size DMA当前写入位置（字节下标，0-DMA_RX_BUF_SIZE之间）
+ * 
+ * @note 核心难点：处理循环DMA的卷绕
+ *       - 循环DMA持续写入固定大小的缓冲区，写到末尾后自动回到开头
+ *       - 每次中断时Size表示DMA当前写到的位置
+ *       - 需要通过Size和old_pos的差值计算出新增了多少数据
+ *       
+ * @note 两种数据增长情况：
+ *       1. 正常线性增长：Size > old_pos（直接取差值）
+ *       2. 发生卷绕：Size < old_pos（从old到缓冲区末尾，再从0到Size）
+ */
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
+{
+    /* Prevent unused argument(s) compilation warning */
+    UNUSED(huart);
+    UNUSED(Size);
+    
+    uint16_t length;
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    
+    /* === 防止误触发/重复触发 === */
+    // 如果当前DMA位置和上次相同，说明没有新数据，直接退出
+    // 这个检查很重要，可以避免处理空数据
+    if(Size == old_pos){
+        return;
+    }
+
+#if 1
+    /**
+     * @brief 循环DMA数据提取核心算法
+     * 
+     * Size: DMA当前写入位置（0到DMA_RX_BUF_SIZE之间）
+     * old_pos: 上次我们处理完数据的位置
+     * 
+     * 例子：
+     * - 缓冲区大小：256字节
+     * - 情况1（正常）：old_pos=10, Size=50
+     *   新增数据：50-10=40字节，在[10, 50)区间
+     * - 情况2（卷绕）：old_pos=240, Size=30
+     *   新增数据：(256-240) + 30 = 46字节
+     *   第一段：[240, 256) = 16字节
+     *   第二段：[0, 30) = 30字节
+     */
+    if(Size > old_pos){
+        // 情况1：正常线性增长，直接计算差值
+        length = Size - old_pos;
+        // 将DMA缓冲区中[old_pos, Size)的数据写入环形缓冲区
+        for(int i = 0; i < length; i++){
+            if(!RB_Write(&g_uart_rx_rb, dma_rx_buf[old_pos + i])){
+                g_drop_cnt++;
+            }
+        }
+    }
+    else{
+        // 情况2：发生卷绕，DMA写到了缓冲区末尾，又从头开始
+        // 例如：old_pos=240, Size=30, 缓冲区大小=256
+        
+        // 第一段：从old_pos到缓冲区末尾
+        length = DMA_RX_BUF_SIZE - old_pos;
+        for(int i = 0; i < length; i++){
+            if(!RB_Write(&g_uart_rx_rb, dma_rx_buf[old_pos + i])){
+                g_drop_cnt++;
+            }
+        }
+        
+        // 第二段：从缓冲区开头到Size
+        for(int i = 0; i < Size; i++){
+            if(!RB_Write(&g_uart_rx_rb, dma_rx_buf[i])){
+                g_drop_cnt++;
+            }
+        }
+    }
+#endif 
+
+#if 0
+    /**
+     * @brief 另一种卷绕处理方法（使用模运算）
+     * 优点：代码更简洁
+     * 缺点：逻辑不如分情况讨论直观
+     */
+    // 计算新增数据长度（自动处理卷绕）
+    length = Size - old_pos;
+    if(length < 0){
+        length += DMA_RX_BUF_SIZE;
+    }
+    
+    // 循环写入，取余操作自动处理回绕
+    for(int i = 0; i < length; i++){
+        uint16_t dma_idx = (old_pos + i) % DMA_RX_BUF_SIZE;
+        
+        // 【诊断关键点】检查是否写入失败
+        if(RB_Write(&g_uart_rx_rb, dma_rx_buf[dma_idx]) == false){
+            // 环形缓冲区满了，数据丢失，计数器递增
+            g_drop_cnt++;
+        }
+    }
+#endif
+    
+    // 更新位置指针，供下一次中断使用
+    old_pos = Size;
+    
+    // 如果Size恰好等于缓冲区大小，说明DMA刚好写满并卷绕回0
+    // 为了安全起见，手动设置old_pos=0，准备下一轮接收
+    if(old_pos == DMA_RX_BUF_SIZE){
+        old_pos = 0;
+    }
+    
+    // 线路空闲判断和停顿溢出判断用
+    uart_rx_event_cnt++;
+    uart_rx_tick = xTaskGetTickCountFromISR();
+
+    // 锁存时间戳供延迟统计使用 (任务还没取走上一组时直接覆盖，只测量最近一次)
+    uart_stamp_isr = uart_isr_cycle;
+    uart_stamp_give = BSP_DWT_GetCycle();
+    uart_stamp_valid = true;
+
+    // 释放信号量，通知APP任务有数据可读
+    xSemaphoreGiveFromISR(uart_Semaphore, &xHigherPriorityTaskWoken);
+    // 触发上文文切换（如果有更高优先级任务被唤醒）
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+#endif
+
+/**
+ * @brief UART DMA 发送完成回调
+ * @param[in] huart UART句柄
+ * @note 另一个缓冲区已收集到数据时立即接着发送，然后通知等待空间的任务
+ */
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    UBaseType_t saved;
+    uint8_t *tx_buf;
+    uint16_t tx_len = 0;
+
+    if(huart->Instance != USART1){
+        return;
+    }
+    saved = taskENTER_CRITICAL_FROM_ISR();
+    uart_tx_state = UART_TX_IDLE;
+    tx_buf = UART_TxTake(&tx_len);
+    taskEXIT_CRITICAL_FROM_ISR(saved);
+    UART_TxStart(tx_buf, tx_len);
+
+    if(NULL != uart_tx_sem){
+        xSemaphoreGiveFromISR(uart_tx_sem, &xHigherPriorityTaskWoken);
+    }
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+}
+
+/**
+ * @brief UART错误回调函数
+ * @param[in] huart UART句柄
+ * @note 可能的错误类型：
+ *       - ORE (Overrun Error)：接收缓冲区溢出，数据丢失
+ *       - NE (Noise Error)：信号线噪声错误
+ *       - FE (Framing Error)：帧格式错误（停止位异常）
+ *       - PE (Parity Error)：奇偶校验错误
+ * @note 错误恢复策略：
+ *       1. 清除错误标志位
+ *       2. 重新启动DMA接收
+ *       3. 重置软件指针（old_pos）
+ */
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+    // 1. 判断是否是USART1（可能有多个UART实例）
+    if(huart->Instance == USART1){
+        // 2. 仅在DMA接收过程中处理错误
+        
+        // 3. 【关键】重启DMA时硬件计数器会归零
+        // 因此必须同步重置软件指针old_pos，否则下次计算会出错
+        // 注意：old_pos是static变量，只能在本文件访问
+        
+        // 4. 清除各种UART错误标志位，过载错误先计入接收丢失统计 (LOG命令查看)
+        if(0 != (huart->ErrorCode & HAL_UART_ERROR_ORE)){
+            uart_rx_overrun_cnt++;
+        }
+        __HAL_UART_CLEAR_OREFLAG(huart);    // 清除过载错误标志
+        __HAL_UART_CLEAR_NEFLAG(huart);     // 清除噪声错误标志
+        __HAL_UART_CLEAR_FEFLAG(huart);     // 清除帧格式错误标志
+        __HAL_UART_CLEAR_PEFLAG(huart);     // 清除奇偶校验错误标志
+        
+        // 5. 暴力重启DMA接收（CPR急救方式）
+        // 注意：这会将DMA写指针重置到0
+        HAL_UARTEx_ReceiveToIdle_DMA(huart, dma_rx_buf, DMA_RX_BUF_SIZE);
+        
+        // 6. 关键：同步重置软件指针
+        // 由于DMA已重启，硬件指针变为0，软件指针也必须变为0
+        old_pos = 0;
+
+        // 7. 发送被错误中止时 (gState 已回到 READY)，丢掉正在发送的缓冲区，接着发下一个
+        //    STARTING 时 DMA 还没启动，由启动它的上下文处理
+        if(UART_TX_BUSY == uart_tx_state && HAL_UART_STATE_READY == huart->gState){
+            UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+            uint8_t *tx_buf;
+            uint16_t tx_len = 0;
+
+            uart_tx_state = UART_TX_IDLE;
+            tx_buf = UART_TxTake(&tx_len);
+            taskEXIT_CRITICAL_FROM_ISR(saved);
+            UART_TxStart(tx_buf, tx_len);
+        }
+    }
+}
@@ -1,22 +1,33 @@
-#ifndef __BSP_UART_DRIVER_H__
-#define __BSP_UART_DRIVER_H__
-
-#include <stdint.h>
-#include "FreeRTOS.h"
-#include <stdint.h>
-#include "cmsis_os.h"
-#include "elog.h"
-#include "usart.h"
-#include "semphr.h"
-#include "ring_buffer.h"
-/* USER CODE BEGIN Variables */
-
-/* USER CODE END Variables */
-void BSP_UART_Init(void);
-uint32_t BSP_UART_Read(uint8_t *data ,uint32_t len);
-
-
-
-
-#endif //end __BSP_UART_DRIVER_H__
-
+#ifndef __BSP_UART_DRIVER_H__
+#define __BSP_UART_DRIVER_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "FreeRTOS.h"
+#include <stdint.h>
+#include "cmsis_os.h"
+#include "elog.h"
+#include "usart.h"
+#include "semphr.h"
+#include "ring_buffer.h"
+#include "bsp_dwt.h"
+/* USER CODE BEGIN Variables */
+
+/* USER CODE END Variables */
+void BSP_UART_Init(void);
+uint32_t BSP_UART_Read(uint8_t *data ,uint32_t len);
+bool BSP_UART_Send(const uint8_t *data, uint16_t len);
+bool BSP_UART_Write(const uint8_t *data, uint16_t len, uint32_t timeout_ms);
+void BSP_UART_GetTxDrop(uint32_t *drop_cnt, uint32_t *drop_bytes);
+void BSP_UART_MarkIsrEntry(void);
+bool BSP_UART_GetRxStamp(uint32_t *isr_cycle, uint32_t *give_cycle);
+bool BSP_UART_RxIdle(uint32_t idle_ms);
+void BSP_UART_RxStallBegin(void);
+void BSP_UART_RxStallEnd(void);
+void BSP_UART_GetRxLoss(uint32_t *overrun_cnt, uint32_t *drop_bytes);
+
+
+
+
+#endif //end __BSP_UART_DRIVER_H__
+
@@ -1,179 +1,257 @@
-/* USER CODE BEGIN Header */
-/**
- ******************************************************************************
- * File Name          : freertos.c
- * Description        : Code for freertos applications
- ******************************************************************************
- * @attention
- *
- * Copyright (c) 2025 STMicroelectronics.
- * All rights reserved.
- *
- * This software is licensed under terms that can be found in the LICENSE file
- * in the root directory of this software component.
- * If no LICENSE file comes with this software, it is provided AS-IS.
- *
- ******************************************************************************
- */
-/* USER CODE END Header */
-
-/* Includes ------------------------------------------------------------------*/
-#include "FreeRTOS.h"
-#include "task.h"
-#include "main.h"
-#include "cmsis_os.h"
-
-/* Private includes ----------------------------------------------------------*/
-/* USER CODE BEGIN Includes */
-#include "elog.h"
-#include "app_usart_task.h"
-/* USER CODE END Includes */
-
-/* Private typedef -----------------------------------------------------------*/
-/* USER CODE BEGIN PTD */
-#define LOG_TAG_D "Default_LOG"
-
-/* USER CODE END PTD */
-
-/* Private define ------------------------------------------------------------*/
-/* USER CODE BEGIN PD */
-
-/* USER CODE END PD */
-
-/* Private macro -------------------------------------------------------------*/
-/* USER CODE BEGIN PM */
-
-/* USER CODE END PM */
-
-/* Private variables ---------------------------------------------------------*/
-/* USER CODE BEGIN Variables */
-osThreadId_t uartparseTaskHandle;
-const osThreadAttr_t uartparseTask_attributes = {
-    .name = "uartparseTask",
-    .stack_size = 512 * 4,
-    .priority = (osPriority_t)osPriorityNormal,
-};
-volatile uint8_t g_cpu_load_enable = 0;
-/* USER CODE END Variables */
-/* Definitions for defaultTask */
-osThreadId_t defaultTaskHandle;
-const osThreadAttr_t defaultTask_attributes = {
-    .name = "defaultTask",
-    .stack_size = 256 * 4,
-    .priority = (osPriority_t)osPriorityNormal,
-};
-
-/* Private function prototypes -----------------------------------------------*/
-/* USER CODE BEGIN FunctionPrototypes */
-
-/* USER CODE END FunctionPrototypes */
-
-void StartDefaultTask(void *argument);
-
-void MX_FREERTOS_Init(void); /* (MISRA C 2004 rule 8.1) */
-
-/* Hook prototypes */
-void configureTimerForRunTimeStats(void);
-unsigned long getRunTimeCounterValue(void);
-
-/* USER CODE BEGIN 1 */
-/* Functions needed when configGENERATE_RUN_TIME_STATS is on */
-__weak void configureTimerForRunTimeStats(void)
-{
-}
-
-__weak unsigned long getRunTimeCounterValue(void)
-{
-  return 0;
-}
-/* USER CODE END 1 */
-
-/**
- * @brief  FreeRTOS initialization
- * @param  None
- * @retval None
- */
-void MX_FREERTOS_Init(void)
-{
-  /* USER CODE BEGIN Init */
-  elog_init();
-  elog_set_fmt(ELOG_LVL_INFO, ELOG_FMT_TAG | ELOG_FMT_TIME | ELOG_FMT_DIR);
-  elog_set_fmt(ELOG_LVL_WARN, ELOG_FMT_TAG | ELOG_FMT_TIME | ELOG_FMT_DIR);
-  elog_start();
-  /* USER CODE END Init */
-
-  /* USER CODE BEGIN RTOS_MUTEX */
-  /* add mutexes, ... */
-  /* USER CODE END RTOS_MUTEX */
-
-  /* USER CODE BEGIN RTOS_SEMAPHORES */
-  /* add semaphores, ... */
-  /* USER CODE END RTOS_SEMAPHORES */
-
-  /* USER CODE BEGIN RTOS_TIMERS */
-  /* start timers, add new ones, ... */
-  /* USER CODE END RTOS_TIMERS */
-
-  /* USER CODE BEGIN RTOS_QUEUES */
-  /* add queues, ... */
-
-  /* USER CODE END RTOS_QUEUES */
-
-  /* Create the thread(s) */
-  /* creation of defaultTask */
-  defaultTaskHandle = osThreadNew(StartDefaultTask, NULL, &defaultTask_attributes);
-
-  /* USER CODE BEGIN RTOS_THREADS */
-  /* add threads, ... */
-  uartparseTaskHandle = osThreadNew(UartParseTask, NULL, &uartparseTask_attributes);
-  /* USER CODE END RTOS_THREADS */
-
-  /* USER CODE BEGIN RTOS_EVENTS */
-  /* add events, ... */
-  /* USER CODE END RTOS_EVENTS */
-}
-
-/* USER CODE BEGIN Header_StartDefaultTask */
-/**
- * @brief  Function implementing the defaultTask thread.
- * @param  argument: Not used
- * @retval None
- */
-/* USER CODE END Header_StartDefaultTask */
-void StartDefaultTask(void *argument)
-{
-  /* USER CODE BEGIN StartDefaultTask */
-  TickType_t startTick = xTaskGetTickCount();
-  elog_i(LOG_TAG_D, "[%lu]StartDefaultTask success", startTick);
-
-  /* Infinite loop */
-  for (;;)
-  {
-    if (g_cpu_load_enable == 1)
-    {
-      // --- ģ߸ ---
-      // ִһЩļ CPU ʱ
-      // ִѭó CPUֱʱƬ
-      uint32_t i;
-      for (i = 0; i < 500000; i++)
-      {
-        __NOP(); // ָ
-      }
-      // ΢Ϣһ£1msֹ CLI 񳹵׶
-      // Ļᶼûˣ
-      osDelay(1);
-    }
-    else
-    {
-      // --- ģʽ (͸) ---
-      // 󲿷ʱ䶼˯
-      osDelay(100);
-    }
-  }
-  /* USER CODE END StartDefaultTask */
-}
-
-/* Private application code --------------------------------------------------*/
-/* USER CODE BEGIN Application */
-
-/* USER CODE END Application */
+/* USER CODE BEGIN Header */
+/**
+ ******************************************************************************
+ * File Name          : freertos.c
+ * Description        : Code for freertos applications
+ ******************************************************************************
+ * @attention
+ *
+ * Copyright (c) 2025 STMicroelectronics.
+ * All rights reserved.
+ *
+ * This software is licensed under terms that can be found in the LICENSE file
+ * in the root directory of this software component.
+ * If no LICENSE file comes with this software, it is provided AS-IS.
+ *
+ ******************************************************************************
+ */
+/* USER CODE END Header */
+
+/* Includes ------------------------------------------------------------------*/
+#include "FreeRTOS.h"
+#include "task.h"
+#include "main.h"
+#include "cmsis_os.h"
+
+/* Private includes ----------------------------------------------------------*/
+/* USER CODE BEGIN Includes */
+#include "timers.h"
+#include "elog.h"
+#include "app_crash_log.h"
+#include "app_usart_task.h"
+#include "app_runtime_stats.h"
+#include "app_profiler.h"
+#include "app_stack_monitor.h"
+#include "app_power.h"
+#include "bsp_mcu_inter_temperature.h"
+/* USER CODE END Includes */
+
+/* Private typedef -----------------------------------------------------------*/
+/* USER CODE BEGIN PTD */
+#define LOG_TAG_D "Default_LOG"
+typedef StaticTask_t osStaticThreadDef_t;
+
+/* USER CODE END PTD */
+
+/* Private define ------------------------------------------------------------*/
+/* USER CODE BEGIN PD */
+#define MONITOR_SAMPLE_MS PROF_SAMPLE_MS // 系统监控采样周期 (ms)，必须远小于运行时间计数的卷绕时间
+#define STACK_SAMPLE_MS 1000            // 栈高水位采样周期 (ms)，需为 MONITOR_SAMPLE_MS 的整数倍
+#define LOG_REPORT_MS 1000              // 日志限流/重复折叠统计的上报周期 (ms)，需为 MONITOR_SAMPLE_MS 的整数倍
+/* USER CODE END PD */
+
+/* Private macro -------------------------------------------------------------*/
+/* USER CODE BEGIN PM */
+
+/* USER CODE END PM */
+
+/* Private variables ---------------------------------------------------------*/
+/* USER CODE BEGIN Variables */
+osThreadId_t uartparseTaskHandle;
+#if APP_STATIC_ALLOCATION
+static uint32_t uartparseTaskBuffer[512];
+static osStaticThreadDef_t uartparseTaskControlBlock;
+#endif
+const osThreadAttr_t uartparseTask_attributes = {
+    .name = "uartparseTask",
+#if APP_STATIC_ALLOCATION
+    .cb_mem = &uartparseTaskControlBlock,
+    .cb_size = sizeof(uartparseTaskControlBlock),
+    .stack_mem = &uartparseTaskBuffer[0],
+#endif
+    .stack_size = 512 * 4,
+    .priority = (osPriority_t)osPriorityNormal,
+};
+volatile uint8_t g_cpu_load_enable = 0;
+TimerHandle_t monitorTimerHandle;
+#if APP_STATIC_ALLOCATION
+static StaticTimer_t monitorTimerControlBlock;
+#endif
+/* USER CODE END Variables */
+/* Definitions for defaultTask */
+osThreadId_t defaultTaskHandle;
+#if APP_STATIC_ALLOCATION
+static uint32_t defaultTaskBuffer[256];
+static osStaticThreadDef_t defaultTaskControlBlock;
+#endif
+const osThreadAttr_t defaultTask_attributes = {
+    .name = "defaultTask",
+#if APP_STATIC_ALLOCATION
+    .cb_mem = &defaultTaskControlBlock,
+    .cb_size = sizeof(defaultTaskControlBlock),
+    .stack_mem = &defaultTaskBuffer[0],
+#endif
+    .stack_size = 256 * 4,
+    .priority = (osPriority_t)osPriorityNormal,
+};
+
+/* Private function prototypes -----------------------------------------------*/
+/* USER CODE BEGIN FunctionPrototypes */
+void MonitorTimer_Callback(TimerHandle_t timer);
+/* USER CODE END FunctionPrototypes */
+
+void StartDefaultTask(void *argument);
+
+void MX_FREERTOS_Init(void); /* (MISRA C 2004 rule 8.1) */
+
+/* Hook prototypes */
+void configureTimerForRunTimeStats(void);
+unsigned long getRunTimeCounterValue(void);
+
+/* USER CODE BEGIN 1 */
+/* Functions needed when configGENERATE_RUN_TIME_STATS is on */
+__weak void configureTimerForRunTimeStats(void)
+{
+}
+
+__weak unsigned long getRunTimeCounterValue(void)
+{
+  return 0;
+}
+/* USER CODE END 1 */
+
+/**
+ * @brief  FreeRTOS initialization
+ * @param  None
+ * @retval None
+ */
+void MX_FREERTOS_Init(void)
+{
+  /* USER CODE BEGIN Init */
+  Trace_Init(); // 在创建任何任务 (包括 elog 的输出任务) 之前初始化，保证任务名都能记录下来
+  CrashLog_Init(); // 在 elog_init() 之前，先把上次运行留下的日志圈出来
+  elog_init();
+  elog_set_fmt(ELOG_LVL_INFO, ELOG_FMT_TAG | ELOG_FMT_TIME | ELOG_FMT_DIR);
+  elog_set_fmt(ELOG_LVL_WARN, ELOG_FMT_TAG | ELOG_FMT_TIME | ELOG_FMT_DIR);
+  elog_start();
+  CrashLog_SaveToFlash();
+  /* USER CODE END Init */
+
+  /* USER CODE BEGIN RTOS_MUTEX */
+  /* add mutexes, ... */
+  /* USER CODE END RTOS_MUTEX */
+
+  /* USER CODE BEGIN RTOS_SEMAPHORES */
+  /* add semaphores, ... */
+  /* USER CODE END RTOS_SEMAPHORES */
+
+  /* USER CODE BEGIN RTOS_TIMERS */
+  /* start timers, add new ones, ... */
+  RuntimeStats_Init();
+  Profiler_Init();
+  LowPower_Reset();
+  // 直接用内核接口创建：osTimerNew 即使给了控制块，也会从堆里申请保存回调参数的结构
+#if APP_STATIC_ALLOCATION
+  monitorTimerHandle = xTimerCreateStatic("monitorTimer", pdMS_TO_TICKS(MONITOR_SAMPLE_MS), pdTRUE, NULL,
+                                          MonitorTimer_Callback, &monitorTimerControlBlock);
+#else
+  monitorTimerHandle = xTimerCreate("monitorTimer", pdMS_TO_TICKS(MONITOR_SAMPLE_MS), pdTRUE, NULL,
+                                    MonitorTimer_Callback);
+#endif
+  xTimerStart(monitorTimerHandle, 0);
+  /* USER CODE END RTOS_TIMERS */
+
+  /* USER CODE BEGIN RTOS_QUEUES */
+  /* add queues, ... */
+
+  /* USER CODE END RTOS_QUEUES */
+
+  /* Create the thread(s) */
+  /* creation of defaultTask */
+  defaultTaskHandle = osThreadNew(StartDefaultTask, NULL, &defaultTask_attributes);
+
+  /* USER CODE BEGIN RTOS_THREADS */
+  /* add threads, ... */
+  uartparseTaskHandle = osThreadNew(UartParseTask, NULL, &uartparseTask_attributes);
+  StackMon_Register((TaskHandle_t)defaultTaskHandle, defaultTask_attributes.stack_size);
+  StackMon_Register((TaskHandle_t)uartparseTaskHandle, uartparseTask_attributes.stack_size);
+  /* USER CODE END RTOS_THREADS */
+
+  /* USER CODE BEGIN RTOS_EVENTS */
+  /* add events, ... */
+  /* USER CODE END RTOS_EVENTS */
+}
+
+/* USER CODE BEGIN Header_StartDefaultTask */
+/**
+ * @brief  Function implementing the defaultTask thread.
+ * @param  argument: Not used
+ * @retval None
+ */
+/* USER CODE END Header_StartDefaultTask */
+void StartDefaultTask(void *argument)
+{
+  /* USER CODE BEGIN StartDefaultTask */
+  TickType_t startTick = xTaskGetTickCount();
+  elog_i(LOG_TAG_D, "[%lu]StartDefaultTask success", startTick);
+  BSP_ADC_Start(); // 温度和 VDDA 改为后台采集，TEMP 命令只读最新结果
+
+  /* Infinite loop */
+  for (;;)
+  {
+    if (g_cpu_load_enable == 1)
+    {
+      // --- 模拟高负载 ---
+      // 执行一些毫无意义的计算来消耗 CPU 时间
+      // 这种纯计算循环不会让出 CPU，直到时间片用完
+      uint32_t i;
+      for (i = 0; i < 500000; i++)
+      {
+        __NOP(); // 空指令
+      }
+      // 稍微休息一下（1ms），防止把 CLI 任务彻底饿死，
+      // 否则你连输命令的机会都没有了！
+      osDelay(1);
+    }
+    else
+    {
+      // --- 正常模式 (低负载) ---
+      // 一直阻塞到 LOAD 命令发来线程标志，不再每 100ms 醒一次轮询，
+      // 空闲时 CPU 才能在无节拍模式下长时间睡眠
+      osThreadFlagsWait(0x01U, osFlagsWaitAny, osWaitForever);
+    }
+  }
+  /* USER CODE END StartDefaultTask */
+}
+
+/* Private application code --------------------------------------------------*/
+/* USER CODE BEGIN Application */
+/**
+ * @brief 系统监控定时器回调 (运行在定时器服务任务中)
+ * @param timer 未使用
+ * @note 周期性采样各任务的运行时间，把内核的32位计数累加到64位，
+ *       保证长时间运行后 TOP 命令的百分比依然准确；
+ *       同一窗口的增量再交给负载分析器记录历史 (PROF 命令)；
+ *       栈高水位变化慢且需要扫描栈空间，每 STACK_SAMPLE_MS 才采样一次；
+ *       日志被限流丢弃和折叠的条数每 LOG_REPORT_MS 汇总输出一次，故障风暴时日志量有上限
+ */
+void MonitorTimer_Callback(TimerHandle_t timer)
+{
+  static uint8_t stack_div = 0;
+  static uint8_t log_div = 0;
+
+  RuntimeStats_Sample();
+  Profiler_Update();
+
+  if (++stack_div >= STACK_SAMPLE_MS / MONITOR_SAMPLE_MS)
+  {
+    stack_div = 0;
+    StackMon_Sample();
+  }
+  if (++log_div >= LOG_REPORT_MS / MONITOR_SAMPLE_MS)
+  {
+    log_div = 0;
+    elog_report_suppressed();
+  }
+}
+/* USER CODE END Application */
@@ -45,6 +45,10 @@ task.h is included from an application file. */
 
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
+/* heap_tlsf.c is used instead when USE_FreeRTOS_HEAP_TLSF is 1 in
+FreeRTOSConfig.h, both files are in the project. */
+#if !defined( USE_FreeRTOS_HEAP_TLSF ) || ( USE_FreeRTOS_HEAP_TLSF == 0 )
+
 #if( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
 	#error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
 #endif
@@ -449,10 +453,12 @@ size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY use
 		pxBlock = xStart.pxNextFreeBlock;
 
 		/* pxBlock will be NULL if the heap has not been initialised.  The heap
-		is initialised automatically when the first allocation is made. */
+		is initialised automatically when the first allocation is made.  When
+		the heap is full pxBlock is pxEnd, whose pxNextFreeBlock is NULL, so the
+		end is tested before the first block is looked at. */
 		if( pxBlock != NULL )
 		{
-			do
+			while( pxBlock != pxEnd )
 			{
 				/* Increment the number of blocks and record the largest block seen
 				so far. */
@@ -471,7 +477,7 @@ size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY use
 				/* Move to the next block in the chain until the last block is
 				reached. */
 				pxBlock = pxBlock->pxNextFreeBlock;
-			} while( pxBlock != pxEnd );
+			}
 		}
 	}
 	xTaskResumeAll();
@@ -490,3 +496,4 @@ size_t xBlocks = 0, xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY use
 	taskEXIT_CRITICAL();
 }
 
+#endif /* USE_FreeRTOS_HEAP_TLSF */
@@ -0,0 +1,754 @@
+/*
+ * FreeRTOS Kernel V10.3.1
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * An implementation of pvPortMalloc() and vPortFree() as an alternative to
+ * heap_4.c (whose first fit search walks the whole free list).  vPortFree()
+ * and an allocation that finds a block through the bitmaps take constant time.
+ * An allocation that finds none is not constant time: it returns the cached
+ * blocks to the heap and walks the one free list its size maps to, which is
+ * linear in the number of blocks on that list, before giving up.
+ *
+ * It is not the default.  heap_4.c is, and this file is only compiled when
+ * USE_FreeRTOS_HEAP_TLSF is 1 in FreeRTOSConfig.h.  On the 15 KB heap the
+ * size class cache and the rounding to list boundaries pack worse than the
+ * address ordered first fit of heap_4.c, STM32_PC_Tool/heap_bench shows more
+ * failed allocations and a higher peak fragmentation.
+ *
+ * Requests up to heapPOOL_MAX_SIZE bytes are rounded up to a size class.  A
+ * freed block of a size class is kept on the list of its class and handed out
+ * again by the next request of the same class, so the kernel objects that are
+ * created and deleted all the time (queues, semaphores, timers, small buffers)
+ * reuse the same blocks instead of cutting the heap into pieces.  At most
+ * configHEAP_POOL_MAX_CACHED blocks are kept per class, the rest are returned.
+ *
+ * All other requests, and the classes whose list is empty, are served by a
+ * TLSF (two level segregated fit) allocator.  Free blocks are kept in lists
+ * indexed by the power of two of their size (first level) and one of eight
+ * subdivisions of it (second level).  A bitmap for each level finds the first
+ * non empty list that fits with two count leading zeros instructions, and
+ * blocks are merged with their free neighbours in memory when they are freed.
+ *
+ * See heap_4.c for the original implementation and the memory management
+ * pages of http://www.FreeRTOS.org for more information.
+ */
+#include <stdlib.h>
+#include <stddef.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* heap_4.c is used instead unless USE_FreeRTOS_HEAP_TLSF is 1 in
+FreeRTOSConfig.h, both files are in the project. */
+#if !defined( USE_FreeRTOS_HEAP_TLSF ) || ( USE_FreeRTOS_HEAP_TLSF == 1 )
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+	#error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+#if( portBYTE_ALIGNMENT != 8 )
+	#error heap_tlsf.c assumes 8 byte alignment
+#endif
+
+/* Second level: each power of two range is split into 2^heapSL_INDEX_LOG2
+lists. */
+#define heapSL_INDEX_LOG2		( 3 )
+#define heapSL_INDEX_COUNT		( 1 << heapSL_INDEX_LOG2 )
+#define heapALIGN_LOG2			( 3 )
+#define heapFL_INDEX_SHIFT		( heapSL_INDEX_LOG2 + heapALIGN_LOG2 )
+
+/* Blocks smaller than this are all in first level 0, one list per 8 bytes. */
+#define heapSMALL_BLOCK_SIZE	( ( size_t ) 1 << heapFL_INDEX_SHIFT )
+
+/* First level lists, enough for blocks below 32KB.  configTOTAL_HEAP_SIZE
+contains a cast so it can not be checked by the preprocessor, prvHeapInit()
+asserts it instead. */
+#define heapFL_INDEX_COUNT		( 10 )
+#define heapMAX_BLOCK_SIZE		( ( ( size_t ) 1 << ( heapFL_INDEX_COUNT + heapFL_INDEX_SHIFT - 1 ) ) - 1 )
+
+/* Size classes of the block pools (usable bytes, multiples of 16).  Queue_t
+(semaphores and mutexes too) is 80 bytes on this port and has a class of its
+own, a TCB falls into the 96 byte class. */
+#define heapPOOL_CLASS_COUNT	( 7 )
+#define heapPOOL_MAX_SIZE		( ( size_t ) 128 )
+
+/* Cached blocks per class.  Cached blocks stay where they are, so a high limit
+trades fragmentation of the rest of the heap for more hits. */
+#ifndef configHEAP_POOL_MAX_CACHED
+	#define configHEAP_POOL_MAX_CACHED	( 4 )
+#endif
+
+/* Flags kept in the low bits of xBlockSize, the sizes are multiples of 8. */
+#define heapBLOCK_FREE_BIT		( ( size_t ) 1 )
+#define heapBLOCK_POOL_BIT		( ( size_t ) 2 )
+#define heapBLOCK_FLAG_MASK		( ( size_t ) 7 )
+
+#if defined( __CC_ARM )
+	#define heapCLZ( x )		__clz( x )
+#else
+	#define heapCLZ( x )		( ( uint32_t ) __builtin_clz( x ) )
+#endif
+
+/* Allocate the memory for the heap. */
+#if( configAPPLICATION_ALLOCATED_HEAP == 1 )
+	/* The application writer has already defined the array used for the RTOS
+	heap - probably so it can be placed in a special segment or address. */
+	extern uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#else
+	static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+#endif /* configAPPLICATION_ALLOCATED_HEAP */
+
+/* Header of every block.  Only the first two members are kept while the block
+belongs to the application, the free list links use the first bytes of the
+memory handed out. */
+typedef struct A_HEAP_BLOCK
+{
+	struct A_HEAP_BLOCK *pxPrevPhysBlock;	/*<< The block just below this one in memory, NULL for the first block. */
+	size_t xBlockSize;						/*<< Size of the block including the header, and the flags in the low bits. */
+	struct A_HEAP_BLOCK *pxNextFreeBlock;	/*<< The next block in the same free list or pool. */
+	struct A_HEAP_BLOCK *pxPrevFreeBlock;	/*<< The previous block in the same free list. */
+} HeapBlock_t;
+
+/* Bytes in front of the memory handed out, 8 on a 32 bit target. */
+#define heapBLOCK_OVERHEAD		( ( size_t ) offsetof( HeapBlock_t, pxNextFreeBlock ) )
+
+/* A free block must hold the whole header. */
+#define heapMINIMUM_BLOCK_SIZE	( ( size_t ) sizeof( HeapBlock_t ) )
+
+#define heapBLOCK_SIZE( pxBlock )	( ( pxBlock )->xBlockSize & ~heapBLOCK_FLAG_MASK )
+#define heapNEXT_PHYS( pxBlock )	( ( HeapBlock_t * ) ( ( ( uint8_t * ) ( pxBlock ) ) + heapBLOCK_SIZE( pxBlock ) ) )
+
+/* One pool of blocks of the same size class. */
+typedef struct A_HEAP_POOL
+{
+	HeapBlock_t *pxFirstBlock;	/*<< Cached blocks, LIFO. */
+	size_t xCachedBlocks;		/*<< Number of cached blocks. */
+	size_t xHits;				/*<< Requests served from the cached blocks. */
+	size_t xMisses;				/*<< Requests served by TLSF. */
+} HeapPool_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Called automatically to setup the required heap structures the first time
+ * pvPortMalloc() is called.
+ */
+static void prvHeapInit( void );
+
+/*
+ * Find the lists a block of the given size belongs to.
+ */
+static void prvMappingInsert( size_t xSize, size_t *pxFl, size_t *pxSl );
+
+/*
+ * Find a free block of at least xSize bytes, normally the first block of the
+ * first list whose blocks are all large enough.
+ */
+static HeapBlock_t *prvFindSuitableBlock( size_t xSize, size_t *pxFl, size_t *pxSl );
+
+static void prvInsertFreeBlock( HeapBlock_t *pxBlock );
+static void prvRemoveFreeBlock( HeapBlock_t *pxBlock, size_t xFl, size_t xSl );
+
+/*
+ * Take a block of exactly xSize bytes (a multiple of 8) from TLSF.
+ */
+static HeapBlock_t *prvAllocateBlock( size_t xSize );
+
+/*
+ * Give a block back to TLSF, merging it with its free neighbours.
+ */
+static void prvReleaseBlock( HeapBlock_t *pxBlock );
+
+/*
+ * Give all cached pool blocks back to TLSF.
+ */
+static void prvFlushPools( void );
+
+/*-----------------------------------------------------------*/
+
+/* Usable bytes of each size class. */
+static const size_t xPoolBlockSize[ heapPOOL_CLASS_COUNT ] = { 16, 32, 48, 64, 80, 96, 128 };
+
+/* Size class of a request, indexed by ( xWantedSize - 1 ) / 16. */
+static const uint8_t ucPoolClassOfSize[ heapPOOL_MAX_SIZE / 16 ] = { 0, 1, 2, 3, 4, 5, 6, 6 };
+
+static HeapPool_t xPools[ heapPOOL_CLASS_COUNT ];
+
+/* TLSF lists and their bitmaps. */
+static uint32_t ulFlBitmap = 0;
+static uint32_t ulSlBitmap[ heapFL_INDEX_COUNT ];
+static HeapBlock_t *pxFreeLists[ heapFL_INDEX_COUNT ][ heapSL_INDEX_COUNT ];
+
+/* Zero sized block at the top of the heap, it is never free so the last real
+block never merges past it.  NULL until the heap is initialised. */
+static HeapBlock_t *pxHeapEnd = NULL;
+
+/* Keeps track of the number of calls to allocate and free memory as well as the
+number of free bytes remaining (the cached pool blocks are counted as free). */
+static size_t xTotalHeapBytes = 0U;
+static size_t xFreeBytesRemaining = 0U;
+static size_t xMinimumEverFreeBytesRemaining = 0U;
+static size_t xNumberOfFreeBlocks = 0U;
+static size_t xNumberOfSuccessfulAllocations = 0;
+static size_t xNumberOfSuccessfulFrees = 0;
+
+/*-----------------------------------------------------------*/
+
+void *pvPortMalloc( size_t xWantedSize )
+{
+HeapBlock_t *pxBlock = NULL;
+HeapPool_t *pxPool = NULL;
+void *pvReturn = NULL;
+size_t xBlockSize;
+
+	vTaskSuspendAll();
+	{
+		/* If this is the first call to malloc then the heap will require
+		initialisation to setup the free lists. */
+		if( pxHeapEnd == NULL )
+		{
+			prvHeapInit();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* Requests larger than the heap would overflow the size calculation
+		below, they can never be served anyway. */
+		if( ( xWantedSize > 0 ) && ( xWantedSize <= xTotalHeapBytes ) )
+		{
+			if( xWantedSize <= heapPOOL_MAX_SIZE )
+			{
+				pxPool = &xPools[ ucPoolClassOfSize[ ( xWantedSize - 1 ) >> 4 ] ];
+				xBlockSize = xPoolBlockSize[ pxPool - xPools ] + heapBLOCK_OVERHEAD;
+
+				pxBlock = pxPool->pxFirstBlock;
+				if( pxBlock != NULL )
+				{
+					pxPool->pxFirstBlock = pxBlock->pxNextFreeBlock;
+					pxPool->xCachedBlocks--;
+					pxPool->xHits++;
+					pxBlock->xBlockSize &= ~heapBLOCK_POOL_BIT;
+				}
+				else
+				{
+					pxPool->xMisses++;
+				}
+			}
+			else
+			{
+				xBlockSize = ( xWantedSize + heapBLOCK_OVERHEAD + portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+			}
+
+			if( pxBlock == NULL )
+			{
+				pxBlock = prvAllocateBlock( xBlockSize );
+
+				/* The cached blocks are free memory as well, give them back
+				to TLSF (where they merge with their neighbours) and try
+				again before failing. */
+				if( pxBlock == NULL )
+				{
+					prvFlushPools();
+					pxBlock = prvAllocateBlock( xBlockSize );
+
+					/* Last try without rounding up to the size class, such a
+					block is not cached when it is freed. */
+					if( ( pxBlock == NULL ) && ( pxPool != NULL ) )
+					{
+						xBlockSize = ( xWantedSize + heapBLOCK_OVERHEAD + portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+						pxBlock = prvAllocateBlock( xBlockSize );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+
+			if( pxBlock != NULL )
+			{
+				xFreeBytesRemaining -= heapBLOCK_SIZE( pxBlock );
+
+				if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+				{
+					xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				pvReturn = ( void * ) ( ( ( uint8_t * ) pxBlock ) + heapBLOCK_OVERHEAD );
+				xNumberOfSuccessfulAllocations++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		traceMALLOC( pvReturn, xWantedSize );
+	}
+	( void ) xTaskResumeAll();
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pvReturn == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
+	configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+HeapBlock_t *pxBlock;
+HeapPool_t *pxPool = NULL;
+size_t xBlockSize, xUsableSize;
+
+	if( pv != NULL )
+	{
+		pxBlock = ( HeapBlock_t * ) ( ( ( uint8_t * ) pv ) - heapBLOCK_OVERHEAD );
+
+		/* The block must belong to the application, a free or cached block
+		here means it is freed twice. */
+		configASSERT( ( pxBlock->xBlockSize & ( heapBLOCK_FREE_BIT | heapBLOCK_POOL_BIT ) ) == 0 );
+
+		vTaskSuspendAll();
+		{
+			xBlockSize = heapBLOCK_SIZE( pxBlock );
+			xUsableSize = xBlockSize - heapBLOCK_OVERHEAD;
+
+			/* Only a block of exactly the class size can be cached, a larger
+			block (the remainder was too small to split off) goes back to
+			TLSF. */
+			if( xUsableSize <= heapPOOL_MAX_SIZE )
+			{
+				pxPool = &xPools[ ucPoolClassOfSize[ ( xUsableSize - 1 ) >> 4 ] ];
+
+				if( ( xPoolBlockSize[ pxPool - xPools ] != xUsableSize ) || ( pxPool->xCachedBlocks >= configHEAP_POOL_MAX_CACHED ) )
+				{
+					pxPool = NULL;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( pxPool != NULL )
+			{
+				pxBlock->xBlockSize |= heapBLOCK_POOL_BIT;
+				pxBlock->pxNextFreeBlock = pxPool->pxFirstBlock;
+				pxPool->pxFirstBlock = pxBlock;
+				pxPool->xCachedBlocks++;
+			}
+			else
+			{
+				prvReleaseBlock( pxBlock );
+			}
+
+			xFreeBytesRemaining += xBlockSize;
+			traceFREE( pv, xBlockSize );
+			xNumberOfSuccessfulFrees++;
+		}
+		( void ) xTaskResumeAll();
+	}
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+	return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+	return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+	/* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapInit( void )
+{
+HeapBlock_t *pxFirstBlock;
+size_t uxAddress, uxEnd;
+
+	/* Ensure the heap starts and ends on correctly aligned boundaries. */
+	uxAddress = ( ( size_t ) ucHeap + portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+	uxEnd = ( ( size_t ) ucHeap + configTOTAL_HEAP_SIZE ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+	/* The end marker only needs the first two members of the header. */
+	uxEnd -= heapBLOCK_OVERHEAD;
+	pxHeapEnd = ( HeapBlock_t * ) uxEnd;
+
+	configASSERT( ( uxEnd - uxAddress ) <= heapMAX_BLOCK_SIZE );
+
+	/* One free block covers the whole heap. */
+	pxFirstBlock = ( HeapBlock_t * ) uxAddress;
+	pxFirstBlock->pxPrevPhysBlock = NULL;
+	pxFirstBlock->xBlockSize = uxEnd - uxAddress;
+	pxHeapEnd->pxPrevPhysBlock = pxFirstBlock;
+	pxHeapEnd->xBlockSize = 0;
+	prvInsertFreeBlock( pxFirstBlock );
+
+	xTotalHeapBytes = heapBLOCK_SIZE( pxFirstBlock );
+	xFreeBytesRemaining = xTotalHeapBytes;
+	xMinimumEverFreeBytesRemaining = xTotalHeapBytes;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMappingInsert( size_t xSize, size_t *pxFl, size_t *pxSl )
+{
+uint32_t ulMsb;
+
+	if( xSize < heapSMALL_BLOCK_SIZE )
+	{
+		*pxFl = 0;
+		*pxSl = xSize >> heapALIGN_LOG2;
+	}
+	else
+	{
+		ulMsb = 31UL - heapCLZ( ( uint32_t ) xSize );
+		*pxSl = ( xSize >> ( ulMsb - heapSL_INDEX_LOG2 ) ) & ( heapSL_INDEX_COUNT - 1 );
+		*pxFl = ulMsb - ( heapFL_INDEX_SHIFT - 1 );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static HeapBlock_t *prvFindSuitableBlock( size_t xSize, size_t *pxFl, size_t *pxSl )
+{
+HeapBlock_t *pxBlock;
+uint32_t ulMap;
+size_t xFl, xSl, xRoundedSize = xSize;
+
+	/* Round the size up to the next list boundary, so every block in the
+	list found is large enough and the first one can be taken. */
+	if( xSize >= heapSMALL_BLOCK_SIZE )
+	{
+		xRoundedSize += ( ( size_t ) 1 << ( 31UL - heapCLZ( ( uint32_t ) xSize ) - heapSL_INDEX_LOG2 ) ) - 1;
+	}
+	prvMappingInsert( xRoundedSize, &xFl, &xSl );
+
+	if( xFl < heapFL_INDEX_COUNT )
+	{
+		/* First the lists of the same first level, then the next non empty
+		first level. */
+		ulMap = ulSlBitmap[ xFl ] & ( ~0UL << xSl );
+		if( ulMap == 0 )
+		{
+			ulMap = ulFlBitmap & ( ~0UL << ( xFl + 1 ) );
+			if( ulMap != 0 )
+			{
+				xFl = 31UL - heapCLZ( ulMap & ( 0UL - ulMap ) );
+				ulMap = ulSlBitmap[ xFl ];
+			}
+		}
+
+		if( ulMap != 0 )
+		{
+			xSl = 31UL - heapCLZ( ulMap & ( 0UL - ulMap ) );
+			*pxFl = xFl;
+			*pxSl = xSl;
+			return pxFreeLists[ xFl ][ xSl ];
+		}
+	}
+
+	/* No block is large enough for sure, but the list the size itself maps
+	to may still hold one that fits.  This walk is linear in the length of
+	that list, so an allocation that gets here is not constant time.  It only
+	happens when the heap is nearly exhausted. */
+	prvMappingInsert( xSize, &xFl, &xSl );
+	if( xFl < heapFL_INDEX_COUNT )
+	{
+		for( pxBlock = pxFreeLists[ xFl ][ xSl ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+		{
+			if( heapBLOCK_SIZE( pxBlock ) >= xSize )
+			{
+				*pxFl = xFl;
+				*pxSl = xSl;
+				return pxBlock;
+			}
+		}
+	}
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertFreeBlock( HeapBlock_t *pxBlock )
+{
+size_t xFl, xSl;
+
+	prvMappingInsert( heapBLOCK_SIZE( pxBlock ), &xFl, &xSl );
+
+	pxBlock->xBlockSize |= heapBLOCK_FREE_BIT;
+	pxBlock->pxPrevFreeBlock = NULL;
+	pxBlock->pxNextFreeBlock = pxFreeLists[ xFl ][ xSl ];
+	if( pxBlock->pxNextFreeBlock != NULL )
+	{
+		pxBlock->pxNextFreeBlock->pxPrevFreeBlock = pxBlock;
+	}
+	pxFreeLists[ xFl ][ xSl ] = pxBlock;
+
+	ulFlBitmap |= 1UL << xFl;
+	ulSlBitmap[ xFl ] |= 1UL << xSl;
+	xNumberOfFreeBlocks++;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveFreeBlock( HeapBlock_t *pxBlock, size_t xFl, size_t xSl )
+{
+	if( pxBlock->pxNextFreeBlock != NULL )
+	{
+		pxBlock->pxNextFreeBlock->pxPrevFreeBlock = pxBlock->pxPrevFreeBlock;
+	}
+
+	if( pxBlock->pxPrevFreeBlock != NULL )
+	{
+		pxBlock->pxPrevFreeBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+	}
+	else
+	{
+		pxFreeLists[ xFl ][ xSl ] = pxBlock->pxNextFreeBlock;
+
+		if( pxFreeLists[ xFl ][ xSl ] == NULL )
+		{
+			ulSlBitmap[ xFl ] &= ~( 1UL << xSl );
+
+			if( ulSlBitmap[ xFl ] == 0 )
+			{
+				ulFlBitmap &= ~( 1UL << xFl );
+			}
+		}
+	}
+
+	pxBlock->xBlockSize &= ~heapBLOCK_FREE_BIT;
+	xNumberOfFreeBlocks--;
+}
+/*-----------------------------------------------------------*/
+
+static HeapBlock_t *prvAllocateBlock( size_t xSize )
+{
+HeapBlock_t *pxBlock, *pxRemainder;
+size_t xFl, xSl;
+
+	pxBlock = prvFindSuitableBlock( xSize, &xFl, &xSl );
+
+	if( pxBlock != NULL )
+	{
+		prvRemoveFreeBlock( pxBlock, xFl, xSl );
+
+		/* Split off the end of the block when it is large enough to be a
+		block by itself.  Its upper neighbour can not be free, free blocks are
+		always merged. */
+		if( ( heapBLOCK_SIZE( pxBlock ) - xSize ) >= heapMINIMUM_BLOCK_SIZE )
+		{
+			pxRemainder = ( HeapBlock_t * ) ( ( ( uint8_t * ) pxBlock ) + xSize );
+			pxRemainder->xBlockSize = heapBLOCK_SIZE( pxBlock ) - xSize;
+			pxRemainder->pxPrevPhysBlock = pxBlock;
+			heapNEXT_PHYS( pxRemainder )->pxPrevPhysBlock = pxRemainder;
+			pxBlock->xBlockSize = xSize;
+			prvInsertFreeBlock( pxRemainder );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	return pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+static void prvReleaseBlock( HeapBlock_t *pxBlock )
+{
+HeapBlock_t *pxNeighbour;
+size_t xFl, xSl;
+
+	/* Merge with the block below. */
+	pxNeighbour = pxBlock->pxPrevPhysBlock;
+	if( ( pxNeighbour != NULL ) && ( ( pxNeighbour->xBlockSize & heapBLOCK_FREE_BIT ) != 0 ) )
+	{
+		prvMappingInsert( heapBLOCK_SIZE( pxNeighbour ), &xFl, &xSl );
+		prvRemoveFreeBlock( pxNeighbour, xFl, xSl );
+		pxNeighbour->xBlockSize += heapBLOCK_SIZE( pxBlock );
+		pxBlock = pxNeighbour;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* Merge with the block above, the end marker is never free. */
+	pxNeighbour = heapNEXT_PHYS( pxBlock );
+	if( ( pxNeighbour->xBlockSize & heapBLOCK_FREE_BIT ) != 0 )
+	{
+		prvMappingInsert( heapBLOCK_SIZE( pxNeighbour ), &xFl, &xSl );
+		prvRemoveFreeBlock( pxNeighbour, xFl, xSl );
+		pxBlock->xBlockSize += heapBLOCK_SIZE( pxNeighbour );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	heapNEXT_PHYS( pxBlock )->pxPrevPhysBlock = pxBlock;
+	prvInsertFreeBlock( pxBlock );
+}
+/*-----------------------------------------------------------*/
+
+static void prvFlushPools( void )
+{
+HeapBlock_t *pxBlock;
+size_t xClass;
+
+	for( xClass = 0; xClass < heapPOOL_CLASS_COUNT; xClass++ )
+	{
+		while( xPools[ xClass ].pxFirstBlock != NULL )
+		{
+			pxBlock = xPools[ xClass ].pxFirstBlock;
+			xPools[ xClass ].pxFirstBlock = pxBlock->pxNextFreeBlock;
+			pxBlock->xBlockSize &= ~heapBLOCK_POOL_BIT;
+			prvReleaseBlock( pxBlock );
+		}
+		xPools[ xClass ].xCachedBlocks = 0;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapStats( HeapStats_t *pxHeapStats )
+{
+HeapBlock_t *pxBlock;
+size_t xMaxSize = 0, xMinSize = portMAX_DELAY; /* portMAX_DELAY used as a portable way of getting the maximum value. */
+uint32_t ulMap;
+size_t xFl, xSl;
+
+	vTaskSuspendAll();
+	{
+		/* The largest free block is in the highest non empty list and the
+		smallest in the lowest one, only those two lists are walked. */
+		if( ulFlBitmap != 0 )
+		{
+			xFl = 31UL - heapCLZ( ulFlBitmap );
+			xSl = 31UL - heapCLZ( ulSlBitmap[ xFl ] );
+			for( pxBlock = pxFreeLists[ xFl ][ xSl ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+			{
+				if( heapBLOCK_SIZE( pxBlock ) > xMaxSize )
+				{
+					xMaxSize = heapBLOCK_SIZE( pxBlock );
+				}
+			}
+
+			ulMap = ulFlBitmap & ( 0UL - ulFlBitmap );
+			xFl = 31UL - heapCLZ( ulMap );
+			ulMap = ulSlBitmap[ xFl ] & ( 0UL - ulSlBitmap[ xFl ] );
+			xSl = 31UL - heapCLZ( ulMap );
+			for( pxBlock = pxFreeLists[ xFl ][ xSl ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+			{
+				if( heapBLOCK_SIZE( pxBlock ) < xMinSize )
+				{
+					xMinSize = heapBLOCK_SIZE( pxBlock );
+				}
+			}
+		}
+
+		pxHeapStats->xSizeOfLargestFreeBlockInBytes = xMaxSize;
+		pxHeapStats->xSizeOfSmallestFreeBlockInBytes = xMinSize;
+		pxHeapStats->xNumberOfFreeBlocks = xNumberOfFreeBlocks;
+		pxHeapStats->xAvailableHeapSpaceInBytes = xFreeBytesRemaining;
+		pxHeapStats->xNumberOfSuccessfulAllocations = xNumberOfSuccessfulAllocations;
+		pxHeapStats->xNumberOfSuccessfulFrees = xNumberOfSuccessfulFrees;
+		pxHeapStats->xMinimumEverFreeBytesRemaining = xMinimumEverFreeBytesRemaining;
+	}
+	( void ) xTaskResumeAll();
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortGetHeapPoolStats( UBaseType_t uxClass, size_t *pxBlockSize, size_t *pxCachedBlocks, size_t *pxHits, size_t *pxMisses )
+{
+	if( uxClass >= heapPOOL_CLASS_COUNT )
+	{
+		return pdFALSE;
+	}
+
+	vTaskSuspendAll();
+	{
+		*pxBlockSize = xPoolBlockSize[ uxClass ];
+		*pxCachedBlocks = xPools[ uxClass ].xCachedBlocks;
+		*pxHits = xPools[ uxClass ].xHits;
+		*pxMisses = xPools[ uxClass ].xMisses;
+	}
+	( void ) xTaskResumeAll();
+
+	return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetTotalHeapSize( void )
+{
+	return xTotalHeapBytes;
+}
+
+#endif /* USE_FreeRTOS_HEAP_TLSF */
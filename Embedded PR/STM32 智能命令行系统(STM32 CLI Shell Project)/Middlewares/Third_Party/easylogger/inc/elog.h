@@ -53,6 +53,17 @@ extern "C" {
 /* output log's level total number */
 #define ELOG_LVL_TOTAL_NUM                   6
 
+/**
+ * Per-module compile-time level ceiling, define it before including <elog.h>:
+ *     #define ELOG_LOCAL_LVL ELOG_LVL_INFO
+ * The log calls above it (or above ELOG_OUTPUT_LVL) are removed by the preprocessor,
+ * their arguments are not even evaluated.
+ */
+#if !defined(ELOG_LOCAL_LVL) || (ELOG_LOCAL_LVL > ELOG_OUTPUT_LVL)
+    #undef ELOG_LOCAL_LVL
+    #define ELOG_LOCAL_LVL                   ELOG_OUTPUT_LVL
+#endif
+
 /* EasyLogger software version number */
 #define ELOG_SW_VERSION                      "2.2.99"
 
@@ -100,50 +111,128 @@ extern "C" {
     #define ELOG_OUTPUT_LINE 0
     #endif
 
+    /*
+     * Every log call site caches its filter result in a static ElogSite. The tag and level filters
+     * are only looked up again after the filter settings are changed, so a log which is filtered
+     * out at run time costs two compares. A site which is called with several tags (a helper taking
+     * the tag as a parameter) is cached by the tag in a small table instead (elog_site_multi_enabled).
+     * A site from elog_limited() also keeps its own rate limit bucket (ELOG_RATE_LIMIT_ENABLE) and
+     * collapses its identical lines (ELOG_REPEAT_COLLAPSE_ENABLE), the other sites output every line.
+     */
+    #define ELOG_SITE_OUTPUT_(level, tag, limited, ...)                                             \
+    do {                                                                                            \
+        static ElogSite elog_site_ = ELOG_SITE_INIT(limited);                                       \
+        if (elog_site_enabled(&elog_site_, level, tag)) {                                           \
+            elog_site_output(&elog_site_, level, tag, ELOG_OUTPUT_DIR, ELOG_OUTPUT_FUNC, ELOG_OUTPUT_LINE, __VA_ARGS__); \
+        }                                                                                           \
+    } while (0)
+    #define ELOG_SITE_OUTPUT(level, tag, ...)         ELOG_SITE_OUTPUT_(level, tag, 0, __VA_ARGS__)
+    #if defined(ELOG_RATE_LIMIT_ENABLE)
+        #define ELOG_SITE_INIT(limited)               { 0, NULL, limited, 0, 0 }
+    #elif defined(ELOG_REPEAT_COLLAPSE_ENABLE)
+        #define ELOG_SITE_INIT(limited)               { 0, NULL, limited }
+    #else
+        #define ELOG_SITE_INIT(limited)               { 0, NULL }
+    #endif
+
     #define elog_raw(...)  elog_raw_output(__VA_ARGS__)
-    #if ELOG_OUTPUT_LVL >= ELOG_LVL_ASSERT
-        #define elog_assert(tag, ...) \
-                elog_output(ELOG_LVL_ASSERT, tag, ELOG_OUTPUT_DIR, ELOG_OUTPUT_FUNC, ELOG_OUTPUT_LINE, __VA_ARGS__)
+    #if ELOG_LOCAL_LVL >= ELOG_LVL_ASSERT
+        #define elog_assert(tag, ...)     ELOG_SITE_OUTPUT(ELOG_LVL_ASSERT, tag, __VA_ARGS__)
     #else
         #define elog_assert(tag, ...)
-    #endif /* ELOG_OUTPUT_LVL >= ELOG_LVL_ASSERT */
+    #endif /* ELOG_LOCAL_LVL >= ELOG_LVL_ASSERT */
 
-    #if ELOG_OUTPUT_LVL >= ELOG_LVL_ERROR
-        #define elog_error(tag, ...) \
-                elog_output(ELOG_LVL_ERROR, tag, ELOG_OUTPUT_DIR, ELOG_OUTPUT_FUNC, ELOG_OUTPUT_LINE, __VA_ARGS__)
+    #if ELOG_LOCAL_LVL >= ELOG_LVL_ERROR
+        #define elog_error(tag, ...)     ELOG_SITE_OUTPUT(ELOG_LVL_ERROR, tag, __VA_ARGS__)
     #else
         #define elog_error(tag, ...)
-    #endif /* ELOG_OUTPUT_LVL >= ELOG_LVL_ERROR */
+    #endif /* ELOG_LOCAL_LVL >= ELOG_LVL_ERROR */
 
-    #if ELOG_OUTPUT_LVL >= ELOG_LVL_WARN
-        #define elog_warn(tag, ...) \
-                elog_output(ELOG_LVL_WARN, tag, ELOG_OUTPUT_DIR, ELOG_OUTPUT_FUNC, ELOG_OUTPUT_LINE, __VA_ARGS__)
+    #if ELOG_LOCAL_LVL >= ELOG_LVL_WARN
+        #define elog_warn(tag, ...)     ELOG_SITE_OUTPUT(ELOG_LVL_WARN, tag, __VA_ARGS__)
     #else
         #define elog_warn(tag, ...)
-    #endif /* ELOG_OUTPUT_LVL >= ELOG_LVL_WARN */
+    #endif /* ELOG_LOCAL_LVL >= ELOG_LVL_WARN */
 
-    #if ELOG_OUTPUT_LVL >= ELOG_LVL_INFO
-        #define elog_info(tag, ...) \
-                elog_output(ELOG_LVL_INFO, tag, ELOG_OUTPUT_DIR, ELOG_OUTPUT_FUNC, ELOG_OUTPUT_LINE, __VA_ARGS__)
+    #if ELOG_LOCAL_LVL >= ELOG_LVL_INFO
+        #define elog_info(tag, ...)     ELOG_SITE_OUTPUT(ELOG_LVL_INFO, tag, __VA_ARGS__)
     #else
         #define elog_info(tag, ...)
-    #endif /* ELOG_OUTPUT_LVL >= ELOG_LVL_INFO */
+    #endif /* ELOG_LOCAL_LVL >= ELOG_LVL_INFO */
 
-    #if ELOG_OUTPUT_LVL >= ELOG_LVL_DEBUG
-        #define elog_debug(tag, ...) \
-                elog_output(ELOG_LVL_DEBUG, tag, ELOG_OUTPUT_DIR, ELOG_OUTPUT_FUNC, ELOG_OUTPUT_LINE, __VA_ARGS__)
+    #if ELOG_LOCAL_LVL >= ELOG_LVL_DEBUG
+        #define elog_debug(tag, ...)     ELOG_SITE_OUTPUT(ELOG_LVL_DEBUG, tag, __VA_ARGS__)
     #else
         #define elog_debug(tag, ...)
-    #endif /* ELOG_OUTPUT_LVL >= ELOG_LVL_DEBUG */
+    #endif /* ELOG_LOCAL_LVL >= ELOG_LVL_DEBUG */
 
-    #if ELOG_OUTPUT_LVL == ELOG_LVL_VERBOSE
-        #define elog_verbose(tag, ...) \
-                elog_output(ELOG_LVL_VERBOSE, tag, ELOG_OUTPUT_DIR, ELOG_OUTPUT_FUNC, ELOG_OUTPUT_LINE, __VA_ARGS__)
+    #if ELOG_LOCAL_LVL == ELOG_LVL_VERBOSE
+        #define elog_verbose(tag, ...)     ELOG_SITE_OUTPUT(ELOG_LVL_VERBOSE, tag, __VA_ARGS__)
     #else
         #define elog_verbose(tag, ...)
-    #endif /* ELOG_OUTPUT_LVL == ELOG_LVL_VERBOSE */
+    #endif /* ELOG_LOCAL_LVL == ELOG_LVL_VERBOSE */
+#endif /* ELOG_OUTPUT_ENABLE */
+
+/*
+ * Rate limited log, for the call sites which may be hit by every received byte or frame
+ * (parser errors, driver faults). The line is dropped when the bucket of the site is empty,
+ * and the identical consecutive lines are collapsed. Command replies and reports which print
+ * many lines from one site must use the normal API, they are never limited.
+ */
+#if !defined(ELOG_OUTPUT_ENABLE)
+    #define elog_limited(level, tag, ...)
+#else
+    #define elog_limited(level, tag, ...)                                                             \
+    do {                                                                                              \
+        if ((level) <= ELOG_LOCAL_LVL) {                                                              \
+            ELOG_SITE_OUTPUT_(level, tag, 1, __VA_ARGS__);                                            \
+        }                                                                                             \
+    } while (0)
 #endif /* ELOG_OUTPUT_ENABLE */
 
+/* max number of arguments (after the format) of one deferred log */
+#define ELOG_DEFER_ARGS_MAX                  7
+/* argument number field of a raw byte record from elog_hexdump_defer() */
+#define ELOG_DEFER_BLOB                      0xFF
+
+/*
+ * Deferred log helpers, standard C99 only (no `##__VA_ARGS__`).
+ * __VA_ARGS__ is "format, arg1, arg2, ...":
+ * ELOG_DEFER_FMT  picks the format
+ * ELOG_DEFER_NARG counts the arguments after the format
+ * ELOG_DEFER_ARGS drops the format, and gives a dummy 0 when there is no argument
+ */
+#define ELOG_DEFER_SEL(_0, _1, _2, _3, _4, _5, _6, _7, N, ...) N
+#define ELOG_DEFER_FMT(...)                  ELOG_DEFER_FMT_(__VA_ARGS__, 0)
+#define ELOG_DEFER_FMT_(fmt, ...)            fmt
+#define ELOG_DEFER_NARG(...)                 ELOG_DEFER_SEL(__VA_ARGS__, 7, 6, 5, 4, 3, 2, 1, 0, 0)
+#define ELOG_DEFER_ARGS(...)                 ELOG_DEFER_ARGS_(ELOG_DEFER_SEL(__VA_ARGS__, SOME, SOME, SOME, SOME, SOME, SOME, SOME, NONE, NONE), __VA_ARGS__)
+#define ELOG_DEFER_ARGS_(n, ...)             ELOG_DEFER_ARGS__(n, __VA_ARGS__)
+#define ELOG_DEFER_ARGS__(n, ...)            ELOG_DEFER_ARGS_##n(__VA_ARGS__)
+#define ELOG_DEFER_ARGS_NONE(fmt)            0
+#define ELOG_DEFER_ARGS_SOME(fmt, ...)       __VA_ARGS__
+
+/*
+ * Deferred log API. The tag and format must be string literals, and every argument must be
+ * a 32 bit integer or pointer (no float/double, "%s" only for strings in flash).
+ */
+#if !defined(ELOG_OUTPUT_ENABLE)
+    #define elog_defer(level, tag, ...)
+#elif defined(ELOG_DEFER_OUTPUT_ENABLE)
+    #define elog_defer(level, tag, ...)                                                               \
+    do {                                                                                              \
+        if ((level) <= ELOG_LOCAL_LVL) {                                                              \
+            static const char elog_defer_fmt[] __attribute__((section(ELOG_DEFER_SECTION))) =         \
+                    tag "\x1f" ELOG_DEFER_FMT(__VA_ARGS__);                                           \
+            elog_defer_output(level, elog_defer_fmt, ELOG_DEFER_NARG(__VA_ARGS__), ELOG_DEFER_ARGS(__VA_ARGS__)); \
+        }                                                                                             \
+    } while (0)
+#else
+    /* deferred mode disabled, fall back to the normal (formatted on target) output */
+    #define elog_defer(level, tag, ...) \
+            elog_output(level, tag, ELOG_OUTPUT_DIR, ELOG_OUTPUT_FUNC, ELOG_OUTPUT_LINE, __VA_ARGS__)
+#endif /* ELOG_DEFER_OUTPUT_ENABLE */
+
 /* all formats index */
 typedef enum {
     ELOG_FMT_LVL    = 1 << 0, /**< level */
@@ -160,11 +249,19 @@ typedef enum {
 #define ELOG_FMT_ALL    (ELOG_FMT_LVL|ELOG_FMT_TAG|ELOG_FMT_TIME|ELOG_FMT_P_INFO|ELOG_FMT_T_INFO| \
     ELOG_FMT_DIR|ELOG_FMT_FUNC|ELOG_FMT_LINE)
 
-/* output log's tag filter */
+/* tag level filter hash table slot state */
+typedef enum {
+    ELOG_TAG_LVL_EMPTY = 0,  /**< never used, a probe stops here */
+    ELOG_TAG_LVL_USED,       /**< holds a tag */
+    ELOG_TAG_LVL_DELETED,    /**< removed tag (tombstone), a probe goes on */
+} ElogTagLvlState;
+
+/* output log's tag filter, one slot of the open-addressed hash table */
 typedef struct {
+    uint32_t hash;  /**< FNV-1a hash of the tag */
     uint8_t level;
+    uint8_t state;  /**< ElogTagLvlState */
     char tag[ELOG_FILTER_TAG_MAX_LEN + 1];
-    bool tag_use_flag; /**< false : tag is no used   true: tag is used */
 } ElogTagLvlFilter, *ElogTagLvlFilter_t;
 
 /* output log's filter */
@@ -191,6 +288,24 @@ typedef struct {
 
 }EasyLogger, *EasyLogger_t;
 
+/* cached filter result of one log call site */
+typedef struct {
+    /**
+     * filter generation when it is resolved (bit 31~8, 0: never resolved) and the limit (bit 7~0):
+     * the levels below it pass the level and tag filters, 0: all are filtered out.
+     * They are packed in one word, a reader never sees the limit of another generation.
+     */
+    volatile uint32_t state;
+    const char * volatile tag; /**< the tag it is resolved for, it is only set once (see elog_site_resolve) */
+#if defined(ELOG_RATE_LIMIT_ENABLE) || defined(ELOG_REPEAT_COLLAPSE_ENABLE)
+    uint8_t limited; /**< 1: elog_limited() site, it is rate limited and its repeats are collapsed */
+#endif
+#ifdef ELOG_RATE_LIMIT_ENABLE
+    uint8_t spent;   /**< tokens taken from the bucket, 0: the bucket is full */
+    uint64_t refill; /**< timestamp (us) of the last refill */
+#endif
+} ElogSite;
+
 /* EasyLogger error code */
 typedef enum {
     ELOG_NO_ERR,
@@ -215,12 +330,48 @@ uint8_t elog_get_filter_tag_lvl(const char *tag);
 void elog_raw_output(const char *format, ...);
 void elog_output(uint8_t level, const char *tag, const char *file, const char *func,
         const long line, const char *format, ...);
+void elog_site_output(ElogSite *site, uint8_t level, const char *tag, const char *file, const char *func,
+        const long line, const char *format, ...);
+uint8_t elog_site_resolve(ElogSite *site, const char *tag);
+bool elog_site_multi_enabled(uint8_t level, const char *tag);
 void elog_output_lock_enabled(bool enabled);
+void elog_report_suppressed(void);
+void elog_get_suppressed_count(uint32_t *rate_limited, uint32_t *repeated);
+extern volatile uint32_t elog_filter_gen;
+extern const char elog_site_tag_multi[];
 extern void (*elog_assert_hook)(const char* expr, const char* func, size_t line);
 void elog_assert_set_hook(void (*hook)(const char* expr, const char* func, size_t line));
 int8_t elog_find_lvl(const char *log);
 const char *elog_find_tag(const char *log, uint8_t lvl, size_t *tag_len);
 void elog_hexdump(const char *name, uint8_t width, const void *buf, uint16_t size);
+void elog_defer_output(uint8_t level, const char *fmt, size_t nargs, ...);
+void (elog_hexdump_defer)(const char *name, const void *buf, uint16_t size);
+/* only the address of the name is sent and the host decoder looks it up in the .axf, so the name
+ * must be a string literal (it is in flash): a string on the stack or heap does not compile here */
+#define elog_hexdump_defer(name, buf, size)  (elog_hexdump_defer)("" name, buf, size)
+
+/**
+ * check the cached filter result of a log call site
+ *
+ * @param site call site
+ * @param level log level
+ * @param tag log tag
+ *
+ * @return true: the log passes the level and tag filters
+ */
+static inline bool elog_site_enabled(ElogSite *site, uint8_t level, const char *tag) {
+    /* the state is read before the tag, it is only written for the tag the site keeps */
+    uint32_t state = site->state;
+    const char *site_tag = site->tag;
+
+    if ((state >> 8) != elog_filter_gen || site_tag != tag) {
+        if (site_tag == elog_site_tag_multi) {
+            return elog_site_multi_enabled(level, tag);
+        }
+        return level < elog_site_resolve(site, tag);
+    }
+    return level < (uint8_t)state;
+}
 
 #define elog_a(tag, ...)     elog_assert(tag, __VA_ARGS__)
 #define elog_e(tag, ...)     elog_error(tag, __VA_ARGS__)
@@ -229,6 +380,18 @@ void elog_hexdump(const char *name, uint8_t width, const void *buf, uint16_t siz
 #define elog_d(tag, ...)     elog_debug(tag, __VA_ARGS__)
 #define elog_v(tag, ...)     elog_verbose(tag, __VA_ARGS__)
 
+#define elog_limited_e(tag, ...) elog_limited(ELOG_LVL_ERROR, tag, __VA_ARGS__)
+#define elog_limited_w(tag, ...) elog_limited(ELOG_LVL_WARN, tag, __VA_ARGS__)
+#define elog_limited_i(tag, ...) elog_limited(ELOG_LVL_INFO, tag, __VA_ARGS__)
+#define elog_limited_d(tag, ...) elog_limited(ELOG_LVL_DEBUG, tag, __VA_ARGS__)
+#define elog_limited_v(tag, ...) elog_limited(ELOG_LVL_VERBOSE, tag, __VA_ARGS__)
+
+#define elog_defer_e(tag, ...) elog_defer(ELOG_LVL_ERROR, tag, __VA_ARGS__)
+#define elog_defer_w(tag, ...) elog_defer(ELOG_LVL_WARN, tag, __VA_ARGS__)
+#define elog_defer_i(tag, ...) elog_defer(ELOG_LVL_INFO, tag, __VA_ARGS__)
+#define elog_defer_d(tag, ...) elog_defer(ELOG_LVL_DEBUG, tag, __VA_ARGS__)
+#define elog_defer_v(tag, ...) elog_defer(ELOG_LVL_VERBOSE, tag, __VA_ARGS__)
+
 /**
  * log API short definition
  * NOTE: The `LOG_TAG` and `LOG_LVL` must defined before including the <elog.h> when you want to use log_x API.
@@ -283,6 +446,9 @@ void elog_flush(void);
 void elog_async_enabled(bool enabled);
 size_t elog_async_get_log(char *log, size_t size);
 size_t elog_async_get_line_log(char *log, size_t size);
+uint32_t elog_async_get_drop_count(void);
+char *elog_async_get_line_buf(void);
+void elog_async_put_line_buf(uint8_t level, char *log, size_t size);
 
 /* elog_utils.c */
 size_t elog_strcpy(size_t cur_len, char *dst, const char *src);
@@ -32,19 +32,22 @@
 /* enable log output. */
 #define ELOG_OUTPUT_ENABLE
 /* setting static output log level. range: from ELOG_LVL_ASSERT to ELOG_LVL_VERBOSE */
+/* a module lowers its own ceiling by defining ELOG_LOCAL_LVL before including <elog.h> */
 #define ELOG_OUTPUT_LVL                          ELOG_LVL_VERBOSE
 /* enable assert check */
 #define ELOG_ASSERT_ENABLE
-/* buffer size for every line's log */
-#define ELOG_LINE_BUF_SIZE                       1024
+/* buffer size for every line's log, it is also the size of each async line slot (x ELOG_ASYNC_LINE_SLOT_NUM) */
+/* 256: the longest line of this project is about 190 bytes (color ~12, tag 16, time ~16, file path ~45,
+ * longest CLI message ~100), a longer line is cut and ends with ELOG_LINE_CUT_SIGN ("...") */
+#define ELOG_LINE_BUF_SIZE                       256
 /* output line number max length */
 #define ELOG_LINE_NUM_MAX_LEN                    5
 /* output filter's tag max length */
 #define ELOG_FILTER_TAG_MAX_LEN                  30
 /* output filter's keyword max length */
 #define ELOG_FILTER_KW_MAX_LEN                   16
-/* output filter's tag level max num */
-#define ELOG_FILTER_TAG_LVL_MAX_NUM              5
+/* output filter's tag level max num, it is the hash table size and must be power of 2 */
+#define ELOG_FILTER_TAG_LVL_MAX_NUM              32
 /* output newline sign */
 #define ELOG_NEWLINE_SIGN                        "\n"
 /*---------------------------------------------------------------------------*/
@@ -64,20 +67,42 @@
 #define ELOG_FMT_USING_DIR
 #define ELOG_FMT_USING_LINE
 /*---------------------------------------------------------------------------*/
+/* enable per call site rate limit (token bucket) of the elog_limited() sites, assert logs are never limited */
+#define ELOG_RATE_LIMIT_ENABLE
+/* max burst of one call site (bucket size, at most 255) */
+#define ELOG_RATE_LIMIT_BURST                    10
+/* one token is added every period (ms), 100 ms means 10 lines per second for one call site */
+#define ELOG_RATE_LIMIT_PERIOD_MS                100
+/* collapse the identical consecutive lines of one elog_limited() site into "last message repeated N times" */
+#define ELOG_REPEAT_COLLAPSE_ENABLE
+/*---------------------------------------------------------------------------*/
 /* enable asynchronous output mode */
-//#define ELOG_ASYNC_OUTPUT_ENABLE
+#define ELOG_ASYNC_OUTPUT_ENABLE
 /* the highest output level for async mode, other level will sync output */
-#define ELOG_ASYNC_OUTPUT_LVL                    ELOG_LVL_ASSERT
-/* buffer size for asynchronous output mode */
-#define ELOG_ASYNC_OUTPUT_BUF_SIZE               (ELOG_LINE_BUF_SIZE * 10)
-/* each asynchronous output's log which must end with newline sign */
-#define ELOG_ASYNC_LINE_OUTPUT
+/* assert logs stay synchronous, they are usually followed by a halt and would never be drained */
+#define ELOG_ASYNC_OUTPUT_LVL                    ELOG_LVL_ERROR
+/* buffer size for asynchronous output mode (not used by the FreeRTOS backend) */
+#define ELOG_ASYNC_OUTPUT_BUF_SIZE               (ELOG_LINE_BUF_SIZE * 4)
+/* each asynchronous output's log which must end with newline sign (not used by the FreeRTOS backend) */
+//#define ELOG_ASYNC_LINE_OUTPUT
 /* asynchronous output mode using POSIX pthread implementation */
-#define ELOG_ASYNC_OUTPUT_USING_PTHREAD
+//#define ELOG_ASYNC_OUTPUT_USING_PTHREAD
+/* asynchronous output mode using FreeRTOS, logs are packaged in the slots of a lock-free queue and output by a low priority drain task */
+#define ELOG_ASYNC_OUTPUT_USING_FREERTOS
+/* line slot number of the FreeRTOS backend (power of 2), each slot is a ELOG_LINE_BUF_SIZE staging buffer */
+#define ELOG_ASYNC_LINE_SLOT_NUM                 16
+/* a slot reserved but not published for this time (ms) is skipped by the drain task, it bounds the delay
+ * a preempted low priority producer causes to the logs behind it, the late line is dropped and counted */
+#define ELOG_ASYNC_LINE_STALE_MS                 10
 /*---------------------------------------------------------------------------*/
 /* enable buffered output mode */
 //#define ELOG_BUF_OUTPUT_ENABLE
 /* buffer size for buffered output mode */
 #define ELOG_BUF_OUTPUT_BUF_SIZE                 (ELOG_LINE_BUF_SIZE * 10)
+/*---------------------------------------------------------------------------*/
+/* enable deferred (binary) output mode, the format strings are rendered on the host */
+#define ELOG_DEFER_OUTPUT_ENABLE
+/* linker section which collects the format strings of deferred logs */
+#define ELOG_DEFER_SECTION                       ".elog_fmt"
 
 #endif /* _ELOG_CFG_H_ */
@@ -30,6 +30,7 @@
 
 #include <stdio.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -37,10 +38,31 @@
 
 #ifdef ELOG_FILE_ENABLE
 
+#ifndef ELOG_FILE_BUF_SIZE
+#define ELOG_FILE_BUF_SIZE             0
+#endif
+
+#ifndef ELOG_FILE_BUF_ALIGN
+#define ELOG_FILE_BUF_ALIGN            4096
+#endif
+
+/* suffix of the log file which is rotated out and waiting for the background rotation */
+#define ROTATING_SUFFIX                ".rot"
+
 /* initialize OK flag */
 static bool init_ok = false;
 static FILE *fp = NULL;
 static ElogFileCfg local_cfg;
+/* current file size, it is tracked in memory instead of seeking on every write */
+static size_t file_size = 0;
+/* the last rotated file is still being moved by elog_file_rotate_shift() */
+static volatile bool rotate_pending = false;
+#if ELOG_FILE_BUF_SIZE > 0
+/* write buffer of the file, the logs go to the file in large blocks.
+ * The buffer is placed on an ELOG_FILE_BUF_ALIGN boundary inside this array (C99 has no aligned
+ * static storage), so every block is copied out of whole pages. */
+static char file_buf_raw[ELOG_FILE_BUF_SIZE + ELOG_FILE_BUF_ALIGN - 1];
+#endif
 
 ElogErrCode elog_file_init(void)
 {
@@ -57,6 +79,9 @@ ElogErrCode elog_file_init(void)
     cfg.max_rotate = ELOG_FILE_MAX_ROTATE;
 
     elog_file_config(&cfg);
+    /* finish the rotation which was interrupted last time */
+    rotate_pending = true;
+    elog_file_rotate_shift();
 
     init_ok = true;
 __exit:
@@ -64,25 +89,87 @@ __exit:
 }
 
 /*
- * rotate the log file xxx.log.n-1 => xxx.log.n, and xxx.log => xxx.log.0
+ * open the log file and get its size, only once for every opening
+ */
+static void elog_file_open(void)
+{
+    file_size = 0;
+    fp = fopen(local_cfg.name, "a+");
+    if (fp == NULL)
+        return;
+
+#if ELOG_FILE_BUF_SIZE > 0
+    /* must be set before any other operation on the file */
+    setvbuf(fp, (char *)(((uintptr_t)file_buf_raw + ELOG_FILE_BUF_ALIGN - 1) & ~(uintptr_t)(ELOG_FILE_BUF_ALIGN - 1)),
+            _IOFBF, ELOG_FILE_BUF_SIZE);
+#endif
+    if (fseek(fp, 0L, SEEK_END) == 0) {
+        long pos = ftell(fp);
+        file_size = (pos > 0) ? (size_t)pos : 0;
+    }
+}
+
+/*
+ * rotate the log file out: xxx.log => xxx.log.rot, and open a new xxx.log
+ * It is called with the lock held, so it only does one rename. The slow part (moving the
+ * older files) is done by elog_file_rotate_shift() after elog_file_port_rotate_notify().
  */
 static bool elog_file_rotate(void)
+{
+    char path[256] = {0};
+    int err;
+
+    /* the last rotation is still running, go on with the current file until it is done */
+    if (rotate_pending)
+        return true;
+
+    snprintf(path, sizeof(path), "%s" ROTATING_SUFFIX, local_cfg.name);
+
+    fclose(fp);
+    err = rename(local_cfg.name, path);
+    /* rename is atomic, the new file takes the name at once */
+    elog_file_open();
+    if (err < 0)
+        return false;
+
+    rotate_pending = true;
+    elog_file_port_rotate_notify();
+
+    return fp != NULL;
+}
+
+/**
+ * move the rotated log file to xxx.log.0, xxx.log.n-1 => xxx.log.n, ... xxx.log.rot => xxx.log.0
+ * It is called by the port after elog_file_port_rotate_notify(), without holding the lock.
+ * Nothing is moved when there is no xxx.log.rot.
+ */
+void elog_file_rotate_shift(void)
 {
 #define SUFFIX_LEN                     10
-    /* mv xxx.log.n-1 => xxx.log.n, and xxx.log => xxx.log.0 */
     int n, err = 0;
     char oldpath[256]= {0}, newpath[256] = {0};
-    size_t base = strlen(local_cfg.name);
-    bool result = true;
+    size_t base;
     FILE *tmp_fp;
 
+    if (!rotate_pending)
+        return;
+
+    base = strlen(local_cfg.name);
+    if (base + SUFFIX_LEN > sizeof(oldpath))
+        goto __exit;
     memcpy(oldpath, local_cfg.name, base);
     memcpy(newpath, local_cfg.name, base);
 
-    fclose(fp);
+    snprintf(oldpath + base, SUFFIX_LEN, ROTATING_SUFFIX);
+    if ((tmp_fp = fopen(oldpath , "r")) == NULL)
+        goto __exit;
+    fclose(tmp_fp);
 
     for (n = local_cfg.max_rotate - 1; n >= 0; --n) {
-        snprintf(oldpath + base, SUFFIX_LEN, n ? ".%d" : "", n - 1);
+        if (n)
+            snprintf(oldpath + base, SUFFIX_LEN, ".%d", n - 1);
+        else
+            snprintf(oldpath + base, SUFFIX_LEN, ROTATING_SUFFIX);
         snprintf(newpath + base, SUFFIX_LEN, ".%d", n);
         /* remove the old file */
         if ((tmp_fp = fopen(newpath , "r")) != NULL) {
@@ -95,24 +182,16 @@ static bool elog_file_rotate(void)
             err = rename(oldpath, newpath);
         }
 
-        if (err < 0) {
-            result = false;
-            goto __exit;
-        }
+        if (err < 0)
+            break;
     }
 
 __exit:
-    /* reopen the file */
-    fp = fopen(local_cfg.name, "a+");
-
-    return result;
+    rotate_pending = false;
 }
 
-
 void elog_file_write(const char *log, size_t size)
 {
-    size_t file_size = 0;
-
     ELOG_ASSERT(init_ok);
     ELOG_ASSERT(log);
     if(fp == NULL) {
@@ -121,9 +200,6 @@ void elog_file_write(const char *log, size_t size)
 
     elog_file_port_lock();
 
-    fseek(fp, 0L, SEEK_END);
-    file_size = ftell(fp);
-
     if (unlikely(file_size > local_cfg.max_size)) {
 #if ELOG_FILE_MAX_ROTATE > 0
         if (!elog_file_rotate()) {
@@ -133,8 +209,12 @@ void elog_file_write(const char *log, size_t size)
         goto __exit;
 #endif
     }
+    if (fp == NULL) {
+        goto __exit;
+    }
 
     fwrite(log, size, 1, fp);
+    file_size += size;
 
 #ifdef ELOG_FILE_FLUSH_CACHE_ENABLE
     fflush(fp);
@@ -144,6 +224,21 @@ __exit:
     elog_file_port_unlock();
 }
 
+/**
+ * write the buffered logs to the file
+ * It should be called periodically when ELOG_FILE_FLUSH_CACHE_ENABLE is not defined,
+ * the pthread port does it every ELOG_FILE_FLUSH_PERIOD ms.
+ */
+void elog_file_flush(void)
+{
+    elog_file_port_lock();
+
+    if (fp)
+        fflush(fp);
+
+    elog_file_port_unlock();
+}
+
 void elog_file_deinit(void)
 {
     ELOG_ASSERT(init_ok);
@@ -172,7 +267,7 @@ void elog_file_config(ElogFileCfg *cfg)
         local_cfg.max_rotate = cfg->max_rotate;
 
         if (local_cfg.name != NULL && strlen(local_cfg.name) > 0)
-            fp = fopen(local_cfg.name, "a+");
+            elog_file_open();
     }
 
     elog_file_port_unlock();
@@ -56,6 +56,8 @@ typedef struct {
 /* elog_file.c */
 ElogErrCode elog_file_init(void);
 void elog_file_write(const char *log, size_t size);
+void elog_file_flush(void);
+void elog_file_rotate_shift(void);
 void elog_file_config(ElogFileCfg *cfg);
 void elog_file_deinit(void);
 
@@ -63,6 +65,7 @@ void elog_file_deinit(void);
 ElogErrCode elog_file_port_init(void);
 void elog_file_port_lock(void);
 void elog_file_port_unlock(void);
+void elog_file_port_rotate_notify(void);
 void elog_file_port_deinit(void);
 
 #ifdef __cplusplus
@@ -38,4 +38,20 @@
 /* EasyLogger file log plugin's using max rotate file count */
 #define ELOG_FILE_MAX_ROTATE           /* @note you must define it for a value */
 
+/* EasyLogger file log plugin's write buffer size, the logs are written to the file in blocks of this size */
+#define ELOG_FILE_BUF_SIZE             (64 * 1024)
+
+/* alignment of the write buffer (bytes, power of 2), a page keeps the blocks off partial pages */
+#define ELOG_FILE_BUF_ALIGN            4096
+
+/* flush the file after every log, otherwise call elog_file_flush() periodically */
+//#define ELOG_FILE_FLUSH_CACHE_ENABLE
+
+/* period of elog_file_flush() in the background thread of the pthread port (ms), 0: never,
+ * the buffered logs reach the file at most this late */
+#define ELOG_FILE_FLUSH_PERIOD         1000
+
+/* the lock and the background rotation thread of the port using POSIX pthread */
+//#define ELOG_FILE_PORT_USING_PTHREAD
+
 #endif /* _ELOG_FILE_CFG_H_ */
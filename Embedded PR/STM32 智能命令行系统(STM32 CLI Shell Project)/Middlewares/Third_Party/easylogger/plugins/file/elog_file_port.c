@@ -28,6 +28,82 @@
 
 #include "elog_file.h"
 
+#ifdef ELOG_FILE_PORT_USING_PTHREAD
+#include <errno.h>
+#include <time.h>
+#include <pthread.h>
+
+#if !defined(ELOG_FILE_FLUSH_PERIOD) || defined(ELOG_FILE_FLUSH_CACHE_ENABLE)
+#undef ELOG_FILE_FLUSH_PERIOD
+#define ELOG_FILE_FLUSH_PERIOD         0
+#endif
+
+static pthread_mutex_t file_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_mutex_t rotate_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t rotate_cond = PTHREAD_COND_INITIALIZER;
+static pthread_t rotate_thread;
+static bool rotate_request = false, rotate_exit = false, rotate_thread_ok = false;
+
+#if ELOG_FILE_FLUSH_PERIOD > 0
+/*
+ * the next flush time, ELOG_FILE_FLUSH_PERIOD ms from now
+ */
+static void flush_due_next(struct timespec *due)
+{
+    clock_gettime(CLOCK_REALTIME, due);
+    due->tv_sec += ELOG_FILE_FLUSH_PERIOD / 1000;
+    due->tv_nsec += (ELOG_FILE_FLUSH_PERIOD % 1000) * 1000000L;
+    if (due->tv_nsec >= 1000000000L) {
+        due->tv_sec++;
+        due->tv_nsec -= 1000000000L;
+    }
+}
+#endif
+
+/**
+ * background thread, it moves the rotated log files without blocking the writers,
+ * and flushes the write buffer every ELOG_FILE_FLUSH_PERIOD ms
+ * A rotation requested before the exit is still done.
+ */
+static void *rotate_entry(void *arg)
+{
+#if ELOG_FILE_FLUSH_PERIOD > 0
+    struct timespec due;
+    bool flush;
+
+    flush_due_next(&due);
+#endif
+
+    (void)arg;
+    pthread_mutex_lock(&rotate_lock);
+    for (;;) {
+#if ELOG_FILE_FLUSH_PERIOD > 0
+        flush = false;
+        while (!rotate_request && !rotate_exit && !flush)
+            flush = (pthread_cond_timedwait(&rotate_cond, &rotate_lock, &due) == ETIMEDOUT);
+        if (flush && !rotate_request && !rotate_exit) {
+            pthread_mutex_unlock(&rotate_lock);
+            elog_file_flush();
+            pthread_mutex_lock(&rotate_lock);
+            flush_due_next(&due);
+            continue;
+        }
+#else
+        while (!rotate_request && !rotate_exit)
+            pthread_cond_wait(&rotate_cond, &rotate_lock);
+#endif
+        if (!rotate_request)
+            break;
+        rotate_request = false;
+        pthread_mutex_unlock(&rotate_lock);
+        elog_file_rotate_shift();
+        pthread_mutex_lock(&rotate_lock);
+    }
+    pthread_mutex_unlock(&rotate_lock);
+    return NULL;
+}
+#endif /* ELOG_FILE_PORT_USING_PTHREAD */
+
 /**
  * EasyLogger flile log pulgin port initialize
  *
@@ -38,6 +114,10 @@ ElogErrCode elog_file_port_init(void)
     ElogErrCode result = ELOG_NO_ERR;
 
     /* add your code here */
+#ifdef ELOG_FILE_PORT_USING_PTHREAD
+    rotate_exit = false;
+    rotate_thread_ok = (pthread_create(&rotate_thread, NULL, rotate_entry, NULL) == 0);
+#endif
 
     return result;
 }
@@ -48,6 +128,9 @@ ElogErrCode elog_file_port_init(void)
 void elog_file_port_lock(void) {
 
     /* add your code here */
+#ifdef ELOG_FILE_PORT_USING_PTHREAD
+    pthread_mutex_lock(&file_lock);
+#endif
 
 }
 
@@ -57,6 +140,30 @@ void elog_file_port_lock(void) {
 void elog_file_port_unlock(void) {
 
     /* add your code here */
+#ifdef ELOG_FILE_PORT_USING_PTHREAD
+    pthread_mutex_unlock(&file_lock);
+#endif
+
+}
+
+/**
+ * the log file has been rotated out (called with the lock held),
+ * elog_file_rotate_shift() should be called to move the old files
+ */
+void elog_file_port_rotate_notify(void) {
+
+    /* add your code here */
+#ifdef ELOG_FILE_PORT_USING_PTHREAD
+    if (rotate_thread_ok) {
+        pthread_mutex_lock(&rotate_lock);
+        rotate_request = true;
+        pthread_cond_signal(&rotate_cond);
+        pthread_mutex_unlock(&rotate_lock);
+        return;
+    }
+#endif
+    /* no background thread, move them at once */
+    elog_file_rotate_shift();
 
 }
 
@@ -66,5 +173,17 @@ void elog_file_port_unlock(void) {
 void elog_file_port_deinit(void) {
 
     /* add your code here */
+#ifdef ELOG_FILE_PORT_USING_PTHREAD
+    if (rotate_thread_ok) {
+        pthread_mutex_lock(&rotate_lock);
+        rotate_exit = true;
+        pthread_cond_signal(&rotate_cond);
+        pthread_mutex_unlock(&rotate_lock);
+        /* the thread does a rotation requested before this and then exits,
+         * one interrupted by a crash is done by the next elog_file_init() */
+        pthread_join(rotate_thread, NULL);
+        rotate_thread_ok = false;
+    }
+#endif
 
 }
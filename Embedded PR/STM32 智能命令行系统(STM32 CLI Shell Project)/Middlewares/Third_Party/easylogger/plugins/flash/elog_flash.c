@@ -22,24 +22,60 @@
  * TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
  * SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  *
- * Function: Save log to flash. Must use EasyFlash(https://github.com/armink/EasyFlash) library.
+ * Function: Save log to the internal flash. The log sectors are used as an append-only ring.
  * Created on: 2015-06-05
  */
 
 #define LOG_TAG    "elog.flash"
 
 #include "elog_flash.h"
-#include <easyflash.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-#ifdef ELOG_FLASH_USING_BUF_MODE
-/* flash log buffer */
-static char log_buf[ELOG_FLASH_BUF_SIZE] = { 0 };
+/*
+ * Flash layout
+ *
+ * Every sector starts with a header: [magic] [sequence], the sequence increases by one for each
+ * newly erased sector, so the newest sector has the largest sequence and the sectors are erased
+ * in turn (even wear). Records are appended after the header:
+ *
+ *     [len | ~len << 16] [log data, padded to 4 bytes]
+ *
+ * The data is programmed before the record header, so a record is only visible after it is
+ * completely written. An erased word (0xFFFFFFFF) or a broken header ends the sector.
+ */
+#define SECTOR_MAGIC                   0x474F4C45 /* "ELOG" */
+#define SECTOR_HEADER_SIZE             8
+#define RECORD_HEADER_SIZE             4
+/* flash is read with this buffer */
+#define READ_BUF_SIZE                  256
+/* the used size of a sector is not scanned yet */
+#define USED_UNKNOWN                   ((size_t)-1)
+
+#if ELOG_FLASH_BUF_SIZE % 4 != 0 || ELOG_FLASH_BUF_SIZE > 0xFFFF
+    #error "ELOG_FLASH_BUF_SIZE must be word aligned and less than 64KB"
+#endif
+
+#if ELOG_FLASH_BUF_SIZE + SECTOR_HEADER_SIZE + RECORD_HEADER_SIZE > ELOG_FLASH_SECTOR_SIZE
+    #error "ELOG_FLASH_BUF_SIZE is too large for the flash sector"
+#endif
+
+/* flash log buffer, the flash is programmed by words */
+static uint32_t log_buf[ELOG_FLASH_BUF_SIZE / 4];
 /* current flash log buffer write position  */
 static size_t cur_buf_size = 0;
-#endif
+/* flash read buffer */
+static uint32_t read_buf[READ_BUF_SIZE / 4];
+
+/* the newest sector, records are appended to it */
+static size_t cur_sector = 0;
+/* sequence of the newest sector, 0: no sector is written yet */
+static uint32_t cur_seq = 0;
+/* next record position in the newest sector */
+static size_t cur_offset = 0;
+/* log size saved in each sector (without headers and padding) */
+static size_t sector_used[ELOG_FLASH_SECTOR_NUM];
 
 /* initialize OK flag */
 static bool init_ok = false;
@@ -52,6 +88,221 @@ static bool log_buf_is_locked_before_disable = false;
 static void log_buf_lock(void);
 static void log_buf_unlock(void);
 
+/**
+ * read the sequence of sector
+ *
+ * @param sector sector index
+ *
+ * @return sequence, 0: the sector is erased or the header is broken
+ */
+static uint32_t sector_read_seq(size_t sector) {
+    uint32_t header[SECTOR_HEADER_SIZE / 4];
+
+    elog_flash_port_read(sector, 0, header, sizeof(header));
+    if (header[0] != SECTOR_MAGIC || header[1] == 0xFFFFFFFF) {
+        return 0;
+    }
+    return header[1];
+}
+
+/**
+ * read the record header
+ *
+ * @param sector sector index
+ * @param offset record position
+ * @param len log size of the record
+ *
+ * @return true: it is a complete record
+ */
+static bool record_read(size_t sector, size_t offset, size_t *len) {
+    uint32_t header;
+
+    if (offset + RECORD_HEADER_SIZE > ELOG_FLASH_SECTOR_SIZE) {
+        return false;
+    }
+    elog_flash_port_read(sector, offset, &header, sizeof(header));
+    if ((header >> 16) != (~header & 0xFFFF)) {
+        return false;
+    }
+    *len = header & 0xFFFF;
+    /* a broken length must not run out of the sector */
+    return offset + RECORD_HEADER_SIZE + ((*len + 3) & ~3) <= ELOG_FLASH_SECTOR_SIZE;
+}
+
+/**
+ * walk all records in the sector
+ *
+ * @param sector sector index
+ * @param end the position after the last record
+ *
+ * @return log size saved in the sector
+ */
+static size_t sector_scan(size_t sector, size_t *end) {
+    size_t offset = SECTOR_HEADER_SIZE, used = 0, len;
+
+    while (record_read(sector, offset, &len)) {
+        used += len;
+        offset += RECORD_HEADER_SIZE + ((len + 3) & ~3);
+    }
+    *end = offset;
+
+    return used;
+}
+
+/**
+ * check the sector is erased from the position to the end
+ */
+static bool sector_is_erased(size_t sector, size_t offset) {
+    size_t size, i;
+
+    while (offset < ELOG_FLASH_SECTOR_SIZE) {
+        size = ELOG_FLASH_SECTOR_SIZE - offset;
+        if (size > sizeof(read_buf)) {
+            size = sizeof(read_buf);
+        }
+        elog_flash_port_read(sector, offset, read_buf, size);
+        for (i = 0; i < size / 4; i++) {
+            if (read_buf[i] != 0xFFFFFFFF) {
+                return false;
+            }
+        }
+        offset += size;
+    }
+
+    return true;
+}
+
+/**
+ * get the log size saved in the sector, the sectors which are full are scanned only once
+ *
+ * @param sector sector index
+ *
+ * @return log size, 0: the sector is not a part of the ring
+ */
+static size_t sector_get_used(size_t sector) {
+    uint32_t seq;
+    size_t end;
+
+    if (sector_used[sector] == USED_UNKNOWN) {
+        seq = sector_read_seq(sector);
+        /* older than the newest sector, otherwise it is left from a broken erase */
+        if (seq != 0 && seq < cur_seq) {
+            sector_used[sector] = sector_scan(sector, &end);
+        } else {
+            sector_used[sector] = 0;
+        }
+    }
+
+    return sector_used[sector];
+}
+
+/**
+ * find the newest sector and the end of its records
+ *
+ * The sequences are increasing from the oldest sector to the newest sector in the ring, and there
+ * is at most one erased (or broken) sector after the newest one. So start from the first valid one
+ * of sector 0 and 1, the sectors which sequence is not smaller than it are a continuous part of the
+ * ring, and the newest sector is the last one of this part. It is found by binary search.
+ */
+static void sector_recover(void) {
+    size_t first, low, high, mid, prev, i;
+    uint32_t first_seq;
+
+    for (i = 0; i < ELOG_FLASH_SECTOR_NUM; i++) {
+        sector_used[i] = USED_UNKNOWN;
+    }
+    first = (sector_read_seq(0) != 0) ? 0 : 1;
+    first_seq = sector_read_seq(first);
+    if (first_seq == 0) {
+        /* nothing saved, the first write erases sector 0 */
+        cur_sector = ELOG_FLASH_SECTOR_NUM - 1;
+        cur_seq = 0;
+        cur_offset = ELOG_FLASH_SECTOR_SIZE;
+        sector_used[cur_sector] = 0;
+        return;
+    }
+    /* low: in the part, high: out of the part */
+    low = 0;
+    high = ELOG_FLASH_SECTOR_NUM;
+    while (high - low > 1) {
+        mid = low + (high - low) / 2;
+        if (sector_read_seq((first + mid) % ELOG_FLASH_SECTOR_NUM) >= first_seq) {
+            low = mid;
+        } else {
+            high = mid;
+        }
+    }
+    cur_sector = (first + low) % ELOG_FLASH_SECTOR_NUM;
+    cur_seq = sector_read_seq(cur_sector);
+    sector_used[cur_sector] = sector_scan(cur_sector, &cur_offset);
+    /* a record is broken by power loss, the remaining space can not be programmed any more */
+    if (!sector_is_erased(cur_sector, cur_offset)) {
+        prev = (cur_sector + ELOG_FLASH_SECTOR_NUM - 1) % ELOG_FLASH_SECTOR_NUM;
+        if (sector_used[cur_sector] == 0 && cur_seq > 1 && sector_read_seq(prev) == cur_seq - 1) {
+            /* nothing is saved in it, so the next record erases it again instead of the oldest sector,
+             * otherwise every power loss in the first record of a sector costs a sector of saved log */
+            cur_sector = prev;
+            cur_seq--;
+            sector_used[cur_sector] = sector_scan(cur_sector, &cur_offset);
+        }
+        cur_offset = ELOG_FLASH_SECTOR_SIZE;
+    }
+}
+
+/**
+ * erase the oldest sector and make it the newest one
+ *
+ * @return true: OK
+ */
+static bool sector_next(void) {
+    size_t next = (cur_sector + 1) % ELOG_FLASH_SECTOR_NUM;
+    uint32_t seq = cur_seq + 1;
+    uint32_t magic = SECTOR_MAGIC;
+
+    sector_used[next] = 0;
+    if (!elog_flash_port_erase(next)) {
+        return false;
+    }
+    /* the sequence is programmed before the magic, the same as the records */
+    if (!elog_flash_port_write(next, 4, &seq, sizeof(seq))
+            || !elog_flash_port_write(next, 0, &magic, sizeof(magic))) {
+        return false;
+    }
+    cur_sector = next;
+    cur_seq = seq;
+    cur_offset = SECTOR_HEADER_SIZE;
+
+    return true;
+}
+
+/**
+ * write all buffered log to flash as one record, the flash log buffer must be locked
+ */
+static void log_buf_flush(void) {
+    size_t size = (cur_buf_size + 3) & ~3;
+    uint32_t header = (uint32_t)cur_buf_size | ((~(uint32_t)cur_buf_size & 0xFFFF) << 16);
+
+    if (cur_buf_size == 0) {
+        return;
+    }
+    /* padding keeps erased, it is not written to flash actually */
+    memset((char *)log_buf + cur_buf_size, 0xFF, size - cur_buf_size);
+    if (cur_offset + RECORD_HEADER_SIZE + size > ELOG_FLASH_SECTOR_SIZE && !sector_next()) {
+        /* erase error, drop the buffered log and try the next sector next time */
+        cur_buf_size = 0;
+        return;
+    }
+    if (elog_flash_port_write(cur_sector, cur_offset + RECORD_HEADER_SIZE, log_buf, size)
+            && elog_flash_port_write(cur_sector, cur_offset, &header, sizeof(header))) {
+        sector_used[cur_sector] += cur_buf_size;
+        cur_offset += RECORD_HEADER_SIZE + size;
+    } else {
+        /* the remaining space may be dirty, the next record goes to the next sector */
+        cur_offset = ELOG_FLASH_SECTOR_SIZE;
+    }
+    cur_buf_size = 0;
+}
+
 /**
  * EasyLogger flash log plugin initialize.
  *
@@ -60,67 +311,97 @@ static void log_buf_unlock(void);
 ElogErrCode elog_flash_init(void) {
     ElogErrCode result = ELOG_NO_ERR;
 
-    /* buffer size must be word alignment */
-    ELOG_ASSERT(ELOG_FLASH_BUF_SIZE % 4 == 0);
-
-#ifdef ELOG_FLASH_USING_BUF_MODE
     /* initialize current flash log buffer write position */
     cur_buf_size = 0;
-#endif
 
     /* port initialize */
-    elog_flash_port_init();
+    result = elog_flash_port_init();
+    if (result != ELOG_NO_ERR) {
+        return result;
+    }
+    sector_recover();
     /* initialize OK */
     init_ok = true;
 
     return result;
 }
 
+/**
+ * get the log size saved in flash
+ *
+ * @return log size (without the buffered log)
+ */
+size_t elog_flash_get_used_size(void) {
+    size_t size = 0, i;
+
+    /* must be call this function after initialize OK */
+    ELOG_ASSERT(init_ok);
+    /* lock flash log buffer */
+    log_buf_lock();
+    for (i = 0; i < ELOG_FLASH_SECTOR_NUM; i++) {
+        size += sector_get_used(i);
+    }
+    /* unlock flash log buffer */
+    log_buf_unlock();
+
+    return size;
+}
+
 /**
  * Read and output log which saved in flash.
+ * The sectors before the position are skipped by their used size, only the records in the
+ * starting sector are walked, so reading the recent log does not depend on the saved log size.
  *
- * @param index index for saved log. @note It will auto word alignment.
+ * @param index index for saved log, from the oldest log.
  *        Minimum index is 0.
  *        Maximum index is log used flash total size - 1.
  * @param size
  */
 void elog_flash_output(size_t index, size_t size) {
-    /* 128 bytes buffer */
-    uint32_t buf[32] = { 0 };
-    size_t log_total_size = ef_log_get_used_size();
-    size_t buf_size = sizeof(buf);
-    size_t read_size = 0, read_overage_size = 0;
-
-    /* word alignment for index */
-    index = index / 4 * 4;
+    size_t log_total_size = elog_flash_get_used_size();
+    size_t sector, offset, used, len, read_size, i;
+
     if (index + size > log_total_size) {
         log_i("The output position and size is out of bound. The max size is %d.", log_total_size);
         return;
     }
-    /* must be call this function after initialize OK */
-    ELOG_ASSERT(init_ok);
     /* lock flash log buffer */
     log_buf_lock();
-    /* output all flash saved log. It will use filter */
-    while (true) {
-        if (read_size + buf_size < size) {
-            ef_log_read(index + read_size, buf, buf_size);
-            elog_flash_port_output((const char*)buf, buf_size);
-            read_size += buf_size;
-        } else {
-            /* flash read is word alignment */
-            if ((size - read_size) % 4 == 0) {
-                read_overage_size = 0;
+    /* from the oldest sector to the newest one */
+    for (i = 1; i <= ELOG_FLASH_SECTOR_NUM && size > 0; i++) {
+        sector = (cur_sector + i) % ELOG_FLASH_SECTOR_NUM;
+        used = sector_get_used(sector);
+        if (index >= used) {
+            index -= used;
+            continue;
+        }
+        offset = SECTOR_HEADER_SIZE;
+        while (size > 0 && record_read(sector, offset, &len)) {
+            offset += RECORD_HEADER_SIZE;
+            if (index < len) {
+                /* output this record from the index */
+                offset += index;
+                len -= index;
+                index = 0;
+                while (size > 0 && len > 0) {
+                    read_size = (len < size) ? len : size;
+                    if (read_size > sizeof(read_buf)) {
+                        read_size = sizeof(read_buf);
+                    }
+                    elog_flash_port_read(sector, offset, read_buf, read_size);
+                    elog_flash_port_output((const char *)read_buf, read_size);
+                    offset += read_size;
+                    len -= read_size;
+                    size -= read_size;
+                }
             } else {
-                read_overage_size = 4 - ((size - read_size) % 4);
+                index -= len;
             }
-            ef_log_read(index + read_size, buf, size - read_size + read_overage_size);
-            elog_flash_port_output((const char*) buf + read_overage_size, size - read_size);
-            /* output newline sign */
-            elog_flash_port_output(ELOG_NEWLINE_SIGN, strlen(ELOG_NEWLINE_SIGN));
-            break;
+            offset = (offset + len + 3) & ~3;
         }
     }
+    /* output newline sign */
+    elog_flash_port_output(ELOG_NEWLINE_SIGN, strlen(ELOG_NEWLINE_SIGN));
     /* unlock flash log buffer */
     log_buf_unlock();
 }
@@ -129,7 +410,7 @@ void elog_flash_output(size_t index, size_t size) {
  * Read and output all log which saved in flash.
  */
 void elog_flash_output_all(void) {
-    elog_flash_output(0, ef_log_get_used_size());
+    elog_flash_output(0, elog_flash_get_used_size());
 }
 
 /**
@@ -138,7 +419,7 @@ void elog_flash_output_all(void) {
  * @param size recent log size
  */
 void elog_flash_output_recent(size_t size) {
-    size_t max_size = ef_log_get_used_size();
+    size_t max_size = elog_flash_get_used_size();
 
     if (size == 0) {
         return;
@@ -152,21 +433,14 @@ void elog_flash_output_recent(size_t size) {
 }
 
 /**
- * Write log to flash. The flash write use buffer mode.
+ * Write log to flash. The log is buffered in RAM and written to flash as one record when the
+ * buffer is full (or it is flushed). In non buffer mode every call is written immediately.
  *
  * @param log log
  * @param size log size
  */
 void elog_flash_write(const char *log, size_t size) {
-
-#ifdef ELOG_FLASH_USING_BUF_MODE
-    size_t write_size = 0, write_index = 0;
-#else
-    size_t write_size_temp = 0;
-    EfErrCode result = EF_NO_ERR;
-    /* write some '\r' for word alignment */
-    char write_overage_c[4] = { '\r', '\r', '\r', '\r' };
-#endif
+    size_t write_size = 0;
 
     /* must be call this function after initialize OK */
     ELOG_ASSERT(init_ok);
@@ -174,36 +448,23 @@ void elog_flash_write(const char *log, size_t size) {
     /* lock flash log buffer */
     log_buf_lock();
 
-#ifdef ELOG_FLASH_USING_BUF_MODE
-    while (true) {
-        if (cur_buf_size + size > ELOG_FLASH_BUF_SIZE) {
-            write_size = ELOG_FLASH_BUF_SIZE - cur_buf_size;
-            elog_memcpy(log_buf + cur_buf_size, log + write_index, write_size);
-            write_index += write_size;
-            size -= write_size;
-            cur_buf_size += write_size;
-            /* unlock flash log buffer */
-            log_buf_unlock();
+    while (size > 0) {
+        if (cur_buf_size == ELOG_FLASH_BUF_SIZE) {
             /* write all buffered log to flash, cur_buf_size will reset */
-            elog_flash_flush();
-            /* lock flash log buffer */
-            log_buf_lock();
-        } else {
-            elog_memcpy(log_buf + cur_buf_size, log + write_index, size);
-            cur_buf_size += size;
-            break;
+            log_buf_flush();
         }
+        write_size = ELOG_FLASH_BUF_SIZE - cur_buf_size;
+        if (write_size > size) {
+            write_size = size;
+        }
+        elog_memcpy((char *)log_buf + cur_buf_size, log, write_size);
+        cur_buf_size += write_size;
+        log += write_size;
+        size -= write_size;
     }
-#else
-    /* calculate the word alignment write size */
-    write_size_temp = size / 4 * 4;
-    /* write log to flash */
-    result = ef_log_write((uint32_t *) log, write_size_temp);
-    /* write last word alignment data */
-    if ((result == EF_NO_ERR) && (write_size_temp != size)) {
-        elog_memcpy(write_overage_c, log + write_size_temp, size - write_size_temp);
-        ef_log_write((uint32_t *) write_overage_c, 4);
-    }
+
+#ifndef ELOG_FLASH_USING_BUF_MODE
+    log_buf_flush();
 #endif
 
     /* unlock flash log buffer */
@@ -215,22 +476,11 @@ void elog_flash_write(const char *log, size_t size) {
  * write all buffered log to flash
  */
 void elog_flash_flush(void) {
-    size_t write_overage_size = 0;
-
     /* must be call this function after initialize OK */
     ELOG_ASSERT(init_ok);
     /* lock flash log buffer */
     log_buf_lock();
-    /* flash write is word alignment */
-    if (cur_buf_size % 4 != 0) {
-        write_overage_size = 4 - (cur_buf_size % 4);
-    }
-    /* fill '\r' for word alignment */
-    memset(log_buf + cur_buf_size, '\r', write_overage_size);
-    /* write all buffered log to flash */
-    ef_log_write((uint32_t *) log_buf, cur_buf_size + write_overage_size);
-    /* reset position */
-    cur_buf_size = 0;
+    log_buf_flush();
     /* unlock flash log buffer */
     log_buf_unlock();
 }
@@ -240,24 +490,33 @@ void elog_flash_flush(void) {
  * clean all log which in flash and ram buffer
  */
 void elog_flash_clean(void) {
-    EfErrCode clean_result = EF_NO_ERR;
+    bool clean_ok = true;
+    size_t i;
 
     /* must be call this function after initialize OK */
     ELOG_ASSERT(init_ok);
     /* lock flash log buffer */
     log_buf_lock();
-    /* clean all log which in flash */
-    clean_result = ef_log_clean();
-
-#ifdef ELOG_FLASH_USING_BUF_MODE
+    /* from the last sector, the remaining sectors are still a valid ring when it is interrupted */
+    for (i = ELOG_FLASH_SECTOR_NUM; i > 0; i--) {
+        if (!elog_flash_port_erase(i - 1)) {
+            clean_ok = false;
+        }
+    }
+    /* the same as a new flash, the first write erases sector 0 */
+    for (i = 0; i < ELOG_FLASH_SECTOR_NUM; i++) {
+        sector_used[i] = 0;
+    }
+    cur_sector = ELOG_FLASH_SECTOR_NUM - 1;
+    cur_seq = 0;
+    cur_offset = ELOG_FLASH_SECTOR_SIZE;
     /* reset position */
     cur_buf_size = 0;
-#endif
 
     /* unlock flash log buffer */
     log_buf_unlock();
 
-    if(clean_result == EF_NO_ERR) {
+    if(clean_ok) {
         log_i("All logs which in flash is clean OK.");
     } else {
         log_e("Clean logs which in flash has an error!");
@@ -40,8 +40,16 @@ extern "C" {
     #error "Please configure RAM buffer size (in elog_flash_cfg.h)"
 #endif
 
+#if !defined(ELOG_FLASH_SECTOR_NUM) || !defined(ELOG_FLASH_SECTOR_SIZE)
+    #error "Please configure flash sector number and size (in elog_flash_cfg.h)"
+#endif
+
+#if ELOG_FLASH_SECTOR_NUM < 2
+    #error "ELOG_FLASH_SECTOR_NUM must be at least 2"
+#endif
+
 /* EasyLogger flash log plugin's software version number */
-#define ELOG_FLASH_SW_VERSION                "V2.0.1"
+#define ELOG_FLASH_SW_VERSION                "V3.0.0"
 
 /* elog_flash.c */
 ElogErrCode elog_flash_init(void);
@@ -52,6 +60,7 @@ void elog_flash_set_filter(uint8_t level,const char *tag,const char *keyword);
 void elog_flash_write(const char *log, size_t size);
 void elog_flash_clean(void);
 void elog_flash_lock_enabled(bool enabled);
+size_t elog_flash_get_used_size(void);
 
 #ifdef ELOG_FLASH_USING_BUF_MODE
 void elog_flash_flush(void);
@@ -59,6 +68,9 @@ void elog_flash_flush(void);
 
 /* elog_flash_port.c */
 ElogErrCode elog_flash_port_init(void);
+bool elog_flash_port_erase(size_t sector);
+bool elog_flash_port_write(size_t sector, size_t offset, const uint32_t *buf, size_t size);
+void elog_flash_port_read(size_t sector, size_t offset, void *buf, size_t size);
 void elog_flash_port_output(const char *log, size_t size);
 void elog_flash_port_lock(void);
 void elog_flash_port_unlock(void);
@@ -31,7 +31,28 @@
 
 /* EasyLogger flash log plugin's using buffer mode */
 #define ELOG_FLASH_USING_BUF_MODE
-/* EasyLogger flash log plugin's RAM buffer size */
-#define ELOG_FLASH_BUF_SIZE                  /* @note you must define it for a value */
+/* EasyLogger flash log plugin's RAM buffer size, it is also the max size of one flash record */
+#define ELOG_FLASH_BUF_SIZE                  1024
+/* number of flash sectors in the log ring, at least 2: the oldest sector is erased when all are full */
+#ifndef ELOG_FLASH_SECTOR_NUM
+#define ELOG_FLASH_SECTOR_NUM                2
+#endif
+/* flash sector size, all sectors in the ring must be the same size.
+ * @note Erase stall budget: the STM32F411 has a single flash bank, the CPU (and every interrupt
+ *       whose code is in flash) stalls while a sector is erased: 128KB sector typ 1 s, max 2 s
+ *       (16KB typ 0.25 s, max 0.5 s). It happens once per sector of saved logs, only in the flash
+ *       task at the idle priority (see elog_port.c), never in the caller of the log or the drain task.
+ *       The DMA keeps running but the UART RX DMA ring (2KB, 178 ms at 115200 baud) is not read
+ *       during the stall, so the input received in a long erase is overwritten. The port waits for
+ *       a pause of the input (ELOG_FLASH_ERASE_RX_IDLE) before it erases, and the input that still
+ *       arrives in the erase is counted as a UART RX overrun (LOG command).
+ *       The 16KB sectors 1~3 would cut the stall to 1/4, but they are in the middle of the code. */
+#ifndef ELOG_FLASH_SECTOR_SIZE
+#define ELOG_FLASH_SECTOR_SIZE               (128 * 1024)
+#endif
+/* the UART input must be idle for this long (ms) before a sector is erased, the erase waits until then */
+#define ELOG_FLASH_ERASE_RX_IDLE             50
+/* use a RAM array instead of the real flash (in elog_flash_port.c), for testing on PC */
+//#define ELOG_FLASH_PORT_USING_RAM
 
 #endif /* _ELOG_FLASH_CFG_H_ */
@@ -27,6 +27,34 @@
  */
 
 #include "elog_flash.h"
+#include <string.h>
+
+#ifdef ELOG_FLASH_PORT_USING_RAM
+/* RAM flash simulator: programming only clears bits and the erase cycles are counted,
+ * so the wear and power loss can be tested on PC */
+static uint8_t ram_flash[ELOG_FLASH_SECTOR_NUM][ELOG_FLASH_SECTOR_SIZE];
+/* the content is kept when it is initialized again, the same as reboot */
+static bool ram_flash_ok = false;
+uint32_t elog_flash_ram_erase_count[ELOG_FLASH_SECTOR_NUM];
+/* the remaining words can be programmed, simulate power loss when it is 0. -1: no limit */
+long elog_flash_ram_write_limit = -1;
+#else
+#include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "bsp_uart_driver.h"
+
+/* the log sectors at the end of the 512KB flash: sector 6 and 7 (128KB each),
+ * the program must not be linked into them (see the IROM size in the Keil project) */
+#define LOG_FLASH_BASE                 0x08040000
+#define LOG_FLASH_FIRST_SECTOR         FLASH_SECTOR_6
+
+static SemaphoreHandle_t flash_lock = NULL;
+static StaticSemaphore_t flash_lock_cb;
+#endif /* ELOG_FLASH_PORT_USING_RAM */
+
+extern void elog_port_output(const char *log, size_t size);
 
 /**
  * EasyLogger flash log pulgin port initialize
@@ -35,12 +63,124 @@
  */
 ElogErrCode elog_flash_port_init(void) {
     ElogErrCode result = ELOG_NO_ERR;
-    
-    /* add your code here */
+
+#ifdef ELOG_FLASH_PORT_USING_RAM
+    if (!ram_flash_ok) {
+        memset(ram_flash, 0xFF, sizeof(ram_flash));
+        ram_flash_ok = true;
+    }
+#else
+    if (flash_lock == NULL) {
+        flash_lock = xSemaphoreCreateMutexStatic(&flash_lock_cb);
+    }
+#endif
 
     return result;
 }
 
+/**
+ * erase a log sector
+ * The CPU stalls in the erase and the UART RX interrupt can not empty the DMA ring, so it waits
+ * until the input has paused for ELOG_FLASH_ERASE_RX_IDLE ms (a command line is received as a
+ * whole and the host waits for the reply). The input arriving in the erase anyway is counted.
+ *
+ * @param sector sector index in the log ring
+ *
+ * @return true: OK
+ */
+bool elog_flash_port_erase(size_t sector) {
+#ifdef ELOG_FLASH_PORT_USING_RAM
+    if (elog_flash_ram_write_limit == 0) {
+        return false;
+    }
+    memset(ram_flash[sector], 0xFF, ELOG_FLASH_SECTOR_SIZE);
+    elog_flash_ram_erase_count[sector]++;
+    return true;
+#else
+    FLASH_EraseInitTypeDef erase;
+    uint32_t error = 0;
+    HAL_StatusTypeDef status;
+
+    erase.TypeErase = FLASH_TYPEERASE_SECTORS;
+    erase.Banks = FLASH_BANK_1;
+    erase.Sector = LOG_FLASH_FIRST_SECTOR + sector;
+    erase.NbSectors = 1;
+    erase.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+    if (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING) {
+        while (!BSP_UART_RxIdle(ELOG_FLASH_ERASE_RX_IDLE)) {
+            vTaskDelay(pdMS_TO_TICKS(10));
+        }
+    }
+    BSP_UART_RxStallBegin();
+    HAL_FLASH_Unlock();
+    status = HAL_FLASHEx_Erase(&erase, &error);
+    HAL_FLASH_Lock();
+    BSP_UART_RxStallEnd();
+
+    return status == HAL_OK;
+#endif
+}
+
+/**
+ * program words into a log sector, the area must be erased
+ *
+ * @param sector sector index in the log ring
+ * @param offset position in the sector, word aligned
+ * @param buf data
+ * @param size data size, word aligned
+ *
+ * @return true: OK
+ */
+bool elog_flash_port_write(size_t sector, size_t offset, const uint32_t *buf, size_t size) {
+#ifdef ELOG_FLASH_PORT_USING_RAM
+    uint32_t *dst = (uint32_t *)&ram_flash[sector][offset];
+    size_t i;
+
+    for (i = 0; i < size / 4; i++) {
+        if (elog_flash_ram_write_limit == 0) {
+            return false;
+        }
+        if (elog_flash_ram_write_limit > 0) {
+            elog_flash_ram_write_limit--;
+        }
+        dst[i] &= buf[i];
+    }
+    return true;
+#else
+    uint32_t addr = LOG_FLASH_BASE + sector * ELOG_FLASH_SECTOR_SIZE + offset;
+    bool result = true;
+    size_t i;
+
+    HAL_FLASH_Unlock();
+    for (i = 0; i < size / 4; i++, addr += 4) {
+        /* the erased words in the padding are skipped */
+        if (buf[i] != 0xFFFFFFFF && HAL_FLASH_Program(FLASH_TYPEPROGRAM_WORD, addr, buf[i]) != HAL_OK) {
+            result = false;
+            break;
+        }
+    }
+    HAL_FLASH_Lock();
+
+    return result;
+#endif
+}
+
+/**
+ * read from a log sector
+ *
+ * @param sector sector index in the log ring
+ * @param offset position in the sector
+ * @param buf read buffer
+ * @param size read size
+ */
+void elog_flash_port_read(size_t sector, size_t offset, void *buf, size_t size) {
+#ifdef ELOG_FLASH_PORT_USING_RAM
+    memcpy(buf, &ram_flash[sector][offset], size);
+#else
+    memcpy(buf, (const void *)(LOG_FLASH_BASE + sector * ELOG_FLASH_SECTOR_SIZE + offset), size);
+#endif
+}
+
 /**
  * output flash saved log port interface
  *
@@ -48,25 +188,28 @@ ElogErrCode elog_flash_port_init(void) {
  * @param size log size
  */
 void elog_flash_port_output(const char *log, size_t size) {
-    
-    /* add your code here */
-    
+    /* the same place as the real-time logs */
+    elog_port_output(log, size);
 }
 
 /**
  * flash log lock
  */
 void elog_flash_port_lock(void) {
-    
-    /* add your code here */
-    
+#ifndef ELOG_FLASH_PORT_USING_RAM
+    if (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING) {
+        xSemaphoreTake(flash_lock, portMAX_DELAY);
+    }
+#endif
 }
 
 /**
  * flash log unlock
  */
 void elog_flash_port_unlock(void) {
-    
-    /* add your code here */
-    
-}
\ No newline at end of file
+#ifndef ELOG_FLASH_PORT_USING_RAM
+    if (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING) {
+        xSemaphoreGive(flash_lock);
+    }
+#endif
+}
@@ -28,8 +28,120 @@
  
 #include <elog.h>
 #include <stdio.h>
+#include <string.h>
 #include "SEGGER_RTT.h"
 #include "stm32f4xx_hal.h"
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "bsp_dwt.h"
+#include "bsp_uart_driver.h"
+#include "elog_flash.h"
+#include "app_crash_log.h"
+
+#ifdef ELOG_DEFER_OUTPUT_ENABLE
+/* RTT up channel for deferred (binary) logs, channel 0 is the text log and 1 is the event trace */
+#define ELOG_DEFER_RTT_CHANNEL         2
+#define ELOG_DEFER_RTT_BUF_SIZE        1024
+static uint8_t defer_rtt_buf[ELOG_DEFER_RTT_BUF_SIZE];
+/* sequence of the deferred records, it lets the host detect the dropped records */
+static uint16_t defer_seq = 0;
+#endif
+
+/* also output the text logs to USART1 (DMA ping-pong backend), RTT needs a debug probe */
+#define ELOG_UART_OUTPUT_ENABLE        1
+/* the logs which level is higher than it only go to RTT, the CLI replies are info logs */
+#define ELOG_UART_OUTPUT_LVL           ELOG_LVL_INFO
+/* max time the drain task waits for the UART buffer, the log is dropped and counted after it */
+#define ELOG_UART_OUTPUT_TIMEOUT_MS    20
+
+/* save the warning and more important logs to the internal flash (plugins/flash) */
+#define ELOG_FLASH_SAVE_ENABLE         1
+/* the logs which level is higher than it are not saved */
+#define ELOG_FLASH_SAVE_LVL            ELOG_LVL_WARN
+/* the logs to save are batched in this RAM ring (power of 2) by the drain task, only the flash task
+ * programs and erases the flash. A line which does not fit is dropped and counted. */
+#define ELOG_FLASH_SAVE_BUF_SIZE       2048
+/* the flash task writes the ring this long (ms) after the first line, a burst becomes one record */
+#define ELOG_FLASH_SAVE_DELAY_MS       1000
+/* stack size (words) of the flash task */
+#define ELOG_FLASH_SAVE_STACK_SIZE     256
+
+#if ELOG_FLASH_SAVE_ENABLE
+#if (ELOG_FLASH_SAVE_BUF_SIZE & (ELOG_FLASH_SAVE_BUF_SIZE - 1)) != 0
+    #error "ELOG_FLASH_SAVE_BUF_SIZE must be a power of 2"
+#endif
+/* single producer (drain task) single consumer (flash task) ring, the positions are free running */
+static char save_buf[ELOG_FLASH_SAVE_BUF_SIZE];
+static volatile uint32_t save_head = 0, save_tail = 0;
+static uint32_t save_drop = 0;
+/* the flash task runs at the idle priority, the flash is only programmed and erased when the CPU
+ * has nothing else to do */
+static TaskHandle_t save_task = NULL;
+static StaticTask_t save_task_cb;
+static StackType_t save_task_stack[ELOG_FLASH_SAVE_STACK_SIZE];
+/* the flash task and elog_port_save_sync() from the FLOG command both empty the ring */
+static SemaphoreHandle_t save_lock = NULL;
+static StaticSemaphore_t save_lock_cb;
+static void save_task_entry(void *arg);
+#endif
+
+/* timestamp string "ms.us", rendered from right to left */
+#define ELOG_TIME_BUF_SIZE             24
+/* "0.000" is always kept at the end of the buffer */
+#define ELOG_TIME_MIN_LEN              5
+static char time_buf[ELOG_TIME_BUF_SIZE];
+/* the first digit of the timestamp string */
+static char *time_str = NULL;
+/* last rendered timestamp, split into seconds/1000 (hi) and us below it (lo, 0~999999999) */
+static uint32_t time_last_hi = 0, time_last_lo = 0;
+/* DWT cycle of the last rendered microsecond, the timestamp is advanced by the cycles after it */
+static uint64_t time_cycle = 0;
+/* DWT cycles per microsecond */
+static uint32_t time_cycles_per_us = 1;
+
+/* interrupt mask before the outermost output lock */
+static UBaseType_t lock_saved = 0;
+/* output lock nesting depth, an assert inside the locked region locks again */
+static uint32_t lock_nest = 0;
+/**
+ * reset the timestamp string to "0.000"
+ */
+static void time_reset(void) {
+    time_str = &time_buf[ELOG_TIME_BUF_SIZE - 1 - ELOG_TIME_MIN_LEN];
+    memcpy(time_str, "0.000", ELOG_TIME_MIN_LEN + 1);
+    time_last_hi = 0;
+    time_last_lo = 0;
+    time_cycle = 0;
+}
+
+/**
+ * render the digits of the timestamp which are changed, from right to left
+ *
+ * @param p the position after the lowest digit
+ * @param now current value
+ * @param last last rendered value
+ * @param n the digits rendered before it, the decimal point is skipped after the 3rd one
+ * @param n_min render at least so many digits (including the ones before it)
+ *
+ * @return the highest rendered digit
+ */
+static char *time_render(char *p, uint32_t now, uint32_t last, uint32_t n, uint32_t n_min) {
+    /* the higher digits are the same as last time when the remaining parts are equal */
+    do {
+        if (n == 3) {
+            /* skip the decimal point */
+            p--;
+        }
+        *--p = '0' + (char)(now % 10);
+        now /= 10;
+        last /= 10;
+        n++;
+    } while (n < n_min || now != last);
+
+    return p;
+}
+
 /**
  * EasyLogger port initialize
  *
@@ -38,7 +150,23 @@
 ElogErrCode elog_port_init(void) {
     ElogErrCode result = ELOG_NO_ERR;
 	SEGGER_RTT_Init();
-    /* add your code here */
+    /* the timestamp uses the DWT cycle counter for sub-millisecond resolution */
+    time_cycles_per_us = BSP_DWT_GetFreq() / 1000000U;
+    if (time_cycles_per_us == 0) {
+        time_cycles_per_us = 1;
+    }
+    time_reset();
+#ifdef ELOG_DEFER_OUTPUT_ENABLE
+    /* skip mode: drop the whole record when the host is not reading fast enough, never block */
+    SEGGER_RTT_ConfigUpBuffer(ELOG_DEFER_RTT_CHANNEL, "ElogDefer", defer_rtt_buf, sizeof(defer_rtt_buf),
+            SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+#endif
+#if ELOG_FLASH_SAVE_ENABLE
+    result = elog_flash_init();
+    save_lock = xSemaphoreCreateMutexStatic(&save_lock_cb);
+    save_task = xTaskCreateStatic(save_task_entry, "elog_flash", ELOG_FLASH_SAVE_STACK_SIZE, NULL,
+            tskIDLE_PRIORITY, save_task_stack, &save_task_cb);
+#endif
     
     return result;
 }
@@ -65,41 +193,227 @@ void elog_port_output(const char *log, size_t size) {
     SEGGER_RTT_Write(0,log,size);
 }
 
+/**
+ * keep log port interface
+ * It is called in the caller context when a log is packaged, before the log waits in the queue.
+ * The log is copied into the RAM ring which survives warm reset, so the logs before a crash
+ * are not lost with the queue.
+ *
+ * @param level log level
+ * @param log log
+ * @param size log size
+ */
+void elog_port_keep(uint8_t level, const char *log, size_t size) {
+    CrashLog_Write(log, size);
+}
+
+/**
+ * save log port interface
+ * It is called by the asynchronous drain task for every log in order, so the wait for the UART
+ * buffer never happens in the caller of the log. The logs to save are only copied into the RAM
+ * ring here, the flash is never programmed or erased from the logging context.
+ *
+ * @param level log level
+ * @param log log
+ * @param size log size
+ */
+void elog_port_save(uint8_t level, const char *log, size_t size) {
+#if ELOG_FLASH_SAVE_ENABLE
+    uint32_t head = save_head, pos, n;
+#endif
+
+#if ELOG_UART_OUTPUT_ENABLE
+    if (level <= ELOG_UART_OUTPUT_LVL) {
+        /* a whole line goes into the UART buffer or is dropped */
+        BSP_UART_Write((const uint8_t *)log, (uint16_t)size, ELOG_UART_OUTPUT_TIMEOUT_MS);
+    }
+#endif
+#if ELOG_FLASH_SAVE_ENABLE
+    if (level > ELOG_FLASH_SAVE_LVL) {
+        return;
+    }
+    if (size > ELOG_FLASH_SAVE_BUF_SIZE - (head - save_tail)) {
+        /* the flash task is behind (erasing a sector), a whole line is dropped */
+        save_drop++;
+        return;
+    }
+    pos = head & (ELOG_FLASH_SAVE_BUF_SIZE - 1);
+    n = ELOG_FLASH_SAVE_BUF_SIZE - pos;
+    if (n > size) {
+        n = size;
+    }
+    memcpy(&save_buf[pos], log, n);
+    memcpy(save_buf, log + n, size - n);
+    /* the data is visible before the new head */
+    __DMB();
+    save_head = head + size;
+    xTaskNotifyGive(save_task);
+#endif
+}
+
+#if ELOG_FLASH_SAVE_ENABLE
+/**
+ * write the logs in the RAM ring to flash
+ * It is called by the flash task, and by the FLOG command before it reads the flash. A sector is
+ * erased in it when the current one is full, the CPU stalls during the erase (see elog_flash_cfg.h).
+ */
+void elog_port_save_sync(void) {
+    uint32_t head, tail, pos, n;
+
+    xSemaphoreTake(save_lock, portMAX_DELAY);
+    while ((head = save_head) != (tail = save_tail)) {
+        __DMB();
+        pos = tail & (ELOG_FLASH_SAVE_BUF_SIZE - 1);
+        n = ELOG_FLASH_SAVE_BUF_SIZE - pos;
+        if (n > head - tail) {
+            n = head - tail;
+        }
+        elog_flash_write(&save_buf[pos], n);
+        save_tail = tail + n;
+    }
+    elog_flash_flush();
+    xSemaphoreGive(save_lock);
+}
+
+/**
+ * get the count of the logs dropped because the RAM ring is full
+ *
+ * @return dropped logs
+ */
+uint32_t elog_port_get_save_drop(void) {
+    return save_drop;
+}
+
+/**
+ * flash task, it waits for the first line of a burst and writes the whole burst a while later
+ */
+static void save_task_entry(void *arg) {
+    (void)arg;
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+        vTaskDelay(pdMS_TO_TICKS(ELOG_FLASH_SAVE_DELAY_MS));
+        elog_port_save_sync();
+    }
+}
+#endif /* ELOG_FLASH_SAVE_ENABLE */
+
 /**
  * output lock
+ * It only protects the filter settings and the shared time string, the logs are packaged in the
+ * staging slots without lock. A critical section is used because logs are also output from
+ * interrupts, it masks the interrupts up to configMAX_SYSCALL_INTERRUPT_PRIORITY.
  */
 void elog_port_output_lock(void) {
-    
-    /* add your code here */
-    
+    UBaseType_t saved = taskENTER_CRITICAL_FROM_ISR();
+
+    if (lock_nest++ == 0) {
+        lock_saved = saved;
+    }
 }
 
 /**
  * output unlock
  */
 void elog_port_output_unlock(void) {
-    
-    /* add your code here */
-    
+    if (--lock_nest == 0) {
+        taskEXIT_CRITICAL_FROM_ISR(lock_saved);
+    }
 }
 
 /**
  * get current time interface
+ * The time is "ms.us" since the DWT counter starts. Only the digits which are changed since
+ * the last call are rendered, usually 3~4 of them. It is called under the output lock
+ * (see elog_output_va), that keeps the shared string and the last time consistent.
+ * The cycles since the last call are converted with 32-bit arithmetic, the 64-bit division
+ * is only used when the logs are more than 2^32 cycles (42.9s) apart.
  *
  * @return current time
  */
 const char *elog_port_get_time(void) {
-    
-    /* add your code here */
-    // 1.  static buf ڴͱ
-    static char buf[32]; 
-    
-    // 2. ʽΪַ
-    snprintf(buf, sizeof(buf), "%lu", (unsigned long)HAL_GetTick());
-    
-    // 3. ַַ
-    return buf;
+    uint64_t cycle = BSP_DWT_GetCycle64(), us;
+    uint32_t hi = time_last_hi, lo = time_last_lo, elapsed;
+    char *p = &time_buf[ELOG_TIME_BUF_SIZE - 1];
+
+    if (cycle < time_cycle) {
+        /* the DWT counter is restarted when the scheduler starts, render all digits again */
+        time_reset();
+        hi = lo = 0;
+    }
+    if ((cycle - time_cycle) >> 32) {
+        us = cycle / time_cycles_per_us;
+        hi = (uint32_t)(us / 1000000000U);
+        lo = (uint32_t)(us % 1000000000U);
+        time_cycle = us * time_cycles_per_us;
+    } else {
+        elapsed = (uint32_t)(cycle - time_cycle) / time_cycles_per_us;
+        time_cycle += (uint64_t)elapsed * time_cycles_per_us;
+        /* elapsed < 2^32 us, the carry out of lo is at most 1 after the split */
+        lo += elapsed % 1000000000U;
+        hi += elapsed / 1000000000U;
+        if (lo >= 1000000000U) {
+            lo -= 1000000000U;
+            hi++;
+        }
+    }
+    if (hi == time_last_hi) {
+        p = time_render(p, lo, time_last_lo, 0, 0);
+    } else {
+        /* all digits below the changed thousand seconds, then the changed ones above them */
+        p = time_render(p, lo, time_last_lo, 0, 9);
+        p = time_render(p, hi, time_last_hi, 9, 0);
+    }
+    time_last_hi = hi;
+    time_last_lo = lo;
+    if (p < time_str) {
+        time_str = p;
+    }
+
+    return time_str;
+}
+
+/**
+ * get current timestamp for deferred logs and the rate limit
+ * The host decoder renders it, so a deferred log sends its low 32 bits as binary microseconds
+ * (wraps every 71 minutes). The rate limit uses all 64 bits, it never wraps.
+ *
+ * @return current time (us)
+ */
+uint64_t elog_port_get_timestamp(void) {
+    return BSP_DWT_GetCycle64() / time_cycles_per_us;
+}
+
+#ifdef ELOG_DEFER_OUTPUT_ENABLE
+/**
+ * output deferred (binary) log record port interface
+ * The free space is checked once for the record, the data and the pad, so the record goes into
+ * the channel as one piece or is dropped as a whole, and records from tasks and interrupts never interleave.
+ * The sequence (record[2] bits 16-31) is taken in the same critical section as the write,
+ * so it is shared safely by tasks and interrupts, and the records appear in the channel in
+ * sequence order. A dropped record still uses its number, the host sees the gap.
+ *
+ * @param record record, record[2] gets the sequence
+ * @param size record size
+ * @param data raw data after the record (padded to 4 bytes), NULL: none
+ * @param data_size data size
+ */
+void elog_port_defer_output(uint32_t *record, size_t size, const void *data, size_t data_size) {
+    static const uint8_t zero[3] = {0, 0, 0};
+    size_t pad = (4 - (data_size & 3)) & 3;
+    unsigned total = (unsigned)(size + data_size + pad);
+
+    SEGGER_RTT_LOCK();
+    record[2] = (record[2] & 0xFFFFu) | ((uint32_t)defer_seq++ << 16);
+    if (SEGGER_RTT_GetAvailWriteSpace(ELOG_DEFER_RTT_CHANNEL) >= total) {
+        SEGGER_RTT_WriteSkipNoLock(ELOG_DEFER_RTT_CHANNEL, record, (unsigned)size);
+        if (data_size) {
+            SEGGER_RTT_WriteSkipNoLock(ELOG_DEFER_RTT_CHANNEL, data, (unsigned)data_size);
+            SEGGER_RTT_WriteSkipNoLock(ELOG_DEFER_RTT_CHANNEL, zero, (unsigned)pad);
+        }
+    }
+    SEGGER_RTT_UNLOCK();
 }
+#endif
 
 /**
  * get current process name interface
@@ -61,6 +61,18 @@
 #ifndef ELOG_FILTER_TAG_LVL_MAX_NUM
 #define ELOG_FILTER_TAG_LVL_MAX_NUM          4
 #endif
+#if defined(ELOG_RATE_LIMIT_ENABLE) && (ELOG_RATE_LIMIT_BURST > 255)
+    #error "ELOG_RATE_LIMIT_BURST must be at most 255"
+#endif
+
+#if (ELOG_FILTER_TAG_LVL_MAX_NUM & (ELOG_FILTER_TAG_LVL_MAX_NUM - 1)) != 0
+    #error "ELOG_FILTER_TAG_LVL_MAX_NUM must be power of 2, it is the hash table size"
+#endif
+
+/* the end of a line which is longer than ELOG_LINE_BUF_SIZE, so a cut line is visible */
+#ifndef ELOG_LINE_CUT_SIGN
+#define ELOG_LINE_CUT_SIGN                   "..."
+#endif
 
 #ifdef ELOG_COLOR_ENABLE
 /**
@@ -116,8 +128,13 @@
 
 /* EasyLogger object */
 static EasyLogger elog;
-/* every line log's buffer */
-static char log_buf[ELOG_LINE_BUF_SIZE] = { 0 };
+#if defined(ELOG_ASYNC_OUTPUT_ENABLE) && defined(ELOG_ASYNC_OUTPUT_USING_FREERTOS)
+/* every log is packaged in its own slot of the asynchronous output queue */
+#define ELOG_LINE_BUF_STAGING
+#else
+/* every line log's buffer, shared by all callers under the output lock */
+static char line_buf[ELOG_LINE_BUF_SIZE] = { 0 };
+#endif
 /* level output info */
 static const char *level_output_info[] = {
         [ELOG_LVL_ASSERT]  = "A/",
@@ -140,17 +157,61 @@ static const char *color_output_info[] = {
 };
 #endif /* ELOG_COLOR_ENABLE */
 
+/* upper case hex digits of every byte value, for hexdump */
+#define HEX_ROW(h) \
+    {h, '0'}, {h, '1'}, {h, '2'}, {h, '3'}, {h, '4'}, {h, '5'}, {h, '6'}, {h, '7'}, \
+    {h, '8'}, {h, '9'}, {h, 'A'}, {h, 'B'}, {h, 'C'}, {h, 'D'}, {h, 'E'}, {h, 'F'}
+static const char hex_table[256][2] = {
+        HEX_ROW('0'), HEX_ROW('1'), HEX_ROW('2'), HEX_ROW('3'), HEX_ROW('4'), HEX_ROW('5'), HEX_ROW('6'), HEX_ROW('7'),
+        HEX_ROW('8'), HEX_ROW('9'), HEX_ROW('A'), HEX_ROW('B'), HEX_ROW('C'), HEX_ROW('D'), HEX_ROW('E'), HEX_ROW('F'),
+};
+
+#ifdef ELOG_RATE_LIMIT_ENABLE
+/* logs dropped by the rate limit, since the last report and in total */
+static uint32_t rate_limited = 0, rate_limited_total = 0;
+#endif
+#ifdef ELOG_REPEAT_COLLAPSE_ENABLE
+/* the last output line of the limited call sites, the identical lines after it are collapsed */
+static struct {
+    const ElogSite *site;
+    uint64_t hash;       /**< hash of the formatted message (without the level, tag, time... prefix) */
+    size_t len;          /**< length of the formatted message */
+    uint8_t level;
+    uint32_t repeated;   /**< collapsed lines which are not reported yet */
+} last_line;
+static uint32_t repeated_total = 0;
+#endif
+
 static bool get_fmt_enabled(uint8_t level, size_t set);
 static bool get_fmt_used_and_enabled_u32(uint8_t level, size_t set, uint32_t arg);
 static bool get_fmt_used_and_enabled_ptr(uint8_t level, size_t set, const char* arg);
 static void elog_set_filter_tag_lvl_default(void);
+static void elog_filter_changed(void);
+static void elog_output_va(ElogSite *site, uint8_t level, const char *tag, const char *file, const char *func,
+        const long line, const char *format, va_list args);
 
 /* EasyLogger assert hook */
 void (*elog_assert_hook)(const char* expr, const char* func, size_t line);
+/* filter generation (24 bits), it changes on every filter setting, the cached call sites are resolved again */
+volatile uint32_t elog_filter_gen = 1;
+/* the tag of the call sites which are called with several tags, they are cached by the tag instead */
+const char elog_site_tag_multi[] = "";
+/* filter results of the tags from the multi-tag call sites, number of entries (power of 2) */
+#define ELOG_TAG_CACHE_NUM                   8
+typedef struct {
+    volatile uint32_t state;
+    const char * volatile tag;
+} ElogTagCache;
+static ElogTagCache tag_cache[ELOG_TAG_CACHE_NUM];
+
+void elog_output_lock(void);
+void elog_output_unlock(void);
 
 extern void elog_port_output(const char *log, size_t size);
 extern void elog_port_output_lock(void);
 extern void elog_port_output_unlock(void);
+extern uint64_t elog_port_get_timestamp(void);
+extern void elog_port_keep(uint8_t level, const char *log, size_t size);
 
 /**
  * EasyLogger initialize.
@@ -346,6 +407,7 @@ void elog_set_filter_lvl(uint8_t level) {
     ELOG_ASSERT(level <= ELOG_LVL_VERBOSE);
 
     elog.filter.level = level;
+    elog_filter_changed();
 }
 
 /**
@@ -355,6 +417,7 @@ void elog_set_filter_lvl(uint8_t level) {
  */
 void elog_set_filter_tag(const char *tag) {
     strncpy(elog.filter.tag, tag, ELOG_FILTER_TAG_MAX_LEN);
+    elog_filter_changed();
 }
 
 /**
@@ -366,6 +429,97 @@ void elog_set_filter_kw(const char *keyword) {
     strncpy(elog.filter.keyword, keyword, ELOG_FILTER_KW_MAX_LEN);
 }
 
+/**
+ * invalidate the cached filter results of all call sites
+ */
+static void elog_filter_changed(void) {
+    uint32_t gen = (elog_filter_gen + 1) & 0x00FFFFFFUL;
+
+    /* 0 is kept for the call sites which are never resolved */
+    elog_filter_gen = (gen == 0) ? 1 : gen;
+}
+
+/**
+ * resolve the filter result of a log call site (or a tag cache entry)
+ * It is only called on the first output of the call site or after the filter settings are changed.
+ * The site keeps the first tag it is called with. When it is called with another tag, the site is
+ * marked as multi-tag and it is never cached in the site again (see elog_site_multi_enabled), so the
+ * state a reader sees always belongs to the tag it has compared. The site is updated under the output
+ * lock for the concurrent callers.
+ *
+ * @param state cached state of the site
+ * @param site_tag the tag the site keeps
+ * @param tag log tag
+ *
+ * @return the levels below it pass the level and tag filters
+ */
+static uint8_t elog_filter_resolve(volatile uint32_t *state, const char * volatile *site_tag, const char *tag) {
+    /* read the generation first, a filter setting during resolving makes it resolve again */
+    uint32_t gen = elog_filter_gen;
+    uint8_t tag_lvl = elog_get_filter_tag_lvl(tag);
+    uint8_t limit = 0;
+
+    if (strstr(tag, elog.filter.tag)) {
+        limit = ((elog.filter.level < tag_lvl) ? elog.filter.level : tag_lvl) + 1;
+    }
+    if (*site_tag == elog_site_tag_multi) {
+        return limit;
+    }
+
+    elog_output_lock();
+    if (*site_tag == NULL) {
+        *site_tag = tag;
+    }
+    if (*site_tag == tag) {
+        /* the tag is written before the state, elog_site_enabled reads them in the reverse order */
+        *state = (gen << 8) | limit;
+    } else {
+        *site_tag = elog_site_tag_multi;
+    }
+    elog_output_unlock();
+
+    return limit;
+}
+
+/**
+ * resolve the filter result of a log call site, see elog_filter_resolve()
+ *
+ * @param site call site
+ * @param tag log tag
+ *
+ * @return the levels below it pass the level and tag filters
+ */
+uint8_t elog_site_resolve(ElogSite *site, const char *tag) {
+    return elog_filter_resolve(&site->state, &site->tag, tag);
+}
+
+/**
+ * check the filters for a multi-tag call site (a helper taking the tag as a parameter)
+ * The result is cached by the tag instead of the site, in a small table indexed by the tag address.
+ * The entries work the same as the call sites: an entry keeps the first tag it gets, and a second tag
+ * with the same index makes it uncached, the tags of it then look the filters up on every call.
+ *
+ * @param level log level
+ * @param tag log tag
+ *
+ * @return true: the log passes the level and tag filters
+ */
+bool elog_site_multi_enabled(uint8_t level, const char *tag) {
+    uintptr_t addr = (uintptr_t)tag;
+    ElogTagCache *entry = &tag_cache[(addr ^ (addr >> 4)) & (ELOG_TAG_CACHE_NUM - 1)];
+    uint32_t state = entry->state;
+    const char *entry_tag = entry->tag;
+
+    if ((state >> 8) == elog_filter_gen && entry_tag == tag) {
+        return level < (uint8_t)state;
+    }
+    /* the global level needs no tag lookup */
+    if (level > elog.filter.level) {
+        return false;
+    }
+    return level < elog_filter_resolve(&entry->state, &entry->tag, tag);
+}
+
 /**
  * lock output 
  */
@@ -395,13 +549,65 @@ void elog_output_unlock(void) {
  */
 static void elog_set_filter_tag_lvl_default(void)
 {
-    uint8_t i = 0;
+    memset(elog.filter.tag_lvl, 0, sizeof(elog.filter.tag_lvl));
+}
+
+/**
+ * FNV-1a hash of the tag, only the first ELOG_FILTER_TAG_MAX_LEN characters are used
+ *
+ * @param tag tag
+ *
+ * @return hash
+ */
+static uint32_t elog_tag_hash(const char *tag)
+{
+    uint32_t hash = 2166136261u;
+    size_t i;
+
+    for (i = 0; i < ELOG_FILTER_TAG_MAX_LEN && tag[i] != '\0'; i++) {
+        hash ^= (uint8_t)tag[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
 
-    for (i =0; i< ELOG_FILTER_TAG_LVL_MAX_NUM; i++){
-        memset(elog.filter.tag_lvl[i].tag, '\0', ELOG_FILTER_TAG_MAX_LEN + 1);
-        elog.filter.tag_lvl[i].level = ELOG_FILTER_LVL_SILENT;
-        elog.filter.tag_lvl[i].tag_use_flag = false;
+/**
+ * find the tag in the tag level filter hash table (linear probing)
+ *
+ * @param tag tag
+ * @param hash hash of the tag
+ * @param insert the slot for inserting this tag when it is not found (the first deleted or empty slot),
+ *        -1 when the table is full, NULL: not used
+ *
+ * @return slot index, -1 when not found
+ */
+static int elog_tag_lvl_find(const char *tag, uint32_t hash, int *insert)
+{
+    ElogTagLvlFilter *slot;
+    int free_slot = -1;
+    size_t i, index;
+
+    for (i = 0; i < ELOG_FILTER_TAG_LVL_MAX_NUM; i++) {
+        index = (hash + i) & (ELOG_FILTER_TAG_LVL_MAX_NUM - 1);
+        slot = &elog.filter.tag_lvl[index];
+        if (slot->state == ELOG_TAG_LVL_EMPTY) {
+            /* the probe chain ends here */
+            if (free_slot < 0) {
+                free_slot = (int)index;
+            }
+            break;
+        } else if (slot->state == ELOG_TAG_LVL_DELETED) {
+            if (free_slot < 0) {
+                free_slot = (int)index;
+            }
+        } else if (slot->hash == hash && !strncmp(tag, slot->tag, ELOG_FILTER_TAG_MAX_LEN)) {
+            return (int)index;
+        }
+    }
+    if (insert) {
+        *insert = free_slot;
     }
+    return -1;
 }
 
 /**
@@ -426,44 +632,41 @@ void elog_set_filter_tag_lvl(const char *tag, uint8_t level)
 {
     ELOG_ASSERT(level <= ELOG_LVL_VERBOSE);
     ELOG_ASSERT(tag != ((void *)0));
-    uint8_t i = 0;
+    uint32_t hash;
+    int index, insert = -1;
+    ElogTagLvlFilter *slot;
 
     if (!elog.init_ok) {
         return;
     }
 
+    hash = elog_tag_hash(tag);
     elog_output_lock();
-    /* find the tag in arr */
-    for (i =0; i< ELOG_FILTER_TAG_LVL_MAX_NUM; i++){
-        if (elog.filter.tag_lvl[i].tag_use_flag == true &&
-            !strncmp(tag, elog.filter.tag_lvl[i].tag,ELOG_FILTER_TAG_MAX_LEN)){
-            break;
-        }
-    }
+    /* find the tag in table */
+    index = elog_tag_lvl_find(tag, hash, &insert);
 
-    if (i < ELOG_FILTER_TAG_LVL_MAX_NUM){
+    if (index >= 0) {
         /* find OK */
-        if (level == ELOG_FILTER_LVL_ALL){
-            /* remove current tag's level filter when input level is the lowest level */
-             elog.filter.tag_lvl[i].tag_use_flag = false;
-             memset(elog.filter.tag_lvl[i].tag, '\0', ELOG_FILTER_TAG_MAX_LEN + 1);
-             elog.filter.tag_lvl[i].level = ELOG_FILTER_LVL_SILENT;
-        } else{
-            elog.filter.tag_lvl[i].level = level;
+        slot = &elog.filter.tag_lvl[index];
+        if (level == ELOG_FILTER_LVL_ALL) {
+            /* remove current tag's level filter when input level is the lowest level,
+             * leave a tombstone so that the probe chains passing here are not broken */
+            slot->state = ELOG_TAG_LVL_DELETED;
+            memset(slot->tag, '\0', ELOG_FILTER_TAG_MAX_LEN + 1);
+            slot->level = ELOG_FILTER_LVL_SILENT;
+        } else {
+            slot->level = level;
         }
-    } else{
+    } else if (level != ELOG_FILTER_LVL_ALL && insert >= 0) {
         /* only add the new tag's level filer when level is not ELOG_FILTER_LVL_ALL */
-        if (level != ELOG_FILTER_LVL_ALL){
-            for (i =0; i< ELOG_FILTER_TAG_LVL_MAX_NUM; i++){
-                if (elog.filter.tag_lvl[i].tag_use_flag == false){
-                    strncpy(elog.filter.tag_lvl[i].tag, tag, ELOG_FILTER_TAG_MAX_LEN);
-                    elog.filter.tag_lvl[i].level = level;
-                    elog.filter.tag_lvl[i].tag_use_flag = true;
-                    break;
-                }
-            }
-        }
+        slot = &elog.filter.tag_lvl[insert];
+        strncpy(slot->tag, tag, ELOG_FILTER_TAG_MAX_LEN);
+        slot->tag[ELOG_FILTER_TAG_MAX_LEN] = '\0';
+        slot->hash = hash;
+        slot->level = level;
+        slot->state = ELOG_TAG_LVL_USED;
     }
+    elog_filter_changed();
     elog_output_unlock();
 }
 
@@ -478,27 +681,73 @@ void elog_set_filter_tag_lvl(const char *tag, uint8_t level)
 uint8_t elog_get_filter_tag_lvl(const char *tag)
 {
     ELOG_ASSERT(tag != ((void *)0));
-    uint8_t i = 0;
+    uint32_t hash;
+    int index;
     uint8_t level = ELOG_FILTER_LVL_ALL;
 
     if (!elog.init_ok) {
         return level;
     }
 
+    /* hash the tag outside the lock, only the probing is locked */
+    hash = elog_tag_hash(tag);
     elog_output_lock();
-    /* find the tag in arr */
-    for (i =0; i< ELOG_FILTER_TAG_LVL_MAX_NUM; i++){
-        if (elog.filter.tag_lvl[i].tag_use_flag == true &&
-            !strncmp(tag, elog.filter.tag_lvl[i].tag,ELOG_FILTER_TAG_MAX_LEN)){
-            level = elog.filter.tag_lvl[i].level;
-            break;
-        }
+    index = elog_tag_lvl_find(tag, hash, NULL);
+    if (index >= 0) {
+        level = elog.filter.tag_lvl[index].level;
     }
     elog_output_unlock();
 
     return level;
 }
 
+/**
+ * get a line buffer to package the log
+ * The output lock is held until line_buf_put() when the shared line buffer is used.
+ *
+ * @return line buffer, NULL when the log is dropped
+ */
+static char *line_buf_get(void) {
+#ifdef ELOG_LINE_BUF_STAGING
+    return elog_async_get_line_buf();
+#else
+    /* lock output */
+    elog_output_lock();
+    return line_buf;
+#endif
+}
+
+/**
+ * output the packaged log and give the line buffer back
+ *
+ * @param level level
+ * @param log the line buffer from line_buf_get()
+ * @param size log size, 0: nothing to output
+ */
+static void line_buf_put(uint8_t level, char *log, size_t size) {
+    if (size) {
+        /* the port may keep a copy before the log waits in the queue */
+        elog_port_keep(level, log, size);
+    }
+#ifdef ELOG_LINE_BUF_STAGING
+    elog_async_put_line_buf(level, log, size);
+#else
+    if (size) {
+#if defined(ELOG_ASYNC_OUTPUT_ENABLE)
+        extern void elog_async_output(uint8_t level, const char *log, size_t size);
+        elog_async_output(level, log, size);
+#elif defined(ELOG_BUF_OUTPUT_ENABLE)
+        extern void elog_buf_output(const char *log, size_t size);
+        elog_buf_output(log, size);
+#else
+        elog_port_output(log, size);
+#endif
+    }
+    /* unlock output */
+    elog_output_unlock();
+#endif
+}
+
 /**
  * output RAW format log
  *
@@ -507,6 +756,7 @@ uint8_t elog_get_filter_tag_lvl(const char *tag)
  */
 void elog_raw_output(const char *format, ...) {
     va_list args;
+    char *log_buf;
     size_t log_len = 0;
     int fmt_result;
 
@@ -515,12 +765,13 @@ void elog_raw_output(const char *format, ...) {
         return;
     }
 
+    log_buf = line_buf_get();
+    if (log_buf == NULL) {
+        return;
+    }
     /* args point to the first variable parameter */
     va_start(args, format);
 
-    /* lock output */
-    elog_output_lock();
-
     /* package log data to buffer */
     fmt_result = vsnprintf(log_buf, ELOG_LINE_BUF_SIZE, format, args);
 
@@ -530,21 +781,9 @@ void elog_raw_output(const char *format, ...) {
     } else {
         log_len = ELOG_LINE_BUF_SIZE;
     }
-    /* output log */
-#if defined(ELOG_ASYNC_OUTPUT_ENABLE)
-    extern void elog_async_output(uint8_t level, const char *log, size_t size);
-    /* raw log will using assert level */
-    elog_async_output(ELOG_LVL_ASSERT, log_buf, log_len);
-#elif defined(ELOG_BUF_OUTPUT_ENABLE)
-    extern void elog_buf_output(const char *log, size_t size);
-    elog_buf_output(log_buf, log_len);
-#else
-    elog_port_output(log_buf, log_len);
-#endif
-    /* unlock output */
-    elog_output_unlock();
-
     va_end(args);
+    /* output log, raw log will using assert level */
+    line_buf_put(ELOG_LVL_ASSERT, log_buf, log_len);
 }
 
 /**
@@ -561,6 +800,218 @@ void elog_raw_output(const char *format, ...) {
  */
 void elog_output(uint8_t level, const char *tag, const char *file, const char *func,
         const long line, const char *format, ...) {
+    va_list args;
+
+    ELOG_ASSERT(level <= ELOG_LVL_VERBOSE);
+
+    /* level filter */
+    if (level > elog.filter.level || level > elog_get_filter_tag_lvl(tag)) {
+        return;
+    } else if (!strstr(tag, elog.filter.tag)) { /* tag filter */
+        return;
+    }
+    /* args point to the first variable parameter */
+    va_start(args, format);
+    elog_output_va(NULL, level, tag, file, func, line, format, args);
+    va_end(args);
+}
+
+#ifdef ELOG_RATE_LIMIT_ENABLE
+/**
+ * take a token from the rate limit bucket of a call site
+ *
+ * @param site call site
+ *
+ * @return false: the bucket is empty, the log is dropped
+ */
+static bool elog_site_take_token(ElogSite *site) {
+    const uint32_t period = ELOG_RATE_LIMIT_PERIOD_MS * 1000U;
+    uint64_t now = elog_port_get_timestamp(), elapsed;
+    uint32_t refills;
+    bool taken;
+
+    elog_output_lock();
+    /* 64 bit timestamp, a site which is idle for any time gets a full bucket */
+    elapsed = now - site->refill;
+    refills = (elapsed >= (uint64_t)period * ELOG_RATE_LIMIT_BURST) ? ELOG_RATE_LIMIT_BURST
+            : (uint32_t)elapsed / period;
+    if (refills >= site->spent) {
+        /* the bucket is full, the tokens beyond its size are not kept */
+        site->spent = 0;
+        site->refill = now;
+    } else {
+        site->spent -= (uint8_t)refills;
+        site->refill += (uint64_t)refills * period;
+    }
+    taken = (site->spent < ELOG_RATE_LIMIT_BURST);
+    if (taken) {
+        site->spent++;
+    } else {
+        rate_limited++;
+        rate_limited_total++;
+    }
+    elog_output_unlock();
+
+    return taken;
+}
+
+/**
+ * give the token back to the bucket of a call site, the line which has taken it is not output
+ *
+ * @param site call site
+ */
+static void elog_site_put_token(ElogSite *site) {
+    elog_output_lock();
+    /* the bucket may have been refilled after the token is taken */
+    if (site->spent) {
+        site->spent--;
+    }
+    elog_output_unlock();
+}
+#endif /* ELOG_RATE_LIMIT_ENABLE */
+
+/**
+ * output the log of a call site which has passed the level and tag filters by elog_site_enabled()
+ * Only the elog_limited() sites are rate limited and collapsed.
+ *
+ * @param site call site
+ * @param level level
+ * @param tag tag
+ * @param file file name
+ * @param func function name
+ * @param line line number
+ * @param format output format
+ * @param ... args
+ *
+ */
+void elog_site_output(ElogSite *site, uint8_t level, const char *tag, const char *file, const char *func,
+        const long line, const char *format, ...) {
+    va_list args;
+
+#ifdef ELOG_RATE_LIMIT_ENABLE
+    /* the rate limit is checked before packaging, a dropped log costs no line buffer */
+    if (site->limited && level != ELOG_LVL_ASSERT && elog.output_enabled && !elog_site_take_token(site)) {
+        return;
+    }
+#endif
+    /* args point to the first variable parameter */
+    va_start(args, format);
+    elog_output_va(site, level, tag, file, func, line, format, args);
+    va_end(args);
+}
+
+#ifdef ELOG_REPEAT_COLLAPSE_ENABLE
+/**
+ * check whether the line is identical with the last output line
+ *
+ * @param site call site
+ * @param level level
+ * @param msg formatted message (without prefix)
+ * @param len message length
+ * @param repeated the collapsed lines of the last line to report before this line, 0: none
+ *
+ * @return true: identical, the line is collapsed
+ */
+static bool elog_repeat_check(const ElogSite *site, uint8_t level, const char *msg, size_t len,
+        uint32_t *repeated) {
+    uint64_t hash = 14695981039346656037ull;
+    bool same;
+    size_t i;
+
+    /* 64 bit FNV-1a, the message is compared by its length and hash, no copy of the last line is kept */
+    for (i = 0; i < len; i++) {
+        hash ^= (uint8_t)msg[i];
+        hash *= 1099511628211ull;
+    }
+
+    elog_output_lock();
+    same = (last_line.site == site && last_line.len == len && last_line.hash == hash
+            && last_line.level == level);
+    if (same) {
+        last_line.repeated++;
+        repeated_total++;
+        *repeated = 0;
+    } else {
+        *repeated = last_line.repeated;
+        last_line.site = site;
+        last_line.hash = hash;
+        last_line.len = len;
+        last_line.level = level;
+        last_line.repeated = 0;
+    }
+    elog_output_unlock();
+
+    return same;
+}
+#endif /* ELOG_REPEAT_COLLAPSE_ENABLE */
+
+/**
+ * report the suppressed logs since the last report
+ * It should be called periodically (e.g. every second) by the application, so the collapsed and
+ * rate limited logs are still visible during a fault storm without flooding the output.
+ */
+void elog_report_suppressed(void) {
+    uint32_t count;
+
+#ifdef ELOG_REPEAT_COLLAPSE_ENABLE
+    elog_output_lock();
+    count = last_line.repeated;
+    last_line.repeated = 0;
+    elog_output_unlock();
+    if (count) {
+        elog_raw_output("last message repeated %lu times" ELOG_NEWLINE_SIGN, (unsigned long)count);
+    }
+#endif
+#ifdef ELOG_RATE_LIMIT_ENABLE
+    elog_output_lock();
+    count = rate_limited;
+    rate_limited = 0;
+    elog_output_unlock();
+    if (count) {
+        elog_output(ELOG_LVL_WARN, LOG_TAG, NULL, NULL, 0, "%lu logs dropped by rate limit", (unsigned long)count);
+    }
+#endif
+    (void)count;
+}
+
+/**
+ * get the total suppressed logs count
+ *
+ * @param rate_limited_cnt dropped by the rate limit, can be NULL
+ * @param repeated_cnt collapsed identical lines, can be NULL
+ */
+void elog_get_suppressed_count(uint32_t *rate_limited_cnt, uint32_t *repeated_cnt) {
+    if (rate_limited_cnt) {
+#ifdef ELOG_RATE_LIMIT_ENABLE
+        *rate_limited_cnt = rate_limited_total;
+#else
+        *rate_limited_cnt = 0;
+#endif
+    }
+    if (repeated_cnt) {
+#ifdef ELOG_REPEAT_COLLAPSE_ENABLE
+        *repeated_cnt = repeated_total;
+#else
+        *repeated_cnt = 0;
+#endif
+    }
+}
+
+/**
+ * package and output the log, the level and tag filters are checked by the caller
+ *
+ * @param site call site, NULL: not a call site (it is neither rate limited nor collapsed)
+ * @param level level
+ * @param tag tag
+ * @param file file name
+ * @param func function name
+ * @param line line number
+ * @param format output format
+ * @param args args
+ *
+ */
+static void elog_output_va(ElogSite *site, uint8_t level, const char *tag, const char *file, const char *func,
+        const long line, const char *format, va_list args) {
     extern const char *elog_port_get_time(void);
     extern const char *elog_port_get_p_info(void);
     extern const char *elog_port_get_t_info(void);
@@ -568,25 +1019,24 @@ void elog_output(uint8_t level, const char *tag, const char *file, const char *f
     size_t tag_len = strlen(tag), log_len = 0, newline_len = strlen(ELOG_NEWLINE_SIGN);
     char line_num[ELOG_LINE_NUM_MAX_LEN + 1] = { 0 };
     char tag_sapce[ELOG_FILTER_TAG_MAX_LEN / 2 + 1] = { 0 };
-    va_list args;
+    char *log_buf;
     int fmt_result;
-
-    ELOG_ASSERT(level <= ELOG_LVL_VERBOSE);
+    size_t fmt_pos;
+#ifdef ELOG_REPEAT_COLLAPSE_ENABLE
+    size_t msg_pos;
+    uint32_t repeated;
+    char notice[48];
+    int notice_len;
+#endif
 
     /* check output enabled */
     if (!elog.output_enabled) {
         return;
     }
-    /* level filter */
-    if (level > elog.filter.level || level > elog_get_filter_tag_lvl(tag)) {
-        return;
-    } else if (!strstr(tag, elog.filter.tag)) { /* tag filter */
+    log_buf = line_buf_get();
+    if (log_buf == NULL) {
         return;
     }
-    /* args point to the first variable parameter */
-    va_start(args, format);
-    /* lock output */
-    elog_output_lock();
 
 #ifdef ELOG_COLOR_ENABLE
     /* add CSI start sign and color info */
@@ -612,6 +1062,10 @@ void elog_output(uint8_t level, const char *tag, const char *file, const char *f
     }
     /* package time, process and thread info */
     if (get_fmt_enabled(level, ELOG_FMT_TIME | ELOG_FMT_P_INFO | ELOG_FMT_T_INFO)) {
+#ifdef ELOG_LINE_BUF_STAGING
+        /* the port returns its shared static buffers, lock them until they are copied */
+        elog_output_lock();
+#endif
         log_len += elog_strcpy(log_len, log_buf + log_len, "[");
         /* package time info */
         if (get_fmt_enabled(level, ELOG_FMT_TIME)) {
@@ -631,6 +1085,9 @@ void elog_output(uint8_t level, const char *tag, const char *file, const char *f
         if (get_fmt_enabled(level, ELOG_FMT_T_INFO)) {
             log_len += elog_strcpy(log_len, log_buf + log_len, elog_port_get_t_info());
         }
+#ifdef ELOG_LINE_BUF_STAGING
+        elog_output_unlock();
+#endif
         log_len += elog_strcpy(log_len, log_buf + log_len, "] ");
     }
     /* package file directory and name, function name and line number info */
@@ -662,10 +1119,13 @@ void elog_output(uint8_t level, const char *tag, const char *file, const char *f
         }
         log_len += elog_strcpy(log_len, log_buf + log_len, ")");
     }
+#ifdef ELOG_REPEAT_COLLAPSE_ENABLE
+    msg_pos = log_len;
+#endif
     /* package other log data to buffer. '\0' must be added in the end by vsnprintf. */
+    fmt_pos = log_len;
     fmt_result = vsnprintf(log_buf + log_len, ELOG_LINE_BUF_SIZE - log_len, format, args);
 
-    va_end(args);
     /* calculate log length */
     if ((log_len + fmt_result <= ELOG_LINE_BUF_SIZE) && (fmt_result > -1)) {
         log_len += fmt_result;
@@ -688,17 +1148,55 @@ void elog_output(uint8_t level, const char *tag, const char *file, const char *f
         /* reserve some space for newline sign */
         log_len -= newline_len;
     }
+    /* the line is cut, mark its end */
+    if ((fmt_result < 0 || fmt_pos + (size_t)fmt_result > log_len)
+            && log_len >= fmt_pos + sizeof(ELOG_LINE_CUT_SIGN) - 1) {
+        memcpy(log_buf + log_len - (sizeof(ELOG_LINE_CUT_SIGN) - 1), ELOG_LINE_CUT_SIGN,
+                sizeof(ELOG_LINE_CUT_SIGN) - 1);
+    }
     /* keyword filter */
     if (elog.filter.keyword[0] != '\0') {
         /* add string end sign */
         log_buf[log_len] = '\0';
         /* find the keyword */
         if (!strstr(log_buf, elog.filter.keyword)) {
-            /* unlock output */
-            elog_output_unlock();
+            line_buf_put(level, log_buf, 0);
+            return;
+        }
+    }
+
+#ifdef ELOG_REPEAT_COLLAPSE_ENABLE
+    if (site != NULL && site->limited) {
+        if (elog_repeat_check(site, level, log_buf + msg_pos, log_len - msg_pos, &repeated)) {
+            line_buf_put(level, log_buf, 0);
+#ifdef ELOG_RATE_LIMIT_ENABLE
+            /* a collapsed line is not output, it costs no token */
+            elog_site_put_token(site);
+#endif
             return;
         }
+        if (repeated) {
+            /* the collapsed lines of the last line are reported in front of this line */
+            notice_len = snprintf(notice, sizeof(notice), "last message repeated %lu times" ELOG_NEWLINE_SIGN,
+                    (unsigned long)repeated);
+            if (notice_len > 0 && (size_t)notice_len < sizeof(notice)) {
+                /* the tail of this line is cut when there is no room for the notice */
+#ifdef ELOG_COLOR_ENABLE
+                if (log_len + notice_len + (sizeof(CSI_END) - 1) + newline_len > ELOG_LINE_BUF_SIZE) {
+                    log_len = ELOG_LINE_BUF_SIZE - (sizeof(CSI_END) - 1) - newline_len - notice_len;
+                }
+#else
+                if (log_len + notice_len + newline_len > ELOG_LINE_BUF_SIZE) {
+                    log_len = ELOG_LINE_BUF_SIZE - newline_len - notice_len;
+                }
+#endif
+                memmove(log_buf + notice_len, log_buf, log_len);
+                memcpy(log_buf, notice, notice_len);
+                log_len += notice_len;
+            }
+        }
     }
+#endif
 
 #ifdef ELOG_COLOR_ENABLE
     /* add CSI end sign */
@@ -710,17 +1208,7 @@ void elog_output(uint8_t level, const char *tag, const char *file, const char *f
     /* package newline sign */
     log_len += elog_strcpy(log_len, log_buf + log_len, ELOG_NEWLINE_SIGN);
     /* output log */
-#if defined(ELOG_ASYNC_OUTPUT_ENABLE)
-    extern void elog_async_output(uint8_t level, const char *log, size_t size);
-    elog_async_output(level, log_buf, log_len);
-#elif defined(ELOG_BUF_OUTPUT_ENABLE)
-    extern void elog_buf_output(const char *log, size_t size);
-    elog_buf_output(log_buf, log_len);
-#else
-    elog_port_output(log_buf, log_len);
-#endif
-    /* unlock output */
-    elog_output_unlock();
+    line_buf_put(level, log_buf, log_len);
 }
 
 /**
@@ -868,7 +1356,7 @@ void elog_hexdump(const char *name, uint8_t width, const void *buf, uint16_t siz
     uint16_t i, j;
     uint16_t log_len = 0;
     const uint8_t *buf_p = buf;
-    char dump_string[8] = {0};
+    char *log_buf, *p, *end;
     int fmt_result;
 
     if (!elog.output_enabled) {
@@ -882,10 +1370,11 @@ void elog_hexdump(const char *name, uint8_t width, const void *buf, uint16_t siz
         return;
     }
 
-    /* lock output */
-    elog_output_lock();
-
     for (i = 0; i < size; i += width) {
+        log_buf = line_buf_get();
+        if (log_buf == NULL) {
+            return;
+        }
         /* package header */
         fmt_result = snprintf(log_buf, ELOG_LINE_BUF_SIZE, "D/HEX %s: %04X-%04X: ", name, i, i + width - 1);
         /* calculate log length */
@@ -894,26 +1383,33 @@ void elog_hexdump(const char *name, uint8_t width, const void *buf, uint16_t siz
         } else {
             log_len = ELOG_LINE_BUF_SIZE;
         }
+        /* the hex and char columns are written straight into the line buffer, reserve the newline sign */
+        p = log_buf + log_len;
+        end = log_buf + ELOG_LINE_BUF_SIZE - strlen(ELOG_NEWLINE_SIGN);
         /* dump hex */
-        for (j = 0; j < width; j++) {
+        for (j = 0; j < width && p + 4 <= end; j++) {
             if (i + j < size) {
-                snprintf(dump_string, sizeof(dump_string), "%02X ", buf_p[i + j]);
+                *p++ = hex_table[buf_p[i + j]][0];
+                *p++ = hex_table[buf_p[i + j]][1];
             } else {
-                strncpy(dump_string, "   ", sizeof(dump_string));
+                *p++ = ' ';
+                *p++ = ' ';
             }
-            log_len += elog_strcpy(log_len, log_buf + log_len, dump_string);
+            *p++ = ' ';
             if ((j + 1) % 8 == 0) {
-                log_len += elog_strcpy(log_len, log_buf + log_len, " ");
+                *p++ = ' ';
             }
         }
-        log_len += elog_strcpy(log_len, log_buf + log_len, "  ");
-        /* dump char for hex */
-        for (j = 0; j < width; j++) {
-            if (i + j < size) {
-                snprintf(dump_string, sizeof(dump_string), "%c", __is_print(buf_p[i + j]) ? buf_p[i + j] : '.');
-                log_len += elog_strcpy(log_len, log_buf + log_len, dump_string);
+        /* the hex column is cut at a whole byte, the char column would not match it, leave it out */
+        if (j == width && p + 2 <= end) {
+            *p++ = ' ';
+            *p++ = ' ';
+            /* dump char for hex */
+            for (j = 0; j < width && i + j < size && p < end; j++) {
+                *p++ = __is_print(buf_p[i + j]) ? buf_p[i + j] : '.';
             }
         }
+        log_len = (uint16_t)(p - log_buf);
         /* overflow check and reserve some space for newline sign */
         if (log_len + strlen(ELOG_NEWLINE_SIGN) > ELOG_LINE_BUF_SIZE) {
             log_len = ELOG_LINE_BUF_SIZE - strlen(ELOG_NEWLINE_SIGN);
@@ -921,16 +1417,94 @@ void elog_hexdump(const char *name, uint8_t width, const void *buf, uint16_t siz
         /* package newline sign */
         log_len += elog_strcpy(log_len, log_buf + log_len, ELOG_NEWLINE_SIGN);
         /* do log output */
-#if defined(ELOG_ASYNC_OUTPUT_ENABLE)
-        extern void elog_async_output(uint8_t level, const char *log, size_t size);
-        elog_async_output(ELOG_LVL_DEBUG, log_buf, log_len);
-#elif defined(ELOG_BUF_OUTPUT_ENABLE)
-        extern void elog_buf_output(const char *log, size_t size);
-        elog_buf_output(log_buf, log_len);
-#else
-        elog_port_output(log_buf, log_len);
-#endif
+        line_buf_put(ELOG_LVL_DEBUG, log_buf, log_len);
     }
-    /* unlock output */
-    elog_output_unlock();
 }
+
+#ifdef ELOG_DEFER_OUTPUT_ENABLE
+extern void elog_port_defer_output(uint32_t *record, size_t size, const void *data, size_t data_size);
+
+/**
+ * output deferred (binary) log
+ * The format is NOT rendered on target. Only a fixed header and the raw argument words are sent,
+ * the host decoder (STM32_PC_Tool/elog_defer_decode.py) reads the "tag\x1f format" string from
+ * the ELF file by its address and renders the text.
+ *
+ * record (32 bit little endian words):
+ *   [0] address of the "tag\x1f format" string
+ *   [1] timestamp from elog_port_get_timestamp()
+ *   [2] level | argument number << 8 | sequence << 16
+ *   [3...] arguments
+ * The sequence is filled in by the port under the channel lock, see elog_port_defer_output().
+ * elog_hexdump_defer() sends ELOG_DEFER_BLOB as the argument number, see it for the layout.
+ *
+ * @param level level
+ * @param fmt address of the "tag\x1f format" string (placed in ELOG_DEFER_SECTION)
+ * @param nargs argument number
+ * @param ... arguments, each one must be 32 bit
+ */
+void elog_defer_output(uint8_t level, const char *fmt, size_t nargs, ...) {
+    uint32_t record[3 + ELOG_DEFER_ARGS_MAX];
+    va_list args;
+    size_t i;
+
+    ELOG_ASSERT(level <= ELOG_LVL_VERBOSE);
+    ELOG_ASSERT(nargs <= ELOG_DEFER_ARGS_MAX);
+
+    /* check output enabled */
+    if (!elog.output_enabled) {
+        return;
+    }
+    /* level filter, the tag filters need the tag string so they are done on the host */
+    if (level > elog.filter.level) {
+        return;
+    }
+
+    record[0] = (uint32_t)(uintptr_t)fmt;
+    record[1] = (uint32_t)elog_port_get_timestamp();
+    record[2] = (uint32_t)level | ((uint32_t)nargs << 8);
+    va_start(args, nargs);
+    for (i = 0; i < nargs; i++) {
+        record[3 + i] = va_arg(args, uint32_t);
+    }
+    va_end(args);
+
+    elog_port_defer_output(record, (3 + nargs) * sizeof(uint32_t), NULL, 0);
+}
+
+/**
+ * dump the raw bytes to the deferred (binary) log channel, the host decoder prints them as hexdump
+ * Nothing is formatted on target, the bytes are copied into the channel as they are.
+ *
+ * record (32 bit little endian words):
+ *   [0] address of the name string
+ *   [1] timestamp from elog_port_get_timestamp()
+ *   [2] ELOG_LVL_DEBUG | ELOG_DEFER_BLOB << 8 | sequence << 16
+ *   [3] byte size
+ *   [4...] bytes, padded with 0 to a multiple of 4
+ *
+ * @param name name, a string literal in flash: only its address is sent, the decoder reads the
+ *        string from the ELF file (the elog_hexdump_defer() macro rejects anything else)
+ * @param buf bytes
+ * @param size byte size
+ */
+void (elog_hexdump_defer)(const char *name, const void *buf, uint16_t size) {
+    uint32_t record[4];
+
+    /* check output enabled */
+    if (!elog.output_enabled) {
+        return;
+    }
+    /* level filter, the same level as elog_hexdump() */
+    if (ELOG_LVL_DEBUG > elog.filter.level) {
+        return;
+    }
+
+    record[0] = (uint32_t)(uintptr_t)name;
+    record[1] = (uint32_t)elog_port_get_timestamp();
+    record[2] = (uint32_t)ELOG_LVL_DEBUG | ((uint32_t)ELOG_DEFER_BLOB << 8);
+    record[3] = size;
+
+    elog_port_defer_output(record, sizeof(record), buf, size);
+}
+#endif /* ELOG_DEFER_OUTPUT_ENABLE */
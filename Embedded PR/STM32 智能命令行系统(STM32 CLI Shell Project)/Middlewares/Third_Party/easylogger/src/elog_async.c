@@ -62,6 +62,75 @@
 static sem_t output_notice;
 /* asynchronous output pthread thread */
 static pthread_t async_output_thread;
+#elif defined(ELOG_ASYNC_OUTPUT_USING_FREERTOS)
+#include <stddef.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#ifndef __linux__
+#include "cmsis_compiler.h"
+#endif
+/* drain task stack size (words) */
+#ifndef ELOG_ASYNC_OUTPUT_FREERTOS_STACK_SIZE
+#define ELOG_ASYNC_OUTPUT_FREERTOS_STACK_SIZE    256
+#endif
+/* drain task priority, keep it low so that outputting logs never delays the application tasks */
+#ifndef ELOG_ASYNC_OUTPUT_FREERTOS_PRIORITY
+#define ELOG_ASYNC_OUTPUT_FREERTOS_PRIORITY      (tskIDLE_PRIORITY + 1)
+#endif
+/* line slot number of the output queue, it must be power of 2 */
+#ifndef ELOG_ASYNC_LINE_SLOT_NUM
+#define ELOG_ASYNC_LINE_SLOT_NUM                 16
+#endif
+/* max ticks a task waits for a free slot when the queue is full, interrupts never wait */
+#ifndef ELOG_ASYNC_LINE_SLOT_WAIT_TICKS
+#define ELOG_ASYNC_LINE_SLOT_WAIT_TICKS          pdMS_TO_TICKS(20)
+#endif
+/* max time (ms) the drain task waits for a reserved slot to be published before it skips the slot */
+#ifndef ELOG_ASYNC_LINE_STALE_MS
+#define ELOG_ASYNC_LINE_STALE_MS                 10
+#endif
+
+#if (ELOG_ASYNC_LINE_SLOT_NUM & (ELOG_ASYNC_LINE_SLOT_NUM - 1)) != 0
+#error "ELOG_ASYNC_LINE_SLOT_NUM must be power of 2"
+#endif
+
+/**
+ * One line of the output queue. The producer who reserved it formats the log in place,
+ * so it is also the private staging buffer of that task or interrupt until it is published.
+ *
+ * seq == position:     free, the producer of this position may reserve it
+ *                      (reserved when enqueue_pos has passed the position)
+ * seq == position + 1: published, the drain task may output it
+ * seq == position + 2: skipped by the drain task, the producer still owns the buffer and frees
+ *                      the slot for the next round when it is done
+ */
+typedef struct {
+    volatile uint32_t seq;
+    uint32_t pos;  /**< the position it is reserved for, only used by the producer */
+    size_t len;
+    uint8_t level;
+    bool output;  /**< false: it has been output synchronously, the drain task only saves it */
+    char buf[ELOG_LINE_BUF_SIZE];
+} async_slot;
+
+/* bounded lock-free multi-producer single-consumer queue of line slots */
+static async_slot slots[ELOG_ASYNC_LINE_SLOT_NUM];
+/* next position to reserve, shared by all producers */
+static volatile uint32_t enqueue_pos = 0;
+/* next position to output, only moved by the consumer */
+static uint32_t dequeue_pos = 0;
+/* asynchronous output drain task */
+static TaskHandle_t async_output_task = NULL;
+static StaticTask_t async_output_task_cb;
+static StackType_t async_output_task_stack[ELOG_ASYNC_OUTPUT_FREERTOS_STACK_SIZE];
+/* tasks wait on it for a free slot when the queue is full, the drain task gives it after output */
+static SemaphoreHandle_t slot_free = NULL;
+static StaticSemaphore_t slot_free_cb;
+/* number of the tasks waiting for a free slot */
+static volatile uint32_t slot_waiters = 0;
+/* dropped logs count because the queue is full or the slot is skipped */
+static volatile uint32_t drop_count = 0;
 #endif /* ELOG_ASYNC_OUTPUT_USING_PTHREAD */
 
 /* the highest output level for async mode, other level will sync output */
@@ -86,6 +155,352 @@ static bool thread_running = false;
 #endif
 /* asynchronous output mode enabled flag */
 static bool is_enabled = false;
+
+extern void elog_port_output(const char *log, size_t size);
+#ifdef ELOG_ASYNC_OUTPUT_USING_FREERTOS
+extern void elog_port_save(uint8_t level, const char *log, size_t size);
+#endif
+extern void elog_output_lock(void);
+extern void elog_output_unlock(void);
+
+#ifdef ELOG_ASYNC_OUTPUT_USING_FREERTOS
+/**
+ * atomic compare and swap
+ *
+ * @param addr variable address
+ * @param expect expected value
+ * @param value new value
+ *
+ * @return true: swapped, false: the variable is not the expected value
+ */
+static bool async_cas(volatile uint32_t *addr, uint32_t expect, uint32_t value) {
+#ifdef __linux__
+    return __atomic_compare_exchange_n(addr, &expect, value, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#else
+    /* the slot content written before must be visible before the new value */
+    __DMB();
+    do {
+        if (__LDREXW(addr) != expect) {
+            __CLREX();
+            return false;
+        }
+    } while (__STREXW(value, addr) != 0);
+    __DMB();
+    return true;
+#endif
+}
+
+/**
+ * read a slot sequence, the slot content must be read after it
+ */
+static uint32_t async_load_seq(volatile uint32_t *seq) {
+#ifdef __linux__
+    return __atomic_load_n(seq, __ATOMIC_ACQUIRE);
+#else
+    uint32_t value = *seq;
+    __DMB();
+    return value;
+#endif
+}
+
+/**
+ * write a slot sequence, the slot content must be written before it
+ */
+static void async_store_seq(volatile uint32_t *seq, uint32_t value) {
+#ifdef __linux__
+    __atomic_store_n(seq, value, __ATOMIC_RELEASE);
+#else
+    __DMB();
+    *seq = value;
+#endif
+}
+
+/**
+ * full memory barrier, the following reads are done after the preceding writes
+ */
+static void async_fence(void) {
+#ifdef __linux__
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+#else
+    __DMB();
+#endif
+}
+
+/**
+ * atomic add
+ *
+ * @param addr variable address
+ * @param value value to add (may be negative)
+ */
+static void async_add(volatile uint32_t *addr, int32_t value) {
+    uint32_t old;
+
+    do {
+        old = async_load_seq(addr);
+    } while (!async_cas(addr, old, old + (uint32_t)value));
+}
+
+/**
+ * reserve a line slot, lock-free, tasks and interrupts can reserve slots at the same time
+ *
+ * @return slot, NULL when the queue is full
+ */
+static async_slot *async_slot_reserve(void) {
+    async_slot *slot;
+    uint32_t pos;
+    int32_t dif;
+
+    for (;;) {
+        pos = async_load_seq(&enqueue_pos);
+        slot = &slots[pos & (ELOG_ASYNC_LINE_SLOT_NUM - 1)];
+        dif = (int32_t)(async_load_seq(&slot->seq) - pos);
+        if (dif == 0) {
+            if (async_cas(&enqueue_pos, pos, pos + 1)) {
+                slot->pos = pos;
+                return slot;
+            }
+        } else if (dif < 0) {
+            /* the slot of previous round is not output yet */
+            return NULL;
+        }
+        /* other producer has taken this position, retry on the new one */
+    }
+}
+
+/**
+ * get the next published slot, only called by the consumer
+ *
+ * @return slot, NULL when no slot is published
+ */
+static async_slot *async_slot_peek(void) {
+    async_slot *slot = &slots[dequeue_pos & (ELOG_ASYNC_LINE_SLOT_NUM - 1)];
+
+    if (async_load_seq(&slot->seq) == dequeue_pos + 1) {
+        return slot;
+    }
+    return NULL;
+}
+
+/**
+ * give the output slot back to the producers, only called by the consumer
+ *
+ * @param slot the slot from async_slot_peek()
+ */
+static void async_slot_release(async_slot *slot) {
+    async_store_seq(&slot->seq, dequeue_pos + ELOG_ASYNC_LINE_SLOT_NUM);
+    dequeue_pos++;
+    /* wake one waiting task, it registers itself before it checks the queue again */
+    async_fence();
+    if (async_load_seq(&slot_waiters) != 0 && slot_free != NULL) {
+        xSemaphoreGive(slot_free);
+    }
+}
+
+/**
+ * skip the next slot which is reserved but not published, only called by the consumer
+ * The producer keeps the buffer, it sees the skip when it publishes, drops the line and
+ * frees the slot for the next round itself.
+ *
+ * @return true: skipped, false: it is published just now
+ */
+static bool async_slot_skip(void) {
+    async_slot *slot = &slots[dequeue_pos & (ELOG_ASYNC_LINE_SLOT_NUM - 1)];
+
+    if (!async_cas(&slot->seq, dequeue_pos, dequeue_pos + 2)) {
+        return false;
+    }
+    dequeue_pos++;
+    async_add(&drop_count, 1);
+    return true;
+}
+
+/**
+ * wake up the drain task
+ */
+static void async_output_notice(void) {
+    BaseType_t woken = pdFALSE;
+
+    if (async_output_task == NULL) {
+        return;
+    }
+    if (xPortIsInsideInterrupt()) {
+        vTaskNotifyGiveFromISR(async_output_task, &woken);
+        /* the drain task has the low priority, this rarely switches */
+        portYIELD_FROM_ISR(woken);
+    } else {
+        xTaskNotifyGive(async_output_task);
+    }
+}
+
+/**
+ * check whether the caller can wait for a free slot
+ *
+ * @return true: called from a task which is allowed to block
+ */
+static bool async_can_wait(void) {
+    if (xPortIsInsideInterrupt() || xTaskGetSchedulerState() != taskSCHEDULER_RUNNING) {
+        return false;
+    }
+#ifndef __linux__
+    /* BASEPRI is raised in critical section */
+    if (__get_BASEPRI() != 0) {
+        return false;
+    }
+#endif
+    return true;
+}
+
+/**
+ * get a line buffer to package one log
+ * Every caller formats in its own reserved slot, so the tasks and interrupts neither wait for
+ * each other nor share the line buffer. The buffer MUST be given back by elog_async_put_line_buf().
+ * Only when the queue is full, a task blocks until the drain task frees a slot (usually the
+ * time of outputting one line), ELOG_ASYNC_LINE_SLOT_WAIT_TICKS at most. An interrupt (or a
+ * task in critical section) drops the log immediately.
+ *
+ * @return line buffer (ELOG_LINE_BUF_SIZE bytes), NULL when the log is dropped
+ */
+char *elog_async_get_line_buf(void) {
+    async_slot *slot = async_slot_reserve();
+    TickType_t start, waited;
+
+    if (slot == NULL && async_can_wait() && slot_free != NULL) {
+        start = xTaskGetTickCount();
+        do {
+            waited = xTaskGetTickCount() - start;
+            if (waited >= ELOG_ASYNC_LINE_SLOT_WAIT_TICKS) {
+                break;
+            }
+            /* register before checking again, a slot freed in between gives the semaphore */
+            async_add(&slot_waiters, 1);
+            async_fence();
+            slot = async_slot_reserve();
+            if (slot == NULL) {
+                xSemaphoreTake(slot_free, ELOG_ASYNC_LINE_SLOT_WAIT_TICKS - waited);
+                slot = async_slot_reserve();
+            }
+            async_add(&slot_waiters, -1);
+        } while (slot == NULL);
+    }
+    if (slot == NULL) {
+        async_add(&drop_count, 1);
+        return NULL;
+    }
+
+    return slot->buf;
+}
+
+/**
+ * publish a packaged log to the drain task
+ * The log which level is higher than ELOG_ASYNC_OUTPUT_LVL (or when asynchronous mode is disabled)
+ * is output directly from the slot, then the slot is still published to keep the queue order,
+ * the drain task only gives it to elog_port_save().
+ *
+ * @param level log level
+ * @param log the line buffer from elog_async_get_line_buf()
+ * @param size log size, 0: nothing to output (the log is filtered)
+ */
+void elog_async_put_line_buf(uint8_t level, char *log, size_t size) {
+    async_slot *slot = (async_slot *)(log - offsetof(async_slot, buf));
+
+    slot->output = true;
+    if (size && !(is_enabled && level >= OUTPUT_LVL)) {
+        elog_port_output(log, size);
+        slot->output = false;
+    }
+    slot->len = size;
+    slot->level = level;
+    if (!async_cas(&slot->seq, slot->pos, slot->pos + 1)) {
+        /* the drain task has skipped it (held too long), the line is dropped, free it for the next round */
+        async_store_seq(&slot->seq, slot->pos + ELOG_ASYNC_LINE_SLOT_NUM);
+        return;
+    }
+    async_output_notice();
+}
+
+/**
+ * get log from asynchronous output queue, one line every time
+ * NOTE: the queue only supports one consumer, don't call it when the drain task is running.
+ *
+ * @param log get log buffer
+ * @param size log buffer size, the line which is longer than it will be truncated
+ *
+ * @return get log size
+ */
+size_t elog_async_get_log(char *log, size_t size) {
+    async_slot *slot;
+    size_t len = 0;
+
+    while ((slot = async_slot_peek()) != NULL) {
+        len = slot->output ? ((slot->len < size) ? slot->len : size) : 0;
+        memcpy(log, slot->buf, len);
+        async_slot_release(slot);
+        if (len) {
+            break;
+        }
+    }
+
+    return len;
+}
+
+/**
+ * get the dropped logs count because the asynchronous output queue is full, or the slot is
+ * skipped by the drain task (held longer than ELOG_ASYNC_LINE_STALE_MS)
+ *
+ * @return dropped logs count
+ */
+uint32_t elog_async_get_drop_count(void) {
+    return async_load_seq(&drop_count);
+}
+
+/**
+ * asynchronous output drain task, it outputs the logs at low priority
+ * The logs are output in the reserved order. When the next slot is reserved but not published,
+ * its producer is packaging it or has been preempted while packaging. The drain task polls it
+ * every tick and skips it after ELOG_ASYNC_LINE_STALE_MS, so a preempted low priority
+ * producer delays the logs behind it by that time at most.
+ */
+static void async_output(void *arg) {
+    async_slot *slot;
+    TickType_t stuck_since = 0;
+    bool stuck = false;
+
+    (void)arg;
+    for (;;) {
+        /* waiting log, every published slot gives one notification */
+        ulTaskNotifyTake(pdTRUE, stuck ? 1 : portMAX_DELAY);
+        for (;;) {
+            slot = async_slot_peek();
+            if (slot != NULL) {
+                stuck = false;
+                if (slot->len) {
+                    if (slot->output) {
+                        elog_port_output(slot->buf, slot->len);
+                    }
+                    /* in the task context and in order, the port may save it to a slow storage */
+                    elog_port_save(slot->level, slot->buf, slot->len);
+                }
+                async_slot_release(slot);
+                continue;
+            }
+            if (async_load_seq(&enqueue_pos) == dequeue_pos) {
+                /* empty */
+                stuck = false;
+                break;
+            }
+            /* the next slot is reserved but not published yet */
+            if (!stuck) {
+                stuck = true;
+                stuck_since = xTaskGetTickCount();
+            } else if (xTaskGetTickCount() - stuck_since >= pdMS_TO_TICKS(ELOG_ASYNC_LINE_STALE_MS) && async_slot_skip()) {
+                stuck = false;
+                continue;
+            }
+            break;
+        }
+    }
+}
+#else
 /* asynchronous output mode's ring buffer */
 static char log_buf[OUTPUT_BUF_SIZE] = { 0 };
 /* log ring buffer write index */
@@ -97,10 +512,6 @@ static bool buf_is_full = false;
 /* log ring buffer empty flag */
 static bool buf_is_empty = true;
 
-extern void elog_port_output(const char *log, size_t size);
-extern void elog_output_lock(void);
-extern void elog_output_unlock(void);
-
 /**
  * asynchronous output ring buffer used size
  *
@@ -263,8 +674,22 @@ __exit:
     return size;
 }
 #endif /* ELOG_ASYNC_LINE_OUTPUT */
+#endif /* ELOG_ASYNC_OUTPUT_USING_FREERTOS */
 
 void elog_async_output(uint8_t level, const char *log, size_t size) {
+#ifdef ELOG_ASYNC_OUTPUT_USING_FREERTOS
+    /* the log is packaged outside the queue, copy it into a slot */
+    char *line = elog_async_get_line_buf();
+
+    if (line == NULL) {
+        return;
+    }
+    if (size > ELOG_LINE_BUF_SIZE) {
+        size = ELOG_LINE_BUF_SIZE;
+    }
+    memcpy(line, log, size);
+    elog_async_put_line_buf(level, line, size);
+#else
     /* this function must be implement by user when ELOG_ASYNC_OUTPUT_USING_PTHREAD is not defined */
     extern void elog_async_output_notice(void);
     size_t put_size;
@@ -282,6 +707,7 @@ void elog_async_output(uint8_t level, const char *log, size_t size) {
     } else {
         elog_port_output(log, size);
     }
+#endif /* ELOG_ASYNC_OUTPUT_USING_FREERTOS */
 }
 
 #ifdef ELOG_ASYNC_OUTPUT_USING_PTHREAD
@@ -354,6 +780,20 @@ ElogErrCode elog_async_init(void) {
     pthread_attr_setschedparam(&thread_attr, &thread_sched_param);
     pthread_create(&async_output_thread, &thread_attr, async_output, NULL);
     pthread_attr_destroy(&thread_attr);
+#elif defined(ELOG_ASYNC_OUTPUT_USING_FREERTOS)
+    uint32_t i;
+
+    /* every slot starts free for the position of the first round */
+    for (i = 0; i < ELOG_ASYNC_LINE_SLOT_NUM; i++) {
+        slots[i].seq = i;
+    }
+    enqueue_pos = 0;
+    dequeue_pos = 0;
+    slot_waiters = 0;
+    slot_free = xSemaphoreCreateCountingStatic(ELOG_ASYNC_LINE_SLOT_NUM, 0, &slot_free_cb);
+    /* static allocation, the logger doesn't take any FreeRTOS heap */
+    async_output_task = xTaskCreateStatic(async_output, "elog", ELOG_ASYNC_OUTPUT_FREERTOS_STACK_SIZE, NULL,
+            ELOG_ASYNC_OUTPUT_FREERTOS_PRIORITY, async_output_task_stack, &async_output_task_cb);
 #endif
 
     init_ok = true;
@@ -378,6 +818,9 @@ void elog_async_deinit(void) {
     pthread_join(async_output_thread, NULL);
     
     sem_destroy(&output_notice);
+#elif defined(ELOG_ASYNC_OUTPUT_USING_FREERTOS)
+    vTaskDelete(async_output_task);
+    async_output_task = NULL;
 #endif
 
     init_ok = false;
@@ -0,0 +1,234 @@
+/*
+ * ADC 换算验证工具：用合成的采样序列在 PC 上检验 bsp_adc_calc.c 的定点换算
+ *
+ * 换算代码原样编译，不依赖 HAL：
+ *     gcc -O2 -I../../BSP/BSP_ADC -o adc_sim adc_sim.c ../../BSP/BSP_ADC/bsp_adc_calc.c -lm
+ *     ./adc_sim             默认 200 颗虚拟芯片
+ *     ./adc_sim 1000 3      1000 颗芯片，噪声 3 LSB (RMS)
+ *
+ * 每颗虚拟芯片按数据手册的离散范围随机生成：内部参考电压 1.18~1.24V，
+ * 温度传感器 V25 0.73~0.79V、斜率 2.4~2.6mV/℃，再按出厂条件 (VDDA=3.3V, 30℃/110℃) 算出校准值。
+ * 在 VDDA 3.0~3.6V、温度 -40~125℃ 的网格上生成带高斯噪声的 12 位读数，
+ * 交错排成 DMA 缓冲区的格式交给 ADC_Calc_Convert，与真实值比较：
+ *     单次采样 / 64 次过采样，出厂校准 / 典型值公式 (旧代码固定 VDDA = 3.3V 的结果也一并列出)
+ * 最后检查极端读数 (0、满量程、校准值无效) 不会溢出或除零。
+ * 结果有一项超出范围时返回非 0，可以直接放进脚本里做回归检查。
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "bsp_adc_calc.h"
+
+#define GRID_VDDA 7     // 3.0, 3.1 ... 3.6V
+#define GRID_TEMP 12    // -40 ... 125℃, 每 15℃ 一格
+
+typedef struct
+{
+    double vrefint;     // 内部参考电压 (V)
+    double v25;         // 25℃ 时温度传感器输出 (V)
+    double slope;       // 温度斜率 (V/℃)
+    ADC_Calib_t cal;
+} Chip_t;
+
+typedef struct
+{
+    const char *name;
+    double max, sum;
+    unsigned count;
+} Err_Stat_t;
+
+static uint32_t rng = 88172645U;
+static double noise_lsb = 1.5;
+
+static double rand_uniform(void)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return (rng + 0.5) / 4294967296.0;
+}
+
+static double rand_gauss(void)
+{
+    return sqrt(-2.0 * log(rand_uniform())) * cos(2.0 * M_PI * rand_uniform());
+}
+
+static double rand_range(double lo, double hi)
+{
+    return lo + (hi - lo) * rand_uniform();
+}
+
+/**
+ * @brief 12 位 ADC：理想量化加高斯噪声
+ */
+static uint16_t adc_sample(double v, double vdda)
+{
+    double code = v / vdda * 4095.0 + rand_gauss() * noise_lsb;
+
+    if (code < 0)
+    {
+        code = 0;
+    }
+    if (code > 4095)
+    {
+        code = 4095;
+    }
+    return (uint16_t)lround(code);
+}
+
+static double sensor_v(const Chip_t *chip, double temp)
+{
+    return chip->v25 + chip->slope * (temp - 25.0);
+}
+
+static void chip_make(Chip_t *chip)
+{
+    chip->vrefint = rand_range(1.18, 1.24);
+    chip->v25 = rand_range(0.73, 0.79);
+    chip->slope = rand_range(0.0024, 0.0026);
+    // 出厂校准：VDDA = 3.3V，多次平均后的读数，不含噪声
+    chip->cal.vrefint_cal = (uint16_t)lround(chip->vrefint / 3.3 * 4095.0);
+    chip->cal.ts_cal1 = (uint16_t)lround(sensor_v(chip, ADC_TS_CAL1_TEMP) / 3.3 * 4095.0);
+    chip->cal.ts_cal2 = (uint16_t)lround(sensor_v(chip, ADC_TS_CAL2_TEMP) / 3.3 * 4095.0);
+}
+
+static void err_add(Err_Stat_t *e, double err)
+{
+    err = fabs(err);
+    if (err > e->max)
+    {
+        e->max = err;
+    }
+    e->sum += err;
+    e->count++;
+}
+
+static void err_print(const Err_Stat_t *e, const char *unit)
+{
+    printf("  %-34s avg %7.3f %s, max %7.3f %s\n", e->name, e->sum / e->count, unit, e->max, unit);
+}
+
+/**
+ * @brief 旧代码的算法：VDDA 固定 3.3V，典型值公式，单次采样
+ */
+static double legacy_temp(uint16_t temp_raw)
+{
+    double v_sense = (double)temp_raw * 3.3 / 4095.0;
+
+    return (v_sense - 0.76) / 0.0025 + 25.0;
+}
+
+/**
+ * @brief 极端输入：不能崩溃，结果要落在类型范围内
+ */
+static int edge_cases(void)
+{
+    static const ADC_Calib_t cals[] = {{1489, 941, 1203}, {0xFFFF, 0xFFFF, 0xFFFF}, {0, 0, 0}, {1489, 1203, 941}};
+    static const uint16_t raws[] = {0, 1, 2048, 4095};
+    uint16_t buf[ADC_OVERSAMPLE * ADC_CH_NUM];
+    ADC_Result_t r;
+    unsigned c, v, t, i, bad = 0;
+
+    for (c = 0; c < sizeof(cals) / sizeof(cals[0]); c++)
+    {
+        for (v = 0; v < sizeof(raws) / sizeof(raws[0]); v++)
+        {
+            for (t = 0; t < sizeof(raws) / sizeof(raws[0]); t++)
+            {
+                for (i = 0; i < ADC_OVERSAMPLE; i++)
+                {
+                    buf[i * ADC_CH_NUM + ADC_CH_VREFINT] = raws[v];
+                    buf[i * ADC_CH_NUM + ADC_CH_TEMP] = raws[t];
+                }
+                ADC_Calc_Convert(&cals[c], buf, ADC_OVERSAMPLE, &r);
+                if (r.vref_q != (raws[v] << ADC_Q_SHIFT) || r.temp_q != (raws[t] << ADC_Q_SHIFT) ||
+                    (0 == raws[v] && (0 != r.vdda_mv || 0 != r.temp_centi)))
+                {
+                    printf("  edge case failed: cal %u/%u/%u vref %u temp %u -> %u mV %d\n", cals[c].vrefint_cal,
+                           cals[c].ts_cal1, cals[c].ts_cal2, raws[v], raws[t], r.vdda_mv, r.temp_centi);
+                    bad++;
+                }
+            }
+        }
+    }
+    return bad;
+}
+
+int main(int argc, char **argv)
+{
+    Err_Stat_t vdda_single = {"VDDA, single sample", 0, 0, 0};
+    Err_Stat_t vdda_over = {"VDDA, 64x oversampled", 0, 0, 0};
+    Err_Stat_t temp_single = {"Temp, calibrated, single sample", 0, 0, 0};
+    Err_Stat_t temp_over = {"Temp, calibrated, 64x oversampled", 0, 0, 0};
+    Err_Stat_t temp_typ = {"Temp, typical formula, 64x", 0, 0, 0};
+    Err_Stat_t temp_legacy = {"Temp, old code (VDDA fixed 3.3V)", 0, 0, 0};
+    uint16_t buf[ADC_OVERSAMPLE * ADC_CH_NUM];
+    ADC_Result_t r;
+    ADC_Calib_t no_cal = {0xFFFF, 0xFFFF, 0xFFFF};
+    unsigned chips = 200, n, a, b, i, bad;
+    double vdda, temp;
+    Chip_t chip;
+
+    if (argc > 1)
+    {
+        chips = (unsigned)atoi(argv[1]);
+    }
+    if (argc > 2)
+    {
+        noise_lsb = atof(argv[2]);
+    }
+    if (0 == chips || noise_lsb < 0)
+    {
+        printf("usage: %s [chips] [noise_lsb_rms]\n", argv[0]);
+        return 1;
+    }
+
+    for (n = 0; n < chips; n++)
+    {
+        chip_make(&chip);
+        for (a = 0; a < GRID_VDDA; a++)
+        {
+            vdda = 3.0 + 0.1 * a;
+            for (b = 0; b < GRID_TEMP; b++)
+            {
+                temp = -40.0 + 15.0 * b;
+                for (i = 0; i < ADC_OVERSAMPLE; i++)
+                {
+                    buf[i * ADC_CH_NUM + ADC_CH_VREFINT] = adc_sample(chip.vrefint, vdda);
+                    buf[i * ADC_CH_NUM + ADC_CH_TEMP] = adc_sample(sensor_v(&chip, temp), vdda);
+                }
+
+                ADC_Calc_Convert(&chip.cal, buf, 1, &r);
+                err_add(&vdda_single, r.vdda_mv - vdda * 1000);
+                err_add(&temp_single, r.temp_centi / 100.0 - temp);
+                err_add(&temp_legacy, legacy_temp(buf[ADC_CH_TEMP]) - temp);
+
+                ADC_Calc_Convert(&chip.cal, buf, ADC_OVERSAMPLE, &r);
+                err_add(&vdda_over, r.vdda_mv - vdda * 1000);
+                err_add(&temp_over, r.temp_centi / 100.0 - temp);
+
+                ADC_Calc_Convert(&no_cal, buf, ADC_OVERSAMPLE, &r);
+                err_add(&temp_typ, r.temp_centi / 100.0 - temp);
+            }
+        }
+    }
+
+    printf("%u chips, VDDA 3.0~3.6V, -40~125 C, noise %.1f LSB RMS, %u scans per result\n", chips, noise_lsb,
+           ADC_OVERSAMPLE);
+    err_print(&vdda_single, "mV");
+    err_print(&vdda_over, "mV");
+    err_print(&temp_legacy, "C ");
+    err_print(&temp_typ, "C ");
+    err_print(&temp_single, "C ");
+    err_print(&temp_over, "C ");
+
+    bad = edge_cases();
+    printf("edge cases: %s\n", (0 == bad) ? "ok" : "FAILED");
+    // 回归门限：过采样 + 校准后 VDDA 误差 < 20mV，温度误差 < 2℃ (默认噪声下)
+    if (noise_lsb <= 1.5 && (vdda_over.max > 20 || temp_over.max > 2.0))
+    {
+        printf("oversampled error above limit\n");
+        bad++;
+    }
+    return (0 == bad) ? 0 : 1;
+}
@@ -0,0 +1,387 @@
+/*
+ * ADC 滤波对比工具：把录下来的 (或合成的) 采样序列送进 bsp_adc_filter.c，
+ * 比较不滤波 / 浮点 / 定点三种方式的输出噪声和每个采样的耗时
+ *
+ * 滤波代码和 CMSIS-DSP 源码原样编译，不依赖 HAL：
+ *     DSP=../../Drivers/CMSIS/DSP
+ *     gcc -O2 -I../../BSP/BSP_ADC -I$DSP/Include -I../../Drivers/CMSIS/Include -o dsp_bench dsp_bench.c \
+ *         ../../BSP/BSP_ADC/bsp_adc_filter.c ../../BSP/BSP_ADC/bsp_adc_calc.c \
+ *         $DSP/Source/FilteringFunctions/arm_biquad_cascade_df1_f32.c \
+ *         $DSP/Source/FilteringFunctions/arm_biquad_cascade_df1_init_f32.c \
+ *         $DSP/Source/FilteringFunctions/arm_biquad_cascade_df1_q15.c \
+ *         $DSP/Source/FilteringFunctions/arm_biquad_cascade_df1_init_q15.c \
+ *         $DSP/Source/StatisticsFunctions/arm_mean_f32.c $DSP/Source/StatisticsFunctions/arm_mean_q15.c -lm
+ *     ./dsp_bench                        合成信号，1Hz 二阶低通
+ *     ./dsp_bench 0.5 2                  截止频率 0.5Hz，两节 (四阶)
+ *     ./dsp_bench 1 1 capture.log        用板子上 FILT DUMP 录下的数据
+ *
+ * 录数据：串口终端记录日志，执行 FILT DUMP 240 (约 1 分钟)，日志中 "ADC:" 后面的数字按 "参考电压 温度" 成对读入。
+ * 连续的 "ADC:" 行是一段不间断的采样，中间夹了别的日志 (丢块警告、下一次 DUMP) 就分段，
+ * 每段滤波器重新初始化，短于 3 * SETTLE_BLOCKS 块的段不参与统计。
+ *
+ * 合成信号：250Hz 采样，VDDA 3.3V，内部参考电压 1.21V，温度 35℃ 缓慢升到 45℃，
+ * 叠加 1.5 LSB (RMS) 白噪声和 1 LSB 的 50Hz 工频干扰。
+ *
+ * 噪声 = 每块输出 (1/16 LSB) 去掉最小二乘直线后的标准差，合成信号另外给出相对真实值的均方根误差。
+ * 耗时是 PC 上的结果，只用来比较相对快慢：PC 有硬件浮点和 64 位乘法，定点没有优势；
+ * Cortex-M4 上的真实周期数用板子上的 FILT 命令查看 (DWT 计数)。
+ * 浮点滤波后噪声反而增加，或定点 (不在死区范围内时) 与浮点均值相差超过 0.25 LSB (截断补偿失效)、
+ * 噪声超过 2 倍时返回非 0。
+ *
+ * 结论 (合成信号)：CMSIS 的 DF1 Q15 状态只有 16 位，截止频率远低于采样率时 1 + a1 + a2 很小，
+ * 输出卡在截断造成的死区里 (1Hz 时噪声是浮点的 15~20 倍)，只适合截止频率 2Hz 以上；
+ * 低截止频率用 F32 (Cortex-M4 有单精度硬件浮点)，两种方式在板子上的实际周期数用 FILT MODE 切换后对比。
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "bsp_adc_filter.h"
+
+#define FS_HZ 250.0             // 扫描频率，与 bsp_mcu_inter_temperature.c 的 ADC_SAMPLE_HZ 相同
+#define SYN_SECONDS 120         // 合成信号时长
+#define MAX_SCANS (1 << 20)
+#define SETTLE_BLOCKS 4         // 每段开头丢掉的块数
+#define TIME_REPEAT 20          // 计时重复次数
+
+typedef struct
+{
+    const char *name;
+    ADC_Filt_Mode_t mode;
+    double noise[ADC_CH_NUM];   // 去趋势后的标准差 (LSB)
+    double rms_err[ADC_CH_NUM]; // 相对真实值 (LSB)，只有合成信号有
+    double mean[ADC_CH_NUM];    // 输出均值 (LSB)
+    double ns_per_sample;
+} Variant_t;
+
+static uint16_t scans_buf[MAX_SCANS * ADC_CH_NUM];
+static double truth_buf[MAX_SCANS * ADC_CH_NUM];
+static uint32_t seg_len[4096];  // 每段连续数据的扫描次数
+static uint32_t seg_num, total_scans;
+static int synthetic;
+static ADC_Filter_t filt;
+
+static uint32_t rng = 2463534242U;
+
+static double rand_uniform(void)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return (rng + 0.5) / 4294967296.0;
+}
+
+static double rand_gauss(void)
+{
+    return sqrt(-2.0 * log(rand_uniform())) * cos(2.0 * M_PI * rand_uniform());
+}
+
+static uint16_t quantize(double code)
+{
+    if (code < 0)
+    {
+        code = 0;
+    }
+    if (code > 4095)
+    {
+        code = 4095;
+    }
+    return (uint16_t)lround(code);
+}
+
+static void make_synthetic(void)
+{
+    const double vref_code = 1.21 / 3.3 * 4095.0;
+    double t, temp, ideal[ADC_CH_NUM], hum;
+    uint32_t i, n = (uint32_t)(SYN_SECONDS * FS_HZ) / ADC_OVERSAMPLE * ADC_OVERSAMPLE;
+    uint8_t ch;
+
+    for (i = 0; i < n; i++)
+    {
+        t = i / FS_HZ;
+        temp = 35.0 + 10.0 * t / SYN_SECONDS;
+        ideal[ADC_CH_VREFINT] = vref_code;
+        ideal[ADC_CH_TEMP] = (0.76 + 0.0025 * (temp - 25.0)) / 3.3 * 4095.0;
+        hum = sin(2.0 * M_PI * 50.0 * t + 0.3);
+        for (ch = 0; ch < ADC_CH_NUM; ch++)
+        {
+            truth_buf[i * ADC_CH_NUM + ch] = ideal[ch];
+            scans_buf[i * ADC_CH_NUM + ch] = quantize(ideal[ch] + 1.5 * rand_gauss() + hum);
+        }
+    }
+    total_scans = n;
+    seg_len[0] = n;
+    seg_num = 1;
+    synthetic = 1;
+}
+
+/**
+ * @brief 读入 FILT DUMP 的日志，每次 DUMP 算一段
+ */
+static int load_record(const char *path)
+{
+    char line[512], *p, *end;
+    unsigned long v[2];
+    uint32_t seg_start = 0;
+    int k, in_dump = 0;
+    FILE *fp = fopen(path, "r");
+
+    if (NULL == fp)
+    {
+        perror(path);
+        return -1;
+    }
+    while (fgets(line, sizeof(line), fp) && total_scans < MAX_SCANS)
+    {
+        p = strstr(line, "ADC:");
+        if (NULL == p)
+        {
+            // 数据行之间夹了别的日志，说明上一次 DUMP 结束了
+            if (in_dump && total_scans > seg_start && seg_num < sizeof(seg_len) / sizeof(seg_len[0]))
+            {
+                seg_len[seg_num++] = total_scans - seg_start;
+                seg_start = total_scans;
+            }
+            in_dump = 0;
+            continue;
+        }
+        in_dump = 1;
+        p += 4;
+        for (;;)
+        {
+            for (k = 0; k < 2; k++)
+            {
+                v[k] = strtoul(p, &end, 10);
+                if (end == p)
+                {
+                    break;
+                }
+                p = end;
+            }
+            if (k < 2 || total_scans >= MAX_SCANS)
+            {
+                break;
+            }
+            scans_buf[total_scans * ADC_CH_NUM + ADC_CH_VREFINT] = (uint16_t)v[0];
+            scans_buf[total_scans * ADC_CH_NUM + ADC_CH_TEMP] = (uint16_t)v[1];
+            total_scans++;
+        }
+    }
+    if (total_scans > seg_start && seg_num < sizeof(seg_len) / sizeof(seg_len[0]))
+    {
+        seg_len[seg_num++] = total_scans - seg_start;
+    }
+    fclose(fp);
+    return (total_scans >= ADC_OVERSAMPLE) ? 0 : -1;
+}
+
+/**
+ * @brief 按块滤波，统计输出
+ * @return 0: 成功, -1: 没有足够长的连续数据
+ */
+static int run_variant(Variant_t *v, const ADC_Filt_Coeffs_t *coeffs)
+{
+    static double out[ADC_CH_NUM][MAX_SCANS / ADC_OVERSAMPLE];
+    static double ref[ADC_CH_NUM][MAX_SCANS / ADC_OVERSAMPLE];
+    double sx, sy, sxx, sxy, a, b, r, err, sum_noise[ADC_CH_NUM] = {0}, sum_err[ADC_CH_NUM] = {0};
+    uint32_t s, i, k, blocks, start = 0, used = 0, samples = 0, rep;
+    uint16_t q[ADC_CH_NUM];
+    struct timespec t0, t1;
+    double ns = 0;
+    uint8_t ch;
+
+    for (ch = 0; ch < ADC_CH_NUM; ch++)
+    {
+        v->mean[ch] = 0;
+    }
+    for (s = 0; s < seg_num; start += seg_len[s], s++)
+    {
+        blocks = seg_len[s] / ADC_OVERSAMPLE;
+        for (rep = 0; rep < TIME_REPEAT; rep++)
+        {
+            ADC_Filter_Init(&filt);
+            ADC_Filter_SetCoeffs(&filt, coeffs);
+            (void)ADC_Filter_SetMode(&filt, v->mode);
+            clock_gettime(CLOCK_MONOTONIC, &t0);
+            for (k = 0; k < blocks; k++)
+            {
+                ADC_Filter_Process(&filt, &scans_buf[(start + k * ADC_OVERSAMPLE) * ADC_CH_NUM], ADC_OVERSAMPLE,
+                                   &q[ADC_CH_VREFINT], &q[ADC_CH_TEMP]);
+                if (0 == rep)
+                {
+                    for (ch = 0; ch < ADC_CH_NUM; ch++)
+                    {
+                        out[ch][k] = q[ch] / (double)(1 << ADC_Q_SHIFT);
+                        ref[ch][k] = 0;
+                        for (i = 0; i < ADC_OVERSAMPLE; i++)
+                        {
+                            ref[ch][k] += truth_buf[(start + k * ADC_OVERSAMPLE + i) * ADC_CH_NUM + ch];
+                        }
+                        ref[ch][k] /= ADC_OVERSAMPLE;
+                    }
+                }
+            }
+            clock_gettime(CLOCK_MONOTONIC, &t1);
+            ns += (t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec);
+            samples += blocks * ADC_OVERSAMPLE * ADC_CH_NUM;
+        }
+
+        // 去掉开头的过渡过程，剩下的做直线拟合；太短的段不参与统计
+        k = SETTLE_BLOCKS;
+        if (blocks < 3 * SETTLE_BLOCKS)
+        {
+            continue;
+        }
+        for (ch = 0; ch < ADC_CH_NUM; ch++)
+        {
+            sx = sy = sxx = sxy = 0;
+            for (i = k; i < blocks; i++)
+            {
+                sx += i;
+                sy += out[ch][i];
+                sxx += (double)i * i;
+                sxy += i * out[ch][i];
+            }
+            r = blocks - k;
+            b = (r > 1) ? (r * sxy - sx * sy) / (r * sxx - sx * sx) : 0;
+            a = (sy - b * sx) / r;
+            for (i = k; i < blocks; i++)
+            {
+                err = out[ch][i] - (a + b * i);
+                sum_noise[ch] += err * err;
+                err = out[ch][i] - ref[ch][i];
+                sum_err[ch] += err * err;
+                v->mean[ch] += out[ch][i];
+            }
+        }
+        used += blocks - k;
+    }
+    if (0 == used)
+    {
+        return -1;
+    }
+    for (ch = 0; ch < ADC_CH_NUM; ch++)
+    {
+        v->noise[ch] = sqrt(sum_noise[ch] / used);
+        v->rms_err[ch] = sqrt(sum_err[ch] / used);
+        v->mean[ch] /= used;
+    }
+    v->ns_per_sample = ns / samples;
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    Variant_t var[] = {
+        {"off (64x mean)", ADC_FILT_OFF, {0}, {0}, {0}, 0},
+        {"f32 biquad", ADC_FILT_F32, {0}, {0}, {0}, 0},
+        {"q15 biquad", ADC_FILT_Q15, {0}, {0}, {0}, 0},
+    };
+    ADC_Filt_Coeffs_t coeffs;
+    float fc = 1.0f;
+    int stages = 1, bad = 0;
+    unsigned v, s;
+    double diff;
+
+    if (argc > 1)
+    {
+        fc = (float)atof(argv[1]);
+    }
+    if (argc > 2)
+    {
+        stages = atoi(argv[2]);
+    }
+    if (stages < 1 || stages > ADC_FILT_MAX_STAGES || !ADC_Filter_DesignLowpass(&coeffs, fc, FS_HZ, (uint8_t)stages))
+    {
+        printf("usage: %s [fc_hz] [stages 1..%d] [capture.log]\n", argv[0], ADC_FILT_MAX_STAGES);
+        return 1;
+    }
+    if (argc > 3)
+    {
+        if (0 != load_record(argv[3]))
+        {
+            printf("no ADC: samples in %s\n", argv[3]);
+            return 1;
+        }
+        printf("%s: %u scans in %u segments\n", argv[3], total_scans, seg_num);
+    }
+    else
+    {
+        make_synthetic();
+        printf("synthetic: %u scans (%d s at %.0f Hz), noise 1.5 LSB RMS + 1 LSB 50 Hz\n", total_scans, SYN_SECONDS,
+               FS_HZ);
+    }
+
+    printf("Butterworth low-pass %.2f Hz, %d stage(s), %d scans per block\n", fc, stages, ADC_OVERSAMPLE);
+    ADC_Filter_Init(&filt);
+    ADC_Filter_SetCoeffs(&filt, &coeffs);
+    for (s = 0; s < (unsigned)stages; s++)
+    {
+        printf("  stage %u: b %+.8f %+.8f %+.8f  a %+.8f %+.8f\n", s, coeffs.coeffs[s][0], coeffs.coeffs[s][1],
+               coeffs.coeffs[s][2], coeffs.coeffs[s][3], coeffs.coeffs[s][4]);
+        printf("      q15: b %6d %6d %6d  a %6d %6d (Q14, a negated)\n", filt.coeff_q15[s * 6 + 0],
+               filt.coeff_q15[s * 6 + 2], filt.coeff_q15[s * 6 + 3], filt.coeff_q15[s * 6 + 4],
+               filt.coeff_q15[s * 6 + 5]);
+    }
+    if (!filt.q15_ok)
+    {
+        printf("  coefficients do not fit q15, q15 skipped\n");
+    }
+    else
+    {
+        printf("  q15 truncation bias compensation %+.3f LSB, min(1 + a1 + a2) = %d/16384%s\n",
+               filt.q15_bias / (double)(1 << ADC_FILT_Q15_SHIFT), (int)filt.q15_den_min,
+               (filt.q15_den_min < ADC_FILT_Q15_DEN_WARN) ? " (below the warning level, expect dead zones)" : "");
+    }
+    printf("\n");
+
+    printf("  %-16s %12s %12s", "", "noise vref", "noise temp");
+    if (synthetic)
+    {
+        printf(" %12s %12s", "err vref", "err temp");
+    }
+    printf(" %12s %12s\n", "mean temp", "ns/sample");
+    for (v = 0; v < sizeof(var) / sizeof(var[0]); v++)
+    {
+        if (ADC_FILT_Q15 == var[v].mode && !filt.q15_ok)
+        {
+            continue;
+        }
+        if (0 != run_variant(&var[v], &coeffs))
+        {
+            printf("no segment is longer than %d blocks\n", 3 * SETTLE_BLOCKS);
+            return 1;
+        }
+        printf("  %-16s %8.4f LSB %8.4f LSB", var[v].name, var[v].noise[ADC_CH_VREFINT], var[v].noise[ADC_CH_TEMP]);
+        if (synthetic)
+        {
+            printf(" %8.4f LSB %8.4f LSB", var[v].rms_err[ADC_CH_VREFINT], var[v].rms_err[ADC_CH_TEMP]);
+        }
+        printf(" %12.3f %12.2f\n", var[v].mean[ADC_CH_TEMP], var[v].ns_per_sample);
+    }
+
+    for (s = 0; s < ADC_CH_NUM; s++)
+    {
+        printf("channel %u: noise f32/off %.2f", s, var[1].noise[s] / var[0].noise[s]);
+        // 滤波器不应该增加噪声
+        if (var[1].noise[s] > var[0].noise[s] * 1.05)
+        {
+            bad++;
+        }
+        if (filt.q15_ok)
+        {
+            diff = var[2].mean[s] - var[1].mean[s];
+            printf(", q15/f32 %.2f, mean q15 - f32 %+.4f LSB", var[2].noise[s] / var[1].noise[s], diff);
+            // 死区以外 Q15 应与 F32 一致：截断补偿后没有偏差，噪声不超过 2 倍
+            if (filt.q15_den_min >= ADC_FILT_Q15_DEN_WARN && (fabs(diff) > 0.25 || var[2].noise[s] > var[1].noise[s] * 2))
+            {
+                bad++;
+            }
+        }
+        printf("\n");
+    }
+    printf("host timing is for comparison only, use FILT on the board for Cortex-M4 cycles per sample\n");
+    printf("%s\n", (0 == bad) ? "ok" : "FAILED");
+    return (0 == bad) ? 0 : 1;
+}
@@ -0,0 +1,1074 @@
+/*
+ * CMSIS-DSP 主机性能测试：Drivers/CMSIS/DSP 的源码在 PC 上用通用 C 路径编译 (不开 Helium / NEON)，
+ * 逐个核心函数测每个采样的耗时，并与 double 精度的参考实现比较结果
+ *
+ * 编译运行 (见同目录 Makefile)：
+ *     make                   与 Keil 工程相同的宏 (不定义 ARM_MATH_LOOPUNROLL)
+ *     make UNROLL=1          打开 CMSIS 的手工循环展开，对比展开前后
+ *     ./dsp_perf             全部测试
+ *     ./dsp_perf fir cfft    只测名字里带 fir 或 cfft 的项
+ *     ./dsp_perf -c          只检查正确性，不计时 (回归检查用，几秒内完成)
+ *     make SIMD=1            FIR / DF2T / CFFT / 点积 / 矩阵乘换成 dsp_simd_x86.c 的 AVX2 版本，
+ *                            这几项另外与通用版本比较：偏差、通用版本耗时、加速比
+ *     DSP_SIMD_OFF=1 ./dsp_perf   SIMD 版本的库强制走通用版本
+ *
+ * 测试项：
+ *     cfft_f32           复数 FFT 16 ~ 4096 点，正变换与 O(N^2) 的 double DFT 比较，
+ *                        再做逆变换与输入比较，取两者较差的信噪比；1 个采样 = 1 个复数点
+ *     fir_f32/q15        32 阶 FIR
+ *     biquad_df1_f32/q15 两节二阶低通 (fc = 0.05 fs)，q15 系数 Q14 (postShift = 1)，与 bsp_adc_filter.c 相同
+ *     biquad_df2T_f32    同上，转置二型
+ *         滤波器类：4096 个采样按块长 16 ~ 1024 (另加 100) 分块处理，块与块之间的状态衔接一并检查
+ *     mean/var/std/rms/max_f32, mean/max_q15, dot_prod_f32
+ *                        块长同上，一块算一个结果
+ *     mat_mult_f32       N x N 矩阵相乘，N = 4 ~ 64 (含 12)；1 个采样 = 1 次乘加
+ *
+ * 误差：浮点用信噪比 (dB) = 10 * log10(参考信号能量 / 误差能量)，低于门限算失败；
+ *       定点用与 double 参考值的最大偏差 (LSB)，超过门限算失败。
+ *       点积的误差相对 sum(|a * b|) 计算。
+ *       SIMD 与通用版本的偏差 = 最大逐点差 / 通用版本输出的均方根 (点积同上)，以 FLT_EPSILON 为单位，超过门限算失败。
+ *       有失败项时返回非 0。
+ * 耗时：每项先把重复次数调到单次测量 5ms 以上，测 5 次取最小值。
+ * PC 上的绝对数值与 Cortex-M4 没有可比性，用来比较算法、块长、编译选项之间的相对快慢。
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <float.h>
+#include "arm_math.h"
+#include "dsp_tables.h"
+#ifdef DSP_SIMD
+#include "dsp_simd_x86.h"
+#endif
+
+#define STREAM_LEN 4096     // 滤波器类测试的总采样数
+#define MAX_BLOCK 1024      // 滤波器 / 统计类的最大块长
+#define FIR_TAPS 32
+#define BQ_STAGES 2
+#define MAT_MAX 64
+#define TIME_MIN_NS 5e6     // 单次测量至少 5ms
+#define TIME_ROUNDS 5
+
+typedef struct
+{
+    const char *name;
+    const uint32_t *sizes;
+    int (*setup)(uint32_t n);   // 准备数据和实例，失败返回非 0
+    void (*run)(uint32_t n);    // 执行一遍，返回值不用
+    uint32_t (*samples)(uint32_t n);
+    double (*check)(uint32_t n);
+    int fixed;                  // 0: 误差为信噪比 (dB)，越大越好；1: 误差为最大偏差 (LSB)，越小越好
+    double limit;
+    void (*run_portable)(uint32_t n);   // SIMD 替换的函数：同样的工作用通用版本做一遍
+    double (*vs_portable)(uint32_t n);  // 与通用版本的偏差 (FLT_EPSILON)
+    double portable_limit;
+} Kernel_t;
+
+/* 只有 make SIMD=1 时才有通用版本可比 */
+#ifdef DSP_SIMD
+#define PORTABLE(run, vs, limit) run, vs, limit
+#else
+#define PORTABLE(run, vs, limit) NULL, NULL, 0
+#endif
+
+static const uint32_t cfft_sizes[] = {16, 32, 64, 128, 256, 512, 1024, 2048, 4096, 0};
+static const uint32_t block_sizes[] = {16, 32, 64, 100, 128, 256, 512, 1024, 0};   // 100：检查不满一组的尾部处理
+static const uint32_t mat_sizes[] = {4, 8, 12, 16, 32, 64, 0};
+
+static uint32_t rng = 88172645U;
+
+/* 输入、输出和 double 参考 */
+static float32_t in_f[2 * DSP_CFFT_MAX_LEN];
+static float32_t in2_f[2 * DSP_CFFT_MAX_LEN];
+static float32_t out_f[2 * DSP_CFFT_MAX_LEN];
+#ifdef DSP_SIMD
+static float32_t out2_f[2 * DSP_CFFT_MAX_LEN];    // SIMD 版本的输出，与通用版本对比
+#endif
+static q15_t in_q[STREAM_LEN];
+static q15_t out_q[STREAM_LEN];
+static double ref_d[2 * DSP_CFFT_MAX_LEN];
+static float32_t scalar_f;
+static q15_t scalar_q;
+
+/* 各测试项的实例 */
+static const arm_cfft_instance_f32 *cfft;
+static float32_t fir_coeff_f[FIR_TAPS];
+static q15_t fir_coeff_q[FIR_TAPS];
+static float32_t fir_state_f[FIR_TAPS + MAX_BLOCK - 1];
+static q15_t fir_state_q[FIR_TAPS + MAX_BLOCK - 1];
+static arm_fir_instance_f32 fir_f;
+static arm_fir_instance_q15 fir_q;
+static double bq_design[BQ_STAGES][5];                  // b0 b1 b2 a1 a2 (double)
+static float32_t bq_coeff_f[BQ_STAGES * 5];             // {b0, b1, b2, -a1, -a2}
+static q15_t bq_coeff_q[BQ_STAGES * 6];                 // {b0, 0, b1, b2, -a1, -a2}，Q14
+static float32_t bq_state_f[BQ_STAGES * 4];
+static q15_t bq_state_q[BQ_STAGES * 4];
+static arm_biquad_casd_df1_inst_f32 bq_df1_f;
+static arm_biquad_cascade_df2T_instance_f32 bq_df2t_f;
+static arm_biquad_casd_df1_inst_q15 bq_df1_q;
+static float32_t mat_a[MAT_MAX * MAT_MAX];
+static float32_t mat_b[MAT_MAX * MAT_MAX];
+static float32_t mat_c[MAT_MAX * MAT_MAX];
+static float32_t mat_c2[MAT_MAX * MAT_MAX];
+static arm_matrix_instance_f32 mat_ia, mat_ib, mat_ic, mat_ic2;
+
+static double rand_uniform(void)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return (rng + 0.5) / 4294967296.0 * 2.0 - 1.0;
+}
+
+static void fill_f32(float32_t *dst, uint32_t n, double offset, double amp)
+{
+    uint32_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        dst[i] = (float32_t)(offset + amp * rand_uniform());
+    }
+}
+
+static void fill_q15(q15_t *dst, uint32_t n, double offset, double amp)
+{
+    uint32_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        dst[i] = (q15_t)lround((offset + amp * rand_uniform()) * 32768.0);
+    }
+}
+
+/**
+ * @brief 信噪比：ref 与 y 逐点比较
+ */
+static double snr_f32(const double *ref, const float32_t *y, uint32_t n)
+{
+    double sig = 0, err = 0, d;
+    uint32_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        d = y[i] - ref[i];
+        sig += ref[i] * ref[i];
+        err += d * d;
+    }
+    if (0 == err)
+    {
+        return 999;
+    }
+    return 10.0 * log10(sig / err);
+}
+
+static double snr_scalar(double ref, double y)
+{
+    return snr_f32(&ref, &(float32_t){(float32_t)y}, 1);
+}
+
+static double lsb_q15(const double *ref, const q15_t *y, uint32_t n)
+{
+    double max = 0, d;
+    uint32_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        d = fabs(y[i] - ref[i] * 32768.0);
+        if (d > max)
+        {
+            max = d;
+        }
+    }
+    return max;
+}
+
+/**
+ * @brief 滤波器类按块长 n 处理 STREAM_LEN 个采样，n 不整除时最后一块较短
+ */
+static uint32_t chunk(uint32_t i, uint32_t n)
+{
+    return (STREAM_LEN - i < n) ? (STREAM_LEN - i) : n;
+}
+
+static uint32_t samples_n(uint32_t n)
+{
+    return n;
+}
+
+static uint32_t samples_stream(uint32_t n)
+{
+    (void)n;
+    return STREAM_LEN;
+}
+
+/*================================ cfft_f32 ================================*/
+
+static int cfft_setup(uint32_t n)
+{
+    cfft = DSP_Tables_CfftF32((uint16_t)n);
+    fill_f32(in_f, 2 * n, 0, 1);
+    return (NULL == cfft);
+}
+
+static void cfft_run(uint32_t n)
+{
+    memcpy(out_f, in_f, 2 * n * sizeof(float32_t));
+    arm_cfft_f32(cfft, out_f, 0, 1);
+}
+
+static double cfft_check(uint32_t n)
+{
+    double *tw = malloc(2 * n * sizeof(double));
+    double *x = malloc(2 * n * sizeof(double));
+    double re, im, fwd, inv;
+    uint32_t k, i, idx;
+
+    for (i = 0; i < n; i++)
+    {
+        tw[2 * i] = cos(2.0 * M_PI * i / n);
+        tw[2 * i + 1] = -sin(2.0 * M_PI * i / n);
+        x[2 * i] = in_f[2 * i];
+        x[2 * i + 1] = in_f[2 * i + 1];
+    }
+    for (k = 0; k < n; k++)
+    {
+        re = 0;
+        im = 0;
+        for (i = 0; i < n; i++)
+        {
+            idx = (k * i) % n;
+            re += x[2 * i] * tw[2 * idx] - x[2 * i + 1] * tw[2 * idx + 1];
+            im += x[2 * i] * tw[2 * idx + 1] + x[2 * i + 1] * tw[2 * idx];
+        }
+        ref_d[2 * k] = re;
+        ref_d[2 * k + 1] = im;
+    }
+    cfft_run(n);
+    fwd = snr_f32(ref_d, out_f, 2 * n);
+
+    // 逆变换 (内部除以 N) 应还原输入
+    arm_cfft_f32(cfft, out_f, 1, 1);
+    inv = snr_f32(x, out_f, 2 * n);
+    free(tw);
+    free(x);
+    return (fwd < inv) ? fwd : inv;
+}
+
+/*================================ fir ================================*/
+
+static void fir_design(void)
+{
+    uint32_t i;
+    double w;
+
+    // 加窗 sinc 低通，截止 0.1 fs；系数对称，CMSIS 要求的倒序存放与正序相同
+    for (i = 0; i < FIR_TAPS; i++)
+    {
+        w = i - (FIR_TAPS - 1) / 2.0;
+        fir_coeff_f[i] = (float32_t)(0.2 * (0 == w ? 1.0 : sin(0.2 * M_PI * w) / (0.2 * M_PI * w)) *
+                                     (0.54 - 0.46 * cos(2.0 * M_PI * i / (FIR_TAPS - 1))));
+        fir_coeff_q[i] = (q15_t)lround(fir_coeff_f[i] * 32768.0);
+    }
+}
+
+static int fir_f32_setup(uint32_t n)
+{
+    fill_f32(in_f, STREAM_LEN, 0, 1);
+    arm_fir_init_f32(&fir_f, FIR_TAPS, fir_coeff_f, fir_state_f, n);
+    return 0;
+}
+
+static void fir_f32_run(uint32_t n)
+{
+    uint32_t i;
+
+    for (i = 0; i < STREAM_LEN; i += n)
+    {
+        arm_fir_f32(&fir_f, in_f + i, out_f + i, chunk(i, n));
+    }
+}
+
+/**
+ * @brief double 参考：y[i] = sum(b[k] * x[i - k])，x 在 0 之前为 0
+ */
+static void fir_ref(const double *b, const double *x)
+{
+    uint32_t i, k;
+    double acc;
+
+    for (i = 0; i < STREAM_LEN; i++)
+    {
+        acc = 0;
+        for (k = 0; k < FIR_TAPS && k <= i; k++)
+        {
+            acc += b[k] * x[i - k];
+        }
+        ref_d[i] = acc;
+    }
+}
+
+static double fir_f32_check(uint32_t n)
+{
+    double b[FIR_TAPS], *x = malloc(STREAM_LEN * sizeof(double));
+    uint32_t i;
+
+    for (i = 0; i < FIR_TAPS; i++)
+    {
+        b[i] = fir_coeff_f[i];
+    }
+    for (i = 0; i < STREAM_LEN; i++)
+    {
+        x[i] = in_f[i];
+    }
+    fir_ref(b, x);
+    free(x);
+    arm_fir_init_f32(&fir_f, FIR_TAPS, fir_coeff_f, fir_state_f, n);
+    fir_f32_run(n);
+    return snr_f32(ref_d, out_f, STREAM_LEN);
+}
+
+static int fir_q15_setup(uint32_t n)
+{
+    fill_q15(in_q, STREAM_LEN, 0, 0.9);
+    return (ARM_MATH_SUCCESS != arm_fir_init_q15(&fir_q, FIR_TAPS, fir_coeff_q, fir_state_q, n));
+}
+
+static void fir_q15_run(uint32_t n)
+{
+    uint32_t i;
+
+    for (i = 0; i < STREAM_LEN; i += n)
+    {
+        arm_fir_q15(&fir_q, in_q + i, out_q + i, chunk(i, n));
+    }
+}
+
+static double fir_q15_check(uint32_t n)
+{
+    double b[FIR_TAPS], *x = malloc(STREAM_LEN * sizeof(double));
+    uint32_t i;
+
+    for (i = 0; i < FIR_TAPS; i++)
+    {
+        b[i] = fir_coeff_q[i] / 32768.0;
+    }
+    for (i = 0; i < STREAM_LEN; i++)
+    {
+        x[i] = in_q[i] / 32768.0;
+    }
+    fir_ref(b, x);
+    free(x);
+    arm_fir_init_q15(&fir_q, FIR_TAPS, fir_coeff_q, fir_state_q, n);
+    fir_q15_run(n);
+    return lsb_q15(ref_d, out_q, STREAM_LEN);
+}
+
+/*================================ biquad ================================*/
+
+/**
+ * @brief 两节 Butterworth 低通 (RBJ 公式，每节 Q 不同)，fc = 0.05 fs
+ */
+static void bq_design_lowpass(void)
+{
+    static const double q[BQ_STAGES] = {0.5411961, 1.3065630};
+    double w0 = 2.0 * M_PI * 0.05, alpha, a0;
+    uint32_t s;
+
+    for (s = 0; s < BQ_STAGES; s++)
+    {
+        alpha = sin(w0) / (2.0 * q[s]);
+        a0 = 1.0 + alpha;
+        bq_design[s][0] = (1.0 - cos(w0)) / 2.0 / a0;
+        bq_design[s][1] = (1.0 - cos(w0)) / a0;
+        bq_design[s][2] = bq_design[s][0];
+        bq_design[s][3] = -2.0 * cos(w0) / a0;
+        bq_design[s][4] = (1.0 - alpha) / a0;
+
+        bq_coeff_f[s * 5 + 0] = (float32_t)bq_design[s][0];
+        bq_coeff_f[s * 5 + 1] = (float32_t)bq_design[s][1];
+        bq_coeff_f[s * 5 + 2] = (float32_t)bq_design[s][2];
+        bq_coeff_f[s * 5 + 3] = (float32_t)-bq_design[s][3];
+        bq_coeff_f[s * 5 + 4] = (float32_t)-bq_design[s][4];
+
+        bq_coeff_q[s * 6 + 0] = (q15_t)lround(bq_design[s][0] * 16384.0);
+        bq_coeff_q[s * 6 + 1] = 0;
+        bq_coeff_q[s * 6 + 2] = (q15_t)lround(bq_design[s][1] * 16384.0);
+        bq_coeff_q[s * 6 + 3] = (q15_t)lround(bq_design[s][2] * 16384.0);
+        bq_coeff_q[s * 6 + 4] = (q15_t)lround(-bq_design[s][3] * 16384.0);
+        bq_coeff_q[s * 6 + 5] = (q15_t)lround(-bq_design[s][4] * 16384.0);
+    }
+}
+
+/**
+ * @brief double 参考：c 为每节 {b0, b1, b2, -a1, -a2}，整段 x 一次滤完
+ */
+static void bq_ref(const double c[][5], const double *x)
+{
+    double x1, x2, y1, y2, in, out;
+    uint32_t s, i;
+
+    for (i = 0; i < STREAM_LEN; i++)
+    {
+        ref_d[i] = x[i];
+    }
+    for (s = 0; s < BQ_STAGES; s++)
+    {
+        x1 = x2 = y1 = y2 = 0;
+        for (i = 0; i < STREAM_LEN; i++)
+        {
+            in = ref_d[i];
+            out = c[s][0] * in + c[s][1] * x1 + c[s][2] * x2 + c[s][3] * y1 + c[s][4] * y2;
+            x2 = x1;
+            x1 = in;
+            y2 = y1;
+            y1 = out;
+            ref_d[i] = out;
+        }
+    }
+}
+
+static double bq_f32_check(void)
+{
+    double c[BQ_STAGES][5], *x = malloc(STREAM_LEN * sizeof(double));
+    uint32_t s, i;
+
+    for (s = 0; s < BQ_STAGES; s++)
+    {
+        for (i = 0; i < 5; i++)
+        {
+            c[s][i] = bq_coeff_f[s * 5 + i];
+        }
+    }
+    for (i = 0; i < STREAM_LEN; i++)
+    {
+        x[i] = in_f[i];
+    }
+    bq_ref(c, x);
+    free(x);
+    return snr_f32(ref_d, out_f, STREAM_LEN);
+}
+
+static int bq_df1_f32_setup(uint32_t n)
+{
+    (void)n;
+    fill_f32(in_f, STREAM_LEN, 0, 1);
+    arm_biquad_cascade_df1_init_f32(&bq_df1_f, BQ_STAGES, bq_coeff_f, bq_state_f);
+    return 0;
+}
+
+static void bq_df1_f32_run(uint32_t n)
+{
+    uint32_t i;
+
+    for (i = 0; i < STREAM_LEN; i += n)
+    {
+        arm_biquad_cascade_df1_f32(&bq_df1_f, in_f + i, out_f + i, chunk(i, n));
+    }
+}
+
+static double bq_df1_f32_check(uint32_t n)
+{
+    arm_biquad_cascade_df1_init_f32(&bq_df1_f, BQ_STAGES, bq_coeff_f, bq_state_f);
+    bq_df1_f32_run(n);
+    return bq_f32_check();
+}
+
+static int bq_df2t_f32_setup(uint32_t n)
+{
+    (void)n;
+    fill_f32(in_f, STREAM_LEN, 0, 1);
+    arm_biquad_cascade_df2T_init_f32(&bq_df2t_f, BQ_STAGES, bq_coeff_f, bq_state_f);
+    return 0;
+}
+
+static void bq_df2t_f32_run(uint32_t n)
+{
+    uint32_t i;
+
+    for (i = 0; i < STREAM_LEN; i += n)
+    {
+        arm_biquad_cascade_df2T_f32(&bq_df2t_f, in_f + i, out_f + i, chunk(i, n));
+    }
+}
+
+static double bq_df2t_f32_check(uint32_t n)
+{
+    arm_biquad_cascade_df2T_init_f32(&bq_df2t_f, BQ_STAGES, bq_coeff_f, bq_state_f);
+    bq_df2t_f32_run(n);
+    return bq_f32_check();
+}
+
+static int bq_df1_q15_setup(uint32_t n)
+{
+    (void)n;
+    fill_q15(in_q, STREAM_LEN, 0, 0.5);
+    arm_biquad_cascade_df1_init_q15(&bq_df1_q, BQ_STAGES, bq_coeff_q, bq_state_q, 1);
+    return 0;
+}
+
+static void bq_df1_q15_run(uint32_t n)
+{
+    uint32_t i;
+
+    for (i = 0; i < STREAM_LEN; i += n)
+    {
+        arm_biquad_cascade_df1_q15(&bq_df1_q, in_q + i, out_q + i, chunk(i, n));
+    }
+}
+
+static double bq_df1_q15_check(uint32_t n)
+{
+    double c[BQ_STAGES][5], *x = malloc(STREAM_LEN * sizeof(double));
+    uint32_t s, i;
+
+    // 参考用量化后的系数，误差只来自定点运算的截断
+    for (s = 0; s < BQ_STAGES; s++)
+    {
+        c[s][0] = bq_coeff_q[s * 6 + 0] / 16384.0;
+        c[s][1] = bq_coeff_q[s * 6 + 2] / 16384.0;
+        c[s][2] = bq_coeff_q[s * 6 + 3] / 16384.0;
+        c[s][3] = bq_coeff_q[s * 6 + 4] / 16384.0;
+        c[s][4] = bq_coeff_q[s * 6 + 5] / 16384.0;
+    }
+    arm_biquad_cascade_df1_init_q15(&bq_df1_q, BQ_STAGES, bq_coeff_q, bq_state_q, 1);
+    for (i = 0; i < STREAM_LEN; i++)
+    {
+        x[i] = in_q[i] / 32768.0;
+    }
+    bq_ref(c, x);
+    free(x);
+    bq_df1_q15_run(n);
+    return lsb_q15(ref_d, out_q, STREAM_LEN);
+}
+
+/*================================ 统计 / 向量 ================================*/
+
+static int stat_f32_setup(uint32_t n)
+{
+    // 带直流分量，均值和方差的相对误差才有意义
+    fill_f32(in_f, n, 0.5, 0.5);
+    fill_f32(in2_f, n, 0, 1);
+    return 0;
+}
+
+static void mean_f32_run(uint32_t n)
+{
+    arm_mean_f32(in_f, n, &scalar_f);
+}
+
+static void var_f32_run(uint32_t n)
+{
+    arm_var_f32(in_f, n, &scalar_f);
+}
+
+static void std_f32_run(uint32_t n)
+{
+    arm_std_f32(in_f, n, &scalar_f);
+}
+
+static void rms_f32_run(uint32_t n)
+{
+    arm_rms_f32(in_f, n, &scalar_f);
+}
+
+static void max_f32_run(uint32_t n)
+{
+    uint32_t idx;
+
+    arm_max_f32(in_f, n, &scalar_f, &idx);
+}
+
+static void dot_f32_run(uint32_t n)
+{
+    arm_dot_prod_f32(in_f, in2_f, n, &scalar_f);
+}
+
+/**
+ * @brief 各统计量的 double 参考值，which: 0 均值 1 方差 (样本方差，除以 n-1) 2 标准差 3 均方根 4 最大值 5 点积
+ */
+static double stat_ref(uint32_t n, int which)
+{
+    double sum = 0, sq = 0, max = in_f[0], dot = 0, mean, d;
+    uint32_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        sum += in_f[i];
+        sq += (double)in_f[i] * in_f[i];
+        dot += (double)in_f[i] * in2_f[i];
+        if (in_f[i] > max)
+        {
+            max = in_f[i];
+        }
+    }
+    mean = sum / n;
+    d = 0;
+    for (i = 0; i < n; i++)
+    {
+        d += (in_f[i] - mean) * (in_f[i] - mean);
+    }
+    switch (which)
+    {
+    case 0:
+        return mean;
+    case 1:
+        return d / (n - 1);
+    case 2:
+        return sqrt(d / (n - 1));
+    case 3:
+        return sqrt(sq / n);
+    case 4:
+        return max;
+    default:
+        return dot;
+    }
+}
+
+static double mean_f32_check(uint32_t n)
+{
+    mean_f32_run(n);
+    return snr_scalar(stat_ref(n, 0), scalar_f);
+}
+
+static double var_f32_check(uint32_t n)
+{
+    var_f32_run(n);
+    return snr_scalar(stat_ref(n, 1), scalar_f);
+}
+
+static double std_f32_check(uint32_t n)
+{
+    std_f32_run(n);
+    return snr_scalar(stat_ref(n, 2), scalar_f);
+}
+
+static double rms_f32_check(uint32_t n)
+{
+    rms_f32_run(n);
+    return snr_scalar(stat_ref(n, 3), scalar_f);
+}
+
+static double max_f32_check(uint32_t n)
+{
+    max_f32_run(n);
+    return snr_scalar(stat_ref(n, 4), scalar_f);
+}
+
+/**
+ * @brief sum(|a * b|)：点积的舍入误差与它成正比，点积本身可能正负抵消接近 0，不适合做分母
+ */
+static double dot_abs(uint32_t n)
+{
+    double sum = 0;
+    uint32_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        sum += fabs((double)in_f[i] * in2_f[i]);
+    }
+    return sum;
+}
+
+static double dot_f32_check(uint32_t n)
+{
+    double err;
+
+    dot_f32_run(n);
+    err = fabs(scalar_f - stat_ref(n, 5));
+    return (0 == err) ? 999 : 20.0 * log10(dot_abs(n) / err);
+}
+
+static int stat_q15_setup(uint32_t n)
+{
+    fill_q15(in_q, n, 0.3, 0.6);
+    return 0;
+}
+
+static void mean_q15_run(uint32_t n)
+{
+    arm_mean_q15(in_q, n, &scalar_q);
+}
+
+static void max_q15_run(uint32_t n)
+{
+    uint32_t idx;
+
+    arm_max_q15(in_q, n, &scalar_q, &idx);
+}
+
+static double mean_q15_check(uint32_t n)
+{
+    double sum = 0;
+    uint32_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        sum += in_q[i] / 32768.0;
+    }
+    ref_d[0] = sum / n;
+    mean_q15_run(n);
+    return lsb_q15(ref_d, &scalar_q, 1);
+}
+
+static double max_q15_check(uint32_t n)
+{
+    uint32_t i;
+
+    ref_d[0] = -1;
+    for (i = 0; i < n; i++)
+    {
+        if (in_q[i] / 32768.0 > ref_d[0])
+        {
+            ref_d[0] = in_q[i] / 32768.0;
+        }
+    }
+    max_q15_run(n);
+    return lsb_q15(ref_d, &scalar_q, 1);
+}
+
+/*================================ mat_mult_f32 ================================*/
+
+static int mat_setup(uint32_t n)
+{
+    fill_f32(mat_a, n * n, 0, 1);
+    fill_f32(mat_b, n * n, 0, 1);
+    arm_mat_init_f32(&mat_ia, n, n, mat_a);
+    arm_mat_init_f32(&mat_ib, n, n, mat_b);
+    arm_mat_init_f32(&mat_ic, n, n, mat_c);
+    arm_mat_init_f32(&mat_ic2, n, n, mat_c2);
+    return 0;
+}
+
+static void mat_run(uint32_t n)
+{
+    (void)n;
+    arm_mat_mult_f32(&mat_ia, &mat_ib, &mat_ic);
+}
+
+static uint32_t mat_samples(uint32_t n)
+{
+    return n * n * n;
+}
+
+static double mat_check(uint32_t n)
+{
+    uint32_t r, c, k;
+    double acc;
+
+    for (r = 0; r < n; r++)
+    {
+        for (c = 0; c < n; c++)
+        {
+            acc = 0;
+            for (k = 0; k < n; k++)
+            {
+                acc += (double)mat_a[r * n + k] * mat_b[k * n + c];
+            }
+            ref_d[r * n + c] = acc;
+        }
+    }
+    if (ARM_MATH_SUCCESS != arm_mat_mult_f32(&mat_ia, &mat_ib, &mat_ic))
+    {
+        return 0;
+    }
+    return snr_f32(ref_d, mat_c, n * n);
+}
+
+/*================================ SIMD 与通用版本对比 ================================*/
+#ifdef DSP_SIMD
+
+/**
+ * @brief 偏差：y 与 ref 的最大逐点差 / ref 的均方根，单位 FLT_EPSILON
+ */
+static double dev_eps(const float32_t *ref, const float32_t *y, uint32_t n)
+{
+    double sq = 0, max = 0, d;
+    uint32_t i;
+
+    for (i = 0; i < n; i++)
+    {
+        sq += (double)ref[i] * ref[i];
+        d = fabs((double)y[i] - ref[i]);
+        if (d > max)
+        {
+            max = d;
+        }
+    }
+    if (0 == max)
+    {
+        return 0;
+    }
+    return max / sqrt(sq / n) / FLT_EPSILON;
+}
+
+static double max_d(double a, double b)
+{
+    return (a > b) ? a : b;
+}
+
+static void cfft_run_portable(uint32_t n)
+{
+    memcpy(out_f, in_f, 2 * n * sizeof(float32_t));
+    arm_cfft_f32_portable(cfft, out_f, 0, 1);
+}
+
+static double cfft_vs(uint32_t n)
+{
+    double fwd, inv;
+
+    cfft_run(n);
+    memcpy(out2_f, out_f, 2 * n * sizeof(float32_t));
+    cfft_run_portable(n);
+    fwd = dev_eps(out_f, out2_f, 2 * n);
+
+    // 两边的正变换结果各自做逆变换
+    arm_cfft_f32(cfft, out2_f, 1, 1);
+    arm_cfft_f32_portable(cfft, out_f, 1, 1);
+    inv = dev_eps(out_f, out2_f, 2 * n);
+    return max_d(fwd, inv);
+}
+
+static void fir_f32_run_portable(uint32_t n)
+{
+    uint32_t i;
+
+    for (i = 0; i < STREAM_LEN; i += n)
+    {
+        arm_fir_f32_portable(&fir_f, in_f + i, out_f + i, chunk(i, n));
+    }
+}
+
+static double fir_f32_vs(uint32_t n)
+{
+    arm_fir_init_f32(&fir_f, FIR_TAPS, fir_coeff_f, fir_state_f, n);
+    fir_f32_run(n);
+    memcpy(out2_f, out_f, STREAM_LEN * sizeof(float32_t));
+    arm_fir_init_f32(&fir_f, FIR_TAPS, fir_coeff_f, fir_state_f, n);
+    fir_f32_run_portable(n);
+    return dev_eps(out_f, out2_f, STREAM_LEN);
+}
+
+static void bq_df2t_f32_run_portable(uint32_t n)
+{
+    uint32_t i;
+
+    for (i = 0; i < STREAM_LEN; i += n)
+    {
+        arm_biquad_cascade_df2T_f32_portable(&bq_df2t_f, in_f + i, out_f + i, chunk(i, n));
+    }
+}
+
+static double bq_df2t_f32_vs(uint32_t n)
+{
+    arm_biquad_cascade_df2T_init_f32(&bq_df2t_f, BQ_STAGES, bq_coeff_f, bq_state_f);
+    bq_df2t_f32_run(n);
+    memcpy(out2_f, out_f, STREAM_LEN * sizeof(float32_t));
+    arm_biquad_cascade_df2T_init_f32(&bq_df2t_f, BQ_STAGES, bq_coeff_f, bq_state_f);
+    bq_df2t_f32_run_portable(n);
+    return dev_eps(out_f, out2_f, STREAM_LEN);
+}
+
+static void dot_f32_run_portable(uint32_t n)
+{
+    arm_dot_prod_f32_portable(in_f, in2_f, n, &scalar_f);
+}
+
+static double dot_f32_vs(uint32_t n)
+{
+    float32_t simd;
+
+    dot_f32_run(n);
+    simd = scalar_f;
+    dot_f32_run_portable(n);
+    return fabs((double)simd - scalar_f) / dot_abs(n) / FLT_EPSILON;
+}
+
+static void mat_run_portable(uint32_t n)
+{
+    (void)n;
+    arm_mat_mult_f32_portable(&mat_ia, &mat_ib, &mat_ic2);
+}
+
+static double mat_vs(uint32_t n)
+{
+    mat_run(n);
+    mat_run_portable(n);
+    return dev_eps(mat_c2, mat_c, n * n);
+}
+
+#endif
+
+/*================================ 框架 ================================*/
+
+/* 门限：f32 单次舍入约 -150dB，FFT 每级累加一点，4096 点仍在 130dB 以上；
+ * SIMD 与通用版本：FIR / 矩阵乘累加顺序相同，只差 FMA 的舍入；点积、FFT 分解方式不同，误差随长度增长；
+ * DF2T 按块递推，反馈把舍入差放大 1 / (1 + a1 + a2) 倍左右，门限按这里 fc = 0.05 fs 的滤波器留余量；
+ * FIR q15 用 64 位累加后截断，误差 < 1 LSB；
+ * IIR q15 每节输出截断 (平均 -0.5 LSB)，经反馈放大 1 / (1 + a1 + a2) 倍 (这里两节约 11 倍和 12 倍)，
+ * 偏差约 12 LSB 加上噪声，与 bsp_adc_filter.c 里 q15_bias 补偿的是同一个误差 */
+static const Kernel_t kernels[] = {
+    {"cfft_f32", cfft_sizes, cfft_setup, cfft_run, samples_n, cfft_check, 0, 110,
+     PORTABLE(cfft_run_portable, cfft_vs, 64)},
+    {"fir_f32", block_sizes, fir_f32_setup, fir_f32_run, samples_stream, fir_f32_check, 0, 120,
+     PORTABLE(fir_f32_run_portable, fir_f32_vs, 16)},
+    {"fir_q15", block_sizes, fir_q15_setup, fir_q15_run, samples_stream, fir_q15_check, 1, 1.0},
+    {"biquad_df1_f32", block_sizes, bq_df1_f32_setup, bq_df1_f32_run, samples_stream, bq_df1_f32_check, 0, 110},
+    {"biquad_df2T_f32", block_sizes, bq_df2t_f32_setup, bq_df2t_f32_run, samples_stream, bq_df2t_f32_check, 0, 110,
+     PORTABLE(bq_df2t_f32_run_portable, bq_df2t_f32_vs, 64)},
+    {"biquad_df1_q15", block_sizes, bq_df1_q15_setup, bq_df1_q15_run, samples_stream, bq_df1_q15_check, 1, 32.0},
+    {"mean_f32", block_sizes, stat_f32_setup, mean_f32_run, samples_n, mean_f32_check, 0, 110},
+    {"var_f32", block_sizes, stat_f32_setup, var_f32_run, samples_n, var_f32_check, 0, 110},
+    {"std_f32", block_sizes, stat_f32_setup, std_f32_run, samples_n, std_f32_check, 0, 110},
+    {"rms_f32", block_sizes, stat_f32_setup, rms_f32_run, samples_n, rms_f32_check, 0, 110},
+    {"max_f32", block_sizes, stat_f32_setup, max_f32_run, samples_n, max_f32_check, 0, 200},
+    {"dot_prod_f32", block_sizes, stat_f32_setup, dot_f32_run, samples_n, dot_f32_check, 0, 120,
+     PORTABLE(dot_f32_run_portable, dot_f32_vs, 16)},
+    {"mean_q15", block_sizes, stat_q15_setup, mean_q15_run, samples_n, mean_q15_check, 1, 1.0},
+    {"max_q15", block_sizes, stat_q15_setup, max_q15_run, samples_n, max_q15_check, 1, 0},
+    {"mat_mult_f32", mat_sizes, mat_setup, mat_run, mat_samples, mat_check, 0, 110,
+     PORTABLE(mat_run_portable, mat_vs, 16)},
+};
+
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/**
+ * @brief 每个采样的耗时 (ns)，重复次数自动加倍到单次测量超过 TIME_MIN_NS，取 TIME_ROUNDS 次的最小值
+ */
+static double time_kernel(const Kernel_t *k, void (*run)(uint32_t n), uint32_t n)
+{
+    uint32_t reps = 1, r, round;
+    double t0, t, best = 1e30;
+
+    for (;;)
+    {
+        t0 = now_ns();
+        for (r = 0; r < reps; r++)
+        {
+            run(n);
+        }
+        t = now_ns() - t0;
+        if (t >= TIME_MIN_NS || reps >= (1U << 30))
+        {
+            break;
+        }
+        reps *= 2;
+    }
+    for (round = 0; round < TIME_ROUNDS; round++)
+    {
+        t0 = now_ns();
+        for (r = 0; r < reps; r++)
+        {
+            run(n);
+        }
+        t = now_ns() - t0;
+        if (t < best)
+        {
+            best = t;
+        }
+    }
+    return best / reps / k->samples(n);
+}
+
+static int selected(const char *name, int argc, char **argv, int first)
+{
+    int i;
+
+    if (first >= argc)
+    {
+        return 1;
+    }
+    for (i = first; i < argc; i++)
+    {
+        if (NULL != strstr(name, argv[i]))
+        {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    const Kernel_t *k;
+    uint32_t i, j, n;
+    int first = 1, timing = 1, bad = 0, ok, ok_p;
+    double err, ns, dev, ns_p;
+
+    if (argc > 1 && 0 == strcmp(argv[1], "-c"))
+    {
+        timing = 0;
+        first = 2;
+    }
+    if (argc > 1 && argv[1][0] == '-' && timing)
+    {
+        printf("usage: %s [-c] [kernel ...]\n", argv[0]);
+        return 1;
+    }
+
+    fir_design();
+    bq_design_lowpass();
+#ifdef ARM_MATH_LOOPUNROLL
+    printf("CMSIS-DSP host build, ARM_MATH_LOOPUNROLL on\n");
+#else
+    printf("CMSIS-DSP host build, ARM_MATH_LOOPUNROLL off (same as the Keil project)\n");
+#endif
+#ifdef DSP_SIMD
+    printf("x86 SIMD kernels: %s\n", DSP_Simd_Active() ? "AVX2/FMA" : "off (no AVX2/FMA or DSP_SIMD_OFF set), portable C");
+#endif
+    printf("%-16s %6s %11s %12s", "kernel", "size", "ns/sample", "error");
+#ifdef DSP_SIMD
+    printf(" %11s %8s %12s", "portable", "speedup", "vs portable");
+#endif
+    printf("\n");
+
+    for (i = 0; i < sizeof(kernels) / sizeof(kernels[0]); i++)
+    {
+        k = &kernels[i];
+        if (!selected(k->name, argc, argv, first))
+        {
+            continue;
+        }
+        for (j = 0; 0 != (n = k->sizes[j]); j++)
+        {
+            if (0 != k->setup(n))
+            {
+                printf("%-16s %6u setup failed\n", k->name, n);
+                bad++;
+                continue;
+            }
+            err = k->check(n);
+            ok = k->fixed ? (err <= k->limit) : (err >= k->limit);
+            ns = timing ? time_kernel(k, k->run, n) : 0;
+            if (k->fixed)
+            {
+                printf("%-16s %6u %11.3f %8.2f LSB", k->name, n, ns, err);
+            }
+            else
+            {
+                printf("%-16s %6u %11.3f %9.1f dB", k->name, n, ns, err);
+            }
+
+            ok_p = 1;
+            if (NULL != k->vs_portable)
+            {
+                dev = k->vs_portable(n);
+                ok_p = (dev <= k->portable_limit);
+                ns_p = timing ? time_kernel(k, k->run_portable, n) : 0;
+                printf(" %11.3f %7.2fx %8.1f eps", ns_p, (ns > 0) ? ns_p / ns : 0, dev);
+            }
+            printf("%s\n", (ok && ok_p) ? "" : "  FAILED");
+            bad += !(ok && ok_p);
+        }
+    }
+    DSP_Tables_Free();
+    printf("%s\n", (0 == bad) ? "all checks passed" : "some checks FAILED");
+    return (0 == bad) ? 0 : 1;
+}
@@ -0,0 +1,528 @@
+/*
+ * CMSIS-DSP 热点函数的 x86 AVX2/FMA 实现，供 PC 上回放录下的传感器数据时加速，板子上不编译
+ *
+ *     arm_fir_f32                   每次算 16 个输出，按抽头顺序累加 (与通用版本的累加顺序相同)
+ *     arm_biquad_cascade_df2T_f32   8 个采样一块的状态空间形式：块输出 = 8 个输入和 2 个状态的线性组合，
+ *                                   块末状态直接由块初状态算出，递推链每 8 个采样只有两级乘加
+ *     arm_cfft_f32                  基 2 时间抽取，前两级合成一个无旋转因子的基 4，其余各级每次 4 个蝶形
+ *     arm_dot_prod_f32              4 组 8 路累加器
+ *     arm_mat_mult_f32              按行广播 A 的元素乘 B 的一行，列数不是 8 的倍数时尾部用掩码读写
+ *
+ * 结果与通用版本不逐位相同 (FMA 少一次舍入、累加顺序或递推形式不同)，偏差由 dsp_perf 的对比检查把关。
+ * 本文件不加 -mavx2 编译，AVX2 代码用 target 属性单独打开，CPU 不支持时转去调用通用版本。
+ * 二阶节的块系数和 FFT 的表按需生成后缓存，不加锁，只能在单线程里调用。
+ */
+#include <stdlib.h>
+#include <string.h>
+#include <immintrin.h>
+#include "dsp_simd_x86.h"
+
+#define SIMD_TARGET __attribute__((target("avx2,fma")))
+
+#define BQ_BLOCK 8          // 状态空间形式的块长 (一个 __m256)
+#define BQ_BASIS 10         // 8 个输入 + d1、d2 两个状态
+#define BQ_CACHE_NUM 4
+#define CFFT_CACHE_NUM 13   // 按 log2(fftLen) 索引，4 ~ 12 有效
+
+typedef struct
+{
+    float32_t g[BQ_BASIS][BQ_BLOCK];    // 每个基向量 (单位输入 / 单位初始状态) 对块内 8 个输出的贡献
+    float32_t e1[BQ_BLOCK];             // 8 个输入对块末 d1 的贡献
+    float32_t e2[BQ_BLOCK];
+    float32_t q1[2];                    // 块初 d1、d2 对块末 d1 的贡献
+    float32_t q2[2];
+} Bq_Stage_t;
+
+typedef struct
+{
+    const float32_t *coeffs;                            // 缓存的键：系数指针、节数和系数值
+    uint32_t stages;
+    float32_t copy[DSP_SIMD_BQ_MAX_STAGES * 5];
+    Bq_Stage_t stage[DSP_SIMD_BQ_MAX_STAGES];
+} Bq_Cache_t;
+
+typedef struct
+{
+    const float32_t *twiddle;   // 生成时用的 S->pTwiddle，变了就重新生成
+    float32_t *w_fwd;           // 第 3 级起各级的旋转因子连续存放：半长 m 的一级 m 个复数 exp(-j*pi*k/m)
+    float32_t *w_inv;           // 共轭
+    uint16_t *swap;             // 位反序交换对 (复数下标)
+    uint32_t swaps;
+} Cfft_Cache_t;
+
+static int simd_state = -1;
+static Bq_Cache_t bq_cache[BQ_CACHE_NUM];
+static uint32_t bq_cache_next;
+static Cfft_Cache_t cfft_cache[CFFT_CACHE_NUM];
+
+/**
+ * @brief SIMD 版本是否生效：CPU 支持 AVX2 和 FMA，且没有设置环境变量 DSP_SIMD_OFF (回放时对比用)
+ */
+int DSP_Simd_Active(void)
+{
+    if (simd_state < 0)
+    {
+        __builtin_cpu_init();
+        simd_state = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") && NULL == getenv("DSP_SIMD_OFF");
+    }
+    return simd_state;
+}
+
+SIMD_TARGET static inline float32_t hsum_ps(__m256 v)
+{
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_movehdup_ps(s));
+    return _mm_cvtss_f32(s);
+}
+
+/**
+ * @brief 4 个复数 (re, im 交错) 逐个相乘：b * w
+ */
+SIMD_TARGET static inline __m256 cmul_ps(__m256 b, __m256 w)
+{
+    __m256 t = _mm256_mul_ps(_mm256_permute_ps(b, 0xB1), _mm256_movehdup_ps(w));
+
+    return _mm256_fmaddsub_ps(b, _mm256_moveldup_ps(w), t);
+}
+
+/*================================ arm_fir_f32 ================================*/
+
+SIMD_TARGET static void fir_f32_avx2(const arm_fir_instance_f32 *S, const float32_t *pSrc, float32_t *pDst,
+                                     uint32_t blockSize)
+{
+    float32_t *pState = S->pState;
+    const float32_t *pCoeffs = S->pCoeffs;
+    uint32_t numTaps = S->numTaps, n = 0, k;
+    __m256 acc0, acc1, c;
+    float32_t acc;
+
+    // 整块输入先放进状态缓冲区 (pSrc 与 pDst 可以是同一块内存)
+    memcpy(pState + numTaps - 1U, pSrc, blockSize * sizeof(float32_t));
+
+    for (; n + 16U <= blockSize; n += 16U)
+    {
+        acc0 = _mm256_setzero_ps();
+        acc1 = _mm256_setzero_ps();
+        for (k = 0; k < numTaps; k++)
+        {
+            c = _mm256_broadcast_ss(&pCoeffs[k]);
+            acc0 = _mm256_fmadd_ps(c, _mm256_loadu_ps(pState + n + k), acc0);
+            acc1 = _mm256_fmadd_ps(c, _mm256_loadu_ps(pState + n + 8U + k), acc1);
+        }
+        _mm256_storeu_ps(pDst + n, acc0);
+        _mm256_storeu_ps(pDst + n + 8U, acc1);
+    }
+    for (; n + 8U <= blockSize; n += 8U)
+    {
+        acc0 = _mm256_setzero_ps();
+        for (k = 0; k < numTaps; k++)
+        {
+            acc0 = _mm256_fmadd_ps(_mm256_broadcast_ss(&pCoeffs[k]), _mm256_loadu_ps(pState + n + k), acc0);
+        }
+        _mm256_storeu_ps(pDst + n, acc0);
+    }
+    for (; n < blockSize; n++)
+    {
+        acc = 0.0f;
+        for (k = 0; k < numTaps; k++)
+        {
+            acc += pState[n + k] * pCoeffs[k];
+        }
+        pDst[n] = acc;
+    }
+
+    // 最后 numTaps - 1 个采样留给下一块
+    memmove(pState, pState + blockSize, (numTaps - 1U) * sizeof(float32_t));
+}
+
+void arm_fir_f32(const arm_fir_instance_f32 *S, const float32_t *pSrc, float32_t *pDst, uint32_t blockSize)
+{
+    if (!DSP_Simd_Active())
+    {
+        arm_fir_f32_portable(S, pSrc, pDst, blockSize);
+        return;
+    }
+    fir_f32_avx2(S, pSrc, pDst, blockSize);
+}
+
+/*================================ arm_biquad_cascade_df2T_f32 ================================*/
+
+/**
+ * @brief 由一节的系数算出 8 个采样一块的状态空间系数
+ * @note 对每个基向量 (某一个输入为 1，或 d1 / d2 初值为 1) 用 double 按转置二型递推 8 步，
+ *       记下 8 个输出和块末的 d1、d2；系数在整个块上是线性的，任意输入按基向量叠加即可
+ */
+static void bq_stage_make(Bq_Stage_t *st, const float32_t *c)
+{
+    double b0 = c[0], b1 = c[1], b2 = c[2], a1 = c[3], a2 = c[4];
+    double d1, d2, x, y;
+    uint32_t j, i;
+
+    for (j = 0; j < BQ_BASIS; j++)
+    {
+        d1 = (BQ_BLOCK == j) ? 1.0 : 0.0;
+        d2 = (BQ_BLOCK + 1U == j) ? 1.0 : 0.0;
+        for (i = 0; i < BQ_BLOCK; i++)
+        {
+            x = (i == j) ? 1.0 : 0.0;
+            y = b0 * x + d1;
+            d1 = b1 * x + d2 + a1 * y;
+            d2 = b2 * x + a2 * y;
+            st->g[j][i] = (float32_t)y;
+        }
+        if (j < BQ_BLOCK)
+        {
+            st->e1[j] = (float32_t)d1;
+            st->e2[j] = (float32_t)d2;
+        }
+        else
+        {
+            st->q1[j - BQ_BLOCK] = (float32_t)d1;
+            st->q2[j - BQ_BLOCK] = (float32_t)d2;
+        }
+    }
+}
+
+/**
+ * @brief 取实例对应的块系数，系数指针、节数、系数值都相同时直接用缓存
+ */
+static const Bq_Cache_t *bq_cache_get(const arm_biquad_cascade_df2T_instance_f32 *S)
+{
+    uint32_t i, size = S->numStages * 5U * sizeof(float32_t);
+    Bq_Cache_t *c;
+
+    for (i = 0; i < BQ_CACHE_NUM; i++)
+    {
+        c = &bq_cache[i];
+        if (c->coeffs == S->pCoeffs && c->stages == S->numStages && 0 == memcmp(c->copy, S->pCoeffs, size))
+        {
+            return c;
+        }
+    }
+    c = &bq_cache[bq_cache_next];
+    bq_cache_next = (bq_cache_next + 1U) % BQ_CACHE_NUM;
+    c->coeffs = S->pCoeffs;
+    c->stages = S->numStages;
+    memcpy(c->copy, S->pCoeffs, size);
+    for (i = 0; i < S->numStages; i++)
+    {
+        bq_stage_make(&c->stage[i], &S->pCoeffs[i * 5U]);
+    }
+    return c;
+}
+
+SIMD_TARGET static void bq_df2t_f32_avx2(const arm_biquad_cascade_df2T_instance_f32 *S, const Bq_Cache_t *c,
+                                         const float32_t *pSrc, float32_t *pDst, uint32_t blockSize)
+{
+    const float32_t *pIn = pSrc;
+    const float32_t *pCoeffs = S->pCoeffs;
+    float32_t *pState = S->pState;
+    const Bq_Stage_t *st;
+    float32_t d1, d2, nd1, nd2, x, y;
+    __m256 e1, e2, xv, acc;
+    uint32_t s, n, j;
+
+    for (s = 0; s < S->numStages; s++)
+    {
+        // 块系数直接从缓存读 (L1 里)，复制到局部数组会被编译成 rep movs，块短时开销比计算还大
+        st = &c->stage[s];
+        e1 = _mm256_loadu_ps(st->e1);
+        e2 = _mm256_loadu_ps(st->e2);
+        d1 = pState[0];
+        d2 = pState[1];
+
+        for (n = 0; n + BQ_BLOCK <= blockSize; n += BQ_BLOCK)
+        {
+            // 输入部分与状态无关，先算；原地处理时 pIn == pDst，要在写回之前读完
+            xv = _mm256_loadu_ps(pIn + n);
+            acc = _mm256_mul_ps(_mm256_broadcast_ss(pIn + n), _mm256_loadu_ps(st->g[0]));
+            for (j = 1; j < BQ_BLOCK; j++)
+            {
+                acc = _mm256_fmadd_ps(_mm256_broadcast_ss(pIn + n + j), _mm256_loadu_ps(st->g[j]), acc);
+            }
+            nd1 = hsum_ps(_mm256_mul_ps(xv, e1));
+            nd2 = hsum_ps(_mm256_mul_ps(xv, e2));
+
+            acc = _mm256_fmadd_ps(_mm256_set1_ps(d1), _mm256_loadu_ps(st->g[BQ_BLOCK]), acc);
+            acc = _mm256_fmadd_ps(_mm256_set1_ps(d2), _mm256_loadu_ps(st->g[BQ_BLOCK + 1]), acc);
+            _mm256_storeu_ps(pDst + n, acc);
+
+            nd1 += st->q1[0] * d1 + st->q1[1] * d2;
+            nd2 += st->q2[0] * d1 + st->q2[1] * d2;
+            d1 = nd1;
+            d2 = nd2;
+        }
+        // 不足一块的部分按原公式逐点递推
+        for (; n < blockSize; n++)
+        {
+            x = pIn[n];
+            y = pCoeffs[0] * x + d1;
+            d1 = pCoeffs[1] * x + d2 + pCoeffs[3] * y;
+            d2 = pCoeffs[2] * x + pCoeffs[4] * y;
+            pDst[n] = y;
+        }
+
+        pState[0] = d1;
+        pState[1] = d2;
+        pState += 2U;
+        pCoeffs += 5U;
+        pIn = pDst;
+    }
+}
+
+void arm_biquad_cascade_df2T_f32(const arm_biquad_cascade_df2T_instance_f32 *S, const float32_t *pSrc,
+                                 float32_t *pDst, uint32_t blockSize)
+{
+    if (!DSP_Simd_Active() || S->numStages > DSP_SIMD_BQ_MAX_STAGES || blockSize < BQ_BLOCK)
+    {
+        arm_biquad_cascade_df2T_f32_portable(S, pSrc, pDst, blockSize);
+        return;
+    }
+    bq_df2t_f32_avx2(S, bq_cache_get(S), pSrc, pDst, blockSize);
+}
+
+/*================================ arm_cfft_f32 ================================*/
+
+static uint32_t log2_u32(uint32_t n)
+{
+    uint32_t r = 0;
+
+    while (n > 1U)
+    {
+        n >>= 1;
+        r++;
+    }
+    return r;
+}
+
+/**
+ * @brief 由 S->pTwiddle (N 个复数 cos, sin) 生成各级旋转因子和位反序交换表
+ */
+static const Cfft_Cache_t *cfft_cache_get(const arm_cfft_instance_f32 *S, uint32_t bits)
+{
+    Cfft_Cache_t *c = &cfft_cache[bits];
+    uint32_t n = S->fftLen, m, k, idx, pos, i, r, b;
+
+    if (c->twiddle == S->pTwiddle && NULL != c->w_fwd)
+    {
+        return c;
+    }
+    free(c->w_fwd);
+    free(c->w_inv);
+    free(c->swap);
+    c->w_fwd = malloc(2U * n * sizeof(float32_t));
+    c->w_inv = malloc(2U * n * sizeof(float32_t));
+    c->swap = malloc(n * sizeof(uint16_t));
+    if (NULL == c->w_fwd || NULL == c->w_inv || NULL == c->swap)
+    {
+        free(c->w_fwd);
+        free(c->w_inv);
+        free(c->swap);
+        c->w_fwd = NULL;
+        c->w_inv = NULL;
+        c->swap = NULL;
+        return NULL;
+    }
+
+    pos = 0;
+    for (m = 4; m < n; m <<= 1)
+    {
+        for (k = 0; k < m; k++)
+        {
+            idx = k * (n / (2U * m));
+            c->w_fwd[pos] = S->pTwiddle[2U * idx];
+            c->w_fwd[pos + 1U] = -S->pTwiddle[2U * idx + 1U];
+            c->w_inv[pos] = S->pTwiddle[2U * idx];
+            c->w_inv[pos + 1U] = S->pTwiddle[2U * idx + 1U];
+            pos += 2U;
+        }
+    }
+
+    c->swaps = 0;
+    for (i = 0; i < n; i++)
+    {
+        r = 0;
+        for (b = 0; b < bits; b++)
+        {
+            r |= ((i >> b) & 1U) << (bits - 1U - b);
+        }
+        if (i < r)
+        {
+            c->swap[c->swaps++] = (uint16_t)i;
+            c->swap[c->swaps++] = (uint16_t)r;
+        }
+    }
+    c->twiddle = S->pTwiddle;
+    return c;
+}
+
+SIMD_TARGET static void cfft_f32_avx2(const Cfft_Cache_t *c, uint32_t n, float32_t *p1, uint8_t ifftFlag)
+{
+    const float32_t *w = ifftFlag ? c->w_inv : c->w_fwd;
+    // 第 2 级的 -j (正变换) / +j (逆变换)：交换实虚部后对其中一个取反
+    const __m256 rot_sign = ifftFlag ? _mm256_setr_ps(0, 0, 0, 0, 0, 0, -0.0f, 0)
+                                     : _mm256_setr_ps(0, 0, 0, 0, 0, 0, 0, -0.0f);
+    const __m256 half_sign = _mm256_setr_ps(1, 1, 1, 1, -1, -1, -1, -1);
+    uint64_t *pc = (uint64_t *)p1, tmp;
+    uint32_t i, m, g, k;
+    __m256 v, sw, t, lo, hi, a, b;
+
+    for (i = 0; i < c->swaps; i += 2U)
+    {
+        tmp = pc[c->swap[i]];
+        pc[c->swap[i]] = pc[c->swap[i + 1U]];
+        pc[c->swap[i + 1U]] = tmp;
+    }
+
+    // 前两级：每 4 个复数一组 [a0 a1 | a2 a3]
+    for (i = 0; i < 2U * n; i += 8U)
+    {
+        v = _mm256_loadu_ps(p1 + i);
+        sw = _mm256_permute_ps(v, 0x4E);                                        // [a1 a0 | a3 a2]
+        t = _mm256_blend_ps(_mm256_add_ps(v, sw), _mm256_sub_ps(sw, v), 0xCC);  // [a0+a1 a0-a1 | a2+a3 a2-a3]
+        t = _mm256_blend_ps(t, _mm256_xor_ps(_mm256_permute_ps(t, 0xB1), rot_sign), 0xC0);
+        lo = _mm256_permute2f128_ps(t, t, 0x00);
+        hi = _mm256_permute2f128_ps(t, t, 0x11);
+        _mm256_storeu_ps(p1 + i, _mm256_fmadd_ps(hi, half_sign, lo));
+    }
+
+    // 其余各级：半长 m，每次 4 个蝶形
+    for (m = 4; m < n; m <<= 1)
+    {
+        for (g = 0; g < n; g += 2U * m)
+        {
+            for (k = 0; k < m; k += 4U)
+            {
+                a = _mm256_loadu_ps(p1 + 2U * (g + k));
+                b = cmul_ps(_mm256_loadu_ps(p1 + 2U * (g + k + m)), _mm256_loadu_ps(w + 2U * k));
+                _mm256_storeu_ps(p1 + 2U * (g + k), _mm256_add_ps(a, b));
+                _mm256_storeu_ps(p1 + 2U * (g + k + m), _mm256_sub_ps(a, b));
+            }
+        }
+        w += 2U * m;
+    }
+
+    if (ifftFlag)
+    {
+        t = _mm256_set1_ps(1.0f / (float32_t)n);
+        for (i = 0; i < 2U * n; i += 8U)
+        {
+            _mm256_storeu_ps(p1 + i, _mm256_mul_ps(_mm256_loadu_ps(p1 + i), t));
+        }
+    }
+}
+
+/**
+ * @note 只接管 bitReverseFlag = 1 的调用：不做位反序时 CMSIS 的输出是基 8 分解的内部顺序，算法不同无法照搬
+ */
+void arm_cfft_f32(const arm_cfft_instance_f32 *S, float32_t *p1, uint8_t ifftFlag, uint8_t bitReverseFlag)
+{
+    uint32_t n = S->fftLen, bits = log2_u32(n);
+    const Cfft_Cache_t *c = NULL;
+
+    if (DSP_Simd_Active() && 0U != bitReverseFlag && n >= 16U && n <= DSP_SIMD_CFFT_MAX_LEN && n == (1U << bits))
+    {
+        c = cfft_cache_get(S, bits);
+    }
+    if (NULL == c)
+    {
+        arm_cfft_f32_portable(S, p1, ifftFlag, bitReverseFlag);
+        return;
+    }
+    cfft_f32_avx2(c, n, p1, ifftFlag);
+}
+
+/*================================ arm_dot_prod_f32 ================================*/
+
+SIMD_TARGET static float32_t dot_prod_f32_avx2(const float32_t *pSrcA, const float32_t *pSrcB, uint32_t blockSize)
+{
+    __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+    __m256 acc2 = _mm256_setzero_ps(), acc3 = _mm256_setzero_ps();
+    uint32_t n = 0;
+    float32_t sum;
+
+    for (; n + 32U <= blockSize; n += 32U)
+    {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(pSrcA + n), _mm256_loadu_ps(pSrcB + n), acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(pSrcA + n + 8U), _mm256_loadu_ps(pSrcB + n + 8U), acc1);
+        acc2 = _mm256_fmadd_ps(_mm256_loadu_ps(pSrcA + n + 16U), _mm256_loadu_ps(pSrcB + n + 16U), acc2);
+        acc3 = _mm256_fmadd_ps(_mm256_loadu_ps(pSrcA + n + 24U), _mm256_loadu_ps(pSrcB + n + 24U), acc3);
+    }
+    for (; n + 8U <= blockSize; n += 8U)
+    {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(pSrcA + n), _mm256_loadu_ps(pSrcB + n), acc0);
+    }
+    sum = hsum_ps(_mm256_add_ps(_mm256_add_ps(acc0, acc1), _mm256_add_ps(acc2, acc3)));
+    for (; n < blockSize; n++)
+    {
+        sum += pSrcA[n] * pSrcB[n];
+    }
+    return sum;
+}
+
+void arm_dot_prod_f32(const float32_t *pSrcA, const float32_t *pSrcB, uint32_t blockSize, float32_t *result)
+{
+    if (!DSP_Simd_Active())
+    {
+        arm_dot_prod_f32_portable(pSrcA, pSrcB, blockSize, result);
+        return;
+    }
+    *result = dot_prod_f32_avx2(pSrcA, pSrcB, blockSize);
+}
+
+/*================================ arm_mat_mult_f32 ================================*/
+
+SIMD_TARGET static void mat_mult_f32_avx2(const arm_matrix_instance_f32 *pSrcA, const arm_matrix_instance_f32 *pSrcB,
+                                          arm_matrix_instance_f32 *pDst)
+{
+    const float32_t *pA = pSrcA->pData, *pB = pSrcB->pData;
+    float32_t *pC = pDst->pData;
+    uint32_t rows = pSrcA->numRows, inner = pSrcA->numCols, cols = pSrcB->numCols;
+    uint32_t r, c, k, tail = cols % 8U;
+    __m256i mask = _mm256_cmpgt_epi32(_mm256_set1_epi32((int)tail), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    __m256 acc;
+
+    for (r = 0; r < rows; r++)
+    {
+        for (c = 0; c + 8U <= cols; c += 8U)
+        {
+            acc = _mm256_setzero_ps();
+            for (k = 0; k < inner; k++)
+            {
+                acc = _mm256_fmadd_ps(_mm256_broadcast_ss(&pA[r * inner + k]), _mm256_loadu_ps(&pB[k * cols + c]),
+                                      acc);
+            }
+            _mm256_storeu_ps(&pC[r * cols + c], acc);
+        }
+        if (0U != tail)
+        {
+            acc = _mm256_setzero_ps();
+            for (k = 0; k < inner; k++)
+            {
+                acc = _mm256_fmadd_ps(_mm256_broadcast_ss(&pA[r * inner + k]),
+                                      _mm256_maskload_ps(&pB[k * cols + c], mask), acc);
+            }
+            _mm256_maskstore_ps(&pC[r * cols + c], mask, acc);
+        }
+    }
+}
+
+arm_status arm_mat_mult_f32(const arm_matrix_instance_f32 *pSrcA, const arm_matrix_instance_f32 *pSrcB,
+                            arm_matrix_instance_f32 *pDst)
+{
+    if (!DSP_Simd_Active())
+    {
+        return arm_mat_mult_f32_portable(pSrcA, pSrcB, pDst);
+    }
+#ifdef ARM_MATH_MATRIX_CHECK
+    if ((pSrcA->numCols != pSrcB->numRows) || (pSrcA->numRows != pDst->numRows) ||
+        (pSrcB->numCols != pDst->numCols))
+    {
+        return ARM_MATH_SIZE_MISMATCH;
+    }
+#endif
+    mat_mult_f32_avx2(pSrcA, pSrcB, pDst);
+    return ARM_MATH_SUCCESS;
+}
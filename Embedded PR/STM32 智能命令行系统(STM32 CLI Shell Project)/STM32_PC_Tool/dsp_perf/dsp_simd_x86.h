@@ -0,0 +1,23 @@
+#ifndef DSP_SIMD_X86_H
+#define DSP_SIMD_X86_H
+#include <stdint.h>
+#include "arm_math.h"
+
+/* x86 AVX2/FMA 版本，只在 PC 上使用 (make SIMD=1)，函数名和参数与 CMSIS-DSP 相同，直接替换通用版本。
+ * 通用版本改名为 xxx_portable 一起编译进库 (见 Makefile)：CPU 不支持 AVX2/FMA、
+ * 设置了环境变量 DSP_SIMD_OFF，或参数不在 SIMD 版本覆盖的范围内时转去调用，dsp_perf 也用它做对比 */
+
+#define DSP_SIMD_BQ_MAX_STAGES 8    // arm_biquad_cascade_df2T_f32 超过这个节数走通用版本
+#define DSP_SIMD_CFFT_MAX_LEN 4096
+
+int DSP_Simd_Active(void);
+
+void arm_fir_f32_portable(const arm_fir_instance_f32 *S, const float32_t *pSrc, float32_t *pDst, uint32_t blockSize);
+void arm_biquad_cascade_df2T_f32_portable(const arm_biquad_cascade_df2T_instance_f32 *S, const float32_t *pSrc,
+                                          float32_t *pDst, uint32_t blockSize);
+void arm_cfft_f32_portable(const arm_cfft_instance_f32 *S, float32_t *p1, uint8_t ifftFlag, uint8_t bitReverseFlag);
+void arm_dot_prod_f32_portable(const float32_t *pSrcA, const float32_t *pSrcB, uint32_t blockSize, float32_t *result);
+arm_status arm_mat_mult_f32_portable(const arm_matrix_instance_f32 *pSrcA, const arm_matrix_instance_f32 *pSrcB,
+                                     arm_matrix_instance_f32 *pDst);
+
+#endif //end DSP_SIMD_X86_H
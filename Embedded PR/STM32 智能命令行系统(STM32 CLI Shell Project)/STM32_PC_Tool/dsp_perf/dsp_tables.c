@@ -0,0 +1,191 @@
+/*
+ * FFT 表的运行时生成
+ *
+ * 旋转因子：twiddle[2i] = cos(2*pi*i/N)，twiddle[2i+1] = sin(2*pi*i/N)，i = 0 ~ N-1，
+ * 与 arm_common_tables.h 里 twiddleCoef_N[2N] 的定义相同，用 double 计算后转成 float。
+ *
+ * 位反序表：arm_cfft_f32 按 radix-8 (及 8by2/8by4) 分解，输出顺序不是简单的二进制位反序，
+ * 官方表是事先算好的交换序列 (每对数值 = 复数下标 * 8，即字节偏移)。
+ * 这里不推导顺序，直接测出来：bitReverseFlag = 0 时把 exp(j*2*pi*k*n/N) 送进 FFT，
+ * 输出只在一个位置上有值 (N)，这个位置就是第 k 个频点被放到的地方。
+ * 得到整个置换后按环分解成交换序列，交换次数 = N - 环数，不超过官方表的长度。
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "dsp_tables.h"
+
+#define CFFT_SIZES 9    // 16 ~ 4096
+
+typedef struct
+{
+    arm_cfft_instance_f32 inst;
+    float32_t *twiddle;
+    uint16_t *bitrev;
+} Cfft_Table_t;
+
+static Cfft_Table_t tables[CFFT_SIZES];
+
+static int cfft_index(uint16_t len)
+{
+    int i;
+
+    for (i = 0; i < CFFT_SIZES; i++)
+    {
+        if ((DSP_CFFT_MIN_LEN << i) == len)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief 测出 FFT 不做位反序时的输出位置：perm[k] = 频点 k 所在的下标
+ */
+static int cfft_measure_perm(const arm_cfft_instance_f32 *s, uint16_t *perm)
+{
+    uint32_t n = s->fftLen, k, i, peak;
+    float32_t *buf = malloc(n * 2 * sizeof(float32_t));
+    double mag, peak_mag;
+
+    if (NULL == buf)
+    {
+        return -1;
+    }
+    for (k = 0; k < n; k++)
+    {
+        for (i = 0; i < n; i++)
+        {
+            // 下标取模，避免 k*i 很大时 double 相位误差
+            double ph = 2.0 * M_PI * (double)((k * i) % n) / n;
+
+            buf[2 * i] = (float32_t)cos(ph);
+            buf[2 * i + 1] = (float32_t)sin(ph);
+        }
+        arm_cfft_f32(s, buf, 0, 0);
+        peak = 0;
+        peak_mag = -1;
+        for (i = 0; i < n; i++)
+        {
+            mag = (double)buf[2 * i] * buf[2 * i] + (double)buf[2 * i + 1] * buf[2 * i + 1];
+            if (mag > peak_mag)
+            {
+                peak_mag = mag;
+                peak = i;
+            }
+        }
+        // 峰值应接近 N^2，否则旋转因子的格式不对
+        if (fabs(sqrt(peak_mag) - n) > 1e-3 * n)
+        {
+            free(buf);
+            return -1;
+        }
+        perm[k] = (uint16_t)peak;
+    }
+    free(buf);
+    return 0;
+}
+
+/**
+ * @brief 把置换拆成交换序列，按 arm_bitreversal_32 的格式 (复数下标 * 8) 写入 table
+ * @return 表长 (uint16_t 个数)
+ */
+static uint16_t cfft_perm_to_swaps(const uint16_t *perm, uint32_t n, uint16_t *table)
+{
+    uint16_t *where = malloc(n * sizeof(uint16_t));     // 原下标 -> 当前位置
+    uint16_t *at = malloc(n * sizeof(uint16_t));        // 当前位置 -> 原下标
+    uint32_t k, src, len = 0;
+
+    for (k = 0; k < n; k++)
+    {
+        where[k] = (uint16_t)k;
+        at[k] = (uint16_t)k;
+    }
+    for (k = 0; k < n; k++)
+    {
+        // 第 k 个频点在原输出的 perm[k] 处，现在被换到了 where[perm[k]]
+        src = where[perm[k]];
+        if (src != k)
+        {
+            table[len++] = (uint16_t)(k * 8);
+            table[len++] = (uint16_t)(src * 8);
+            where[at[k]] = (uint16_t)src;
+            at[src] = at[k];
+            where[perm[k]] = (uint16_t)k;
+            at[k] = perm[k];
+        }
+    }
+    free(where);
+    free(at);
+    return (uint16_t)len;
+}
+
+/**
+ * @brief 取长度为 len 的浮点复数 FFT 实例，第一次调用时生成表
+ * @param len 16 ~ 4096，2 的幂
+ * @return 不支持的长度或生成失败时返回 NULL
+ */
+const arm_cfft_instance_f32 *DSP_Tables_CfftF32(uint16_t len)
+{
+    int idx = cfft_index(len);
+    Cfft_Table_t *t;
+    uint16_t *perm;
+    uint32_t i;
+
+    if (idx < 0)
+    {
+        return NULL;
+    }
+    t = &tables[idx];
+    if (NULL != t->twiddle)
+    {
+        return &t->inst;
+    }
+
+    t->twiddle = malloc(2 * len * sizeof(float32_t));
+    t->bitrev = malloc(2 * len * sizeof(uint16_t));
+    perm = malloc(len * sizeof(uint16_t));
+    if (NULL == t->twiddle || NULL == t->bitrev || NULL == perm)
+    {
+        free(perm);
+        DSP_Tables_Free();
+        return NULL;
+    }
+    for (i = 0; i < len; i++)
+    {
+        t->twiddle[2 * i] = (float32_t)cos(2.0 * M_PI * i / len);
+        t->twiddle[2 * i + 1] = (float32_t)sin(2.0 * M_PI * i / len);
+    }
+    t->inst.fftLen = len;
+    t->inst.pTwiddle = t->twiddle;
+    t->inst.pBitRevTable = t->bitrev;
+    t->inst.bitRevLength = 0;
+
+    if (0 != cfft_measure_perm(&t->inst, perm))
+    {
+        fprintf(stderr, "cfft %u: output order not a permutation, twiddle format mismatch?\n", len);
+        free(perm);
+        free(t->twiddle);
+        free(t->bitrev);
+        t->twiddle = NULL;
+        t->bitrev = NULL;
+        return NULL;
+    }
+    t->inst.bitRevLength = cfft_perm_to_swaps(perm, len, t->bitrev);
+    free(perm);
+    return &t->inst;
+}
+
+void DSP_Tables_Free(void)
+{
+    int i;
+
+    for (i = 0; i < CFFT_SIZES; i++)
+    {
+        free(tables[i].twiddle);
+        free(tables[i].bitrev);
+        tables[i].twiddle = NULL;
+        tables[i].bitrev = NULL;
+    }
+}
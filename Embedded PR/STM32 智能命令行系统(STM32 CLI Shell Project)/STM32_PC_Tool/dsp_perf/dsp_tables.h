@@ -0,0 +1,14 @@
+#ifndef DSP_TABLES_H
+#define DSP_TABLES_H
+#include <stdint.h>
+#include "arm_math.h"
+
+/* 仓库里的 CMSIS-DSP 没有带 arm_common_tables.c，FFT 的旋转因子和位反序表在 PC 上运行时生成 */
+
+#define DSP_CFFT_MIN_LEN 16
+#define DSP_CFFT_MAX_LEN 4096
+
+const arm_cfft_instance_f32 *DSP_Tables_CfftF32(uint16_t len);
+void DSP_Tables_Free(void);
+
+#endif //end DSP_TABLES_H
@@ -0,0 +1,23 @@
+#ifndef __ELOG_ASYNC_TEST_FREERTOS_H__
+#define __ELOG_ASYNC_TEST_FREERTOS_H__
+
+/* elog_async_test 专用：只提供 elog_async.c (FreeRTOS 后端) 用到的定义
+ * 任务用 pthread 线程代替，实现见 freertos_posix.c */
+#include <stdint.h>
+#include <stddef.h>
+#include <assert.h>
+
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+typedef uint32_t StackType_t;
+
+#define pdFALSE ((BaseType_t)0)
+#define pdTRUE ((BaseType_t)1)
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms)) // 与固件一样 1 tick = 1ms
+#define portMAX_DELAY ((TickType_t)0xFFFFFFFFUL)
+#define tskIDLE_PRIORITY ((UBaseType_t)0U)
+#define configASSERT(x) assert(x)
+#define portYIELD_FROM_ISR(x) ((void)(x))
+
+#endif //end __ELOG_ASYNC_TEST_FREERTOS_H__
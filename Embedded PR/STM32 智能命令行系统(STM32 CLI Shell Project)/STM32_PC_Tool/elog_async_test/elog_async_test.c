@@ -0,0 +1,648 @@
+/*
+ * EasyLogger 异步输出队列测试：在 PC 上检验 elog_async.c 的 FreeRTOS 后端
+ *
+ * elog_async.c 原样编译 (__linux__ 分支用 GCC 原子操作代替 LDREX/STREX)，
+ * 仓库里没有 FreeRTOS 的 POSIX 移植，本目录的 FreeRTOS.h / task.h / semphr.h / freertos_posix.c
+ * 用 pthread 提供它用到的几个接口：任务 = 线程，任务通知、信号量 = 条件变量，
+ * "中断" = 置位 sim_isr_nest 的线程 (xPortIsInsideInterrupt 返回真，不能等待)。
+ *     gcc -O2 -pthread -I. -I../../Middlewares/Third_Party/easylogger/inc -o elog_async_test
+ *         elog_async_test.c freertos_posix.c ../../Middlewares/Third_Party/easylogger/src/elog_async.c
+ *     ./elog_async_test                  功能测试
+ *     ./elog_async_test stress 4 10      压力测试：4 个任务 + 1 个中断 + 1 个经常被长时间抢占的任务，运行 10 秒
+ * 加 -fsanitize=thread 编译可以同时检查数据竞争。
+ *
+ * 每行日志写成 "P<生产者> <序号> <填充>|<校验和>"，长度随序号变化，
+ * elog_port_output / elog_port_save 由本程序实现，按生产者检查内容、顺序和条数：
+ *     1. 单任务顺序输出，不丢不乱
+ *     2. 同步等级 (断言) 和关闭异步时在调用者里直接输出，drain 任务只保存
+ *     3. 被过滤的行 (长度 0) 不输出也不保存，槽位照常归还
+ *     4. drain 任务卡住时：中断立即丢弃并计数，任务最多等待 ELOG_ASYNC_LINE_SLOT_WAIT_TICKS 后丢弃，恢复后按序输出
+ *     5. 队列满时等待的任务在 drain 任务腾出槽位后立即被唤醒，不按 tick 轮询
+ *     6. 取到槽位后迟迟不发布的生产者 (被抢占) 最多挡住后面的日志 ELOG_ASYNC_LINE_STALE_MS，
+ *        它的行被丢弃并计数，槽位下一轮照常使用
+ *     7. 多个任务和一个中断同时写，每个生产者的顺序不变，接受的行全部输出
+ *     8. elog_async_output 复制路径，超长的行按 ELOG_LINE_BUF_SIZE 截断
+ * 压力测试另外检查：保存的行数 = 接受的行数 - 被跳过的行数，所有行校验和正确，并给出吞吐量。
+ * 有一项不符时返回非 0。
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include <pthread.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "elog.h"
+
+#define PRODUCER_MAX 8
+#define SINGLE_LINES 20000
+#define MULTI_TASKS 4
+#define MULTI_LINES 50000
+#define ISR_LINES 20000
+
+/* elog_async.c 中没有放进 elog.h 的接口 */
+extern ElogErrCode elog_async_init(void);
+extern void elog_async_output(uint8_t level, const char *log, size_t size);
+
+typedef struct
+{
+    uint32_t next;          // 下一个期望的序号
+    uint32_t saved;         // 已保存的行数
+    bool allow_gap;         // 允许丢行 (只检查递增)
+} Producer_Check_t;
+
+static pthread_mutex_t check_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t gate_cond = PTHREAD_COND_INITIALIZER;
+static bool gate_closed;                    // true: drain 任务在 elog_port_save 里等待
+static Producer_Check_t check[PRODUCER_MAX];
+static uint32_t saved_total, output_total, output_by_caller;
+static size_t last_len;
+static unsigned long fail_count;
+static __thread bool is_producer;           // 生产者线程的标记，用来区分谁调用了 elog_port_output
+
+#define CHECK(cond, ...)                                        \
+    do                                                          \
+    {                                                           \
+        if (!(cond) && fail_count++ < 20)                       \
+        {                                                       \
+            printf("FAIL line %d: ", __LINE__);                 \
+            printf(__VA_ARGS__);                                \
+            printf("\n");                                       \
+        }                                                       \
+    } while (0)
+
+static double Now_Ms(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+/**
+ * @brief 行内容的校验和 (FNV-1a)
+ */
+static uint32_t Line_Sum(const char *text, size_t len)
+{
+    uint32_t h = 2166136261U;
+
+    while (len--)
+    {
+        h = (h ^ (uint8_t)*text++) * 16777619U;
+    }
+    return h;
+}
+
+/**
+ * @brief 生成一行 "P<生产者> <序号> <长度随序号变化的填充>|<校验和>\n"
+ * @return 行长度
+ */
+static int Line_Format(char *buf, int producer, uint32_t seq)
+{
+    int len = snprintf(buf, ELOG_LINE_BUF_SIZE, "P%d %u ", producer, (unsigned)seq);
+    int fill = (int)((seq * 37U + (uint32_t)producer * 11U) % 160U);
+
+    while (fill-- > 0)
+    {
+        buf[len] = (char)('a' + (seq + (uint32_t)len) % 26U);
+        len++;
+    }
+    len += snprintf(buf + len, ELOG_LINE_BUF_SIZE - len, "|%08x\n", (unsigned)Line_Sum(buf, (size_t)len));
+    return len;
+}
+
+/**
+ * @brief 检查一行的内容和所属生产者的顺序 (调用时持有 check_lock)
+ */
+static void Check_Line(const char *log, size_t size)
+{
+    int producer, body;
+    unsigned seq, sum;
+    char text[ELOG_LINE_BUF_SIZE + 1];
+
+    last_len = size;
+    if (size >= sizeof(text) || log[0] != 'P')
+    {
+        return; // 不是测试格式的行 (截断测试)，只记录长度
+    }
+    memcpy(text, log, size);
+    text[size] = '\0';
+    body = (int)(strchr(text, '|') ? strchr(text, '|') - text : -1);
+    if (body < 0 || sscanf(text, "P%d %u", &producer, &seq) != 2 || sscanf(text + body, "|%x\n", &sum) != 1 ||
+        producer < 0 || producer >= PRODUCER_MAX)
+    {
+        CHECK(0, "bad line \"%.*s\"", (int)size, log);
+        return;
+    }
+    CHECK(sum == Line_Sum(text, (size_t)body), "P%d seq %u corrupted", producer, seq);
+    if (check[producer].allow_gap)
+    {
+        CHECK(seq >= check[producer].next, "P%d seq %u after %u", producer, seq, check[producer].next);
+    }
+    else
+    {
+        CHECK(seq == check[producer].next, "P%d seq %u, expect %u", producer, seq, check[producer].next);
+    }
+    check[producer].next = seq + 1;
+    check[producer].saved++;
+}
+
+void elog_port_output(const char *log, size_t size)
+{
+    pthread_mutex_lock(&check_lock);
+    output_total++;
+    if (is_producer)
+    {
+        output_by_caller++;
+    }
+    pthread_mutex_unlock(&check_lock);
+    (void)log;
+    (void)size;
+}
+
+void elog_port_save(uint8_t level, const char *log, size_t size)
+{
+    (void)level;
+    pthread_mutex_lock(&check_lock);
+    while (gate_closed)
+    {
+        pthread_cond_wait(&gate_cond, &check_lock);
+    }
+    Check_Line(log, size);
+    saved_total++;
+    pthread_mutex_unlock(&check_lock);
+}
+
+void elog_output_lock(void)
+{
+}
+
+void elog_output_unlock(void)
+{
+}
+
+static void Gate_Set(bool closed)
+{
+    pthread_mutex_lock(&check_lock);
+    gate_closed = closed;
+    pthread_cond_broadcast(&gate_cond);
+    pthread_mutex_unlock(&check_lock);
+}
+
+static void Reset_Check(void)
+{
+    pthread_mutex_lock(&check_lock);
+    memset(check, 0, sizeof(check));
+    saved_total = output_total = output_by_caller = 0;
+    pthread_mutex_unlock(&check_lock);
+}
+
+static uint32_t Get_Saved(void)
+{
+    uint32_t n;
+
+    pthread_mutex_lock(&check_lock);
+    n = saved_total;
+    pthread_mutex_unlock(&check_lock);
+    return n;
+}
+
+/**
+ * @brief 等待 drain 任务保存到 n 行
+ * @return false: 超时
+ */
+static bool Wait_Saved(uint32_t n, double timeout_ms)
+{
+    double end = Now_Ms() + timeout_ms;
+
+    while (Get_Saved() < n)
+    {
+        if (Now_Ms() > end)
+        {
+            return false;
+        }
+        vTaskDelay(1);
+    }
+    return true;
+}
+
+/**
+ * @brief 与 elog_output 相同的用法：取槽位、在槽位里格式化、发布
+ * @return false: 队列满被丢弃
+ */
+static bool Log_Line(uint8_t level, int producer, uint32_t seq)
+{
+    char *buf = elog_async_get_line_buf();
+    int len;
+
+    if (buf == NULL)
+    {
+        return false;
+    }
+    len = Line_Format(buf, producer, seq);
+    elog_async_put_line_buf(level, buf, (size_t)len);
+    return true;
+}
+
+static void Test_Single(void)
+{
+    uint32_t i, drop = elog_async_get_drop_count();
+
+    Reset_Check();
+    is_producer = true;
+    for (i = 0; i < SINGLE_LINES; i++)
+    {
+        CHECK(Log_Line(ELOG_LVL_INFO, 0, i), "line %u dropped", (unsigned)i);
+    }
+    CHECK(Wait_Saved(SINGLE_LINES, 2000), "saved %u of %u", (unsigned)Get_Saved(), SINGLE_LINES);
+    CHECK(check[0].next == SINGLE_LINES, "last seq %u", (unsigned)check[0].next);
+    CHECK(output_total == SINGLE_LINES && output_by_caller == 0, "output %u, by caller %u", (unsigned)output_total,
+          (unsigned)output_by_caller);
+    CHECK(elog_async_get_drop_count() == drop, "dropped %u", (unsigned)(elog_async_get_drop_count() - drop));
+    printf("single task: %u lines in order\n", SINGLE_LINES);
+}
+
+static void Test_Sync_Level(void)
+{
+    Reset_Check();
+    is_producer = true;
+
+    // 断言等级在调用者里立即输出
+    Log_Line(ELOG_LVL_ASSERT, 0, 0);
+    CHECK(output_by_caller == 1, "assert output by caller %u", (unsigned)output_by_caller);
+
+    // 关闭异步模式，所有等级都在调用者里输出
+    elog_async_enabled(false);
+    Log_Line(ELOG_LVL_INFO, 0, 1);
+    elog_async_enabled(true);
+    CHECK(output_by_caller == 2, "disabled output by caller %u", (unsigned)output_by_caller);
+
+    // drain 任务仍按顺序保存，但不再输出
+    CHECK(Wait_Saved(2, 1000), "saved %u of 2", (unsigned)Get_Saved());
+    CHECK(output_total == 2, "output %u times", (unsigned)output_total);
+    printf("sync level: output in the caller, saved by the drain task\n");
+}
+
+static void Test_Filtered(void)
+{
+    char *buf;
+
+    Reset_Check();
+    is_producer = true;
+    buf = elog_async_get_line_buf();
+    CHECK(buf != NULL, "no slot");
+    elog_async_put_line_buf(ELOG_LVL_INFO, buf, 0);
+    Log_Line(ELOG_LVL_INFO, 0, 0);
+    CHECK(Wait_Saved(1, 1000), "saved %u of 1", (unsigned)Get_Saved());
+    vTaskDelay(5);
+    CHECK(saved_total == 1 && output_total == 1, "saved %u output %u", (unsigned)saved_total, (unsigned)output_total);
+    printf("filtered: empty line neither output nor saved\n");
+}
+
+static void *Isr_Burst(void *arg)
+{
+    uint32_t *accepted = arg, i;
+
+    sim_isr_nest = 1;
+    is_producer = true;
+    for (i = 0; i < ELOG_ASYNC_LINE_SLOT_NUM + 4; i++)
+    {
+        *accepted += Log_Line(ELOG_LVL_INFO, 1, i) ? 1 : 0;
+    }
+    return NULL;
+}
+
+static void Test_Full(void)
+{
+    pthread_t isr;
+    uint32_t accepted = 0, drop = elog_async_get_drop_count();
+    double t0, isr_ms, task_ms;
+    bool ok;
+
+    Reset_Check();
+    check[1].allow_gap = true;
+    Gate_Set(true);
+
+    // 中断：队列满立即丢弃
+    t0 = Now_Ms();
+    pthread_create(&isr, NULL, Isr_Burst, &accepted);
+    pthread_join(isr, NULL);
+    isr_ms = Now_Ms() - t0;
+    CHECK(accepted == ELOG_ASYNC_LINE_SLOT_NUM, "isr accepted %u", (unsigned)accepted);
+    CHECK(elog_async_get_drop_count() - drop == 4, "isr dropped %u", (unsigned)(elog_async_get_drop_count() - drop));
+
+    // 任务：等待 ELOG_ASYNC_LINE_SLOT_WAIT_TICKS 后丢弃
+    is_producer = true;
+    t0 = Now_Ms();
+    ok = Log_Line(ELOG_LVL_INFO, 2, 0);
+    task_ms = Now_Ms() - t0;
+    CHECK(!ok, "task got a slot from a full queue");
+
+    Gate_Set(false);
+    CHECK(Wait_Saved(accepted, 1000), "saved %u of %u", (unsigned)Get_Saved(), (unsigned)accepted);
+    CHECK(check[1].next == ELOG_ASYNC_LINE_SLOT_NUM, "isr last seq %u", (unsigned)check[1].next);
+    printf("queue full: isr %u accepted, 4 dropped in %.3f ms; task gave up after %.1f ms\n",
+           (unsigned)accepted, isr_ms, task_ms);
+}
+
+static void *Task_One_Line(void *arg)
+{
+    double *wait_ms = arg, t0 = Now_Ms();
+
+    is_producer = true;
+    if (!Log_Line(ELOG_LVL_INFO, 2, 0))
+    {
+        *wait_ms = -1;
+        return NULL;
+    }
+    *wait_ms = Now_Ms() - t0;
+    return NULL;
+}
+
+static void Test_Wakeup(void)
+{
+    pthread_t isr, task;
+    uint32_t accepted = 0;
+    double wait_ms = 0, open_ms;
+
+    Reset_Check();
+    check[1].allow_gap = true;
+    Gate_Set(true);
+    pthread_create(&isr, NULL, Isr_Burst, &accepted);
+    pthread_join(isr, NULL);
+
+    // 队列满时任务阻塞，drain 任务一腾出槽位就被唤醒，不按 tick 轮询
+    pthread_create(&task, NULL, Task_One_Line, &wait_ms);
+    vTaskDelay(5);
+    open_ms = 5.0;
+    Gate_Set(false);
+    pthread_join(task, NULL);
+    CHECK(wait_ms >= 0, "task dropped the line");
+    CHECK(wait_ms < open_ms + 2.0, "task woke up %.2f ms after the slot was freed", wait_ms - open_ms);
+    CHECK(Wait_Saved(accepted + 1, 1000), "saved %u of %u", (unsigned)Get_Saved(), (unsigned)accepted + 1);
+    printf("wake up: task waited %.2f ms for a drain stalled %.0f ms\n", wait_ms, open_ms);
+}
+
+static void Test_Stale(void)
+{
+    char *held;
+    uint32_t i, drop = elog_async_get_drop_count();
+    double t0, ms;
+    bool ok;
+
+    Reset_Check();
+    is_producer = true;
+
+    // 低优先级任务取到槽位后被抢占，后面的日志不能一直被它挡住
+    held = elog_async_get_line_buf();
+    CHECK(held != NULL, "no slot");
+    t0 = Now_Ms();
+    for (i = 0; i < 8; i++)
+    {
+        Log_Line(ELOG_LVL_INFO, 0, i);
+    }
+    ok = Wait_Saved(8, 1000);
+    ms = Now_Ms() - t0;
+    CHECK(ok, "saved %u of 8 behind a held slot", (unsigned)Get_Saved());
+    CHECK(ms < ELOG_ASYNC_LINE_STALE_MS + 5.0, "lines behind the held slot waited %.1f ms", ms);
+    CHECK(elog_async_get_drop_count() - drop == 1, "skipped %u", (unsigned)(elog_async_get_drop_count() - drop));
+
+    // 被跳过的生产者最后发布：丢弃，不输出，槽位留给下一轮
+    Line_Format(held, 1, 0);
+    elog_async_put_line_buf(ELOG_LVL_INFO, held, strlen(held));
+    for (i = 8; i < 8 + ELOG_ASYNC_LINE_SLOT_NUM * 3; i++)
+    {
+        CHECK(Log_Line(ELOG_LVL_INFO, 0, i), "line %u dropped", (unsigned)i);
+    }
+    CHECK(Wait_Saved(8 + ELOG_ASYNC_LINE_SLOT_NUM * 3, 1000), "saved %u", (unsigned)Get_Saved());
+    vTaskDelay(5);
+    CHECK(check[1].saved == 0, "skipped line was output");
+    CHECK(saved_total == 8 + ELOG_ASYNC_LINE_SLOT_NUM * 3, "saved %u", (unsigned)saved_total);
+    printf("stale slot: skipped after %.1f ms, later lines unaffected\n", ms);
+}
+
+typedef struct
+{
+    int id;
+    bool isr;
+    uint32_t lines;
+    uint32_t accepted;
+} Producer_Arg_t;
+
+static void *Producer(void *arg)
+{
+    Producer_Arg_t *p = arg;
+    uint32_t i;
+
+    sim_isr_nest = p->isr ? 1 : 0;
+    is_producer = true;
+    for (i = 0; i < p->lines; i++)
+    {
+        if (Log_Line(ELOG_LVL_DEBUG, p->id, i))
+        {
+            p->accepted++;
+        }
+        else if (p->isr)
+        {
+            sched_yield(); // 中断不能等，给 drain 任务让一下再继续
+        }
+    }
+    return NULL;
+}
+
+static void Test_Multi(void)
+{
+    pthread_t thread[MULTI_TASKS + 1];
+    Producer_Arg_t arg[MULTI_TASKS + 1];
+    uint32_t accepted = 0;
+    double t0, ms;
+    int i;
+
+    Reset_Check();
+    for (i = 0; i <= MULTI_TASKS; i++)
+    {
+        arg[i].id = i;
+        arg[i].isr = (i == MULTI_TASKS);
+        arg[i].lines = arg[i].isr ? ISR_LINES : MULTI_LINES;
+        arg[i].accepted = 0;
+        check[i].allow_gap = true; // 任务等待超时也会丢行，只要求顺序递增
+    }
+    t0 = Now_Ms();
+    for (i = 0; i <= MULTI_TASKS; i++)
+    {
+        pthread_create(&thread[i], NULL, Producer, &arg[i]);
+    }
+    for (i = 0; i <= MULTI_TASKS; i++)
+    {
+        pthread_join(thread[i], NULL);
+        accepted += arg[i].accepted;
+    }
+    CHECK(Wait_Saved(accepted, 5000), "saved %u of %u", (unsigned)Get_Saved(), (unsigned)accepted);
+    ms = Now_Ms() - t0;
+    for (i = 0; i <= MULTI_TASKS; i++)
+    {
+        CHECK(check[i].saved == arg[i].accepted, "P%d saved %u, accepted %u", i, (unsigned)check[i].saved,
+              (unsigned)arg[i].accepted);
+    }
+    printf("multi producer: %d tasks + 1 isr, %u of %u lines accepted, all in order, %.0f lines/s\n", MULTI_TASKS,
+           (unsigned)accepted, MULTI_TASKS * MULTI_LINES + ISR_LINES, accepted / ms * 1000.0);
+}
+
+static void Test_Copy(void)
+{
+    char line[ELOG_LINE_BUF_SIZE * 2];
+
+    Reset_Check();
+    is_producer = true;
+    memset(line, 'x', sizeof(line));
+    elog_async_output(ELOG_LVL_INFO, line, sizeof(line));
+    CHECK(Wait_Saved(1, 1000), "copy path not saved");
+    CHECK(last_len == ELOG_LINE_BUF_SIZE, "copy path length %u", (unsigned)last_len);
+    printf("copy path: %u byte line saved as %u bytes\n", (unsigned)sizeof(line), (unsigned)last_len);
+}
+
+typedef struct
+{
+    int id;
+    int kind;               // 0 任务, 1 中断, 2 会被长时间抢占的低优先级任务
+    bool *stop;
+    uint32_t accepted;
+    uint32_t rejected;
+    uint32_t held;          // 取到槽位后故意停顿超过 ELOG_ASYNC_LINE_STALE_MS 的次数 (线程被系统调度出去的不算在内)
+} Stress_Arg_t;
+
+static void *Stress_Producer(void *arg)
+{
+    Stress_Arg_t *p = arg;
+    uint32_t seq = 0, rnd = 12345U + (uint32_t)p->id;
+    char *buf;
+    int len;
+
+    sim_isr_nest = (p->kind == 1) ? 1 : 0;
+    is_producer = true;
+    while (!__atomic_load_n(p->stop, __ATOMIC_RELAXED))
+    {
+        buf = elog_async_get_line_buf();
+        if (buf == NULL)
+        {
+            p->rejected++;
+            sched_yield();
+            continue;
+        }
+        len = Line_Format(buf, p->id, seq++);
+        rnd = rnd * 1103515245U + 12345U;
+        if (p->kind == 2 && (rnd >> 16) % 64U == 0)
+        {
+            // 格式化到一半被高优先级任务抢占
+            uint32_t hold = (rnd >> 8) % (ELOG_ASYNC_LINE_STALE_MS * 2U);
+            p->held += (hold > ELOG_ASYNC_LINE_STALE_MS) ? 1 : 0;
+            vTaskDelay(hold);
+        }
+        elog_async_put_line_buf(ELOG_LVL_DEBUG, buf, (size_t)len);
+        p->accepted++;
+        if (p->kind == 1 && (seq & 15U) == 0)
+        {
+            vTaskDelay(0); // 中断不会连续不断地进入
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief 压力测试：多个任务、一个中断、一个经常被长时间抢占的任务同时写
+ * @param tasks 普通任务数
+ * @param seconds 运行时间
+ */
+static void Stress(int tasks, double seconds)
+{
+    pthread_t thread[PRODUCER_MAX];
+    Stress_Arg_t arg[PRODUCER_MAX];
+    bool stop = false;
+    uint32_t accepted = 0, rejected = 0, held = 0, saved = 0, skipped;
+    uint32_t drop = elog_async_get_drop_count();
+    int i, n = tasks + 2;
+    double t0, ms;
+
+    Reset_Check();
+    memset(arg, 0, sizeof(arg));
+    for (i = 0; i < n; i++)
+    {
+        arg[i].id = i;
+        arg[i].kind = (i == tasks) ? 1 : (i == tasks + 1) ? 2 : 0;
+        arg[i].stop = &stop;
+        check[i].allow_gap = true;
+    }
+    t0 = Now_Ms();
+    for (i = 0; i < n; i++)
+    {
+        pthread_create(&thread[i], NULL, Stress_Producer, &arg[i]);
+    }
+    vTaskDelay((TickType_t)(seconds * 1000.0));
+    __atomic_store_n(&stop, true, __ATOMIC_RELAXED);
+    for (i = 0; i < n; i++)
+    {
+        pthread_join(thread[i], NULL);
+        accepted += arg[i].accepted;
+        rejected += arg[i].rejected;
+        held += arg[i].held;
+    }
+    skipped = elog_async_get_drop_count() - drop - rejected;
+    CHECK(Wait_Saved(accepted - skipped, 5000), "saved %u of %u", (unsigned)Get_Saved(), (unsigned)(accepted - skipped));
+    ms = Now_Ms() - t0;
+    for (i = 0; i < n; i++)
+    {
+        saved += check[i].saved;
+        printf("  P%d %-5s accepted %8u  rejected %7u  saved %8u\n", i,
+               arg[i].kind == 0 ? "task" : arg[i].kind == 1 ? "isr" : "slow", (unsigned)arg[i].accepted,
+               (unsigned)arg[i].rejected, (unsigned)check[i].saved);
+    }
+    CHECK(saved == accepted - skipped, "saved %u, accepted %u, skipped %u", (unsigned)saved, (unsigned)accepted,
+          (unsigned)skipped);
+    printf("stress: %d tasks + 1 isr + 1 slow task, %.1f s, %u lines saved (%.0f lines/s), "
+           "%u rejected (queue full), %u skipped (held > %d ms: %u)\n",
+           tasks, seconds, (unsigned)saved, saved / ms * 1000.0, (unsigned)rejected, (unsigned)skipped,
+           ELOG_ASYNC_LINE_STALE_MS, (unsigned)held);
+}
+
+int main(int argc, char **argv)
+{
+    elog_async_init();
+    elog_async_enabled(true);
+
+    if (argc > 1 && strcmp(argv[1], "stress") == 0)
+    {
+        int tasks = (argc > 2) ? atoi(argv[2]) : 4;
+        double seconds = (argc > 3) ? atof(argv[3]) : 5.0;
+        if (tasks < 1 || tasks > PRODUCER_MAX - 2 || seconds <= 0)
+        {
+            printf("usage: elog_async_test stress [tasks 1-%d] [seconds]\n", PRODUCER_MAX - 2);
+            return 1;
+        }
+        Stress(tasks, seconds);
+        if (fail_count > 0)
+        {
+            printf("\n%lu checks FAILED\n", fail_count);
+            return 1;
+        }
+        printf("\nall checks passed\n");
+        return 0;
+    }
+
+    Test_Single();
+    Test_Sync_Level();
+    Test_Filtered();
+    Test_Full();
+    Test_Wakeup();
+    Test_Stale();
+    Test_Multi();
+    Test_Copy();
+
+    if (fail_count > 0)
+    {
+        printf("\n%lu checks FAILED\n", fail_count);
+        return 1;
+    }
+    printf("\nall checks passed\n");
+    return 0;
+}
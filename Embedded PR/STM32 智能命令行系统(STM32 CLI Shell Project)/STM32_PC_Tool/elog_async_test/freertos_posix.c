@@ -0,0 +1,197 @@
+/*
+ * elog_async_test 用的 FreeRTOS 接口，建立在 pthread 上
+ * 只实现 elog_async.c 用到的部分，语义与内核相同：任务通知是计数型的，
+ * ulTaskNotifyTake(pdTRUE) 取走全部计数，vTaskDelete 可以删除正阻塞在通知上的任务，
+ * 计数信号量达到上限后 Give 返回失败
+ */
+#include <time.h>
+#include <errno.h>
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+__thread int sim_isr_nest = 0;
+static __thread StaticTask_t *sim_self = NULL; // 当前线程对应的任务控制块，普通线程为 NULL
+
+static void *Task_Entry(void *arg)
+{
+    sim_self = arg;
+    sim_self->code(sim_self->param);
+    return NULL;
+}
+
+TaskHandle_t xTaskCreateStatic(TaskFunction_t pxTaskCode, const char *const pcName, const uint32_t ulStackDepth,
+                               void *const pvParameters, UBaseType_t uxPriority, StackType_t *const puxStackBuffer,
+                               StaticTask_t *const pxTaskBuffer)
+{
+    (void)pcName;
+    (void)ulStackDepth;
+    (void)uxPriority;
+    (void)puxStackBuffer;
+
+    pthread_mutex_init(&pxTaskBuffer->lock, NULL);
+    pthread_cond_init(&pxTaskBuffer->cond, NULL);
+    pxTaskBuffer->notify = 0;
+    pxTaskBuffer->code = pxTaskCode;
+    pxTaskBuffer->param = pvParameters;
+    if (pthread_create(&pxTaskBuffer->thread, NULL, Task_Entry, pxTaskBuffer) != 0)
+    {
+        return NULL;
+    }
+    return pxTaskBuffer;
+}
+
+void vTaskDelete(TaskHandle_t xTaskToDelete)
+{
+    pthread_cancel(xTaskToDelete->thread);
+    pthread_join(xTaskToDelete->thread, NULL);
+    pthread_mutex_destroy(&xTaskToDelete->lock);
+    pthread_cond_destroy(&xTaskToDelete->cond);
+}
+
+void vTaskDelay(const TickType_t xTicksToDelay)
+{
+    struct timespec ts = {(time_t)(xTicksToDelay / 1000U), (long)(xTicksToDelay % 1000U) * 1000000L};
+
+    while (nanosleep(&ts, &ts) != 0 && errno == EINTR)
+    {
+    }
+}
+
+TickType_t xTaskGetTickCount(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (TickType_t)((uint64_t)ts.tv_sec * 1000U + (uint64_t)ts.tv_nsec / 1000000U);
+}
+
+BaseType_t xTaskGetSchedulerState(void)
+{
+    return taskSCHEDULER_RUNNING;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t xTaskToNotify)
+{
+    pthread_mutex_lock(&xTaskToNotify->lock);
+    xTaskToNotify->notify++;
+    pthread_cond_signal(&xTaskToNotify->cond);
+    pthread_mutex_unlock(&xTaskToNotify->lock);
+    return pdTRUE;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken)
+{
+    xTaskNotifyGive(xTaskToNotify);
+    if (pxHigherPriorityTaskWoken != NULL)
+    {
+        *pxHigherPriorityTaskWoken = pdTRUE;
+    }
+}
+
+/**
+ * @brief 条件变量的超时时刻 (当前时间 + ticks 毫秒)
+ */
+static struct timespec Deadline(TickType_t ticks)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_REALTIME, &ts);
+    ts.tv_sec += ticks / 1000U;
+    ts.tv_nsec += (long)(ticks % 1000U) * 1000000L;
+    if (ts.tv_nsec >= 1000000000L)
+    {
+        ts.tv_sec++;
+        ts.tv_nsec -= 1000000000L;
+    }
+    return ts;
+}
+
+static void Notify_Unlock(void *arg)
+{
+    pthread_mutex_unlock(arg);
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait)
+{
+    StaticTask_t *tcb = sim_self;
+    uint32_t value;
+
+    assert(tcb != NULL); // 只能在任务中调用
+    pthread_mutex_lock(&tcb->lock);
+    pthread_cleanup_push(Notify_Unlock, &tcb->lock);
+    if (xTicksToWait == portMAX_DELAY)
+    {
+        while (tcb->notify == 0)
+        {
+            pthread_cond_wait(&tcb->cond, &tcb->lock);
+        }
+    }
+    else if (tcb->notify == 0 && xTicksToWait > 0)
+    {
+        struct timespec ts = Deadline(xTicksToWait);
+        while (tcb->notify == 0 && pthread_cond_timedwait(&tcb->cond, &tcb->lock, &ts) == 0)
+        {
+        }
+    }
+    value = tcb->notify;
+    if (value != 0)
+    {
+        tcb->notify = xClearCountOnExit ? 0 : value - 1;
+    }
+    pthread_cleanup_pop(1);
+    return value;
+}
+
+SemaphoreHandle_t xSemaphoreCreateCountingStatic(UBaseType_t uxMaxCount, UBaseType_t uxInitialCount,
+                                                 StaticSemaphore_t *pxSemaphoreBuffer)
+{
+    pthread_mutex_init(&pxSemaphoreBuffer->lock, NULL);
+    pthread_cond_init(&pxSemaphoreBuffer->cond, NULL);
+    pxSemaphoreBuffer->count = uxInitialCount;
+    pxSemaphoreBuffer->max = uxMaxCount;
+    return pxSemaphoreBuffer;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t xSemaphore, TickType_t xBlockTime)
+{
+    BaseType_t result = pdFALSE;
+    struct timespec ts = Deadline(xBlockTime);
+
+    pthread_mutex_lock(&xSemaphore->lock);
+    if (xBlockTime == portMAX_DELAY)
+    {
+        while (xSemaphore->count == 0)
+        {
+            pthread_cond_wait(&xSemaphore->cond, &xSemaphore->lock);
+        }
+    }
+    else
+    {
+        while (xSemaphore->count == 0 && pthread_cond_timedwait(&xSemaphore->cond, &xSemaphore->lock, &ts) == 0)
+        {
+        }
+    }
+    if (xSemaphore->count > 0)
+    {
+        xSemaphore->count--;
+        result = pdTRUE;
+    }
+    pthread_mutex_unlock(&xSemaphore->lock);
+    return result;
+}
+
+BaseType_t xSemaphoreGive(SemaphoreHandle_t xSemaphore)
+{
+    BaseType_t result = pdFALSE;
+
+    pthread_mutex_lock(&xSemaphore->lock);
+    if (xSemaphore->count < xSemaphore->max)
+    {
+        xSemaphore->count++;
+        pthread_cond_signal(&xSemaphore->cond);
+        result = pdTRUE;
+    }
+    pthread_mutex_unlock(&xSemaphore->lock);
+    return result;
+}
@@ -0,0 +1,22 @@
+#ifndef __ELOG_ASYNC_TEST_SEMPHR_H__
+#define __ELOG_ASYNC_TEST_SEMPHR_H__
+
+/* 计数信号量 = 互斥锁 + 条件变量，实现见 freertos_posix.c */
+#include <pthread.h>
+
+typedef struct xSTATIC_QUEUE
+{
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    UBaseType_t count;
+    UBaseType_t max;
+} StaticSemaphore_t;
+
+typedef StaticSemaphore_t *SemaphoreHandle_t;
+
+SemaphoreHandle_t xSemaphoreCreateCountingStatic(UBaseType_t uxMaxCount, UBaseType_t uxInitialCount,
+                                                 StaticSemaphore_t *pxSemaphoreBuffer);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t xSemaphore, TickType_t xBlockTime);
+BaseType_t xSemaphoreGive(SemaphoreHandle_t xSemaphore);
+
+#endif //end __ELOG_ASYNC_TEST_SEMPHR_H__
@@ -0,0 +1,39 @@
+#ifndef __ELOG_ASYNC_TEST_TASK_H__
+#define __ELOG_ASYNC_TEST_TASK_H__
+
+/* 任务 = pthread 线程，任务通知 = 互斥锁 + 条件变量，中断 = 把 sim_isr_nest 置位的线程 */
+#include <pthread.h>
+
+typedef struct xSTATIC_TCB
+{
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+    uint32_t notify;                // 任务通知计数
+    void (*code)(void *);
+    void *param;
+} StaticTask_t;
+
+typedef StaticTask_t *TaskHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+#define taskSCHEDULER_SUSPENDED ((BaseType_t)0)
+#define taskSCHEDULER_NOT_STARTED ((BaseType_t)1)
+#define taskSCHEDULER_RUNNING ((BaseType_t)2)
+
+extern __thread int sim_isr_nest;   // 非 0：当前线程在模拟中断上下文
+
+TaskHandle_t xTaskCreateStatic(TaskFunction_t pxTaskCode, const char *const pcName, const uint32_t ulStackDepth,
+                               void *const pvParameters, UBaseType_t uxPriority, StackType_t *const puxStackBuffer,
+                               StaticTask_t *const pxTaskBuffer);
+void vTaskDelete(TaskHandle_t xTaskToDelete);
+void vTaskDelay(const TickType_t xTicksToDelay);
+TickType_t xTaskGetTickCount(void);
+BaseType_t xTaskGetSchedulerState(void);
+BaseType_t xTaskNotifyGive(TaskHandle_t xTaskToNotify);
+void vTaskNotifyGiveFromISR(TaskHandle_t xTaskToNotify, BaseType_t *pxHigherPriorityTaskWoken);
+uint32_t ulTaskNotifyTake(BaseType_t xClearCountOnExit, TickType_t xTicksToWait);
+
+static inline BaseType_t xPortIsInsideInterrupt(void) { return sim_isr_nest ? pdTRUE : pdFALSE; }
+
+#endif //end __ELOG_ASYNC_TEST_TASK_H__
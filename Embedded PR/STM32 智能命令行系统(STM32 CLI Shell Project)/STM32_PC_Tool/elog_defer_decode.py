@@ -0,0 +1,155 @@
+"""
+EasyLogger 延迟日志 (deferred log) 解码工具
+
+固件端 elog_defer_x() 不在 MCU 上格式化字符串，只从 RTT 通道 2 发出：
+    [格式串地址] [时间戳us] [等级 | 参数个数<<8 | 序号<<16] [参数0] ... [参数N-1]
+每个字段都是 32 位小端。格式串 ("tag\\x1f format") 保存在固件镜像里，
+本工具从编译生成的 .axf (ELF) 中按地址读出格式串，再把参数代入还原成文本。
+elog_hexdump_defer() 发出的原始字节记录，参数个数字段为 0xFF：
+    [名字地址] [时间戳us] [等级 | 0xFF<<8 | 序号<<16] [字节数] [数据，补齐到 4 字节]
+
+抓取方法 (J-Link)：
+    JLinkRTTLogger -Device STM32F411CE -If SWD -Speed 4000 -RTTChannel 2 defer.bin
+解码：
+    python elog_defer_decode.py "MDK-ARM/STM32 CLI Shell/STM32 CLI Shell.axf" defer.bin
+
+依赖：pip install pyelftools
+"""
+import argparse
+import re
+import struct
+import sys
+
+from elftools.elf.elffile import ELFFile
+
+LEVEL_NAME = ["A", "E", "W", "I", "D", "V"]
+BLOB = 0xFF         # 原始字节记录，与 elog.h 中的 ELOG_DEFER_BLOB 一致
+HEX_WIDTH = 16      # 原始字节每行显示的字节数
+
+# C 格式说明符：%[flags][width][.precision][length]conversion
+SPEC = re.compile(r"%([-+ #0]*)(\d*|\*)(?:\.(\d+))?(hh|h|ll|l|z|t|j)?([diouxXcsp%])")
+
+
+class Image:
+    """按地址读取 ELF 中已加载段的内容"""
+
+    def __init__(self, path):
+        self.chunks = []
+        with open(path, "rb") as f:
+            elf = ELFFile(f)
+            for seg in elf.iter_segments():
+                if seg["p_type"] == "PT_LOAD" and seg["p_filesz"]:
+                    self.chunks.append((seg["p_vaddr"], seg.data()))
+
+    def read_cstr(self, addr):
+        for base, data in self.chunks:
+            if base <= addr < base + len(data):
+                end = data.find(b"\0", addr - base)
+                return data[addr - base:end].decode("utf-8", "replace")
+        return None
+
+
+def render(image, fmt, args):
+    """把 32 位原始参数代入 C 格式串"""
+    out = []
+    pos = 0
+    it = iter(args)
+    for m in SPEC.finditer(fmt):
+        out.append(fmt[pos:m.start()])
+        pos = m.end()
+        flags, width, prec, _, conv = m.groups()
+        if conv == "%":
+            out.append("%")
+            continue
+        if width == "*":
+            width = str(next(it, 0))
+        value = next(it, 0)
+        spec = "%" + flags + (width or "") + ("." + prec if prec else "")
+        if conv in "di":
+            value = value - (1 << 32) if value & 0x80000000 else value
+            out.append((spec + "d") % value)
+        elif conv == "c":
+            out.append((spec + "c") % chr(value & 0xFF))
+        elif conv == "s":
+            s = image.read_cstr(value)
+            out.append((spec + "s") % (s if s is not None else "<0x%08X>" % value))
+        elif conv == "p":
+            out.append("0x%08X" % value)
+        else:
+            out.append((spec + conv) % value)
+    out.append(fmt[pos:])
+    return "".join(out)
+
+
+def decode(image, data, out):
+    pos = 0
+    last_seq = None
+    last_ts = None
+    high = 0  # 32位微秒时间戳约 71 分钟卷绕一次
+    while pos + 12 <= len(data):
+        addr, ts, info = struct.unpack_from("<III", data, pos)
+        level, nargs, seq = info & 0xFF, (info >> 8) & 0xFF, info >> 16
+        blob = None
+        if nargs == BLOB and level < len(LEVEL_NAME) and pos + 16 <= len(data):
+            size = struct.unpack_from("<I", data, pos + 12)[0]
+            end = pos + 16 + ((size + 3) & ~3)
+            if size <= 0xFFFF and end <= len(data):
+                blob = data[pos + 16:pos + 16 + size]
+                nargs = 0
+        if level >= len(LEVEL_NAME) or nargs > 7:
+            # 数据错位 (例如从记录中间开始抓取)，按字对齐向后搜索
+            pos += 4
+            continue
+        if blob is not None:
+            pos = end
+            args = ()
+        else:
+            args = struct.unpack_from("<%dI" % nargs, data, pos + 12)
+            pos += 12 + 4 * nargs
+
+        if last_seq is not None and seq != (last_seq + 1) & 0xFFFF:
+            out.write("--- %d record(s) dropped ---\n" % ((seq - last_seq - 1) & 0xFFFF))
+        last_seq = seq
+
+        if last_ts is not None and ts < last_ts:
+            high += 1
+        last_ts = ts
+        us = (high << 32) + ts
+        stamp = "%d.%03d" % (us // 1000, us % 1000)  # 与文本日志一致：毫秒.微秒
+
+        text = image.read_cstr(addr)
+        if blob is not None:
+            name = text if text is not None else "0x%08X" % addr
+            for off in range(0, len(blob), HEX_WIDTH):
+                chunk = blob[off:off + HEX_WIDTH]
+                hexs = " ".join("%02X" % b for b in chunk)
+                chars = "".join(chr(b) if 32 <= b < 127 else "." for b in chunk)
+                out.write("%s/HEX %-12s [%s] %04X: %-*s  %s\n" % (LEVEL_NAME[level], name, stamp, off,
+                                                                 HEX_WIDTH * 3 - 1, hexs, chars))
+            continue
+        if text is None:
+            out.write("[%s] %s/???: unknown format @0x%08X %s\n" % (stamp, LEVEL_NAME[level], addr, args))
+            continue
+        tag, _, fmt = text.partition("\x1f")
+        line = render(image, fmt, args).rstrip("\r\n")
+        out.write("%s/%-16s [%s] %s\n" % (LEVEL_NAME[level], tag, stamp, line))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="EasyLogger 延迟日志解码")
+    parser.add_argument("elf", help="固件 .axf/.elf 文件 (必须与运行中的固件一致)")
+    parser.add_argument("input", help="RTT 通道 2 的二进制抓取文件")
+    parser.add_argument("-o", "--output", help="输出文本文件，默认打印到终端")
+    args = parser.parse_args()
+
+    image = Image(args.elf)
+    with open(args.input, "rb") as f:
+        data = f.read()
+    out = open(args.output, "w", encoding="utf-8") if args.output else sys.stdout
+    decode(image, data, out)
+    if args.output:
+        out.close()
+
+
+if __name__ == "__main__":
+    main()
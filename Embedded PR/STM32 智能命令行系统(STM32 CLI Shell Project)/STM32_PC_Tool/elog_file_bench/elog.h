@@ -0,0 +1,15 @@
+#ifndef __ELOG_FILE_BENCH_ELOG_H__
+#define __ELOG_FILE_BENCH_ELOG_H__
+
+/* elog_file_bench 专用：elog_file.c 只用到错误码和断言 */
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef enum {
+    ELOG_NO_ERR,
+} ElogErrCode;
+
+#define ELOG_ASSERT(EXPR) assert(EXPR)
+
+#endif //end __ELOG_FILE_BENCH_ELOG_H__
@@ -0,0 +1,232 @@
+/*
+ * EasyLogger 文件插件吞吐测试：在 PC 上测量 elog_file_write 每秒写入的行数，并检查轮转后的文件内容
+ *
+ * elog_file.c / elog_file_port.c 原样编译，本目录的 elog.h / elog_file_cfg.h 代替 easylogger 的头文件：
+ * 4 MiB 一个文件，保留 5 个旧文件，64 KiB 写缓冲，pthread 后台轮转，后台每 100 ms 刷新一次。
+ *     gcc -O2 -pthread -I. -I../../Middlewares/Third_Party/easylogger/plugins/file -o elog_file_bench elog_file_bench.c
+ *         ../../Middlewares/Third_Party/easylogger/plugins/file/elog_file.c
+ *         ../../Middlewares/Third_Party/easylogger/plugins/file/elog_file_port.c
+ *     ./elog_file_bench                     写 2000000 行到 elog_file_bench_out/ 下
+ *     ./elog_file_bench 5000000 /tmp/out    指定行数和输出目录
+ * 加 -DELOG_FILE_FLUSH_CACHE_ENABLE 编译可测每行都 fflush 的情况。
+ * 本程序只调用 elog_file_init / elog_file_write / elog_file_deinit，把两个源文件换成改动之前的版本
+ * (git show <提交>:路径) 也能编译，用来对比。
+ *
+ * 每行 100 字节，写成 "I/bench seq <序号> <填充>\n"。
+ *     1. 写完后不调用任何接口，等 3 个刷新周期：当前文件的最后一行已经是最后写入的那一行
+ *        (后台线程按 ELOG_FILE_FLUSH_PERIOD 刷新，写缓冲里的日志不会一直留在内存里)
+ * deinit 后按 .4 .3 .2 .1 .0 (.rot) 和当前文件的顺序读回，检查：
+ *     2. 每一行完整 (100 字节)，序号连续递增，最后一行是最后写入的那一行
+ *     3. 旧文件的个数不超过 ELOG_FILE_MAX_ROTATE，每个文件不超过 ELOG_FILE_MAX_SIZE + 一行
+ *        (后台轮转还没完成时当前文件会继续写，允许超出，另外统计)，deinit 后没有留下 .rot
+ * 同时统计单次写入的最长耗时 (轮转时 rename/打开文件的停顿)。有一项不符时返回非 0。
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/stat.h>
+#include "elog_file.h"
+
+#define BENCH_LINES_DEFAULT 2000000UL
+#define LINE_LEN 100
+#define SEQ_POS 12          // "I/bench seq " 之后是 10 位序号
+#define SEQ_DIGITS 10
+
+char bench_file_name[256];
+
+static double Now_Ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* 第 n 个文件名：n < 0 是当前文件，ELOG_FILE_MAX_ROTATE 是 .rot，其余是 .n */
+static void File_Path(char *path, size_t size, int n)
+{
+    if (n < 0)
+    {
+        snprintf(path, size, "%s", bench_file_name);
+    }
+    else if (n == ELOG_FILE_MAX_ROTATE)
+    {
+        snprintf(path, size, "%s.rot", bench_file_name);
+    }
+    else
+    {
+        snprintf(path, size, "%s.%d", bench_file_name, n);
+    }
+}
+
+static void Clean_Files(void)
+{
+    char path[300];
+    int n;
+
+    for (n = -1; n <= ELOG_FILE_MAX_ROTATE + 1; n++)
+    {
+        File_Path(path, sizeof(path), n);
+        remove(path);
+    }
+}
+
+static void Put_Seq(char *line, unsigned long seq)
+{
+    int i;
+
+    for (i = SEQ_DIGITS - 1; i >= 0; i--)
+    {
+        line[SEQ_POS + i] = (char)('0' + seq % 10);
+        seq /= 10;
+    }
+}
+
+/* 当前文件最后一行的序号，没有完整的一行时返回 -1 */
+static long Last_Seq(void)
+{
+    char line[LINE_LEN + 1];
+    FILE *fp = fopen(bench_file_name, "rb");
+    long seq = -1;
+
+    if (fp == NULL)
+    {
+        return -1;
+    }
+    if (fseek(fp, -LINE_LEN, SEEK_END) == 0 && fread(line, 1, LINE_LEN, fp) == LINE_LEN
+        && memcmp(line, "I/bench seq ", SEQ_POS) == 0 && line[LINE_LEN - 1] == '\n')
+    {
+        line[LINE_LEN] = '\0';
+        seq = (long)strtoul(line + SEQ_POS, NULL, 10);
+    }
+    fclose(fp);
+    return seq;
+}
+
+/* 读回一个文件，检查每一行并接着上一个文件的序号 */
+static int Check_File(const char *path, long *next_seq, unsigned long *bytes, unsigned long *lines)
+{
+    char line[LINE_LEN + 1];
+    FILE *fp = fopen(path, "rb");
+    size_t n;
+    unsigned long seq;
+    int fail = 0;
+
+    if (fp == NULL)
+    {
+        return 0;
+    }
+    while ((n = fread(line, 1, LINE_LEN, fp)) > 0)
+    {
+        line[n] = '\0';
+        if (n != LINE_LEN || line[LINE_LEN - 1] != '\n' || memcmp(line, "I/bench seq ", SEQ_POS) != 0)
+        {
+            printf("%s: broken line at byte %lu\n", path, *bytes);
+            fail = 1;
+            break;
+        }
+        seq = strtoul(line + SEQ_POS, NULL, 10);
+        if (*next_seq >= 0 && seq != (unsigned long)*next_seq)
+        {
+            printf("%s: seq %lu after %ld\n", path, seq, *next_seq - 1);
+            fail = 1;
+            break;
+        }
+        *next_seq = (long)seq + 1;
+        *bytes += n;
+        (*lines)++;
+    }
+    fclose(fp);
+    return fail;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned long lines = (argc > 1) ? strtoul(argv[1], NULL, 0) : BENCH_LINES_DEFAULT;
+    const char *dir = (argc > 2) ? argv[2] : "elog_file_bench_out";
+    char line[LINE_LEN], path[300];
+    unsigned long i, bytes = 0, kept = 0, oversize = 0, slow = 0;
+    long next_seq = -1;
+    double t0, t1, dt, max_ns = 0, total;
+    struct timespec wait = { 0, 3 * ELOG_FILE_FLUSH_PERIOD * 1000000L };
+    struct stat st;
+    int n, files = 0, fail = 0;
+
+    if (lines == 0)
+    {
+        lines = BENCH_LINES_DEFAULT;
+    }
+    mkdir(dir, 0755);
+    snprintf(bench_file_name, sizeof(bench_file_name), "%s/elog.log", dir);
+    Clean_Files();
+
+    memset(line, 'x', sizeof(line));
+    memcpy(line, "I/bench seq ", SEQ_POS);
+    line[SEQ_POS + SEQ_DIGITS] = ' ';
+    line[LINE_LEN - 1] = '\n';
+
+    elog_file_init();
+    total = Now_Ns();
+    for (i = 0; i < lines; i++)
+    {
+        Put_Seq(line, i);
+        t0 = Now_Ns();
+        elog_file_write(line, LINE_LEN);
+        t1 = Now_Ns();
+        dt = t1 - t0;
+        if (dt > max_ns)
+        {
+            max_ns = dt;
+        }
+        if (dt > 1e6)
+        {
+            slow++;
+        }
+    }
+    total = Now_Ns() - total;
+
+    nanosleep(&wait, NULL);
+    printf("last line in the file %d ms after the last write: %ld (written %lu)\n", 3 * ELOG_FILE_FLUSH_PERIOD,
+           Last_Seq(), lines - 1);
+    if (Last_Seq() != (long)lines - 1)
+    {
+        fail = 1;
+    }
+    /* 关闭文件时写出缓冲区，并等待后台轮转完成 */
+    elog_file_deinit();
+
+    printf("%lu lines of %d bytes in %.3f s: %.0f lines/s, %.1f MB/s\n", lines, LINE_LEN, total / 1e9,
+           lines / (total / 1e9), lines * (double)LINE_LEN / (total / 1e3));
+    printf("max write %.1f us, writes over 1 ms: %lu\n", max_ns / 1e3, slow);
+
+    /* 从最旧的文件读到当前文件：.4 ... .0，.rot (轮转出来还没移走的)，当前文件 */
+    for (n = ELOG_FILE_MAX_ROTATE - 1; n >= -2; n--)
+    {
+        File_Path(path, sizeof(path), (n >= 0) ? n : ((n == -1) ? ELOG_FILE_MAX_ROTATE : -1));
+        if (stat(path, &st) != 0)
+        {
+            continue;
+        }
+        files++;
+        if ((unsigned long)st.st_size > ELOG_FILE_MAX_SIZE + LINE_LEN)
+        {
+            oversize++;
+        }
+        fail |= Check_File(path, &next_seq, &bytes, &kept);
+    }
+    File_Path(path, sizeof(path), ELOG_FILE_MAX_ROTATE);
+    if (stat(path, &st) == 0)
+    {
+        printf("%s is left after deinit\n", path);
+        fail = 1;
+    }
+    printf("%d files, %lu bytes, %lu lines kept (seq %lu ~ %ld), over size: %lu\n", files, bytes, kept,
+           (unsigned long)(next_seq - (long)kept), next_seq - 1, oversize);
+    if (next_seq != (long)lines || files > ELOG_FILE_MAX_ROTATE + 1)
+    {
+        fail = 1;
+    }
+    printf("%s\n", fail ? "FAIL" : "PASS");
+    return fail;
+}
@@ -0,0 +1,16 @@
+#ifndef __ELOG_FILE_BENCH_CFG_H__
+#define __ELOG_FILE_BENCH_CFG_H__
+
+/* elog_file_bench 专用配置：4 MiB 一个文件，保留 5 个旧文件，后台线程轮转，每 100 ms 刷新一次 */
+#define ELOG_FILE_ENABLE
+
+extern char bench_file_name[];
+#define ELOG_FILE_NAME                 bench_file_name
+#define ELOG_FILE_MAX_SIZE             (4 * 1024 * 1024)
+#define ELOG_FILE_MAX_ROTATE           5
+#define ELOG_FILE_BUF_SIZE             (64 * 1024)
+#define ELOG_FILE_BUF_ALIGN            4096
+#define ELOG_FILE_FLUSH_PERIOD         100
+#define ELOG_FILE_PORT_USING_PTHREAD
+
+#endif //end __ELOG_FILE_BENCH_CFG_H__
@@ -0,0 +1,21 @@
+#ifndef __ELOG_FLASH_TEST_ELOG_H__
+#define __ELOG_FLASH_TEST_ELOG_H__
+
+/* elog_flash_test 专用：elog_flash.c 只用到错误码、断言、换行符和自己的提示日志 */
+#include <assert.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+typedef enum {
+    ELOG_NO_ERR,
+} ElogErrCode;
+
+#define ELOG_NEWLINE_SIGN "\n"
+#define ELOG_ASSERT(EXPR) assert(EXPR)
+#define elog_memcpy(dst, src, n) memcpy(dst, src, n)
+#define log_i(...) ((void)0)
+#define log_e(...) ((void)0)
+
+#endif //end __ELOG_FLASH_TEST_ELOG_H__
@@ -0,0 +1,303 @@
+/*
+ * EasyLogger Flash 日志掉电测试：在 PC 上用 RAM 模拟 Flash，检查 elog_flash.c 掉电后的恢复 (sector_recover)
+ *
+ * elog_flash.c / elog_flash_port.c 原样编译，ELOG_FLASH_PORT_USING_RAM 打开 port 里的 RAM Flash 模拟：
+ * 编程只能把 1 改成 0，统计每个扇区的擦除次数，elog_flash_ram_write_limit 限制还能编程的字数，
+ * 到 0 时编程/擦除失败，模拟掉电。本目录的 elog.h 代替 easylogger 的头文件。
+ * 扇区数和扇区大小可以在编译时指定 (用小扇区，几百次掉电也很快)：
+ *     gcc -O2 -I. -I../../Middlewares/Third_Party/easylogger/plugins/flash -DELOG_FLASH_PORT_USING_RAM
+ *         -DELOG_FLASH_SECTOR_NUM=4 -DELOG_FLASH_SECTOR_SIZE=4096 -o elog_flash_test elog_flash_test.c
+ *         ../../Middlewares/Third_Party/easylogger/plugins/flash/elog_flash.c
+ *         ../../Middlewares/Third_Party/easylogger/plugins/flash/elog_flash_port.c
+ *     ./elog_flash_test              300 次掉电
+ *     ./elog_flash_test 2000 7       2000 次掉电，随机数种子 7
+ * 扇区数 2~7 分别编译运行一遍。
+ *
+ * 每行日志的内容由序号决定，写成 "L<序号> <填充>\n"，写入前缓冲区放不下时先 flush，一条记录里都是整行。
+ * 1. 不掉电写满几轮环形扇区后 "重启" (再调用 elog_flash_init)：读回的日志是最后写入的一段，连续、逐字节正确，
+ *    保存的量不少于 (扇区数 - 1) 个扇区减去记录的零头，这期间各扇区擦除次数相差不超过 1
+ *    (掉电时扇区里一条完整的记录都没有，重启后会再擦一次这个扇区而不是擦掉最旧的扇区，所以累计次数不必相同)
+ * 2. 随机写入、随机 flush，中途随机设置剩余可编程字数 (可能掉在数据、记录头、扇区头或擦除上)，掉电后重启：
+ *    每一行完整正确，序号递增，flush 成功的行一条不少，只有掉电时还没 flush 完的行可能缺失；
+ *    重启后接着写，下一次检查时前面的内容仍然成立
+ * 3. 每次重启后随机取 elog_flash_output(index, size) 的一段，与整体读出的对应部分相同
+ * 有一项不符时返回非 0。
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "elog_flash.h"
+
+#define CUTS_DEFAULT 300
+#define LINE_MAX 128
+#define LOST_MAX 4096
+#define OUT_SIZE (ELOG_FLASH_SECTOR_NUM * ELOG_FLASH_SECTOR_SIZE + 16)
+
+extern uint32_t elog_flash_ram_erase_count[ELOG_FLASH_SECTOR_NUM];
+extern long elog_flash_ram_write_limit;
+
+static char out_buf[OUT_SIZE], all_buf[OUT_SIZE];
+static size_t out_len;
+/* 模型：下一行的序号，flush 成功的最大序号，RAM 缓冲里的字节数 */
+static long next_seq, confirmed_seq = -1;
+static size_t buf_used;
+/* 掉电时可能丢失的序号范围 */
+static long lost_lo[LOST_MAX], lost_hi[LOST_MAX];
+static int lost_num;
+
+/* ---------------- elog 移植接口 ---------------- */
+
+void elog_port_output(const char *log, size_t size)
+{
+    if (out_len + size <= sizeof(out_buf))
+    {
+        memcpy(out_buf + out_len, log, size);
+    }
+    out_len += size;
+}
+
+/* ---------------- 模型 ---------------- */
+
+static size_t Make_Line(long seq, char *line)
+{
+    int pad = (int)((seq * 37) % (LINE_MAX - 16)), n;
+
+    n = snprintf(line, LINE_MAX, "L%08ld ", seq);
+    memset(line + n, 'a' + (int)(seq % 26), (size_t)pad);
+    line[n + pad] = '\n';
+    return (size_t)(n + pad + 1);
+}
+
+static bool May_Lost(long seq)
+{
+    int i;
+
+    for (i = 0; i < lost_num; i++)
+    {
+        if (seq >= lost_lo[i] && seq <= lost_hi[i])
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/* 写一行，缓冲区放不下时先 flush；返回 false 表示掉电 */
+static bool Write_Line(void)
+{
+    char line[LINE_MAX];
+    size_t len = Make_Line(next_seq, line);
+
+    if (buf_used + len > ELOG_FLASH_BUF_SIZE)
+    {
+        elog_flash_flush();
+        if (elog_flash_ram_write_limit == 0)
+        {
+            return false;
+        }
+        confirmed_seq = next_seq - 1;
+        buf_used = 0;
+    }
+    elog_flash_write(line, len);
+    buf_used += len;
+    next_seq++;
+    return true;
+}
+
+static bool Flush(void)
+{
+    elog_flash_flush();
+    if (elog_flash_ram_write_limit == 0)
+    {
+        return false;
+    }
+    confirmed_seq = next_seq - 1;
+    buf_used = 0;
+    return true;
+}
+
+/* 重启：还没确认写入的行记为可能丢失 */
+static void Reboot(void)
+{
+    if (confirmed_seq + 1 <= next_seq - 1 && lost_num < LOST_MAX)
+    {
+        lost_lo[lost_num] = confirmed_seq + 1;
+        lost_hi[lost_num] = next_seq - 1;
+        lost_num++;
+    }
+    elog_flash_ram_write_limit = -1;
+    buf_used = 0;
+    elog_flash_init();
+}
+
+/* ---------------- 检查 ---------------- */
+
+static int Check(const char *when, size_t *saved)
+{
+    char line[LINE_MAX];
+    size_t used = elog_flash_get_used_size(), pos = 0, len, index, size, i;
+    long seq, last = -1, s;
+    char *nl;
+
+    out_len = 0;
+    elog_flash_output(0, used);
+    if (out_len != used + 1 || out_buf[used] != '\n')
+    {
+        printf("%s: output %lu bytes, used %lu\n", when, (unsigned long)out_len, (unsigned long)used);
+        return 1;
+    }
+    memcpy(all_buf, out_buf, used);
+    *saved = used;
+
+    while (pos < used)
+    {
+        nl = memchr(all_buf + pos, '\n', used - pos);
+        if (nl == NULL || all_buf[pos] != 'L')
+        {
+            printf("%s: broken line at %lu\n", when, (unsigned long)pos);
+            return 1;
+        }
+        seq = strtol(all_buf + pos + 1, NULL, 10);
+        len = Make_Line(seq, line);
+        if ((size_t)(nl - (all_buf + pos)) + 1 != len || memcmp(all_buf + pos, line, len) != 0)
+        {
+            printf("%s: line %ld is wrong\n", when, seq);
+            return 1;
+        }
+        if (last >= 0)
+        {
+            if (seq <= last)
+            {
+                printf("%s: line %ld after %ld\n", when, seq, last);
+                return 1;
+            }
+            for (s = last + 1; s < seq; s++)
+            {
+                if (!May_Lost(s))
+                {
+                    printf("%s: line %ld is lost\n", when, s);
+                    return 1;
+                }
+            }
+        }
+        last = seq;
+        pos += len;
+    }
+    /* flush 成功的行一条不少：最新的那行必须在 */
+    if (last < confirmed_seq)
+    {
+        printf("%s: last line %ld, %ld is flushed\n", when, last, confirmed_seq);
+        return 1;
+    }
+    if (last >= 0)
+    {
+        confirmed_seq = last;
+    }
+
+    /* 随机一段 */
+    for (i = 0; i < 8 && used > 0; i++)
+    {
+        index = (size_t)rand() % used;
+        size = 1 + (size_t)rand() % (used - index);
+        out_len = 0;
+        elog_flash_output(index, size);
+        if (out_len != size + 1 || memcmp(out_buf, all_buf + index, size) != 0)
+        {
+            printf("%s: output(%lu, %lu) differs\n", when, (unsigned long)index, (unsigned long)size);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/* 1. 不掉电：写满几轮 */
+static int Fill_Check(void)
+{
+    size_t saved, min_saved = (ELOG_FLASH_SECTOR_NUM - 1) * (ELOG_FLASH_SECTOR_SIZE - 2 * ELOG_FLASH_BUF_SIZE);
+    uint32_t erased[ELOG_FLASH_SECTOR_NUM], lo = 0xFFFFFFFF, hi = 0, n;
+    long start = next_seq;
+    int i, fail;
+
+    memcpy(erased, elog_flash_ram_erase_count, sizeof(erased));
+    while ((next_seq - start) * (LINE_MAX / 2) < 3L * ELOG_FLASH_SECTOR_NUM * ELOG_FLASH_SECTOR_SIZE)
+    {
+        Write_Line();
+    }
+    Flush();
+    Reboot();
+    fail = Check("fill", &saved);
+    for (i = 0; i < ELOG_FLASH_SECTOR_NUM; i++)
+    {
+        n = elog_flash_ram_erase_count[i] - erased[i];
+        lo = (n < lo) ? n : lo;
+        hi = (n > hi) ? n : hi;
+    }
+    printf("fill: %lu bytes saved (expect >= %lu), erased %u ~ %u times per sector\n", (unsigned long)saved,
+           (unsigned long)min_saved, lo, hi);
+    if (saved < min_saved || hi - lo > 1)
+    {
+        fail = 1;
+    }
+    return fail;
+}
+
+/* 2. 随机掉电 */
+static int Cut_Check(int cuts)
+{
+    char when[32];
+    size_t saved, saved_min = (size_t)-1, saved_max = 0;
+    long lines;
+    int cut;
+
+    for (cut = 0; cut < cuts; cut++)
+    {
+        /* 先正常写一段 */
+        lines = rand() % (3 * ELOG_FLASH_SECTOR_SIZE / (LINE_MAX / 2));
+        while (lines-- > 0)
+        {
+            Write_Line();
+            if (rand() % 8 == 0)
+            {
+                Flush();
+            }
+        }
+        /* 再限制剩余可编程的字数，写到掉电为止 */
+        elog_flash_ram_write_limit = rand() % (2 * ELOG_FLASH_BUF_SIZE / 4 + 8);
+        while (elog_flash_ram_write_limit != 0)
+        {
+            if (!Write_Line() || (rand() % 8 == 0 && !Flush()))
+            {
+                break;
+            }
+        }
+        Reboot();
+        snprintf(when, sizeof(when), "cut %d", cut);
+        if (Check(when, &saved))
+        {
+            return 1;
+        }
+        saved_min = (saved < saved_min) ? saved : saved_min;
+        saved_max = (saved > saved_max) ? saved : saved_max;
+    }
+    printf("%d power cuts: %lu ~ %lu bytes saved after reboot, %ld lines written, %d lost ranges\n", cuts,
+           (unsigned long)saved_min, (unsigned long)saved_max, next_seq, lost_num);
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    int cuts = (argc > 1) ? atoi(argv[1]) : CUTS_DEFAULT;
+    int fail;
+
+    srand((argc > 2) ? (unsigned)atoi(argv[2]) : 1U);
+    printf("%d sectors of %d bytes, buffer %d bytes\n", ELOG_FLASH_SECTOR_NUM, ELOG_FLASH_SECTOR_SIZE,
+           ELOG_FLASH_BUF_SIZE);
+    elog_flash_init();
+
+    fail = Fill_Check();
+    fail |= Cut_Check(cuts > 0 ? cuts : CUTS_DEFAULT);
+    /* 掉电之后再写满几轮，擦除仍然按顺序轮流 */
+    fail |= Fill_Check();
+    printf("%s\n", fail ? "FAIL" : "PASS");
+    return fail;
+}
@@ -0,0 +1,311 @@
+/*
+ * EasyLogger hexdump 测试：在 PC 上测量 elog_hexdump 每次调用的时间，并与改动之前的 snprintf 版本对比输出
+ *
+ * elog.c 原样编译，elog_port_xxx 和异步队列的两个行缓冲接口由本程序实现：
+ * 行缓冲用一个静态数组，放回时按行记下内容 (检查) 或只累加长度 (测量)。
+ * Hexdump_Ref 是改动之前的 elog_hexdump (每个字节一次 snprintf)，只把行缓冲换成本程序的数组。
+ *     gcc -O2 -I../../Middlewares/Third_Party/easylogger/inc -o elog_hexdump_bench elog_hexdump_bench.c
+ *         ../../Middlewares/Third_Party/easylogger/src/elog.c ../../Middlewares/Third_Party/easylogger/src/elog_utils.c
+ *     ./elog_hexdump_bench              测量 + 检查
+ *     ./elog_hexdump_bench 1000000      指定测量的调用次数 (默认 200000)
+ *
+ * 1. 测量 255 字节、每行 16 字节 (一帧最长的数据) 一次 hexdump 的时间，两个版本对比。
+ * 2. 随机数据、随机长度 (0~600)、每行 1~48 字节 (一行放得下) 时两个版本的输出逐字节相同；
+ *    每行 49~255 字节 (可能放不下) 时行数相同，每行不超过 ELOG_LINE_BUF_SIZE，是旧版本那一行的前缀 (在整字节处截断)。
+ * 有一项不符时返回非 0。
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "elog.h"
+
+#define BENCH_CALLS_DEFAULT 200000UL
+#define CHECK_ROUNDS 20000
+#define CHECK_OUT_SIZE (64 * 1024)
+
+static char line_buf[ELOG_LINE_BUF_SIZE];
+static char check_out[CHECK_OUT_SIZE];
+static size_t check_len;
+static int check_mode;
+static unsigned long bench_bytes;
+
+/* ---------------- elog 移植接口 ---------------- */
+
+ElogErrCode elog_port_init(void)
+{
+    return ELOG_NO_ERR;
+}
+
+void elog_port_deinit(void)
+{
+}
+
+void elog_port_output_lock(void)
+{
+}
+
+void elog_port_output_unlock(void)
+{
+}
+
+void elog_port_keep(uint8_t level, const char *log, size_t size)
+{
+    (void)level;
+    (void)log;
+    (void)size;
+}
+
+void elog_port_defer_output(uint32_t *record, size_t size, const void *data, size_t data_size)
+{
+    (void)record;
+    (void)size;
+    (void)data;
+    (void)data_size;
+}
+
+const char *elog_port_get_time(void)
+{
+    return "0.000";
+}
+
+uint64_t elog_port_get_timestamp(void)
+{
+    return 0;
+}
+
+const char *elog_port_get_p_info(void)
+{
+    return "";
+}
+
+const char *elog_port_get_t_info(void)
+{
+    return "";
+}
+
+ElogErrCode elog_async_init(void)
+{
+    return ELOG_NO_ERR;
+}
+
+void elog_async_deinit(void)
+{
+}
+
+void elog_async_enabled(bool enabled)
+{
+    (void)enabled;
+}
+
+char *elog_async_get_line_buf(void)
+{
+    return line_buf;
+}
+
+void elog_async_put_line_buf(uint8_t level, char *log, size_t size)
+{
+    (void)level;
+    if (!check_mode)
+    {
+        bench_bytes += size + (uint8_t)log[0];
+        return;
+    }
+    if (check_len + size <= sizeof(check_out))
+    {
+        memcpy(check_out + check_len, log, size);
+        check_len += size;
+    }
+}
+
+/* ---------------- 改动之前的版本 ---------------- */
+
+static void Hexdump_Ref(const char *name, uint8_t width, const void *buf, uint16_t size)
+{
+#define __is_print(ch)       ((unsigned int)((ch) - ' ') < 127u - ' ')
+
+    uint16_t i, j;
+    uint16_t log_len = 0;
+    const uint8_t *buf_p = buf;
+    char dump_string[8] = {0};
+    char *log_buf;
+    int fmt_result;
+
+    for (i = 0; i < size; i += width)
+    {
+        log_buf = elog_async_get_line_buf();
+        /* package header */
+        fmt_result = snprintf(log_buf, ELOG_LINE_BUF_SIZE, "D/HEX %s: %04X-%04X: ", name, i, i + width - 1);
+        /* calculate log length */
+        if ((fmt_result > -1) && (fmt_result <= ELOG_LINE_BUF_SIZE))
+        {
+            log_len = fmt_result;
+        }
+        else
+        {
+            log_len = ELOG_LINE_BUF_SIZE;
+        }
+        /* dump hex */
+        for (j = 0; j < width; j++)
+        {
+            if (i + j < size)
+            {
+                snprintf(dump_string, sizeof(dump_string), "%02X ", buf_p[i + j]);
+            }
+            else
+            {
+                strncpy(dump_string, "   ", sizeof(dump_string));
+            }
+            log_len += elog_strcpy(log_len, log_buf + log_len, dump_string);
+            if ((j + 1) % 8 == 0)
+            {
+                log_len += elog_strcpy(log_len, log_buf + log_len, " ");
+            }
+        }
+        log_len += elog_strcpy(log_len, log_buf + log_len, "  ");
+        /* dump char for hex */
+        for (j = 0; j < width; j++)
+        {
+            if (i + j < size)
+            {
+                snprintf(dump_string, sizeof(dump_string), "%c", __is_print(buf_p[i + j]) ? buf_p[i + j] : '.');
+                log_len += elog_strcpy(log_len, log_buf + log_len, dump_string);
+            }
+        }
+        /* overflow check and reserve some space for newline sign */
+        if (log_len + strlen(ELOG_NEWLINE_SIGN) > ELOG_LINE_BUF_SIZE)
+        {
+            log_len = ELOG_LINE_BUF_SIZE - strlen(ELOG_NEWLINE_SIGN);
+        }
+        /* package newline sign */
+        log_len += elog_strcpy(log_len, log_buf + log_len, ELOG_NEWLINE_SIGN);
+        /* do log output */
+        elog_async_put_line_buf(ELOG_LVL_DEBUG, log_buf, log_len);
+    }
+}
+
+/* ---------------- 测量 ---------------- */
+
+static double Now_Ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static void Bench(unsigned long calls)
+{
+    uint8_t frame[255];
+    unsigned long i;
+    double t0, t_new, t_ref;
+
+    for (i = 0; i < sizeof(frame); i++)
+    {
+        frame[i] = (uint8_t)(i * 37 + 11);
+    }
+    check_mode = 0;
+
+    t0 = Now_Ns();
+    for (i = 0; i < calls; i++)
+    {
+        elog_hexdump("rx", 16, frame, sizeof(frame));
+    }
+    t_new = (Now_Ns() - t0) / calls;
+
+    t0 = Now_Ns();
+    for (i = 0; i < calls; i++)
+    {
+        Hexdump_Ref("rx", 16, frame, sizeof(frame));
+    }
+    t_ref = (Now_Ns() - t0) / calls;
+
+    printf("255 bytes, width 16: table %.2f us/dump, snprintf %.2f us/dump (%.1fx)\n", t_new / 1e3, t_ref / 1e3,
+           t_ref / t_new);
+}
+
+/* ---------------- 输出检查 ---------------- */
+
+static int Check(void)
+{
+    static char ref_out[CHECK_OUT_SIZE];
+    uint8_t data[600];
+    size_t ref_len, pos, len, ref_pos, ref_line;
+    uint16_t size;
+    uint8_t width;
+    char *nl, *ref_nl;
+    int round, same = 0, cut = 0, fail = 0;
+
+    srand(1);
+    check_mode = 1;
+    for (round = 0; round < CHECK_ROUNDS && !fail; round++)
+    {
+        size = (uint16_t)(rand() % (sizeof(data) + 1));
+        width = (uint8_t)((round & 1) ? 1 + rand() % 48 : 49 + rand() % 207);
+        for (pos = 0; pos < size; pos++)
+        {
+            data[pos] = (uint8_t)rand();
+        }
+
+        check_len = 0;
+        Hexdump_Ref("chk", width, data, size);
+        ref_len = check_len;
+        memcpy(ref_out, check_out, ref_len);
+        check_len = 0;
+        elog_hexdump("chk", width, data, size);
+
+        if (width <= 48)
+        {
+            if (check_len != ref_len || memcmp(check_out, ref_out, ref_len) != 0)
+            {
+                printf("size %u width %u: output differs\n", size, width);
+                fail = 1;
+            }
+            same++;
+            continue;
+        }
+        /* 一行放不下：旧版本在行缓冲末尾截断 (可能截在一个字节中间)，新版本在整字节处截断，
+         * 所以每一行都是旧版本那一行的前缀，最多短 3 个字符 ("XX ") */
+        for (pos = 0, ref_pos = 0; pos < check_len && ref_pos < ref_len; pos += len + 1, ref_pos += ref_line + 1)
+        {
+            nl = memchr(check_out + pos, '\n', check_len - pos);
+            ref_nl = memchr(ref_out + ref_pos, '\n', ref_len - ref_pos);
+            if (nl == NULL || ref_nl == NULL)
+            {
+                break;
+            }
+            len = (size_t)(nl - (check_out + pos));
+            ref_line = (size_t)(ref_nl - (ref_out + ref_pos));
+            if (len + 1 > ELOG_LINE_BUF_SIZE || len > ref_line || ref_line - len > 3
+                    || memcmp(check_out + pos, ref_out + ref_pos, len) != 0)
+            {
+                printf("size %u width %u: bad cut line at %lu\n", size, width, (unsigned long)pos);
+                fail = 1;
+                break;
+            }
+        }
+        if (!fail && (pos != check_len || ref_pos != ref_len))
+        {
+            printf("size %u width %u: line count differs\n", size, width);
+            fail = 1;
+        }
+        cut++;
+    }
+    printf("output check: %d identical to snprintf version, %d long line cuts\n", same, cut);
+    return fail;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned long calls = (argc > 1) ? strtoul(argv[1], NULL, 0) : BENCH_CALLS_DEFAULT;
+    int fail;
+
+    elog_init();
+    elog_set_filter_lvl(ELOG_LVL_VERBOSE);
+    elog_start();
+
+    Bench(calls ? calls : BENCH_CALLS_DEFAULT);
+    fail = Check();
+    printf("%s\n", fail ? "FAIL" : "PASS");
+    return fail;
+}
@@ -0,0 +1,388 @@
+/*
+ * EasyLogger 调用点缓存测试：在 PC 上测量 elog.c 过滤调用的开销，并检查变量 tag 调用点的结果
+ *
+ * elog.c 原样编译，elog_port_xxx 和异步队列的两个行缓冲接口由本程序实现：
+ * 行缓冲用线程局部数组，输出只按 tag 计数，时间戳默认每次前进 1 秒 (速率限制总是有令牌)。
+ *     gcc -O2 -pthread -I../../Middlewares/Third_Party/easylogger/inc -o elog_site_bench elog_site_bench.c
+ *         ../../Middlewares/Third_Party/easylogger/src/elog.c ../../Middlewares/Third_Party/easylogger/src/elog_utils.c
+ *     ./elog_site_bench              测量 + 检查
+ *     ./elog_site_bench 100000000    指定测量的调用次数 (默认 20000000)
+ *
+ * 1. 测量被过滤掉的 log_d 每次调用的时间：
+ *        固定 tag 的调用点 (缓存命中)、变量 tag 的调用点 (按 tag 地址缓存)、
+ *        不用缓存直接查过滤表 (elog_get_filter_tag_lvl + strstr，缓存之前每次调用的开销)，
+ *    以及一条通过过滤、完整格式化的日志，作对比。
+ * 2. 两个线程用同一个辅助函数 (类似 Latency_Print(tag)) 交替输出打开和关闭的 tag，
+ *    打开的 tag 一条不少，关闭的 tag 一条不出；中途修改过滤等级后按新等级过滤；
+ *    内容相同、地址不同的 32 个 tag (多于 tag 缓存的项数，一定有冲突) 同样按过滤等级输出。
+ * 3. 速率限制 (时间戳停住)：普通调用点连续输出 (类似 HELP) 一条不少；elog_limited 调用点只出一个桶 (10 条)，
+ *    被合并的重复行不消耗令牌，等长的不同消息不会被合并，时间戳跨过 32 位微秒回绕后桶照样加满。
+ * 有一项不符时返回非 0。
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include "elog.h"
+
+#define BENCH_CALLS_DEFAULT 20000000UL
+#define RACE_CALLS 200000UL
+#define TAG_COPIES 32
+
+static pthread_mutex_t port_lock;
+static __thread char line_buf[ELOG_LINE_BUF_SIZE];
+static unsigned long out_on, out_off, out_lim, out_other;
+static uint64_t sim_timestamp;
+static uint64_t sim_step = 1000000U;
+static char tag_copies[TAG_COPIES][4];
+
+/* ---------------- elog 移植接口 ---------------- */
+
+ElogErrCode elog_port_init(void)
+{
+    pthread_mutexattr_t attr;
+
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&port_lock, &attr);
+    return ELOG_NO_ERR;
+}
+
+void elog_port_deinit(void)
+{
+}
+
+void elog_port_output_lock(void)
+{
+    pthread_mutex_lock(&port_lock);
+}
+
+void elog_port_output_unlock(void)
+{
+    pthread_mutex_unlock(&port_lock);
+}
+
+void elog_port_keep(uint8_t level, const char *log, size_t size)
+{
+    (void)level;
+    (void)log;
+    (void)size;
+}
+
+void elog_port_defer_output(uint32_t *record, size_t size, const void *data, size_t data_size)
+{
+    (void)record;
+    (void)size;
+    (void)data;
+    (void)data_size;
+}
+
+const char *elog_port_get_time(void)
+{
+    return "0.000";
+}
+
+uint64_t elog_port_get_timestamp(void)
+{
+    /* 在输出锁外调用，检查速率限制时只有一个线程 */
+    sim_timestamp += sim_step;
+    return sim_timestamp;
+}
+
+const char *elog_port_get_p_info(void)
+{
+    return "";
+}
+
+const char *elog_port_get_t_info(void)
+{
+    return "";
+}
+
+ElogErrCode elog_async_init(void)
+{
+    return ELOG_NO_ERR;
+}
+
+void elog_async_deinit(void)
+{
+}
+
+void elog_async_enabled(bool enabled)
+{
+    (void)enabled;
+}
+
+char *elog_async_get_line_buf(void)
+{
+    return line_buf;
+}
+
+void elog_async_put_line_buf(uint8_t level, char *log, size_t size)
+{
+    size_t tag_len;
+    const char *tag;
+    char *notice;
+
+    if (size == 0)
+    {
+        return;
+    }
+    /* 前面带着 "last message repeated N times" 的行，tag 在第二行 */
+    notice = (strncmp(log, "last message", 12) == 0) ? memchr(log, '\n', size) : NULL;
+    if (notice)
+    {
+        size -= (size_t)(notice + 1 - log);
+        log = notice + 1;
+    }
+    tag = elog_find_tag(log, level, &tag_len);
+    pthread_mutex_lock(&port_lock);
+    if (tag && tag_len == 2 && memcmp(tag, "on", 2) == 0)
+    {
+        out_on++;
+    }
+    else if (tag && tag_len == 3 && memcmp(tag, "off", 3) == 0)
+    {
+        out_off++;
+    }
+    else if (tag && tag_len == 3 && memcmp(tag, "lim", 3) == 0)
+    {
+        out_lim++;
+    }
+    else
+    {
+        out_other++;
+    }
+    pthread_mutex_unlock(&port_lock);
+}
+
+/* ---------------- 测量 ---------------- */
+
+static double Now_Ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* 变量 tag 的辅助函数，同一个调用点会收到不同的 tag */
+static void __attribute__((noinline)) Bench_Print(const char *tag, unsigned long n)
+{
+    elog_d(tag, "n %lu", n);
+}
+
+static void __attribute__((noinline)) Bench_Fixed(unsigned long n)
+{
+    elog_d("bench", "n %lu", n);
+}
+
+static bool __attribute__((noinline)) Bench_Uncached(const char *tag, uint8_t level)
+{
+    uint8_t tag_lvl = elog_get_filter_tag_lvl(tag);
+
+    return strstr(tag, "") != NULL && level <= tag_lvl;
+}
+
+static void Bench(unsigned long calls)
+{
+    const char *volatile tags[2] = { "bench", "bench2" };
+    volatile unsigned long hits = 0;
+    unsigned long i;
+    double t0;
+
+    elog_set_filter_tag_lvl("bench", ELOG_LVL_INFO);
+    elog_set_filter_tag_lvl("bench2", ELOG_LVL_INFO);
+
+    t0 = Now_Ns();
+    for (i = 0; i < calls; i++)
+    {
+        Bench_Fixed(i);
+    }
+    printf("filtered, fixed tag     : %6.2f ns/call\n", (Now_Ns() - t0) / calls);
+
+    t0 = Now_Ns();
+    for (i = 0; i < calls; i++)
+    {
+        Bench_Print(tags[i & 1], i);
+    }
+    printf("filtered, variable tag  : %6.2f ns/call\n", (Now_Ns() - t0) / calls);
+
+    t0 = Now_Ns();
+    for (i = 0; i < calls; i++)
+    {
+        hits += Bench_Uncached(tags[0], ELOG_LVL_DEBUG);
+    }
+    printf("filtered, no cache      : %6.2f ns/call\n", (Now_Ns() - t0) / calls);
+
+    calls /= 20;
+    t0 = Now_Ns();
+    for (i = 0; i < calls; i++)
+    {
+        Bench_Print("on", i);
+    }
+    printf("output (formatted)      : %6.2f ns/call\n", (Now_Ns() - t0) / calls);
+    out_on = 0;
+    (void)hits;
+}
+
+/* ---------------- 变量 tag 检查 ---------------- */
+
+static void *Race_Thread(void *arg)
+{
+    unsigned long id = (unsigned long)(uintptr_t)arg, i;
+
+    /* 两个线程的消息不同，不会被当作重复行合并 */
+    for (i = 0; i < RACE_CALLS; i++)
+    {
+        Bench_Print((i & 1) ? "off" : "on", i * 2 + id);
+    }
+    return NULL;
+}
+
+static int Race_Check(void)
+{
+    pthread_t th[2];
+    unsigned long i;
+    int fail = 0;
+
+    elog_set_filter_tag_lvl("on", ELOG_LVL_DEBUG);
+    elog_set_filter_tag_lvl("off", ELOG_LVL_INFO);
+    out_on = out_off = out_other = 0;
+    for (i = 0; i < 2; i++)
+    {
+        pthread_create(&th[i], NULL, Race_Thread, (void *)(uintptr_t)i);
+    }
+    for (i = 0; i < 2; i++)
+    {
+        pthread_join(th[i], NULL);
+    }
+    printf("variable tag: on %lu (expect %lu), off %lu (expect 0)\n", out_on, RACE_CALLS, out_off);
+    if (out_on != RACE_CALLS || out_off != 0 || out_other != 0)
+    {
+        fail = 1;
+    }
+
+    /* 修改过滤等级：打开的关掉，关闭的打开 */
+    elog_set_filter_tag_lvl("on", ELOG_LVL_INFO);
+    elog_set_filter_tag_lvl("off", ELOG_LVL_DEBUG);
+    out_on = out_off = 0;
+    for (i = 0; i < 100; i++)
+    {
+        Bench_Print((i & 1) ? "off" : "on", i);
+    }
+    printf("after filter change: on %lu (expect 0), off %lu (expect 50)\n", out_on, out_off);
+    if (out_on != 0 || out_off != 50)
+    {
+        fail = 1;
+    }
+
+    /* 地址不同的 tag，有的共用 tag 缓存的一项 */
+    for (i = 0; i < TAG_COPIES; i++)
+    {
+        strcpy(tag_copies[i], (i & 1) ? "off" : "on");
+    }
+    out_on = out_off = 0;
+    for (i = 0; i < 100 * TAG_COPIES; i++)
+    {
+        Bench_Print(tag_copies[i % TAG_COPIES], i);
+    }
+    printf("%d tag copies: on %lu (expect 0), off %lu (expect %d)\n", TAG_COPIES, out_on, out_off,
+           50 * TAG_COPIES);
+    if (out_on != 0 || out_off != 50UL * TAG_COPIES)
+    {
+        fail = 1;
+    }
+    return fail;
+}
+
+/* ---------------- 速率限制检查 ---------------- */
+
+static void __attribute__((noinline)) Limit_Print(const char *msg)
+{
+    elog_limited_i("lim", "%s", msg);
+}
+
+static int Limit_Expect(const char *what, unsigned long got, unsigned long expect)
+{
+    printf("%-40s: %lu (expect %lu)\n", what, got, expect);
+    return got != expect;
+}
+
+static int Limit_Check(void)
+{
+    char msg[16];
+    unsigned long i;
+    int fail = 0;
+
+    elog_set_filter_tag_lvl("cli", ELOG_LVL_DEBUG);
+    elog_set_filter_tag_lvl("lim", ELOG_LVL_DEBUG);
+    sim_step = 0;
+
+    /* 普通调用点不限流 */
+    out_other = 0;
+    for (i = 0; i < 100; i++)
+    {
+        elog_i("cli", "help line %lu", i);
+    }
+    fail |= Limit_Expect("normal site, 100 lines at once", out_other, 100);
+
+    /* 限流调用点只出一个桶 */
+    out_lim = 0;
+    for (i = 0; i < 30; i++)
+    {
+        snprintf(msg, sizeof(msg), "n %02lu", i);
+        Limit_Print(msg);
+    }
+    fail |= Limit_Expect("limited site, 30 lines at once", out_lim, ELOG_RATE_LIMIT_BURST);
+
+    /* 桶加满后：重复行被合并且不消耗令牌，之后还能出 BURST - 1 条不同的行 (长度相同) */
+    sim_timestamp += (uint64_t)ELOG_RATE_LIMIT_BURST * ELOG_RATE_LIMIT_PERIOD_MS * 1000U;
+    out_lim = 0;
+    for (i = 0; i < 30; i++)
+    {
+        Limit_Print("same");
+    }
+    for (i = 0; i < 20; i++)
+    {
+        snprintf(msg, sizeof(msg), "x %02lu", i);
+        Limit_Print(msg);
+    }
+    fail |= Limit_Expect("30 repeats + 20 different lines", out_lim, ELOG_RATE_LIMIT_BURST);
+
+    /* 空桶，时间前进 2^32 us + 50 us：32 位差值只有 50 us，64 位时间戳加满桶 */
+    sim_timestamp += (1ULL << 32) + 50U;
+    out_lim = 0;
+    for (i = 0; i < 30; i++)
+    {
+        snprintf(msg, sizeof(msg), "w %02lu", i);
+        Limit_Print(msg);
+    }
+    fail |= Limit_Expect("after 2^32 us idle, 30 lines at once", out_lim, ELOG_RATE_LIMIT_BURST);
+
+    sim_step = 1000000U;
+    return fail;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned long calls = (argc > 1) ? strtoul(argv[1], NULL, 0) : BENCH_CALLS_DEFAULT;
+    uint8_t level;
+    int fail;
+
+    elog_init();
+    /* elog_find_tag 要求每个等级都输出 tag */
+    for (level = ELOG_LVL_ASSERT; level <= ELOG_LVL_VERBOSE; level++)
+    {
+        elog_set_fmt(level, ELOG_FMT_LVL | ELOG_FMT_TAG);
+    }
+    elog_set_filter_lvl(ELOG_LVL_VERBOSE);
+    elog_start();
+
+    Bench(calls ? calls : BENCH_CALLS_DEFAULT);
+    fail = Race_Check();
+    fail |= Limit_Check();
+    printf("%s\n", fail ? "FAIL" : "PASS");
+    return fail;
+}
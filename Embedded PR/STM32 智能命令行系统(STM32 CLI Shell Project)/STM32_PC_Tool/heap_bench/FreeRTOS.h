@@ -0,0 +1,57 @@
+#ifndef __HEAP_BENCH_FREERTOS_H__
+#define __HEAP_BENCH_FREERTOS_H__
+
+/* heap_bench 专用：只提供 heap_4.c / heap_tlsf.c 用到的定义，让堆实现原样在 PC 上编译 */
+#include <stdint.h>
+#include <stddef.h>
+#include <assert.h>
+
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+#define pdFALSE ((BaseType_t)0)
+#define pdTRUE ((BaseType_t)1)
+
+/* 堆大小与固件 FreeRTOSConfig.h 的两种配置一致：APP_STATIC_ALLOCATION 为 1 (固件当前设置) 时 1024，
+ * 为 0 (任务和内核对象从堆创建) 时 15360；改了固件里的数值要同步改这里 */
+#ifndef APP_STATIC_ALLOCATION
+#define APP_STATIC_ALLOCATION 1
+#endif
+#ifndef configTOTAL_HEAP_SIZE
+#if APP_STATIC_ALLOCATION
+#define configTOTAL_HEAP_SIZE ((size_t)1024)
+#else
+#define configTOTAL_HEAP_SIZE ((size_t)15360)
+#endif
+#endif
+#define configSUPPORT_DYNAMIC_ALLOCATION 1
+#define configAPPLICATION_ALLOCATED_HEAP 0
+#define configUSE_MALLOC_FAILED_HOOK 0
+#define configASSERT(x) assert(x)
+
+#define portBYTE_ALIGNMENT 8
+#define portBYTE_ALIGNMENT_MASK (0x0007)
+#define portMAX_DELAY ((size_t)-1)
+
+#define mtCOVERAGE_TEST_MARKER()
+#define traceMALLOC(pvAddress, uiSize)
+#define traceFREE(pvAddress, uiSize)
+
+typedef struct xHeapStats
+{
+    size_t xAvailableHeapSpaceInBytes;
+    size_t xSizeOfLargestFreeBlockInBytes;
+    size_t xSizeOfSmallestFreeBlockInBytes;
+    size_t xNumberOfFreeBlocks;
+    size_t xMinimumEverFreeBytesRemaining;
+    size_t xNumberOfSuccessfulAllocations;
+    size_t xNumberOfSuccessfulFrees;
+} HeapStats_t;
+
+void *pvPortMalloc(size_t xSize);
+void vPortFree(void *pv);
+size_t xPortGetFreeHeapSize(void);
+size_t xPortGetMinimumEverFreeHeapSize(void);
+void vPortGetHeapStats(HeapStats_t *pxHeapStats);
+
+#endif //end __HEAP_BENCH_FREERTOS_H__
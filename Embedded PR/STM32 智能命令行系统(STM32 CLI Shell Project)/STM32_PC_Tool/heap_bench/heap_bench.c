@@ -0,0 +1,296 @@
+/*
+ * 堆分配器对比工具：在 PC 上回放固件记录的分配序列，比较 heap_4 与 heap_tlsf
+ *
+ * 堆实现的源文件原样编译，本目录的 FreeRTOS.h / task.h 只提供它们用到的定义，
+ * 每种堆各编译一个程序：
+ *     gcc -O2 -I. -o bench_heap4 heap_bench.c ../../Middlewares/Third_Party/FreeRTOS/Source/portable/MemMang/heap_4.c
+ *     gcc -O2 -I. -o bench_tlsf heap_bench.c ../../Middlewares/Third_Party/FreeRTOS/Source/portable/MemMang/heap_tlsf.c
+ * 堆大小默认与固件当前配置 (APP_STATIC_ALLOCATION 为 1) 一样是 1024 字节；
+ * 加 -DAPP_STATIC_ALLOCATION=0 按动态创建时的 15360 字节编译，-DconfigTOTAL_HEAP_SIZE=n 指定任意大小。
+ *
+ * 分配序列来自 RTT 事件追踪 (TRACE ON 后用 JLinkRTTLogger 抓取通道 1)：
+ *     python trace_decode.py trace.bin --heap heap.txt
+ *     ./bench_heap4 heap.txt
+ *     ./bench_tlsf heap.txt
+ * 不给文件时使用内置的随机序列 (按固件里常见的对象大小生成，固定种子，两次运行完全相同)。
+ * 随机序列模拟的是任务和内核对象都从堆创建的情况，峰值约 13KB，要用 -DAPP_STATIC_ALLOCATION=0 编译；
+ * 1024 字节的堆只用来回放静态模式下抓到的序列。
+ *
+ * 输出：每次 malloc/free 的平均、99% 和最坏耗时 (已扣除计时本身的开销)，
+ *       分配失败次数、峰值用量、回放过程中的最大碎片率 (1 - 最大空闲块/空闲总量)。
+ * PC 上的指针是 64 位，块头比固件大，字节数只用于两种堆之间的相对比较。
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "FreeRTOS.h"
+
+#define MAX_OPS 200000      // 分配序列最大长度
+#define SLOT_NUM 65536      // 块编号是地址>>3 的低16位
+#define RANDOM_OPS 100000   // 内置序列长度
+#define RANDOM_LIVE 48      // 内置序列同时存在的最多块数
+#define FRAG_SAMPLE 16      // 每隔多少次操作采样一次碎片率
+
+typedef struct
+{
+    char op;        // 'm' 分配, 'f' 释放, 'x' 固件上分配失败的申请
+    uint16_t slot;  // 块编号
+    uint32_t size;  // 申请字节数
+} Heap_Op_t;
+
+typedef struct
+{
+    double total;   // 累计耗时 (ns)
+    double max;     // 最坏耗时 (ns)
+    unsigned count;
+    float *samples; // 每次的耗时，用于求 99% 分位
+} Bench_Time_t;
+
+// heap_tlsf.c 才有分级缓存统计，heap_4 下这个符号为空
+extern BaseType_t xPortGetHeapPoolStats(UBaseType_t uxClass, size_t *pxBlockSize, size_t *pxCachedBlocks,
+                                        size_t *pxHits, size_t *pxMisses) __attribute__((weak));
+
+static Heap_Op_t ops[MAX_OPS];
+static void *live[SLOT_NUM];
+static double timer_overhead;
+
+static double now_ns(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/**
+ * @brief 读取 trace_decode.py --heap 导出的文本
+ * @return 操作条数
+ */
+static unsigned load_trace(const char *path)
+{
+    FILE *f = fopen(path, "r");
+    char line[64];
+    unsigned n = 0, slot, size;
+    char op;
+
+    if (NULL == f)
+    {
+        perror(path);
+        exit(1);
+    }
+    while (n < MAX_OPS && NULL != fgets(line, sizeof(line), f))
+    {
+        if (3 == sscanf(line, " %c %u %u", &op, &slot, &size) && NULL != strchr("mfx", op))
+        {
+            ops[n].op = op;
+            ops[n].slot = (uint16_t)slot;
+            ops[n].size = size;
+            n++;
+        }
+    }
+    fclose(f);
+    return n;
+}
+
+/**
+ * @brief 生成内置序列：内核对象、消息缓冲区和偶尔的任务栈混合申请/释放
+ * @return 操作条数
+ */
+static unsigned gen_random(void)
+{
+    static const uint32_t common[] = {80, 80, 92, 24, 32, 48, 64, 64, 128, 200, 256, 512};
+    uint32_t seed = 12345;
+    uint8_t used[RANDOM_LIVE] = {0};
+    unsigned n, i;
+    uint32_t r;
+
+    for (n = 0; n < RANDOM_OPS; n++)
+    {
+        seed = seed * 1103515245U + 12345U;
+        r = seed >> 8;
+        i = r % RANDOM_LIVE;
+        ops[n].slot = (uint16_t)i;
+        if (used[i])
+        {
+            ops[n].op = 'f';
+            ops[n].size = 0;
+            used[i] = 0;
+            continue;
+        }
+        ops[n].op = 'm';
+        r >>= 6;
+        if (0 == r % 20)
+        {
+            ops[n].size = 512 + (r >> 5) % 1536; // 任务栈
+        }
+        else if (0 == r % 3)
+        {
+            ops[n].size = 8 + (r >> 5) % 120;    // 零散的小缓冲区
+        }
+        else
+        {
+            ops[n].size = common[(r >> 5) % (sizeof(common) / sizeof(common[0]))];
+        }
+        used[i] = 1;
+    }
+    return n;
+}
+
+static void time_add(Bench_Time_t *t, double ns)
+{
+    ns -= timer_overhead;
+    if (ns < 0)
+    {
+        ns = 0;
+    }
+    t->total += ns;
+    if (ns > t->max)
+    {
+        t->max = ns;
+    }
+    t->samples[t->count++] = (float)ns;
+}
+
+static int cmp_float(const void *a, const void *b)
+{
+    float x = *(const float *)a, y = *(const float *)b;
+    return (x > y) - (x < y);
+}
+
+static void time_print(const char *name, Bench_Time_t *t)
+{
+    if (0 == t->count)
+    {
+        printf("%-7s no samples\n", name);
+        return;
+    }
+    qsort(t->samples, t->count, sizeof(float), cmp_float);
+    printf("%-7s %8u ops, avg %6.1f ns, p99 %6.1f ns, max %8.1f ns\n", name, t->count, t->total / t->count,
+           t->samples[(size_t)(t->count * 0.99)], t->max);
+}
+
+/**
+ * @brief 计时器自身的开销：取多次空测量的最小值
+ */
+static double calibrate(void)
+{
+    double best = 1e9, t0;
+    int i;
+
+    for (i = 0; i < 10000; i++)
+    {
+        t0 = now_ns();
+        t0 = now_ns() - t0;
+        if (t0 < best)
+        {
+            best = t0;
+        }
+    }
+    return best;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned n, i, pass, passes = 20, failed = 0, unknown = 0;
+    Bench_Time_t t_malloc = {0}, t_free = {0};
+    HeapStats_t stats;
+    double t0, frag, frag_max = 0;
+    size_t block_size, cached, hits, misses;
+    UBaseType_t c;
+    void *p;
+
+    if (argc > 2)
+    {
+        passes = (unsigned)atoi(argv[2]);
+    }
+    n = (argc > 1 && 0 != strcmp(argv[1], "-")) ? load_trace(argv[1]) : gen_random();
+    if (0 == n || 0 == passes)
+    {
+        printf("usage: %s [heap.txt|-] [passes]\n", argv[0]);
+        return 1;
+    }
+    timer_overhead = calibrate();
+    t_malloc.samples = malloc(sizeof(float) * (size_t)n * passes);
+    t_free.samples = malloc(sizeof(float) * ((size_t)n + SLOT_NUM) * passes);
+
+    // 每一遍从空堆状态开始 (上一遍结束时释放全部存活的块)，堆本身不重新初始化，和固件长时间运行一样
+    for (pass = 0; pass < passes; pass++)
+    {
+        for (i = 0; i < n; i++)
+        {
+            Heap_Op_t *op = &ops[i];
+
+            if ('f' == op->op)
+            {
+                if (NULL == live[op->slot])
+                {
+                    unknown++; // 追踪开始前分配的块
+                    continue;
+                }
+                t0 = now_ns();
+                vPortFree(live[op->slot]);
+                time_add(&t_free, now_ns() - t0);
+                live[op->slot] = NULL;
+            }
+            else
+            {
+                if (NULL != live[op->slot])
+                {
+                    vPortFree(live[op->slot]); // 漏掉了释放记录 (通道满丢弃)，先还掉旧块
+                }
+                t0 = now_ns();
+                p = pvPortMalloc(op->size);
+                time_add(&t_malloc, now_ns() - t0);
+                if (NULL == p)
+                {
+                    failed++;
+                }
+                else if ('x' == op->op)
+                {
+                    vPortFree(p); // 固件上失败的申请只看这里能不能成功
+                    p = NULL;
+                }
+                live[op->slot] = p;
+            }
+
+            if (0 == i % FRAG_SAMPLE)
+            {
+                vPortGetHeapStats(&stats);
+                frag = (0 == stats.xAvailableHeapSpaceInBytes) ? 0
+                       : 1.0 - (double)stats.xSizeOfLargestFreeBlockInBytes / stats.xAvailableHeapSpaceInBytes;
+                if (frag > frag_max)
+                {
+                    frag_max = frag;
+                }
+            }
+        }
+        for (i = 0; i < SLOT_NUM; i++)
+        {
+            if (NULL != live[i])
+            {
+                t0 = now_ns();
+                vPortFree(live[i]);
+                time_add(&t_free, now_ns() - t0);
+                live[i] = NULL;
+            }
+        }
+    }
+
+    vPortGetHeapStats(&stats);
+    printf("heap %s, %lu bytes, %u ops x %u passes (%s)\n", (NULL != xPortGetHeapPoolStats) ? "heap_tlsf" : "heap_4",
+           (unsigned long)configTOTAL_HEAP_SIZE, n, passes, (argc > 1 && 0 != strcmp(argv[1], "-")) ? argv[1] : "random");
+    time_print("malloc", &t_malloc);
+    time_print("free", &t_free);
+    printf("failed %u, unmatched free %u\n", failed, unknown / passes);
+    printf("peak used %lu bytes, max fragmentation %.1f%%\n",
+           (unsigned long)(stats.xAvailableHeapSpaceInBytes - stats.xMinimumEverFreeBytesRemaining), frag_max * 100);
+    if (NULL != xPortGetHeapPoolStats)
+    {
+        for (c = 0; pdTRUE == xPortGetHeapPoolStats(c, &block_size, &cached, &hits, &misses); c++)
+        {
+            printf("pool %4lu: hit %lu, miss %lu\n", (unsigned long)block_size, (unsigned long)hits, (unsigned long)misses);
+        }
+    }
+    return 0;
+}
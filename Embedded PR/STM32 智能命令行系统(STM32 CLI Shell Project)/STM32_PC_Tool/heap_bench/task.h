@@ -0,0 +1,10 @@
+#ifndef __HEAP_BENCH_TASK_H__
+#define __HEAP_BENCH_TASK_H__
+
+/* heap_bench 是单线程程序，挂起调度器和临界区什么都不用做 */
+static inline void vTaskSuspendAll(void) {}
+static inline BaseType_t xTaskResumeAll(void) { return pdFALSE; }
+#define taskENTER_CRITICAL()
+#define taskEXIT_CRITICAL()
+
+#endif //end __HEAP_BENCH_TASK_H__
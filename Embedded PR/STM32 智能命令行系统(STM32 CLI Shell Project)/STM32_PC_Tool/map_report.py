@@ -0,0 +1,105 @@
+"""
+Keil 链接 map 文件内存报告工具
+
+从 armlink 生成的 .map 文件中提取：
+    1. 各执行区 (ER_IROM1 / ER_ELOG_FMT / RW_IRAM1 / RW_NOINIT) 的已用大小、上限和占用率
+    2. 按目标文件统计的 RAM 占用 (RW Data + ZI Data)
+    3. RAM 中最大的变量 (任务栈、控制块、缓冲区、FreeRTOS 堆 ucHeap 等)
+固件打开 APP_STATIC_ALLOCATION 后，任务栈和控制块都是有名字的静态变量，
+第 3 项就是完整的 SRAM 预算，不再有藏在堆里的部分。
+
+map 文件由 Keil 工程 Options -> Listing 中的 Linker Listing 生成 (工程已勾选 Memory Map、
+Symbols 和 Size Info)，每次编译后在 Listing 目录更新：
+    python map_report.py "STM32 CLI Shell.map"
+    python map_report.py "STM32 CLI Shell.map" --top 30
+"""
+import argparse
+import re
+import sys
+
+RAM_START = 0x20000000
+RAM_END = 0x20020000  # STM32F411: 128KB SRAM
+
+REGION = re.compile(r"^\s*(Load|Execution) Region (\S+) \((?:Exec base|Base): (0x[0-9a-fA-F]+).*?Size: (0x[0-9a-fA-F]+), "
+                    r"Max: (0x[0-9a-fA-F]+)(.*)\)")
+SYMBOL = re.compile(r"^\s+(\S+)\s+(0x[0-9a-fA-F]+)\s+(Data|Thumb Code|ARM Code|Section|Number)\s+(\d+)\s+(\S+)")
+COMPONENT = re.compile(r"^\s+(\d+)\s+(\d+)\s+(\d+)\s+(\d+)\s+(\d+)\s+(\d+)\s+(\S.*?)\s*$")
+
+
+def parse(lines):
+    """解析 map 文件，返回 (执行区列表, 目标文件列表, RAM 变量列表)"""
+    regions = []
+    objects = []
+    symbols = {}
+    part = None
+    for line in lines:
+        if "Image component sizes" in line:
+            part = "sizes"
+        elif "Image Symbol Table" in line:
+            part = "symbols"
+        elif "Memory Map of the image" in line:
+            part = "map"
+        elif "Library Totals" in line or "Grand Totals" in line:
+            part = None
+
+        m = REGION.match(line)
+        if m:
+            kind, name, base, size, limit, attr = m.groups()
+            if kind == "Execution":
+                regions.append((name, int(base, 16), int(size, 16), int(limit, 16), "UNINIT" in attr))
+            continue
+
+        if part == "sizes":
+            m = COMPONENT.match(line)
+            if m and not m.group(7).endswith("Totals") and not m.group(7).startswith("("):
+                code, _, ro, rw, zi, _, name = m.groups()
+                objects.append((name, int(code), int(ro), int(rw), int(zi)))
+        elif part == "symbols":
+            m = SYMBOL.match(line)
+            if m and m.group(3) == "Data":
+                name, value, _, size, obj = m.groups()
+                addr, size = int(value, 16), int(size)
+                if RAM_START <= addr < RAM_END and size:
+                    # 同一个变量可能同时出现在局部和全局符号表里
+                    symbols[(addr, name)] = (name, addr, size, obj)
+    return regions, objects, sorted(symbols.values(), key=lambda s: -s[2])
+
+
+def report(regions, objects, symbols, top, out):
+    out.write("%-12s %-10s %10s %10s %7s\n" % ("Region", "Base", "Used", "Max", "Use%"))
+    for name, base, size, limit, uninit in regions:
+        out.write("%-12s 0x%08X %10d %10d %6.1f%%%s\n" % (name, base, size, limit, 100.0 * size / limit if limit else 0,
+                                                         " (UNINIT)" if uninit else ""))
+    ram = sum(size for _, base, size, _, _ in regions if RAM_START <= base < RAM_END)
+    out.write("RAM used: %d of %d bytes\n\n" % (ram, RAM_END - RAM_START))
+
+    if objects:
+        out.write("RAM by object (RW + ZI):\n")
+        for name, code, ro, rw, zi in sorted(objects, key=lambda o: -(o[3] + o[4]))[:top]:
+            if rw + zi:
+                out.write("  %8d  %s\n" % (rw + zi, name))
+        out.write("\n")
+
+    if symbols:
+        out.write("Largest RAM variables:\n")
+        for name, addr, size, obj in symbols[:top]:
+            out.write("  %8d  0x%08X  %-32s %s\n" % (size, addr, name, obj))
+    else:
+        out.write("No data symbols found, enable Symbols/Local Symbols in the linker listing options\n")
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Keil map 文件内存报告")
+    parser.add_argument("map", help="armlink 生成的 .map 文件")
+    parser.add_argument("--top", type=int, default=20, help="目标文件和变量各列出前几项")
+    args = parser.parse_args()
+
+    with open(args.map, encoding="utf-8", errors="replace") as f:
+        regions, objects, symbols = parse(f)
+    if not regions:
+        sys.exit("%s: no execution regions found, is this an armlink map file?" % args.map)
+    report(regions, objects, symbols, args.top, sys.stdout)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,16 @@
+#ifndef __RTS_WRAP_TEST_FREERTOS_H__
+#define __RTS_WRAP_TEST_FREERTOS_H__
+
+/* rts_wrap_test 专用：只提供 app_runtime_stats.c 用到的定义 */
+#include <stdint.h>
+#include <stddef.h>
+
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+#define pdFALSE ((BaseType_t)0)
+#define pdTRUE ((BaseType_t)1)
+
+#define configMAX_TASK_NAME_LEN 16 // 与固件 FreeRTOSConfig.h 一致
+
+#endif //end __RTS_WRAP_TEST_FREERTOS_H__
@@ -0,0 +1,9 @@
+#ifndef __RTS_WRAP_TEST_ELOG_H__
+#define __RTS_WRAP_TEST_ELOG_H__
+
+/* TOP 的输出直接打到标准输出 */
+#include <stdio.h>
+
+#define elog_i(tag, ...) ((void)(tag), printf(__VA_ARGS__))
+
+#endif //end __RTS_WRAP_TEST_ELOG_H__
@@ -0,0 +1,33 @@
+#ifndef __RTS_WRAP_TEST_MAIN_H__
+#define __RTS_WRAP_TEST_MAIN_H__
+
+/* rts_wrap_test 专用：代替 CubeMX 的 main.h，只提供 bsp_dwt.c 目标分支用到的 CMSIS 定义
+ * DWT/CoreDebug 是普通的全局变量，测试程序直接改写 CYCCNT 模拟计数和卷绕 */
+#include <stdint.h>
+
+typedef struct
+{
+    volatile uint32_t CTRL;
+    volatile uint32_t CYCCNT;
+} DWT_Type;
+
+typedef struct
+{
+    volatile uint32_t DEMCR;
+} CoreDebug_Type;
+
+extern DWT_Type sim_dwt;
+extern CoreDebug_Type sim_core_debug;
+extern uint32_t sim_primask;
+extern uint32_t SystemCoreClock;
+
+#define DWT (&sim_dwt)
+#define CoreDebug (&sim_core_debug)
+#define DWT_CTRL_CYCCNTENA_Msk (1UL << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk (1UL << 24)
+
+static inline uint32_t __get_PRIMASK(void) { return sim_primask; }
+static inline void __set_PRIMASK(uint32_t primask) { sim_primask = primask; }
+static inline void __disable_irq(void) { sim_primask = 1; }
+
+#endif //end __RTS_WRAP_TEST_MAIN_H__
@@ -0,0 +1,311 @@
+/*
+ * 运行时间统计卷绕测试：在 PC 上检验 bsp_dwt.c 的 64 位周期扩展和 app_runtime_stats.c 的 64 位累计
+ *
+ * 两个源文件原样编译，取消 __linux__ 让 bsp_dwt.c 走目标板分支，
+ * 本目录的 main.h / FreeRTOS.h / task.h / elog.h 只提供它们用到的定义：
+ *     gcc -O2 -U__linux__ -I. -I../../BSP/BSP_DWT -I../../APP/APP_MONITOR -o rts_wrap_test rts_wrap_test.c
+ *         ../../BSP/BSP_DWT/bsp_dwt.c ../../APP/APP_MONITOR/app_runtime_stats.c
+ *     ./rts_wrap_test         模拟运行 3 小时
+ *     ./rts_wrap_test 24      模拟运行 24 小时
+ *
+ * 1. 直接改写 CYCCNT，检查 BSP_DWT_GetCycle64 在卷绕点前后、重复读取时的结果，以及 PRIMASK 的保存恢复
+ * 2. 按 100MHz 的内核时钟模拟任务切换：每次切换和固件一样通过 getRunTimeCounterValue() 读时钟，
+ *    按 tasks.c 的方式把32位差值累加到内核的32位 ulRunTimeCounter；
+ *    定时器服务任务每 1 秒调用 RuntimeStats_Sample。
+ *    运行期间 CYCCNT 每 42.9 秒卷绕一次，32位统计时钟每 11.5 分钟卷绕一次，
+ *    每次采样都要求 64 位计数与真实周期数完全相等、各任务 64 位累计与真实运行时间完全相等，
+ *    中途创建和删除任务，检查表项的分配和释放。
+ * 最后打印 TOP 的输出，并列出只用32位计数时空闲任务的百分比作对比。
+ * 有一项不符时返回非 0，可以直接放进脚本里做回归检查。
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include "main.h"
+#include "bsp_dwt.h"
+#include "app_runtime_stats.h"
+
+#define CORE_CLOCK 100000000ULL             // 内核时钟 (Hz)
+#define SAMPLE_CYCLES CORE_CLOCK            // 采样周期 1 秒，与 MONITOR_SAMPLE_MS 一致
+#define SLICE_MAX_US 2000                   // 单个时间片最长 2ms
+#define SIM_TASKS 6
+
+DWT_Type sim_dwt;
+CoreDebug_Type sim_core_debug;
+uint32_t sim_primask;
+uint32_t SystemCoreClock = (uint32_t)CORE_CLOCK;
+
+typedef struct
+{
+    const char *name;
+    UBaseType_t num;        // xTaskNumber
+    uint32_t weight;        // 被选中运行的权重
+    uint32_t counter;       // 内核的32位 ulRunTimeCounter
+    uint64_t truth;         // 真实运行时间 (统计时钟计数, 64位)
+    bool alive;
+} Sim_Task_t;
+
+static Sim_Task_t sim_task[SIM_TASKS] = {
+    {"IDLE", 1, 60, 0, 0, true},
+    {"Tmr Svc", 2, 2, 0, 0, true},
+    {"defaultTask", 3, 5, 0, 0, true},
+    {"UartParseTask", 4, 25, 0, 0, true},
+    {"Worker", 5, 8, 0, 0, false},      // 20 分钟时创建，50 分钟时删除
+    {"Worker2", 6, 8, 0, 0, false},     // 60 分钟时创建
+};
+
+static uint64_t sim_time;               // 真实周期数
+static int sim_current;                 // 正在运行的任务
+static uint32_t switched_in_time;       // tasks.c 的 ulTaskSwitchedInTime
+static uint64_t switched_in_truth;
+static unsigned long fail_count;
+static uint32_t rng = 2463534242U;
+
+static uint32_t Rand(void)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return rng;
+}
+
+static void Check(bool ok, const char *what, unsigned long long got, unsigned long long expect)
+{
+    if (!ok && fail_count++ < 10)
+    {
+        printf("FAIL %s: got %llu, expect %llu (t = %.3f s)\n", what, got, expect,
+               (double)sim_time / CORE_CLOCK);
+    }
+}
+
+/**
+ * @brief 与 main.c 的 getRunTimeCounterValue 相同，调用前先把真实时间写进 CYCCNT
+ */
+static unsigned long Sim_RunTimeCounter(void)
+{
+    uint64_t cycle;
+
+    sim_dwt.CYCCNT = (uint32_t)sim_time;
+    cycle = BSP_DWT_GetCycle64();
+    Check(cycle == sim_time, "cycle64", cycle, sim_time);
+    return (unsigned long)(cycle >> DWT_RUNTIME_SHIFT);
+}
+
+/**
+ * @brief 任务切换，统计部分与 tasks.c vTaskSwitchContext 相同
+ */
+static void Sim_Switch(int next)
+{
+    uint32_t now = (uint32_t)Sim_RunTimeCounter();
+    uint64_t truth = sim_time >> DWT_RUNTIME_SHIFT;
+
+    sim_task[sim_current].counter += now - switched_in_time;
+    sim_task[sim_current].truth += truth - switched_in_truth;
+    switched_in_time = now;
+    switched_in_truth = truth;
+    sim_current = next;
+}
+
+UBaseType_t uxTaskGetSystemState(TaskStatus_t *const pxTaskStatusArray, const UBaseType_t uxArraySize,
+                                 uint32_t *const pulTotalRunTime)
+{
+    UBaseType_t count = 0;
+    int i;
+
+    for (i = 0; i < SIM_TASKS && count < uxArraySize; i++)
+    {
+        if (sim_task[i].alive)
+        {
+            pxTaskStatusArray[count].pcTaskName = sim_task[i].name;
+            pxTaskStatusArray[count].xTaskNumber = sim_task[i].num;
+            pxTaskStatusArray[count].ulRunTimeCounter = sim_task[i].counter;
+            count++;
+        }
+    }
+    if (NULL != pulTotalRunTime)
+    {
+        *pulTotalRunTime = switched_in_time;
+    }
+    return count;
+}
+
+static int Sim_PickTask(void)
+{
+    uint32_t total = 0, r;
+    int i;
+
+    for (i = 0; i < SIM_TASKS; i++)
+    {
+        total += sim_task[i].alive ? sim_task[i].weight : 0;
+    }
+    r = Rand() % total;
+    for (i = 0; i < SIM_TASKS; i++)
+    {
+        if (!sim_task[i].alive)
+        {
+            continue;
+        }
+        if (r < sim_task[i].weight)
+        {
+            return i;
+        }
+        r -= sim_task[i].weight;
+    }
+    return 0;
+}
+
+static uint64_t Sim_Minutes(uint32_t min)
+{
+    return (uint64_t)min * 60U * CORE_CLOCK;
+}
+
+/**
+ * @brief 直接改写 CYCCNT 检查卷绕检测和 PRIMASK
+ */
+static void Test_Cycle64(void)
+{
+    static const struct
+    {
+        uint32_t cyccnt;
+        uint64_t expect;
+    } step[] = {
+        {0x00000000U, 0x000000000ULL},
+        {0x7FFFFFFFU, 0x07FFFFFFFULL},
+        {0xFFFFFFFFU, 0x0FFFFFFFFULL},
+        {0xFFFFFFFFU, 0x0FFFFFFFFULL}, // 重复读取同一个值不算卷绕
+        {0x00000000U, 0x100000000ULL}, // 正好卷绕
+        {0x00000005U, 0x100000005ULL},
+        {0x00000004U, 0x200000004ULL}, // 变小一点也算卷绕 (两次读取相隔超过 42.9 秒之外的唯一可能)
+        {0xFFFFFFF0U, 0x2FFFFFFF0ULL},
+        {0x00000010U, 0x300000010ULL},
+    };
+    uint32_t i;
+
+    BSP_DWT_Init();
+    Check(sim_core_debug.DEMCR & CoreDebug_DEMCR_TRCENA_Msk, "TRCENA", sim_core_debug.DEMCR, 1);
+    Check(sim_dwt.CTRL & DWT_CTRL_CYCCNTENA_Msk, "CYCCNTENA", sim_dwt.CTRL, 1);
+
+    for (i = 0; i < sizeof(step) / sizeof(step[0]); i++)
+    {
+        uint64_t got;
+
+        sim_primask = i & 1U; // 交替在开中断/已关中断的上下文中调用
+        sim_dwt.CYCCNT = step[i].cyccnt;
+        got = BSP_DWT_GetCycle64();
+        Check(got == step[i].expect, "cycle64 step", got, step[i].expect);
+        Check(sim_primask == (i & 1U), "primask restore", sim_primask, i & 1U);
+    }
+    printf("cycle64 steps: %u checked\n", (unsigned)i);
+}
+
+int main(int argc, char **argv)
+{
+    double hours = (argc > 1) ? atof(argv[1]) : 3.0;
+    uint64_t end, next_sample;
+    uint64_t last_sample_tick = 0;
+    unsigned long samples = 0, switches = 0;
+    const RTS_TaskEntry_t *table;
+    uint32_t window;
+    int i, j;
+
+    if (hours <= 0)
+    {
+        printf("usage: rts_wrap_test [hours]\n");
+        return 1;
+    }
+
+    Test_Cycle64();
+
+    // 与固件启动顺序相同：configureTimerForRunTimeStats -> RuntimeStats_Init -> 调度器启动
+    sim_time = 0;
+    sim_primask = 0;
+    BSP_DWT_Init();
+    RuntimeStats_Init();
+    end = (uint64_t)(hours * 3600.0 * CORE_CLOCK);
+    next_sample = SAMPLE_CYCLES;
+    sim_current = 0;
+    switched_in_time = (uint32_t)Sim_RunTimeCounter();
+    switched_in_truth = sim_time >> DWT_RUNTIME_SHIFT;
+
+    while (sim_time < end)
+    {
+        // 运行一个时间片，周期数故意不对齐 16，让右移截断也参与检查
+        sim_time += (uint64_t)(Rand() % (SLICE_MAX_US * 100U)) + 1U;
+
+        if (sim_time >= next_sample)
+        {
+            sim_time = next_sample;
+            next_sample += SAMPLE_CYCLES;
+
+            // 生命周期事件在采样点上发生
+            if (sim_time == Sim_Minutes(20))
+            {
+                sim_task[4].alive = true;
+            }
+            else if (sim_time == Sim_Minutes(50))
+            {
+                Sim_Switch(0);
+                sim_task[4].alive = false;
+            }
+            else if (sim_time == Sim_Minutes(60))
+            {
+                sim_task[5].alive = true;
+            }
+
+            // 定时器服务任务运行监控回调
+            Sim_Switch(1);
+            sim_time += 2000;
+            RuntimeStats_Sample();
+            samples++;
+
+            table = RuntimeStats_GetTable(&window);
+            {
+                uint64_t tick = sim_time >> DWT_RUNTIME_SHIFT;
+                Check(window == (uint32_t)(tick - last_sample_tick) || samples == 1, "window", window,
+                      tick - last_sample_tick);
+                last_sample_tick = tick;
+            }
+            for (i = 0; i < SIM_TASKS; i++)
+            {
+                bool found = false;
+                for (j = 0; j < RTS_MAX_TASKS; j++)
+                {
+                    if (table[j].used && table[j].task_num == sim_task[i].num)
+                    {
+                        found = true;
+                        Check(table[j].total == sim_task[i].truth, sim_task[i].name, table[j].total,
+                              sim_task[i].truth);
+                    }
+                }
+                Check(found == sim_task[i].alive, "entry used", found, sim_task[i].alive);
+            }
+        }
+
+        Sim_Switch(Sim_PickTask());
+        switches++;
+    }
+    printf("simulated %.2f h: %lu switches, %lu samples, CYCCNT wrapped %llu times, "
+           "run-time counter wrapped %llu times\n\n",
+           (double)sim_time / CORE_CLOCK / 3600.0, switches, samples,
+           (unsigned long long)(sim_time >> 32),
+           (unsigned long long)((sim_time >> DWT_RUNTIME_SHIFT) >> 32));
+
+    RuntimeStats_Print("TOP");
+
+    // 对比：只有32位计数时 (vTaskGetRunTimeStats 的算法) 空闲任务的百分比
+    {
+        uint32_t total32 = switched_in_time;
+        uint64_t total64 = sim_time >> DWT_RUNTIME_SHIFT;
+        printf("\nIDLE share: 64-bit %.1f%%, 32-bit counters only %.1f%%\n",
+               100.0 * (double)sim_task[0].truth / (double)total64,
+               total32 ? 100.0 * (double)sim_task[0].counter / (double)total32 : 0.0);
+    }
+
+    if (fail_count > 0)
+    {
+        printf("\n%lu checks FAILED\n", fail_count);
+        return 1;
+    }
+    printf("\nall checks passed\n");
+    return 0;
+}
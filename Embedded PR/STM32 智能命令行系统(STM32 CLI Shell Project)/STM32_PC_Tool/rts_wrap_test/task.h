@@ -0,0 +1,19 @@
+#ifndef __RTS_WRAP_TEST_TASK_H__
+#define __RTS_WRAP_TEST_TASK_H__
+
+/* 任务状态由 rts_wrap_test.c 模拟，uxTaskGetSystemState 返回模拟的内核32位计数 */
+typedef struct xTASK_STATUS
+{
+    const char *pcTaskName;
+    UBaseType_t xTaskNumber;
+    uint32_t ulRunTimeCounter;
+} TaskStatus_t;
+
+UBaseType_t uxTaskGetSystemState(TaskStatus_t *const pxTaskStatusArray, const UBaseType_t uxArraySize,
+                                 uint32_t *const pulTotalRunTime);
+
+/* 单线程程序，挂起调度器什么都不用做 */
+static inline void vTaskSuspendAll(void) {}
+static inline BaseType_t xTaskResumeAll(void) { return pdFALSE; }
+
+#endif //end __RTS_WRAP_TEST_TASK_H__
@@ -0,0 +1,19 @@
+#ifndef __RTT_SHM_H__
+#define __RTT_SHM_H__
+
+/* rtt_shm_test 专用：编译 SEGGER_RTT.c 时用 -include 强制包含
+ * 控制块和所有 RTT 缓冲区放进 rtt_shm 段，启动时把这个段复制到共享内存，
+ * SEGGER_RTT.c 访问控制块和缓冲区时都加上 SEGGER_RTT_UNCACHED_OFF (原本给带 cache 的内核用的非缓存别名)，
+ * 这里设成共享内存相对 rtt_shm 段的偏移，于是所有读写都落在共享内存里，
+ * fork 出来的 "J-Link" 进程从共享内存里按 "SEGGER RTT" 搜索控制块并读取，和调试器读目标内存一样 */
+#include <stdint.h>
+
+#define RTT_SHM_SECTION "rtt_shm"
+#define SEGGER_RTT_SECTION RTT_SHM_SECTION
+#define SEGGER_RTT_UNCACHED_OFF rtt_shm_off
+/* x86 的写顺序本来就不变，这里只需要挡住编译器重排 (固件上是 DMB) */
+#define RTT__DMB() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+
+extern intptr_t rtt_shm_off;
+
+#endif //end __RTT_SHM_H__
@@ -0,0 +1,442 @@
+/*
+ * SEGGER RTT 共享内存替身：在 PC 上检验固件写 RTT 的方式和 J-Link 并发读取
+ *
+ * SEGGER_RTT.c 原样编译，用 -include rtt_shm.h 把控制块和缓冲区的访问重定向到共享内存 (原理见 rtt_shm.h)。
+ * 父进程是目标板 (生产者)，fork 出的子进程是 J-Link (消费者)：
+ * 在共享内存里搜索 "SEGGER RTT" 找到控制块，像调试器一样轮询 WrOff、复制数据、写回 RdOff，
+ * 读得比写得慢，缓冲区经常是满的 (NO_BLOCK_SKIP，写不下就整条丢弃)。
+ *     gcc -O2 -I. -I../../Middlewares/Third_Party/RTT -o rtt_shm_test rtt_shm_test.c
+ *         -include rtt_shm.h ../../Middlewares/Third_Party/RTT/SEGGER_RTT.c
+ *     ./rtt_shm_test              并发检查，每个通道 200000 条
+ *     ./rtt_shm_test 1000000      指定条数
+ *
+ * 三个通道按固件里的用法写入：
+ *     0 文本日志 SEGGER_RTT_Write，长度随机的行 "L<序号> <填充>|<校验和>\n" (elog_port_output)
+ *     1 事件跟踪 SEGGER_RTT_WriteSkipNoLock 8 字节记录 (app_trace.c)
+ *     2 延迟日志 先查剩余空间，记录头、数据、补零分三次 SEGGER_RTT_WriteSkipNoLock，12~40 字节 (elog_port_defer_output)
+ * 两个缓冲区的大小都不是记录长度的整数倍，记录经常跨越卷绕点。
+ * 检查：J-Link 收到的每条记录完整、按序，条数与目标板写入成功的条数相等 (整条写入或整条丢弃)，
+ * 2 通道确实出现过跨越卷绕点的记录。有一项不符时返回非 0。
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include "rtt_shm.h"
+#include "SEGGER_RTT.h"
+
+#define RECORDS_DEFAULT 200000UL
+#define TRACE_CHANNEL 1
+#define TRACE_BUF_SIZE 1020                     // 不是 8 的整数倍，记录会跨越卷绕点
+#define DEFER_CHANNEL 2
+#define DEFER_BUF_SIZE 1000                     // 不是记录长度的整数倍，记录会跨越卷绕点
+#define LINE_MAX 120
+#define READ_CHUNK 256                          // J-Link 每次轮询每个通道最多读的字节数
+
+extern char __start_rtt_shm[], __stop_rtt_shm[];
+intptr_t rtt_shm_off;
+
+static char trace_buf[TRACE_BUF_SIZE] __attribute__((section(RTT_SHM_SECTION), aligned(4)));
+static char defer_buf[DEFER_BUF_SIZE] __attribute__((section(RTT_SHM_SECTION), aligned(4)));
+
+/* 两个进程共享的结果 */
+typedef struct
+{
+    volatile int done;                          // 目标板写完
+    unsigned long sent[3];                      // 目标板提交成功的条数
+    unsigned long dropped[3];                   // 目标板写不下丢弃的条数
+    unsigned long split;                        // 2 通道跨越卷绕点的条数
+    unsigned long received[3];                  // J-Link 收到的条数
+    unsigned long errors;                       // J-Link 发现的错误
+} Shared_t;
+
+static Shared_t *shared;
+
+/* ---------------- 共享内存 ---------------- */
+
+/**
+ * @brief 把 rtt_shm 段搬到共享内存，之后 SEGGER_RTT.c 的所有访问都落在共享内存里
+ */
+static char *Shm_Attach(size_t *size)
+{
+    char *shm;
+
+    *size = (size_t)(__stop_rtt_shm - __start_rtt_shm);
+    shm = mmap(NULL, *size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (shm == MAP_FAILED)
+    {
+        perror("mmap");
+        exit(2);
+    }
+    memcpy(shm, __start_rtt_shm, *size);
+    rtt_shm_off = (intptr_t)(shm - __start_rtt_shm);
+    return shm;
+}
+
+/* ---------------- 记录格式 ---------------- */
+
+static uint32_t Sum(const uint8_t *p, size_t n)
+{
+    uint32_t h = 2166136261u;
+
+    while (n--)
+    {
+        h = (h ^ *p++) * 16777619u;
+    }
+    return h;
+}
+
+static size_t Line_Format(char *line, unsigned long seq)
+{
+    int n = sprintf(line, "L%lu ", seq);
+    size_t len = 24 + (seq * 7919u) % (LINE_MAX - 40);
+
+    memset(line + n, 'a' + (char)(seq % 26), len - n);
+    return len + (size_t)sprintf(line + len, "|%08lx\n", (unsigned long)Sum((const uint8_t *)line, len));
+}
+
+static void Trace_Format(uint32_t rec[2], uint32_t seq)
+{
+    rec[0] = seq;
+    rec[1] = seq * 2654435761u;
+}
+
+/* 延迟日志记录：[长度][序号低 24 位][负载...] 12 字节记录头 + 0~28 字节数据 + 补零到 4 的倍数 */
+static size_t Defer_Data_Size(uint32_t seq)
+{
+    return seq % 29;
+}
+
+static size_t Defer_Format(uint8_t *rec, uint32_t seq)
+{
+    size_t data_size = Defer_Data_Size(seq), len = 12 + ((data_size + 3) & ~(size_t)3), i;
+
+    rec[0] = (uint8_t)len;
+    rec[1] = (uint8_t)seq;
+    rec[2] = (uint8_t)(seq >> 8);
+    rec[3] = (uint8_t)(seq >> 16);
+    for (i = 4; i < len; i++)
+    {
+        rec[i] = (i < 12 + data_size) ? (uint8_t)(seq * 31 + i) : 0;
+    }
+    return len;
+}
+
+/* ---------------- 目标板 ---------------- */
+
+/**
+ * @brief 按 app_trace.c 的方式写一条 8 字节记录
+ */
+static bool Trace_Put(uint32_t seq)
+{
+    uint32_t rec[2];
+    unsigned n;
+
+    Trace_Format(rec, seq);
+    SEGGER_RTT_LOCK();
+    n = SEGGER_RTT_WriteSkipNoLock(TRACE_CHANNEL, rec, sizeof(rec));
+    SEGGER_RTT_UNLOCK();
+    return n != 0;
+}
+
+/**
+ * @brief 按 elog_port_defer_output 的方式写一条记录：先查空间，再分三次写记录头、数据和补零
+ */
+static bool Defer_Put(uint32_t seq)
+{
+    static const uint8_t zero[3] = { 0, 0, 0 };
+    volatile SEGGER_RTT_BUFFER_UP *ring = (SEGGER_RTT_BUFFER_UP *)((uintptr_t)&_SEGGER_RTT.aUp[DEFER_CHANNEL] + rtt_shm_off);
+    uint8_t rec[40];
+    size_t len = Defer_Format(rec, seq), data_size = Defer_Data_Size(seq);
+    bool ok;
+
+    SEGGER_RTT_LOCK();
+    ok = (SEGGER_RTT_GetAvailWriteSpace(DEFER_CHANNEL) >= len);
+    if (ok)
+    {
+        if (ring->WrOff + len > ring->SizeOfBuffer)
+        {
+            shared->split++;
+        }
+        SEGGER_RTT_WriteSkipNoLock(DEFER_CHANNEL, rec, 12);
+        if (data_size)
+        {
+            SEGGER_RTT_WriteSkipNoLock(DEFER_CHANNEL, rec + 12, (unsigned)data_size);
+            SEGGER_RTT_WriteSkipNoLock(DEFER_CHANNEL, zero, (unsigned)(len - 12 - data_size));
+        }
+    }
+    SEGGER_RTT_UNLOCK();
+    return ok;
+}
+
+static void Target_Run(unsigned long records)
+{
+    char line[LINE_MAX + 16];
+    unsigned long seq[3] = { 0, 0, 0 };
+    struct timespec pause = { 0, 200000 };
+    size_t len;
+    int ch;
+
+    while (seq[0] < records || seq[1] < records || seq[2] < records)
+    {
+        ch = rand() % 3;
+        if (seq[ch] >= records)
+        {
+            continue;
+        }
+        switch (ch)
+        {
+        case 0:
+            len = Line_Format(line, seq[0]);
+            if (SEGGER_RTT_Write(0, line, (unsigned)len) == len)
+            {
+                shared->sent[0]++;
+            }
+            else
+            {
+                shared->dropped[0]++;
+            }
+            break;
+        case TRACE_CHANNEL:
+            Trace_Put((uint32_t)seq[1]) ? shared->sent[1]++ : shared->dropped[1]++;
+            break;
+        default:
+            Defer_Put((uint32_t)seq[2]) ? shared->sent[2]++ : shared->dropped[2]++;
+            break;
+        }
+        seq[ch]++;
+        if ((rand() & 127) == 0)
+        {
+            /* 偶尔停一下，让 J-Link 读空，缓冲区满和不满两种情况都覆盖到 */
+            nanosleep(&pause, NULL);
+        }
+    }
+    __atomic_store_n(&shared->done, 1, __ATOMIC_RELEASE);
+}
+
+/* ---------------- J-Link ---------------- */
+
+typedef struct
+{
+    uint8_t buf[4096];
+    size_t len;
+    long last;                                  // 上一条记录的序号
+} Stream_t;
+
+/**
+ * @brief 像调试器一样读一个上行缓冲区：读 WrOff，复制 RdOff 到 WrOff 之间的数据，写回 RdOff
+ */
+static size_t Host_Read(volatile SEGGER_RTT_BUFFER_UP *ring, uint8_t *dst, size_t max)
+{
+    unsigned wr = __atomic_load_n(&ring->WrOff, __ATOMIC_ACQUIRE);
+    unsigned rd = ring->RdOff;
+    const char *base = ring->pBuffer + rtt_shm_off;
+    size_t n = 0;
+
+    while (rd != wr && n < max)
+    {
+        dst[n++] = (uint8_t)base[rd];
+        if (++rd == ring->SizeOfBuffer)
+        {
+            rd = 0;
+        }
+    }
+    __atomic_store_n(&ring->RdOff, rd, __ATOMIC_RELEASE);
+    return n;
+}
+
+static void Host_Error(const char *what, int ch, long seq)
+{
+    if (shared->errors++ < 10)
+    {
+        printf("J-Link: channel %d %s (after %ld)\n", ch, what, seq);
+    }
+}
+
+/**
+ * @brief 解析收到的数据，返回消耗的字节数
+ */
+static size_t Host_Parse(int ch, Stream_t *s)
+{
+    size_t pos = 0;
+
+    for (;;)
+    {
+        uint8_t *p = &s->buf[pos];
+        size_t avail = s->len - pos, len;
+        unsigned long seq;
+
+        if (ch == 0)
+        {
+            uint8_t *nl = memchr(p, '\n', avail);
+            char *bar;
+
+            if (!nl)
+            {
+                break;
+            }
+            len = (size_t)(nl - p) + 1;
+            bar = memchr(p, '|', len);
+            if (p[0] != 'L' || !bar || sscanf((char *)p + 1, "%lu", &seq) != 1
+                || strtoul(bar + 1, NULL, 16) != Sum(p, (size_t)((uint8_t *)bar - p)))
+            {
+                Host_Error("broken line", ch, s->last);
+                seq = (unsigned long)s->last + 1;
+            }
+        }
+        else if (ch == TRACE_CHANNEL)
+        {
+            uint32_t rec[2], want[2];
+
+            len = 8;
+            if (avail < len)
+            {
+                break;
+            }
+            memcpy(rec, p, 8);
+            seq = rec[0];
+            Trace_Format(want, rec[0]);
+            if (rec[1] != want[1])
+            {
+                Host_Error("broken trace record", ch, s->last);
+            }
+        }
+        else
+        {
+            uint8_t want[40];
+
+            len = p[0];
+            if (avail < 1 || avail < len)
+            {
+                break;
+            }
+            seq = p[1] | ((unsigned long)p[2] << 8) | ((unsigned long)p[3] << 16);
+            /* 序号只有 24 位，按上一条补齐高位 */
+            seq |= ((unsigned long)(s->last + 1) & ~0xFFFFFFUL);
+            if ((long)seq <= s->last)
+            {
+                seq += 0x1000000UL;
+            }
+            if (len < 12 || Defer_Format(want, (uint32_t)seq) != len || memcmp(want, p, len) != 0)
+            {
+                Host_Error("broken defer record", ch, s->last);
+                s->len = 0;
+                return 0;
+            }
+        }
+        if ((long)seq <= s->last)
+        {
+            Host_Error("out of order", ch, s->last);
+        }
+        s->last = (long)seq;
+        shared->received[ch]++;
+        pos += len;
+    }
+    memmove(s->buf, s->buf + pos, s->len - pos);
+    s->len -= pos;
+    return pos;
+}
+
+static void Host_Run(char *shm, size_t size)
+{
+    SEGGER_RTT_CB *cb = NULL;
+    Stream_t stream[3];
+    struct timespec nap = { 0, 20000 };
+    size_t i, n;
+    int ch, idle = 0;
+
+    memset(stream, 0, sizeof(stream));
+    for (ch = 0; ch < 3; ch++)
+    {
+        stream[ch].last = -1;
+    }
+    /* 和 J-Link 一样在 "目标内存" 里搜索控制块 */
+    while (cb == NULL)
+    {
+        for (i = 0; i + sizeof(SEGGER_RTT_CB) <= size; i += 4)
+        {
+            if (memcmp(shm + i, "SEGGER RTT", 11) == 0)
+            {
+                cb = (SEGGER_RTT_CB *)(shm + i);
+                break;
+            }
+        }
+        nanosleep(&nap, NULL);
+    }
+    for (;;)
+    {
+        bool done = __atomic_load_n(&shared->done, __ATOMIC_ACQUIRE);
+
+        n = 0;
+        for (ch = 0; ch < 3; ch++)
+        {
+            volatile SEGGER_RTT_BUFFER_UP *ring = &cb->aUp[ch];
+            Stream_t *s = &stream[ch];
+            size_t got;
+
+            if (ring->pBuffer == NULL)
+            {
+                continue;
+            }
+            got = Host_Read(ring, s->buf + s->len, sizeof(s->buf) - s->len < READ_CHUNK ?
+                            sizeof(s->buf) - s->len : READ_CHUNK);
+            s->len += got;
+            n += got;
+            Host_Parse(ch, s);
+        }
+        if (n == 0 && done && ++idle > 3)
+        {
+            break;
+        }
+        /* 调试器的轮询间隔，读得比目标板写得慢 */
+        nanosleep(&nap, NULL);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned long records = (argc > 1) ? strtoul(argv[1], NULL, 0) : RECORDS_DEFAULT;
+    size_t size;
+    char *shm;
+    pid_t pid;
+    int ch, status, fail = 0;
+
+    shared = mmap(NULL, sizeof(*shared), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    memset(shared, 0, sizeof(*shared));
+    shm = Shm_Attach(&size);
+    SEGGER_RTT_Init();
+    SEGGER_RTT_ConfigUpBuffer(TRACE_CHANNEL, "Trace", trace_buf, sizeof(trace_buf), SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+    SEGGER_RTT_ConfigUpBuffer(DEFER_CHANNEL, "ElogDefer", defer_buf, sizeof(defer_buf), SEGGER_RTT_MODE_NO_BLOCK_SKIP);
+    pid = fork();
+    if (pid == 0)
+    {
+        Host_Run(shm, size);
+        _exit(0);
+    }
+    srand(1);
+    Target_Run(records ? records : RECORDS_DEFAULT);
+    waitpid(pid, &status, 0);
+
+    printf("shared memory: %zu bytes, control block at +%ld\n", size,
+           (long)((char *)&_SEGGER_RTT - __start_rtt_shm));
+    for (ch = 0; ch < 3; ch++)
+    {
+        printf("channel %d: committed %lu, dropped %lu, received %lu\n", ch, shared->sent[ch], shared->dropped[ch],
+               shared->received[ch]);
+        if (shared->received[ch] != shared->sent[ch] || shared->sent[ch] == 0)
+        {
+            fail = 1;
+        }
+    }
+    printf("defer records across the wrap point: %lu, errors: %lu\n", shared->split, shared->errors);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0 || shared->errors || shared->split == 0)
+    {
+        fail = 1;
+    }
+    printf("%s\n", fail ? "FAIL" : "PASS");
+    return fail;
+}
@@ -0,0 +1,662 @@
+/*
+ * 无节拍空闲 (tickless idle) 睡眠/唤醒时序仿真工具
+ *
+ * 在 PC 上按 CPU 周期推进一个简化的固件模型，比较系统节拍常开和无节拍空闲两种配置：
+ *     - SysTick 按硬件行为建模 (24 位递减计数、LOAD 在下次重装时生效、COUNTFLAG、停表期间冻结)，
+ *       port.c 中 vPortSuppressTicksAndSleep 的计算逐行照搬，包括提前唤醒时的节拍补偿和停表损失
+ *     - HAL 时间基准 TIM1 与 SysTick 相位不同，睡眠期间按 app_power.c 的方式挂起再补节拍
+ *     - DWT CYCCNT 在 WFI 期间停止计数，醒来后按 app_power.c 的方式用 SysTick 算出停掉的周期数补上
+ *       (BSP_DWT_AddSleep)；日志时间戳、TOP 统计、日志限速都用这个 64 位周期数
+ *     - 负载：系统监控定时器每 PROF_SAMPLE_MS 一次，串口按泊松过程随机到来一批数据，
+ *       DMA 收完后空闲线中断释放信号量，UartParseTask 解析后 osDelay(1) 再等下一批
+ * 各段代码的耗时 (周期数) 是估计值，定义在下面的 COST_ 宏里，可以按 LAT / TOP 命令在板上实测的结果修改。
+ *
+ *     gcc -O2 -o tickless_sim tickless_sim.c -lm
+ *     ./tickless_sim                  默认：平均 500ms 一批，每批 16 字节，仿真 600s
+ *     ./tickless_sim 50 64 120        平均 50ms 一批，每批 64 字节，仿真 120s
+ *
+ * 输出：
+ *     睡眠驻留率、每秒中断次数 (CPU 被叫醒的次数)、睡眠次数和提前唤醒次数，
+ *     串口空闲线中断 -> 解析任务开始运行的延迟 (区分 CPU 醒着和睡着两种情况)，
+ *     内核节拍和 HAL 节拍相对真实时间的最大偏差和最终偏差，
+ *     DWT 时间戳相对真实时间的偏差 (以及不补睡眠周期时的偏差)。
+ * 检查：DWT 时间戳单调不减，与真实时间的偏差不超过 DWT_DRIFT_LIMIT 个周期，否则返回非 0。
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+
+#define CPU_HZ 100000000ULL                 // configCPU_CLOCK_HZ
+#define TICK_HZ 1000U                       // configTICK_RATE_HZ
+#define TICK_CYCLES (CPU_HZ / TICK_HZ)      // ulTimerCountsForOneTick
+#define MAX_SUPPRESSED (0xFFFFFFUL / TICK_CYCLES) // xMaximumPossibleSuppressedTicks (167)
+#define STOPPED_COMPENSATION 45UL           // ulStoppedTimerCompensation (portMISSED_COUNTS_FACTOR)
+#define EXPECTED_IDLE_BEFORE_SLEEP 2U       // configEXPECTED_IDLE_TIME_BEFORE_SLEEP
+#define PROF_SAMPLE_MS 250U                 // 系统监控定时器周期
+#define TIM1_PHASE 37123ULL                 // TIM1 与 SysTick 的相位差 (周期)
+#define UART_BAUD 115200U
+#define UART_BYTE_CYCLES (CPU_HZ * 10U / UART_BAUD) // 1 起始位 + 8 数据位 + 1 停止位
+
+// 各段代码耗时估计 (周期)
+#define COST_IRQ_ENTRY 12U      // 中断压栈
+#define COST_TICK_ISR 300U      // xPortSysTickHandler -> xTaskIncrementTick
+#define COST_TICK_PENDED 250U   // xTaskResumeAll 补一个挂起期间积压的节拍
+#define COST_TIM1_ISR 150U      // HAL_IncTick
+#define COST_UART_ISR 900U      // 空闲线中断 + xSemaphoreGiveFromISR
+#define COST_CTX_SWITCH 200U    // PendSV 切换任务
+#define COST_TIMER_TASK 4000U   // 定时器任务执行 MonitorTimer_Callback
+#define COST_PARSE_BASE 3000U   // UartParseTask 每批固定开销
+#define COST_PARSE_BYTE 250U    // 每字节分发和解析
+#define COST_DELAY_WAKE 600U    // osDelay(1) 到期后任务回到等待信号量
+#define COST_IDLE_ENTRY 400U    // 空闲任务 prvGetExpectedIdleTime + vTaskSuspendAll
+#define COST_STOP_ENTRY 45U     // 停表到重新开表 (port.c 按 portMISSED_COUNTS_FACTOR 补偿)
+#define COST_PRE_SLEEP 40U      // LowPower_PreSleep
+#define COST_SLEEP_EXIT 10U     // Sleep 模式唤醒 (时钟不停，只需恢复流水线)
+#define COST_POST_SLEEP 60U     // LowPower_PostSleep
+#define COST_STOP_EXIT 60U      // 醒来后停表到重新开表 (没有补偿，提前唤醒时每次损失这么多)
+#define COST_RESUME_ALL 500U    // LowPower_IdleEnd + xTaskResumeAll
+
+#define LAT_BUCKETS 64          // 延迟直方图，每格 1us
+#define DWT_DRIFT_LIMIT 100U    // DWT 时间戳与真实时间的最大允许偏差 (周期，1us)
+
+typedef struct
+{
+    int enabled;
+    uint64_t zero_at;   // 下一次计到 0 的时刻 (运行时有效)
+    uint32_t value;     // 冻结时的当前值
+    uint32_t load;      // LOAD 寄存器
+    int count_flag;     // CTRL.COUNTFLAG，读 CTRL 时清零
+    int pending;        // SysTick 中断挂起
+} SysTick_Model_t;
+
+typedef struct
+{
+    uint32_t count;
+    uint64_t total;     // 周期
+    uint32_t max;
+    uint32_t hist[LAT_BUCKETS];
+} Lat_Stat_t;
+
+typedef struct
+{
+    int tickless;
+    // 统计
+    uint64_t sleep_cycles, busy_cycles;
+    uint32_t irq_cnt, sleep_cnt, early_cnt, abort_cnt, max_sleep;
+    uint64_t sleep_ticks;
+    Lat_Stat_t lat_awake, lat_sleep;
+    double kernel_drift_max, hal_drift_max;
+    double kernel_drift, hal_drift;
+    uint64_t dwt_drift_max, dwt_raw_drift;  // 周期
+    uint32_t dwt_backward;                  // 时间戳变小的次数
+} Sim_Result_t;
+
+static uint64_t t;                  // 当前时刻 (周期)
+static uint64_t busy_until;         // CPU 忙到什么时候
+static SysTick_Model_t st;
+static uint32_t tick_count, pended_ticks; // xTickCount / xPendedTicks
+static uint32_t next_timer;         // 监控定时器下次到期的节拍
+static uint32_t delay_until;        // UartParseTask 的 osDelay(1) 到期节拍，0 表示没有
+static int delay_pending;           // 解析完成后进入 osDelay(1)
+static uint64_t tim1_next;          // TIM1 下一次更新事件
+static int tim1_it;                 // TIM1 更新中断使能
+static uint32_t uw_tick;            // HAL uwTick
+static uint64_t uart_irq;           // 下一次串口空闲线中断
+static uint32_t uart_len;           // 这一批的字节数
+static double burst_mean_ms;
+static uint32_t burst_bytes;
+static uint32_t rng = 2463534242U;
+static Sim_Result_t *res;
+
+static uint32_t lp_begin, lp_expected; // app_power.c 的睡眠记录
+static uint32_t lp_hal_offset;
+static int lp_sleeping, lp_hal_synced;
+static uint32_t lp_st_val, lp_dwt;
+static int lp_st_pend;
+
+static uint64_t dwt_frozen;         // WFI 期间 CYCCNT 停掉的周期数
+static uint64_t dwt_sleep;          // BSP_DWT_AddSleep 补上的周期数
+static uint64_t dwt_last;           // 上一次读到的时间戳
+
+static double rand_uniform(void)
+{
+    rng ^= rng << 13;
+    rng ^= rng >> 17;
+    rng ^= rng << 5;
+    return (rng + 0.5) / 4294967296.0;
+}
+
+/**
+ * @brief 安排下一批串口数据：泊松到达，DMA 收完最后一个字节后再过 1 个字符时间触发空闲线中断
+ */
+static void uart_schedule(uint64_t after)
+{
+    double gap = -log(rand_uniform()) * burst_mean_ms * (CPU_HZ / 1000);
+
+    uart_len = burst_bytes;
+    uart_irq = after + (uint64_t)gap + (uint64_t)(uart_len + 1) * UART_BYTE_CYCLES;
+}
+
+/* ---------------- SysTick 硬件模型 ---------------- */
+
+static void st_advance(uint64_t now)
+{
+    while (st.enabled && st.zero_at <= now)
+    {
+        st.count_flag = 1;
+        st.pending = 1;
+        st.zero_at += (uint64_t)st.load + 1;
+    }
+}
+
+static uint32_t st_current(uint64_t now)
+{
+    st_advance(now);
+    return st.enabled ? (uint32_t)(st.zero_at - now) : st.value;
+}
+
+static void st_stop(uint64_t now)
+{
+    st.value = st_current(now);
+    st.enabled = 0;
+}
+
+/**
+ * @brief 开表，计数从 value 继续；value 为 0 时下一个周期装入 LOAD
+ */
+static void st_start(uint64_t now)
+{
+    st.zero_at = now + ((0 == st.value) ? (uint64_t)st.load + 1 : st.value);
+    st.enabled = 1;
+}
+
+static int st_read_count_flag(uint64_t now)
+{
+    int flag;
+
+    st_advance(now);
+    flag = st.count_flag;
+    st.count_flag = 0;
+    return flag;
+}
+
+/* ---------------- DWT 周期计数 (bsp_dwt.c) ---------------- */
+
+static uint64_t dwt_read(void)
+{
+    return t - dwt_frozen + dwt_sleep; // BSP_DWT_GetCycle64
+}
+
+/* ---------------- 内核与中断 ---------------- */
+
+static void lat_add(Lat_Stat_t *l, uint64_t cycles)
+{
+    uint32_t us = (uint32_t)(cycles / (CPU_HZ / 1000000));
+
+    l->count++;
+    l->total += cycles;
+    if (cycles > l->max)
+    {
+        l->max = (uint32_t)cycles;
+    }
+    l->hist[(us < LAT_BUCKETS) ? us : LAT_BUCKETS - 1]++;
+}
+
+static void cpu_work(uint32_t cycles)
+{
+    if (busy_until < t)
+    {
+        busy_until = t;
+    }
+    busy_until += cycles;
+    res->busy_cycles += cycles;
+}
+
+/**
+ * @brief 节拍到来时检查到期的任务 (xTaskIncrementTick 中调度器未挂起的部分)
+ */
+static void kernel_tick(void)
+{
+    tick_count++;
+    if (tick_count == next_timer)
+    {
+        cpu_work(2 * COST_CTX_SWITCH + COST_TIMER_TASK);
+        next_timer += PROF_SAMPLE_MS;
+    }
+    if (0 != delay_until && tick_count == delay_until)
+    {
+        cpu_work(2 * COST_CTX_SWITCH + COST_DELAY_WAKE);
+        delay_until = 0;
+    }
+}
+
+static void tick_isr(int scheduler_suspended)
+{
+    st.pending = 0;
+    res->irq_cnt++;
+    cpu_work(COST_IRQ_ENTRY + COST_TICK_ISR);
+    if (scheduler_suspended)
+    {
+        pended_ticks++;
+    }
+    else
+    {
+        kernel_tick();
+    }
+}
+
+static void tim1_isr(void)
+{
+    res->irq_cnt++;
+    uw_tick++;
+    tim1_next += TICK_CYCLES;
+    cpu_work(COST_IRQ_ENTRY + COST_TIM1_ISR);
+}
+
+/**
+ * @brief 解析任务处理一批数据，结束时 osDelay(1)
+ */
+static void uart_task_run(void)
+{
+    cpu_work(COST_PARSE_BASE + COST_PARSE_BYTE * uart_len);
+    delay_pending = 1;
+}
+
+/**
+ * @brief CPU 醒着时的空闲线中断：解析任务优先级最高，中断退出后直接切过去
+ */
+static void uart_isr_awake(void)
+{
+    res->irq_cnt++;
+    lat_add(&res->lat_awake, COST_IRQ_ENTRY + COST_UART_ISR + COST_CTX_SWITCH);
+    cpu_work(COST_IRQ_ENTRY + COST_UART_ISR + COST_CTX_SWITCH);
+    uart_task_run();
+    uart_schedule(uart_irq);
+}
+
+static void track_drift(void)
+{
+    double real = (double)t / TICK_CYCLES;
+    double kd = (double)(tick_count + pended_ticks) - real;
+    double hd = (double)uw_tick - (double)(t - TIM1_PHASE) / TICK_CYCLES;
+    uint64_t now = dwt_read();
+    uint64_t dd = (now > t) ? now - t : t - now;
+
+    res->kernel_drift = kd;
+    res->hal_drift = hd;
+    if (fabs(kd) > res->kernel_drift_max)
+    {
+        res->kernel_drift_max = fabs(kd);
+    }
+    if (fabs(hd) > res->hal_drift_max)
+    {
+        res->hal_drift_max = fabs(hd);
+    }
+    if (now < dwt_last)
+    {
+        res->dwt_backward++;
+    }
+    dwt_last = now;
+    if (dd > res->dwt_drift_max)
+    {
+        res->dwt_drift_max = dd;
+    }
+    res->dwt_raw_drift = dwt_frozen;
+}
+
+/* ---------------- 无节拍睡眠 (port.c vPortSuppressTicksAndSleep) ---------------- */
+
+static void suppress_ticks_and_sleep(uint32_t expected)
+{
+    uint32_t reload, complete, decrements, calc, slept;
+    uint64_t irq_at = 0, wake;
+    int uart_woke = 0;
+
+    if (expected > MAX_SUPPRESSED)
+    {
+        expected = MAX_SUPPRESSED;
+    }
+    // traceLOW_POWER_IDLE_BEGIN
+    lp_begin = tick_count + pended_ticks;
+    lp_expected = expected;
+    if (!lp_hal_synced)
+    {
+        lp_hal_synced = 1;
+        lp_hal_offset = uw_tick - lp_begin;
+    }
+
+    st_stop(t);
+    st.count_flag = 0; // CTRL &= ~ENABLE 是读-改-写，读 CTRL 清掉了 COUNTFLAG
+    reload = st.value + TICK_CYCLES * (expected - 1);
+    if (reload > STOPPED_COMPENSATION)
+    {
+        reload -= STOPPED_COMPENSATION;
+    }
+    t += COST_STOP_ENTRY;
+
+    if (uart_irq <= t)
+    {
+        // eTaskConfirmSleepModeStatus() == eAbortSleep：中断已经挂起，从停表时的值继续
+        res->abort_cnt++;
+        st.load = st.value;
+        st_start(t);
+        st.load = TICK_CYCLES - 1;
+        return;
+    }
+
+    st.load = reload;
+    st.value = 0;
+    st_start(t);
+
+    // configPRE_SLEEP_PROCESSING：记下 SysTick 和 DWT 的值
+    lp_sleeping = 1;
+    tim1_it = 0;
+    st_advance(t);
+    lp_st_pend = st.pending;
+    lp_st_val = st_current(t);
+    lp_dwt = (uint32_t)dwt_read();
+    t += COST_PRE_SLEEP;
+
+    // WFI：只有 SysTick 和串口能叫醒 (TIM1 更新中断已关)，内核时钟停止，CYCCNT 不计数
+    wake = (st.zero_at < uart_irq) ? st.zero_at : uart_irq;
+    if (wake < t)
+    {
+        wake = t;
+    }
+    res->sleep_cycles += wake - t;
+    dwt_frozen += wake - t;
+    t = wake + COST_SLEEP_EXIT;
+
+    // configPOST_SLEEP_PROCESSING：按 SysTick 补上 CYCCNT 停掉的周期，清掉睡眠期间 TIM1 的更新标志
+    st_advance(t);
+    calc = st_current(t);
+    if (calc > lp_st_val || (st.pending && !lp_st_pend))
+    {
+        decrements = lp_st_val + st.load + 1 - calc;
+    }
+    else
+    {
+        decrements = lp_st_val - calc;
+    }
+    calc = (uint32_t)dwt_read() - lp_dwt;
+    if ((int32_t)(decrements - calc) > 0)
+    {
+        dwt_sleep += decrements - calc;
+    }
+    while (tim1_next <= t)
+    {
+        tim1_next += TICK_CYCLES;
+    }
+    tim1_it = 1;
+    t += COST_POST_SLEEP;
+
+    // 开中断，叫醒 CPU 的中断在这里执行 (调度器仍挂起)
+    if (uart_irq <= t)
+    {
+        res->irq_cnt++;
+        irq_at = uart_irq;
+        uart_woke = 1;
+        t += COST_IRQ_ENTRY + COST_UART_ISR;
+        res->busy_cycles += COST_IRQ_ENTRY + COST_UART_ISR;
+    }
+    st_advance(t);
+    if (st.pending)
+    {
+        st.pending = 0;
+        res->irq_cnt++;
+        pended_ticks++;
+        t += COST_IRQ_ENTRY + COST_TICK_ISR;
+        res->busy_cycles += COST_IRQ_ENTRY + COST_TICK_ISR;
+    }
+
+    // 关中断，停表 (直接写 CTRL 不读，保留 COUNTFLAG)，按 COUNTFLAG 判断是节拍到期还是被其他中断提前叫醒
+    if (st_read_count_flag(t))
+    {
+        st_stop(t);
+        calc = (TICK_CYCLES - 1) - (reload - st.value);
+        if (calc < STOPPED_COMPENSATION || calc > TICK_CYCLES)
+        {
+            calc = TICK_CYCLES - 1;
+        }
+        st.load = calc;
+        complete = expected - 1;
+    }
+    else
+    {
+        st_stop(t);
+        decrements = expected * TICK_CYCLES - st.value;
+        complete = decrements / TICK_CYCLES;
+        st.load = (complete + 1) * TICK_CYCLES - decrements;
+    }
+    t += COST_STOP_EXIT;
+    st.value = 0;
+    st_start(t);
+    tick_count += complete; // vTaskStepTick
+    st.load = TICK_CYCLES - 1;
+
+    // 开中断，停表期间若恰好到了节拍，这里执行 (调度器仍挂起)
+    st_advance(t);
+    if (st.pending)
+    {
+        st.pending = 0;
+        res->irq_cnt++;
+        pended_ticks++;
+        t += COST_IRQ_ENTRY + COST_TICK_ISR;
+    }
+
+    // traceLOW_POWER_IDLE_END (LowPower_IdleEnd)
+    slept = tick_count + pended_ticks - lp_begin;
+    if (lp_sleeping)
+    {
+        lp_sleeping = 0;
+        if ((int32_t)(tick_count + pended_ticks + lp_hal_offset - uw_tick) > 0)
+        {
+            uw_tick = tick_count + pended_ticks + lp_hal_offset;
+        }
+        res->sleep_cnt++;
+        res->sleep_ticks += slept;
+        if (slept + 1 < lp_expected)
+        {
+            res->early_cnt++;
+        }
+        if (slept > res->max_sleep)
+        {
+            res->max_sleep = slept;
+        }
+    }
+
+    // xTaskResumeAll：补上积压的节拍，再切到就绪的解析任务
+    t += COST_RESUME_ALL;
+    busy_until = t;
+    while (pended_ticks > 0)
+    {
+        pended_ticks--;
+        cpu_work(COST_TICK_PENDED);
+        kernel_tick();
+    }
+    if (uart_woke)
+    {
+        lat_add(&res->lat_sleep, busy_until + COST_CTX_SWITCH - irq_at);
+        cpu_work(COST_CTX_SWITCH);
+        uart_task_run();
+        uart_schedule(irq_at);
+    }
+    track_drift();
+}
+
+/**
+ * @brief 下一个任务超时的节拍 (prvGetExpectedIdleTime)
+ */
+static uint32_t expected_idle_time(void)
+{
+    uint32_t next = next_timer;
+
+    if (0 != delay_until && delay_until < next)
+    {
+        next = delay_until;
+    }
+    return next - tick_count;
+}
+
+static void simulate(int tickless, double seconds, Sim_Result_t *r)
+{
+    uint64_t end = (uint64_t)(seconds * CPU_HZ), next_ev;
+
+    memset(r, 0, sizeof(*r));
+    res = r;
+    r->tickless = tickless;
+    rng = 2463534242U; // 两种配置使用相同的串口到达序列
+    t = 0;
+    busy_until = 0;
+    memset(&st, 0, sizeof(st));
+    st.load = TICK_CYCLES - 1;
+    st_start(0);
+    tick_count = 0;
+    pended_ticks = 0;
+    next_timer = PROF_SAMPLE_MS;
+    delay_until = 0;
+    delay_pending = 0;
+    tim1_next = TIM1_PHASE;
+    tim1_it = 1;
+    uw_tick = 0;
+    lp_sleeping = 0;
+    lp_hal_synced = 0;
+    dwt_frozen = 0;
+    dwt_sleep = 0;
+    dwt_last = 0;
+    uart_schedule(0);
+
+    while (t < end)
+    {
+        next_ev = st.zero_at;
+        if (tim1_next < next_ev)
+        {
+            next_ev = tim1_next;
+        }
+        if (uart_irq < next_ev)
+        {
+            next_ev = uart_irq;
+        }
+
+        // CPU 空闲：空闲任务决定是否进入无节拍睡眠
+        if (busy_until <= t)
+        {
+            if (delay_pending)
+            {
+                delay_pending = 0;
+                delay_until = tick_count + 1;
+            }
+            if (tickless && expected_idle_time() >= EXPECTED_IDLE_BEFORE_SLEEP && next_ev > t + COST_IDLE_ENTRY)
+            {
+                t += COST_IDLE_ENTRY;
+                suppress_ticks_and_sleep(expected_idle_time());
+                continue;
+            }
+        }
+        else if (busy_until < next_ev)
+        {
+            t = busy_until; // 任务执行完，回到空闲
+            continue;
+        }
+
+        // 处理下一个中断 (CPU 醒着，或空闲任务在空转)；睡眠退出路径中关中断期间到来的中断在这里补上
+        if (next_ev > t)
+        {
+            t = next_ev;
+        }
+        if (uart_irq == next_ev)
+        {
+            uart_isr_awake();
+        }
+        else if (tim1_next == next_ev)
+        {
+            tim1_isr();
+        }
+        else
+        {
+            st_advance(t);
+            tick_isr(0);
+        }
+        track_drift();
+    }
+}
+
+static void lat_print(const char *name, const Lat_Stat_t *l)
+{
+    uint32_t i, n = 0;
+
+    if (0 == l->count)
+    {
+        printf("  %-24s no samples\n", name);
+        return;
+    }
+    for (i = 0; i < LAT_BUCKETS && n * 100 < l->count * 99; i++)
+    {
+        n += l->hist[i];
+    }
+    printf("  %-24s %6u, avg %6.2f us, p99 <%2u us, max %6.2f us\n", name, l->count,
+           (double)l->total / l->count / (CPU_HZ / 1000000), i, (double)l->max / (CPU_HZ / 1000000));
+}
+
+static void result_print(const Sim_Result_t *r, double seconds)
+{
+    printf("%s\n", r->tickless ? "Tickless idle ON (configUSE_TICKLESS_IDLE = 1)" : "Tickless idle OFF (tick always running)");
+    printf("  Sleep residency          %6.2f%%\n", 100.0 * r->sleep_cycles / (seconds * CPU_HZ));
+    printf("  CPU busy                 %6.2f%%\n", 100.0 * r->busy_cycles / (seconds * CPU_HZ));
+    printf("  Interrupts per second    %8.1f\n", r->irq_cnt / seconds);
+    if (r->tickless)
+    {
+        printf("  Sleeps                   %6u (early wakes %u, aborted %u), longest %u ms, average %.1f ms\n",
+               r->sleep_cnt, r->early_cnt, r->abort_cnt, r->max_sleep,
+               (0 == r->sleep_cnt) ? 0.0 : (double)r->sleep_ticks / r->sleep_cnt);
+    }
+    printf("  UART ISR -> task latency\n");
+    lat_print("CPU awake", &r->lat_awake);
+    lat_print("woken from sleep", &r->lat_sleep);
+    printf("  Kernel tick drift        max %6.3f ms, end %+7.3f ms (%+.1f ppm)\n", r->kernel_drift_max, r->kernel_drift,
+           r->kernel_drift * 1000 / seconds);
+    printf("  HAL tick drift           max %6.3f ms, end %+7.3f ms\n", r->hal_drift_max, r->hal_drift);
+    printf("  DWT timestamp drift      max %llu cycles, backward %u (without sleep correction: %+.3f ms)\n",
+           (unsigned long long)r->dwt_drift_max, r->dwt_backward, -(double)r->dwt_raw_drift * 1000 / CPU_HZ);
+}
+
+/**
+ * @brief DWT 时间戳单调不减，并且与真实时间成比例 (偏差不超过 DWT_DRIFT_LIMIT)
+ */
+static int dwt_check(const Sim_Result_t *r)
+{
+    return (0 == r->dwt_backward && r->dwt_drift_max <= DWT_DRIFT_LIMIT) ? 0 : 1;
+}
+
+int main(int argc, char **argv)
+{
+    Sim_Result_t off, on;
+    double seconds = 600;
+    int fail;
+
+    burst_mean_ms = (argc > 1) ? atof(argv[1]) : 500;
+    burst_bytes = (argc > 2) ? (uint32_t)atoi(argv[2]) : 16;
+    if (argc > 3)
+    {
+        seconds = atof(argv[3]);
+    }
+    if (burst_mean_ms <= 0 || 0 == burst_bytes || burst_bytes > 64 || seconds <= 0)
+    {
+        printf("usage: %s [burst_interval_ms] [burst_bytes 1..64] [seconds]\n", argv[0]);
+        return 1;
+    }
+
+    printf("UART bursts: %u bytes every %.1f ms on average at %u baud, %.0f s simulated\n\n", burst_bytes,
+           burst_mean_ms, UART_BAUD, seconds);
+    simulate(0, seconds, &off);
+    result_print(&off, seconds);
+    printf("\n");
+    simulate(1, seconds, &on);
+    result_print(&on, seconds);
+    fail = dwt_check(&off) | dwt_check(&on);
+    printf("\nDWT timestamps monotonic and within %u cycles of real time: %s\n", DWT_DRIFT_LIMIT,
+           fail ? "FAIL" : "PASS");
+    return fail;
+}
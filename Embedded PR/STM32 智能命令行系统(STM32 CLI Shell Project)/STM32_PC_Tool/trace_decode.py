@@ -0,0 +1,152 @@
+"""
+RTT 事件追踪解码工具
+
+把 RTT 通道 1 抓到的二进制追踪数据转换成 Chrome Trace JSON，
+用 chrome://tracing 或 https://ui.perfetto.dev 打开即可看到任务/中断时间线。
+
+抓取方法 (J-Link)：
+    JLinkRTTLogger -Device STM32F411CE -If SWD -Speed 4000 -RTTChannel 1 trace.bin
+解码：
+    python trace_decode.py trace.bin -o trace.json
+导出堆分配序列 (交给 heap_bench 回放，比较 heap_4 与 heap_tlsf)：
+    python trace_decode.py trace.bin --heap heap.txt
+
+记录格式与固件 app_trace.h 保持一致：每条 8 字节，小端
+    uint32 ts | uint8 event | uint8 id | uint16 arg
+"""
+import argparse
+import json
+import struct
+
+# 事件编号，与 app_trace.h 中的 Trace_Event_t 一致
+TRC_SYNC = 0
+TRC_TASK_NAME = 1
+TRC_TASK_SWITCH_IN = 2
+TRC_ISR_ENTER = 3
+TRC_ISR_EXIT = 4
+TRC_QUEUE_SEND = 5
+TRC_QUEUE_SEND_ISR = 6
+TRC_QUEUE_RECEIVE = 7
+TRC_QUEUE_BLOCK = 8
+TRC_DROP = 9
+TRC_MALLOC = 10
+TRC_FREE = 11
+
+RECORD = struct.Struct("<IBBH")
+
+QUEUE_EVENT_NAME = {
+    TRC_QUEUE_SEND: "send",
+    TRC_QUEUE_SEND_ISR: "send_isr",
+    TRC_QUEUE_RECEIVE: "receive",
+    TRC_QUEUE_BLOCK: "block",
+}
+
+# 队列类型，与 queue.h 中的 queueQUEUE_TYPE_xxx 一致
+QUEUE_TYPE_NAME = {0: "queue", 1: "mutex", 2: "counting_sem", 3: "binary_sem", 4: "recursive_mutex"}
+
+# STM32F411 常用的 IRQ 编号
+IRQ_NAME = {37: "USART1", 58: "DMA2_Stream2", 70: "DMA2_Stream7", 25: "TIM1_UP"}
+
+PID = 1
+TID_ISR = 1000  # 中断单独占一行时间线
+
+
+def decode(data, freq_mhz, heap_ops=None):
+    """解析二进制记录，返回 Chrome Trace 事件列表；heap_ops 不为 None 时追加堆操作 (op, 块编号, 字节数)"""
+    events = []
+    names = {}        # 任务编号 -> 名字分片
+    cur_task = None   # 当前运行的任务 (编号, 切入时刻us)
+    isr_stack = {}    # IRQ 编号 -> 进入时刻us
+    last_ts = None
+    high = 0          # 32位时间戳卷绕次数
+
+    def to_us(ts):
+        return ts / freq_mhz
+
+    for off in range(0, len(data) - RECORD.size + 1, RECORD.size):
+        ts, event, rid, arg = RECORD.unpack_from(data, off)
+
+        if event == TRC_TASK_NAME:
+            # ts 字段携带 4 个字符，不是时间戳
+            names.setdefault(rid, {})[arg] = struct.pack("<I", ts)
+            continue
+
+        if event in (TRC_MALLOC, TRC_FREE):
+            # ts 字段是字节数，不是时间戳；块编号是地址>>3 的低16位
+            if heap_ops is not None:
+                if event == TRC_FREE:
+                    heap_ops.append(("f", arg, ts))
+                else:
+                    heap_ops.append(("x" if rid else "m", arg, ts))
+            continue
+
+        if event == TRC_SYNC:
+            if arg:
+                freq_mhz = arg
+            last_ts = None
+            high = 0
+
+        # 展开 32 位卷绕：追踪期间至少每个周期都有任务切换，相邻记录间隔远小于卷绕时间
+        if last_ts is not None and ts < last_ts:
+            high += 1
+        last_ts = ts
+        t = to_us((high << 32) + ts)
+
+        if event == TRC_TASK_SWITCH_IN:
+            if cur_task is not None:
+                tid, start = cur_task
+                events.append({"name": "run", "ph": "X", "pid": PID, "tid": tid, "ts": start, "dur": t - start})
+            cur_task = (rid, t)
+        elif event == TRC_ISR_ENTER:
+            isr_stack[rid] = t
+        elif event == TRC_ISR_EXIT:
+            start = isr_stack.pop(rid, None)
+            if start is not None:
+                events.append({"name": IRQ_NAME.get(rid, "IRQ%d" % rid), "ph": "X", "pid": PID,
+                               "tid": TID_ISR, "ts": start, "dur": t - start})
+        elif event in QUEUE_EVENT_NAME:
+            addr = 0x20000000 | (arg << 2)
+            tid = TID_ISR if event == TRC_QUEUE_SEND_ISR or cur_task is None else cur_task[0]
+            events.append({"name": "%s %s" % (QUEUE_TYPE_NAME.get(rid, "queue"), QUEUE_EVENT_NAME[event]),
+                           "ph": "i", "s": "t", "pid": PID, "tid": tid, "ts": t,
+                           "args": {"queue": "0x%08X" % addr}})
+        elif event == TRC_DROP:
+            events.append({"name": "dropped %d records" % arg, "ph": "i", "s": "g", "pid": PID, "ts": t})
+
+    # 任务名元数据
+    for rid, chunks in names.items():
+        raw = b"".join(chunks[i] for i in sorted(chunks))
+        name = raw.split(b"\0", 1)[0].decode("ascii", "replace")
+        events.append({"name": "thread_name", "ph": "M", "pid": PID, "tid": rid, "args": {"name": name}})
+    events.append({"name": "thread_name", "ph": "M", "pid": PID, "tid": TID_ISR, "args": {"name": "ISR"}})
+    return events
+
+
+def main():
+    parser = argparse.ArgumentParser(description="RTT 事件追踪 -> Chrome Trace JSON")
+    parser.add_argument("input", help="JLinkRTTLogger 抓取的二进制文件")
+    parser.add_argument("-o", "--output", default="trace.json", help="输出 JSON 文件")
+    parser.add_argument("--freq", type=float, default=100.0, help="CPU 频率 (MHz)，数据中有同步记录时以记录为准")
+    parser.add_argument("--heap", help="另外导出堆分配序列到文本文件 (heap_bench 的输入)")
+    args = parser.parse_args()
+
+    with open(args.input, "rb") as f:
+        data = f.read()
+
+    heap_ops = [] if args.heap else None
+    events = decode(data, args.freq, heap_ops)
+    with open(args.output, "w") as f:
+        json.dump({"traceEvents": events, "displayTimeUnit": "ns"}, f)
+    print("%d records -> %d events, saved to %s" % (len(data) // RECORD.size, len(events), args.output))
+
+    if args.heap:
+        # 每行一个操作：m <块编号> <申请字节数> / f <块编号> <块大小> / x <块编号> <申请字节数> (分配失败)
+        with open(args.heap, "w") as f:
+            f.write("# heap trace from %s\n" % args.input)
+            for op, slot, size in heap_ops:
+                f.write("%s %d %d\n" % (op, slot, size))
+        print("%d heap operations saved to %s" % (len(heap_ops), args.heap))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,49 @@
+#ifndef __UART_TX_SIM_FREERTOS_H__
+#define __UART_TX_SIM_FREERTOS_H__
+
+/* uart_tx_sim 专用：只提供 bsp_uart_driver.c 用到的定义
+ * 单线程离散事件模拟，信号量等待时推进模拟时间，实现见 uart_tx_sim.c */
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef uint32_t TickType_t;
+
+typedef struct
+{
+    volatile uint32_t count;
+} StaticSemaphore_t;
+typedef StaticSemaphore_t *SemaphoreHandle_t;
+
+#define pdFALSE ((BaseType_t)0)
+#define pdTRUE ((BaseType_t)1)
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms)) // 与固件一样 1 tick = 1ms
+#define taskSCHEDULER_RUNNING ((BaseType_t)2)
+#define APP_STATIC_ALLOCATION 1              // 与固件 FreeRTOSConfig.h 一致
+#define portYIELD_FROM_ISR(x) ((void)(x))
+
+extern int sim_isr_nest;
+
+TickType_t xTaskGetTickCount(void);
+BaseType_t xTaskGetSchedulerState(void);
+SemaphoreHandle_t xSemaphoreCreateBinaryStatic(StaticSemaphore_t *cb);
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks);
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem, BaseType_t *woken);
+UBaseType_t taskENTER_CRITICAL_FROM_ISR(void);
+void taskEXIT_CRITICAL_FROM_ISR(UBaseType_t saved);
+#define taskENTER_CRITICAL() ((void)taskENTER_CRITICAL_FROM_ISR())
+#define taskEXIT_CRITICAL() taskEXIT_CRITICAL_FROM_ISR(0)
+
+static inline BaseType_t xPortIsInsideInterrupt(void)
+{
+    return sim_isr_nest > 0;
+}
+
+static inline uint32_t __get_BASEPRI(void)
+{
+    return 0;
+}
+
+#endif //end __UART_TX_SIM_FREERTOS_H__
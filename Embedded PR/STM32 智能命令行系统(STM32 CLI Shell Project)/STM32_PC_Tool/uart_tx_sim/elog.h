@@ -0,0 +1,7 @@
+#ifndef __UART_TX_SIM_ELOG_H__
+#define __UART_TX_SIM_ELOG_H__
+
+/* uart_tx_sim 专用：bsp_uart_driver.c 初始化时的日志不输出 */
+#define elog_i(tag, ...) ((void)(tag))
+
+#endif //end __UART_TX_SIM_ELOG_H__
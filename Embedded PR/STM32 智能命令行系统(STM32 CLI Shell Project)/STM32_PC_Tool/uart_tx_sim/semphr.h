@@ -0,0 +1,7 @@
+#ifndef __UART_TX_SIM_SEMPHR_H__
+#define __UART_TX_SIM_SEMPHR_H__
+
+/* uart_tx_sim 专用：定义都在 FreeRTOS.h 里 */
+#include "FreeRTOS.h"
+
+#endif //end __UART_TX_SIM_SEMPHR_H__
@@ -0,0 +1,388 @@
+/*
+ * UART DMA 乒乓发送模拟：在 PC 上检验 bsp_uart_driver.c 的发送路径
+ *
+ * bsp_uart_driver.c 原样编译，本目录的 FreeRTOS.h / usart.h 等只提供它用到的定义。
+ * 单线程离散事件模拟：HAL_UART_Transmit_DMA 只记下数据，按 115200 波特率算出发完的时刻，
+ * 模拟时间推进到那里时在 "中断" 里 (sim_isr_nest > 0) 调用 HAL_UART_TxCpltCallback；
+ * 任务等待信号量、两次写之间的间隔都通过推进模拟时间实现。
+ *     gcc -O2 -I. -I../../BSP/BSP_UART -I../../BSP/BSP_DWT -I../../Utils/RingBuffer -o uart_tx_sim uart_tx_sim.c
+ *         ../../BSP/BSP_UART/bsp_uart_driver.c ../../Utils/RingBuffer/ring_buffer.c
+ *     ./uart_tx_sim              模拟 60 秒
+ *     ./uart_tx_sim 600          模拟 600 秒
+ *
+ * 日志任务按 120% 的线路负载写入长度随机的行 (超时 20ms)，中断偶尔写入短行 (不等待)，
+ * 每行写成 "<T|I><序号> <填充>|<长度>\n"。另外在 DMA 启动的瞬间插入中断写入和错误回调，
+ * 偶尔让 HAL_UART_Transmit_DMA 返回 HAL_BUSY。检查：
+ *     1. 线路上每一行完整、不交织，任务和中断各自的序号递增，接受的行全部发出
+ *        (启动失败丢弃的缓冲区除外，按字节核对)，丢弃计数与被拒绝的写入一致
+ *     2. 中断里不调用 xTaskGetTickCount，HAL_UART_Transmit_DMA 不在临界区里调用，同时只有一个 DMA
+ *     3. 发送完成时另一个缓冲区有数据就立即接着发，过载时线路利用率接近 100%
+ *     4. 任务最长等待不超过超时时间
+ * 有一项不符时返回非 0。
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bsp_uart_driver.h"
+
+#define BAUD 115200
+#define BYTE_NS (1000000000ULL * 10 / BAUD)     // 1 起始位 + 8 数据位 + 1 停止位
+#define LOAD_PERCENT 120                        // 任务写入的平均负载 (占线路带宽)
+#define TASK_TIMEOUT_MS 20                      // 与 ELOG_UART_OUTPUT_TIMEOUT_MS 一致
+#define LINE_MIN 24
+#define LINE_MAX 200
+#define ISR_LINE_PERMILLE 100                   // 每 1000 次写入里中断写入的次数
+#define INJECT_PERMILLE 20                      // DMA 启动瞬间插入中断写入 / 错误回调的概率
+#define FAIL_PERMILLE 2                         // HAL_UART_Transmit_DMA 返回 HAL_BUSY 的概率
+#define WIRE_MAX (16 * 1024 * 1024)
+
+UART_HandleTypeDef huart1;
+DMA_HandleTypeDef hdma_usart1_rx;
+USART_TypeDef sim_usart1;
+int sim_isr_nest;
+
+static uint64_t sim_ns;                         // 模拟时间
+static int sim_crit;                            // 临界区嵌套深度
+static struct
+{
+    bool active;
+    uint64_t end_ns;
+    const uint8_t *buf;
+    uint16_t len;
+} dma;
+static uint8_t *wire;                           // 线路上发出的字节
+static size_t wire_len;
+static uint64_t wire_busy_ns;                   // 线路忙的总时间
+static uint32_t err_tick_in_isr, err_dma_in_crit, err_dma_overlap;
+static uint32_t start_fail_cnt, start_fail_bytes;
+static bool inject_armed;
+
+/* ---------------- FreeRTOS / HAL 接口 ---------------- */
+
+TickType_t xTaskGetTickCount(void)
+{
+    if (sim_isr_nest)
+    {
+        err_tick_in_isr++;
+    }
+    return (TickType_t)(sim_ns / 1000000ULL);
+}
+
+uint32_t BSP_DWT_GetCycle(void)
+{
+    return (uint32_t)(sim_ns / 10);             // 100MHz
+}
+
+BaseType_t xTaskGetSchedulerState(void)
+{
+    return taskSCHEDULER_RUNNING;
+}
+
+SemaphoreHandle_t xSemaphoreCreateBinaryStatic(StaticSemaphore_t *cb)
+{
+    cb->count = 0;
+    return cb;
+}
+
+UBaseType_t taskENTER_CRITICAL_FROM_ISR(void)
+{
+    sim_crit++;
+    return 0;
+}
+
+void taskEXIT_CRITICAL_FROM_ISR(UBaseType_t saved)
+{
+    (void)saved;
+    sim_crit--;
+}
+
+BaseType_t xSemaphoreGiveFromISR(SemaphoreHandle_t sem, BaseType_t *woken)
+{
+    sem->count = 1;
+    *woken = pdTRUE;
+    return pdTRUE;
+}
+
+static void Sim_Inject(void);
+
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t *data, uint16_t size)
+{
+    if (sim_crit)
+    {
+        err_dma_in_crit++;
+    }
+    if (inject_armed)
+    {
+        /* 任务已经交换了缓冲区、还没启动 DMA 时来了中断 */
+        inject_armed = false;
+        Sim_Inject();
+    }
+    if (dma.active || huart->gState != HAL_UART_STATE_READY)
+    {
+        err_dma_overlap += dma.active;
+        return HAL_BUSY;
+    }
+    if (rand() % 1000 < FAIL_PERMILLE)
+    {
+        start_fail_cnt++;
+        start_fail_bytes += size;
+        return HAL_BUSY;
+    }
+    huart->gState = HAL_UART_STATE_BUSY_TX;
+    dma.active = true;
+    dma.buf = data;
+    dma.len = size;
+    dma.end_ns = sim_ns + size * BYTE_NS;
+    wire_busy_ns += size * BYTE_NS;
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *data, uint16_t size)
+{
+    (void)huart;
+    (void)data;
+    (void)size;
+    return HAL_OK;
+}
+
+/* ---------------- 模拟时间 ---------------- */
+
+/**
+ * @brief 推进模拟时间到 t，途中 DMA 发完时在中断里调用发送完成回调
+ * @param stop 非 NULL 时信号量被释放就停下
+ */
+static void Sim_Advance(uint64_t t, SemaphoreHandle_t stop)
+{
+    while (dma.active && dma.end_ns <= t)
+    {
+        sim_ns = dma.end_ns;
+        if (wire_len + dma.len <= WIRE_MAX)
+        {
+            memcpy(&wire[wire_len], dma.buf, dma.len);
+        }
+        wire_len += dma.len;
+        dma.active = false;
+        huart1.gState = HAL_UART_STATE_READY;
+        sim_isr_nest++;
+        HAL_UART_TxCpltCallback(&huart1);
+        sim_isr_nest--;
+        if (stop && stop->count)
+        {
+            return;
+        }
+    }
+    sim_ns = t;
+}
+
+BaseType_t xSemaphoreTake(SemaphoreHandle_t sem, TickType_t ticks)
+{
+    if (!sem->count)
+    {
+        Sim_Advance(sim_ns + ticks * 1000000ULL, sem);
+    }
+    if (sem->count)
+    {
+        sem->count = 0;
+        return pdTRUE;
+    }
+    return pdFALSE;
+}
+
+/* ---------------- 写入和检查 ---------------- */
+
+static uint32_t task_seq, isr_seq;
+static uint64_t accepted_bytes, rejected_bytes, rejected_cnt;
+
+/**
+ * @brief 生成一行 "<T|I><序号> <填充>|<长度>\n"
+ */
+static uint16_t Line_Format(char *line, char who, uint32_t seq, uint16_t len)
+{
+    int n = sprintf(line, "%c%lu ", who, (unsigned long)seq);
+    char tail[16];
+    int t = sprintf(tail, "|%u\n", len);
+
+    memset(line + n, 'a' + (char)(seq % 26), len - n - t);
+    memcpy(line + len - t, tail, t);
+    return len;
+}
+
+static void Write_Line(char who, uint16_t len, uint32_t timeout_ms)
+{
+    char line[LINE_MAX + 32];
+    uint32_t *seq = (who == 'T') ? &task_seq : &isr_seq;
+
+    Line_Format(line, who, *seq, len);
+    if (BSP_UART_Write((const uint8_t *)line, len, timeout_ms))
+    {
+        accepted_bytes += len;
+    }
+    else
+    {
+        rejected_bytes += len;
+        rejected_cnt++;
+    }
+    (*seq)++;
+}
+
+static void Isr_Write(void)
+{
+    sim_isr_nest++;
+    Write_Line('I', LINE_MIN + rand() % 16, 0);
+    sim_isr_nest--;
+}
+
+static void Sim_Inject(void)
+{
+    Isr_Write();
+    if (rand() & 1)
+    {
+        /* 接收出错：发送的状态是 STARTING，错误回调不能动它 */
+        sim_isr_nest++;
+        HAL_UART_ErrorCallback(&huart1);
+        sim_isr_nest--;
+    }
+}
+
+/**
+ * @brief 检查线路上的字节流
+ * @return 完整的行数，格式错误或顺序错误时返回 -1
+ */
+static long Wire_Check(void)
+{
+    size_t pos = 0;
+    long lines = 0;
+    long last_t = -1, last_i = -1;
+
+    while (pos < wire_len)
+    {
+        const char *p = (const char *)&wire[pos];
+        const char *nl = memchr(p, '\n', wire_len - pos);
+        const char *bar;
+        char line[LINE_MAX + 32];
+        unsigned long seq;
+        unsigned len;
+        long *last;
+
+        if (!nl)
+        {
+            printf("wire: unterminated line at %zu\n", pos);
+            return -1;
+        }
+        bar = nl;
+        while (bar > p && *bar != '|')
+        {
+            bar--;
+        }
+        if ((p[0] != 'T' && p[0] != 'I') || sscanf(p + 1, "%lu", &seq) != 1 || sscanf(bar, "|%u", &len) != 1
+            || len != (unsigned)(nl - p + 1) || len > LINE_MAX)
+        {
+            printf("wire: broken line at %zu\n", pos);
+            return -1;
+        }
+        Line_Format(line, p[0], (uint32_t)seq, (uint16_t)len);
+        if (memcmp(line, p, len) != 0)
+        {
+            printf("wire: interleaved line at %zu\n", pos);
+            return -1;
+        }
+        last = (p[0] == 'T') ? &last_t : &last_i;
+        if ((long)seq <= *last)
+        {
+            printf("wire: %c%lu after %c%ld\n", p[0], seq, p[0], *last);
+            return -1;
+        }
+        *last = (long)seq;
+        pos += len;
+        lines++;
+    }
+    return lines;
+}
+
+int main(int argc, char *argv[])
+{
+    uint64_t duration_ns = (uint64_t)((argc > 1) ? strtoul(argv[1], NULL, 0) : 60) * 1000000000ULL;
+    uint64_t mean_gap_ns = (LINE_MIN + LINE_MAX) / 2 * BYTE_NS * 100 / LOAD_PERCENT;
+    uint64_t t0, wait_ns, wait_max_ns = 0, write_ns, write_busy_ns;
+    uint32_t drop_cnt, drop_bytes;
+    long lines;
+    int fail = 0;
+
+    wire = malloc(WIRE_MAX);
+    srand(1);
+    huart1.Instance = USART1;
+    huart1.gState = HAL_UART_STATE_READY;
+    BSP_UART_Init();
+
+    while (sim_ns < duration_ns)
+    {
+        uint64_t gap = (uint64_t)(mean_gap_ns * 2.0 * rand() / RAND_MAX);
+        uint64_t next = sim_ns + gap;
+        Sim_Advance(next, NULL);
+        if (rand() % 1000 < ISR_LINE_PERMILLE)
+        {
+            Isr_Write();
+            continue;
+        }
+        inject_armed = (rand() % 1000 < INJECT_PERMILLE);
+        t0 = sim_ns;
+        Write_Line('T', LINE_MIN + rand() % (LINE_MAX - LINE_MIN + 1), TASK_TIMEOUT_MS);
+        inject_armed = false;
+        wait_ns = sim_ns - t0;
+        if (wait_ns > wait_max_ns)
+        {
+            wait_max_ns = wait_ns;
+        }
+    }
+    /* 利用率只算写入期间，之后把剩下的数据发完 */
+    write_ns = sim_ns;
+    write_busy_ns = wire_busy_ns - (dma.active ? dma.end_ns - sim_ns : 0);
+    Sim_Advance(sim_ns + 1000000000ULL, NULL);
+
+    BSP_UART_GetTxDrop(&drop_cnt, &drop_bytes);
+    lines = Wire_Check();
+    printf("simulated %.1f s at %u baud, offered load %d%%\n", sim_ns / 1e9, BAUD, LOAD_PERCENT);
+    printf("written: task %lu, isr %lu lines; accepted %llu bytes, rejected %llu lines (%llu bytes)\n",
+           (unsigned long)task_seq, (unsigned long)isr_seq, (unsigned long long)accepted_bytes,
+           (unsigned long long)rejected_cnt, (unsigned long long)rejected_bytes);
+    printf("wire: %zu bytes, %ld lines, %.2f%% busy while writing, throughput %.0f B/s (max %u)\n", wire_len,
+           lines, 100.0 * write_busy_ns / write_ns, write_busy_ns / (double)BYTE_NS * 1e9 / write_ns, BAUD / 10);
+    printf("start failed: %lu buffers (%lu bytes); driver drop: %lu (%lu bytes)\n", (unsigned long)start_fail_cnt,
+           (unsigned long)start_fail_bytes, (unsigned long)drop_cnt, (unsigned long)drop_bytes);
+    printf("max task wait: %.2f ms (timeout %d ms)\n", wait_max_ns / 1e6, TASK_TIMEOUT_MS);
+
+    if (lines < 0 || wire_len > WIRE_MAX)
+    {
+        fail = 1;
+    }
+    if (wire_len + start_fail_bytes != accepted_bytes)
+    {
+        printf("FAIL: wire %zu + start failed %lu != accepted %llu\n", wire_len, (unsigned long)start_fail_bytes,
+               (unsigned long long)accepted_bytes);
+        fail = 1;
+    }
+    if (drop_cnt != rejected_cnt + start_fail_cnt || drop_bytes != rejected_bytes + start_fail_bytes)
+    {
+        printf("FAIL: driver drop count does not match\n");
+        fail = 1;
+    }
+    if (err_tick_in_isr || err_dma_in_crit || err_dma_overlap)
+    {
+        printf("FAIL: tick read in ISR %lu, DMA started in critical section %lu, DMA overlap %lu\n",
+               (unsigned long)err_tick_in_isr, (unsigned long)err_dma_in_crit, (unsigned long)err_dma_overlap);
+        fail = 1;
+    }
+    if (write_busy_ns * 100 < write_ns * 97)
+    {
+        printf("FAIL: line utilization below 97%% under %d%% load\n", LOAD_PERCENT);
+        fail = 1;
+    }
+    if (wait_max_ns > (TASK_TIMEOUT_MS + 1) * 1000000ULL)
+    {
+        printf("FAIL: task waited longer than the timeout\n");
+        fail = 1;
+    }
+    printf("%s\n", fail ? "FAIL" : "PASS");
+    free(wire);
+    return fail;
+}
@@ -0,0 +1,51 @@
+#ifndef __UART_TX_SIM_USART_H__
+#define __UART_TX_SIM_USART_H__
+
+/* uart_tx_sim 专用：代替 CubeMX 的 usart.h，只提供 bsp_uart_driver.c 用到的 HAL 定义
+ * HAL_UART_Transmit_DMA 只记下要发送的数据，由模拟程序按波特率推进并调用发送完成回调 */
+#include <stdint.h>
+
+typedef enum
+{
+    HAL_OK = 0,
+    HAL_ERROR,
+    HAL_BUSY,
+    HAL_TIMEOUT,
+} HAL_StatusTypeDef;
+
+typedef enum
+{
+    HAL_UART_STATE_READY = 0x20,
+    HAL_UART_STATE_BUSY_TX = 0x21,
+} HAL_UART_StateTypeDef;
+
+typedef struct
+{
+    int dummy;
+} USART_TypeDef;
+
+typedef struct
+{
+    int dummy;
+} DMA_HandleTypeDef;
+
+typedef struct
+{
+    USART_TypeDef *Instance;
+    volatile HAL_UART_StateTypeDef gState;
+} UART_HandleTypeDef;
+
+extern USART_TypeDef sim_usart1;
+#define USART1 (&sim_usart1)
+#define UNUSED(x) ((void)(x))
+#define __HAL_UART_CLEAR_OREFLAG(h) ((void)(h))
+#define __HAL_UART_CLEAR_NEFLAG(h) ((void)(h))
+#define __HAL_UART_CLEAR_FEFLAG(h) ((void)(h))
+#define __HAL_UART_CLEAR_PEFLAG(h) ((void)(h))
+
+HAL_StatusTypeDef HAL_UART_Transmit_DMA(UART_HandleTypeDef *huart, const uint8_t *data, uint16_t size);
+HAL_StatusTypeDef HAL_UARTEx_ReceiveToIdle_DMA(UART_HandleTypeDef *huart, uint8_t *data, uint16_t size);
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart);
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart);
+
+#endif //end __UART_TX_SIM_USART_H__